@@ -0,0 +1,54 @@
+#pragma once
+//  === Host shim: the slice of the arduino-esp32 core the firmware uses =============================
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+#include "esp_timer.h"
+
+#include "WString.h"
+#include "Print.h"
+#include "IPAddress.h"
+#include "Esp.h"
+
+#define HIGH          0x1
+#define LOW           0x0
+#define INPUT         0x01
+#define OUTPUT        0x03
+#define INPUT_PULLUP  0x05
+
+#define PROGMEM
+#define PGM_P         const char*
+#define F(s)          (s)
+
+unsigned long millis(void);
+unsigned long micros(void);
+void          delay(uint32_t ms);
+void          yield(void);
+void          pinMode(uint8_t pin, uint8_t mode);
+void          digitalWrite(uint8_t pin, uint8_t val);
+int           digitalRead(uint8_t pin);
+
+bool          psramFound(void);
+void*         ps_malloc(size_t size);
+
+class HardwareSerial : public Print {
+public:
+  void begin(unsigned long baud) { (void) baud; }
+  size_t write(uint8_t c);
+  size_t write(const uint8_t* buffer, size_t size);
+  using Print::write;
+  operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
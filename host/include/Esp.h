@@ -0,0 +1,22 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// Heap figures are modelled on an ESP32 with 4 MB PSRAM; the host tracks what the firmware
+// allocates through ps_malloc so PSRAM numbers move with the frame buffers
+class EspClass {
+public:
+  uint32_t getHeapSize();
+  uint32_t getFreeHeap();
+  uint32_t getMinFreeHeap();
+  uint32_t getMaxAllocHeap();
+  uint32_t getPsramSize();
+  uint32_t getFreePsram();
+  uint32_t getMinFreePsram();
+  uint32_t getMaxAllocPsram();
+  uint32_t getCpuFreqMHz() { return 240; }
+  const char* getSdkVersion() { return "host"; }
+  void restart() __attribute__ ((noreturn));
+};
+
+extern EspClass ESP;
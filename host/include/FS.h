@@ -0,0 +1,44 @@
+#pragma once
+//  === Host shim: Arduino FS File over stdio =====================================================
+
+#include <stdio.h>
+#include <memory>
+#include "Arduino.h"
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+
+class File {
+public:
+  File() {}
+  File(FILE* f, const String& name);
+
+  size_t  size() const { return _size; }
+  int     available();
+  int     read();
+  int     read(uint8_t* buf, size_t size);
+  size_t  write(const uint8_t* buf, size_t size);
+  void    close();
+  const char* name() const { return _name.c_str(); }
+  operator bool() const { return (bool) _f; }
+
+private:
+  std::shared_ptr<FILE> _f;
+  String                _name;
+  size_t                _size = 0;
+};
+
+namespace fs {
+class FS {
+public:
+  explicit FS(const char* root) : _root(root) {}
+  File  open(const char* path, const char* mode = FILE_READ);
+  File  open(const String& path, const char* mode = FILE_READ) { return open(path.c_str(), mode); }
+  bool  exists(const char* path);
+  bool  exists(const String& path) { return exists(path.c_str()); }
+  void  setRoot(const char* root) { _root = root; }
+
+protected:
+  String _root;
+};
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <stdint.h>
+#include "WString.h"
+
+class IPAddress {
+public:
+  IPAddress() : _addr(0) {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+    : _addr((uint32_t) a | ((uint32_t) b << 8) | ((uint32_t) c << 16) | ((uint32_t) d << 24)) {}
+  IPAddress(uint32_t addr) : _addr(addr) {}
+  operator uint32_t() const { return _addr; }
+  uint8_t operator[](int i) const { return (uint8_t) (_addr >> (8 * i)); }
+  String toString() const;
+
+private:
+  uint32_t _addr;
+};
@@ -0,0 +1,38 @@
+#pragma once
+//  === Host shim: Preferences backed by one text file per NVS namespace ===========================
+
+#include <map>
+#include <string>
+#include "Arduino.h"
+
+class Preferences {
+public:
+  bool    begin(const char* name, bool readOnly = false, const char* partition_label = NULL);
+  void    end();
+  bool    clear();
+  bool    remove(const char* key);
+  bool    isKey(const char* key);
+
+  size_t  putInt(const char* key, int32_t value);
+  size_t  putUInt(const char* key, uint32_t value);
+  size_t  putString(const char* key, const char* value);
+  size_t  putString(const char* key, const String& value) { return putString(key, value.c_str()); }
+  size_t  putBytes(const char* key, const void* value, size_t len);
+
+  int32_t  getInt(const char* key, int32_t defaultValue = 0);
+  uint32_t getUInt(const char* key, uint32_t defaultValue = 0);
+  String   getString(const char* key, const String& defaultValue = String());
+  size_t   getBytesLength(const char* key);
+  size_t   getBytes(const char* key, void* buf, size_t maxLen);
+
+private:
+  bool    commit();
+
+  std::string                         _path;
+  bool                                _open = false;
+  bool                                _readOnly = false;
+  std::map<std::string, std::string>  _values;   // key -> type char + hex encoded payload
+};
+
+// Number of NVS commits made by all Preferences instances (each one is a flash write on the device)
+extern uint32_t hostNvsCommits;
@@ -0,0 +1,10 @@
+#pragma once
+#include "FS.h"
+
+class SPIFFSFS : public fs::FS {
+public:
+  SPIFFSFS() : fs::FS("data") {}
+  bool begin(bool formatOnFail = false) { (void) formatOnFail; return true; }
+};
+
+extern SPIFFSFS SPIFFS;
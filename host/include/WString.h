@@ -0,0 +1,78 @@
+#pragma once
+//  === Host shim: Arduino String over std::string ==================================================
+
+#include <string>
+#include <stdint.h>
+#include <stddef.h>
+
+class String {
+public:
+  String() {}
+  String(const char* s) : _s(s ? s : "") {}
+  String(const std::string& s) : _s(s) {}
+  String(const String& s) : _s(s._s) {}
+  explicit String(char c) : _s(1, c) {}
+  explicit String(int v, unsigned char base = 10);
+  explicit String(unsigned int v, unsigned char base = 10);
+  explicit String(long v, unsigned char base = 10);
+  explicit String(unsigned long v, unsigned char base = 10);
+  explicit String(float v, unsigned int decimals = 2);
+  explicit String(double v, unsigned int decimals = 2);
+
+  String& operator=(const String& rhs) { _s = rhs._s; return *this; }
+  String& operator=(const char* rhs) { _s = rhs ? rhs : ""; return *this; }
+
+  bool reserve(unsigned int size) { _s.reserve(size); return true; }
+  unsigned int length() const { return _s.length(); }
+  const char* c_str() const { return _s.c_str(); }
+  bool isEmpty() const { return _s.empty(); }
+
+  bool concat(const String& s) { _s += s._s; return true; }
+  bool concat(const char* s) { if (s) _s += s; return true; }
+  bool concat(char c) { _s += c; return true; }
+  bool concat(int v) { return concat(String(v)); }
+  bool concat(unsigned int v) { return concat(String(v)); }
+  bool concat(long v) { return concat(String(v)); }
+  bool concat(unsigned long v) { return concat(String(v)); }
+
+  String& operator+=(const String& rhs) { concat(rhs); return *this; }
+  String& operator+=(const char* rhs) { concat(rhs); return *this; }
+  String& operator+=(char rhs) { concat(rhs); return *this; }
+  String& operator+=(int rhs) { concat(rhs); return *this; }
+  String& operator+=(unsigned int rhs) { concat(rhs); return *this; }
+  String& operator+=(long rhs) { concat(rhs); return *this; }
+  String& operator+=(unsigned long rhs) { concat(rhs); return *this; }
+
+  bool equals(const String& s) const { return _s == s._s; }
+  bool equals(const char* s) const { return _s == (s ? s : ""); }
+  bool equalsIgnoreCase(const String& s) const;
+  bool operator==(const String& rhs) const { return equals(rhs); }
+  bool operator==(const char* rhs) const { return equals(rhs); }
+  bool operator!=(const String& rhs) const { return !equals(rhs); }
+  bool operator!=(const char* rhs) const { return !equals(rhs); }
+  bool startsWith(const String& s) const { return _s.compare(0, s._s.size(), s._s) == 0; }
+  bool endsWith(const String& s) const;
+
+  char charAt(unsigned int i) const { return i < _s.size() ? _s[i] : 0; }
+  char operator[](unsigned int i) const { return charAt(i); }
+
+  int indexOf(char c, unsigned int from = 0) const;
+  int indexOf(const String& s, unsigned int from = 0) const;
+  int lastIndexOf(char c) const;
+  String substring(unsigned int from) const;
+  String substring(unsigned int from, unsigned int to) const;
+
+  void replace(const String& find, const String& replace);
+  void trim();
+  void toLowerCase();
+  long toInt() const;
+  float toFloat() const;
+
+  friend String operator+(const String& lhs, const String& rhs) { String r(lhs); r += rhs; return r; }
+  friend String operator+(const String& lhs, const char* rhs) { String r(lhs); r += rhs; return r; }
+  friend String operator+(const char* lhs, const String& rhs) { String r(lhs); r += rhs; return r; }
+  friend String operator+(const String& lhs, char rhs) { String r(lhs); r += rhs; return r; }
+
+private:
+  std::string _s;
+};
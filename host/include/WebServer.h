@@ -0,0 +1,95 @@
+#pragma once
+//  === Host shim: single-threaded HTTP/1.1 server with the arduino-esp32 WebServer interface =======
+
+#include <functional>
+#include <vector>
+#include "Arduino.h"
+#include "WiFiClient.h"
+
+typedef enum {
+  HTTP_ANY = 0,
+  HTTP_GET,
+  HTTP_HEAD,
+  HTTP_POST,
+  HTTP_PUT,
+  HTTP_PATCH,
+  HTTP_DELETE,
+  HTTP_OPTIONS
+} HTTPMethod;
+
+#define CONTENT_LENGTH_UNKNOWN  ((size_t) -1)
+#define CONTENT_LENGTH_NOT_SET  ((size_t) -2)
+
+class WebServer {
+public:
+  typedef std::function<void(void)> THandlerFunction;
+
+  explicit WebServer(int port = 80);
+  ~WebServer();
+
+  void        begin();
+  void        handleClient();
+  void        on(const String& uri, THandlerFunction fn) { on(uri, HTTP_ANY, fn); }
+  void        on(const String& uri, HTTPMethod method, THandlerFunction fn);
+  void        onNotFound(THandlerFunction fn) { _notFound = fn; }
+
+  String      uri() const { return _uri; }
+  HTTPMethod  method() const { return _method; }
+  WiFiClient& client() { return _client; }
+
+  String      arg(const String& name) const;
+  String      arg(int i) const;
+  String      argName(int i) const;
+  int         args() const { return (int) _args.size(); }
+  bool        hasArg(const String& name) const;
+  void        collectHeaders(const char* headerKeys[], const size_t headerKeysCount);
+  String      header(const String& name) const;
+  bool        hasHeader(const String& name) const;
+
+  void        send(int code, const char* content_type = NULL, const String& content = String(""));
+  void        send(int code, const String& content_type, const String& content) { send(code, content_type.c_str(), content); }
+  void        send_P(int code, PGM_P content_type, PGM_P content);
+  void        send_P(int code, PGM_P content_type, PGM_P content, size_t contentLength);
+  void        sendHeader(const String& name, const String& value, bool first = false);
+  void        setContentLength(const size_t contentLength) { _contentLength = contentLength; }
+  void        sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+  void        sendContent(const char* content, size_t contentLength);
+  void        sendContent_P(PGM_P content, size_t size) { sendContent(content, size); }
+
+  template <typename T>
+  size_t streamFile(T& file, const String& contentType) {
+    setContentLength(file.size());
+    send(200, contentType.c_str(), "");
+    uint8_t buf[1460];
+    size_t total = 0;
+    int n;
+    while ( (n = file.read(buf, sizeof(buf))) > 0 ) {
+      total += _client.write(buf, n);
+    }
+    return total;
+  }
+
+private:
+  struct handler_t {
+    String            uri;
+    HTTPMethod        method;
+    THandlerFunction  fn;
+  };
+  typedef std::pair<String, String> kv_t;
+
+  bool        readRequest(int fd);
+  void        sendHead(int code, const char* content_type, size_t contentLength);
+
+  int                     _port;
+  int                     _listenFd;
+  std::vector<handler_t>  _handlers;
+  THandlerFunction        _notFound;
+  WiFiClient              _client;
+  String                  _uri;
+  HTTPMethod              _method;
+  std::vector<kv_t>       _args;
+  std::vector<kv_t>       _headers;
+  String                  _responseHeaders;
+  size_t                  _contentLength;
+  bool                    _chunked;
+};
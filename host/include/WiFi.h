@@ -0,0 +1,46 @@
+#pragma once
+//  === Host shim: WiFi is always "connected" to the loopback network ==============================
+
+#include "Arduino.h"
+#include "esp_wifi.h"
+#include "WiFiClient.h"
+
+typedef enum { WIFI_OFF = 0, WIFI_STA, WIFI_AP, WIFI_AP_STA } wifi_mode_t;
+typedef enum { WL_IDLE_STATUS = 0, WL_NO_SSID_AVAIL, WL_SCAN_COMPLETED, WL_CONNECTED,
+               WL_CONNECT_FAILED, WL_CONNECTION_LOST, WL_DISCONNECTED } wl_status_t;
+typedef enum { WIFI_POWER_19_5dBm = 78 } wifi_power_t;
+typedef enum { WIFI_AUTH_OPEN = 0, WIFI_AUTH_WEP, WIFI_AUTH_WPA_PSK } wifi_auth_mode_t;
+
+class WiFiClass {
+public:
+  bool        mode(wifi_mode_t m) { _mode = m; return true; }
+  bool        softAP(const char* ssid, const char* pwd = NULL) { (void) ssid; (void) pwd; return true; }
+  bool        softAPdisconnect(bool wifioff = false) { (void) wifioff; return true; }
+  IPAddress   softAPIP() { return IPAddress(127, 0, 0, 1); }
+  bool        enableAP(bool enable) { (void) enable; return true; }
+  bool        setAutoReconnect(bool v) { (void) v; return true; }
+  bool        setSleep(bool v) { (void) v; return true; }
+  bool        setTxPower(wifi_power_t p) { (void) p; return true; }
+  void        setMinSecurity(wifi_auth_mode_t m) { (void) m; }
+  wl_status_t begin(const char* ssid, const char* pwd = NULL, int32_t channel = 0,
+                    const uint8_t* bssid = NULL, bool connect = true);
+  bool        disconnect(bool wifioff = false) { (void) wifioff; _status = WL_DISCONNECTED; return true; }
+  wl_status_t status() { return _status; }
+  IPAddress   localIP() { return IPAddress(127, 0, 0, 1); }
+  int8_t      RSSI();
+  int32_t     channel() { return 6; }
+  int16_t     scanNetworks(bool async = false, bool hidden = false, bool passive = false,
+                           uint32_t maxMsPerChan = 300, uint8_t channel = 0, const char* ssid = NULL);
+  String      SSID(uint8_t i) { (void) i; return _ssid; }
+  int32_t     RSSI(uint8_t i) { (void) i; return RSSI(); }
+  int32_t     channel(uint8_t i) { (void) i; return channel(); }
+  uint8_t*    BSSID(uint8_t i) { (void) i; return _bssid; }
+
+private:
+  wifi_mode_t _mode = WIFI_OFF;
+  wl_status_t _status = WL_DISCONNECTED;
+  String      _ssid;
+  uint8_t     _bssid[6] = { 0x02, 0, 0, 0, 0, 0x01 };
+};
+
+extern WiFiClass WiFi;
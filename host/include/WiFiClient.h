@@ -0,0 +1,34 @@
+#pragma once
+//  === Host shim: WiFiClient over a POSIX TCP socket ==============================================
+//  Copies share the socket like the arduino-esp32 client does, so a handler can keep the
+//  connection after the web server drops its own reference.
+
+#include <memory>
+#include "Arduino.h"
+
+class hostSocket;
+
+class WiFiClient : public Print {
+public:
+  WiFiClient() {}
+  explicit WiFiClient(int fd);
+  virtual ~WiFiClient() {}
+
+  size_t  write(uint8_t c) { return write(&c, 1); }
+  size_t  write(const uint8_t* buf, size_t size);
+  using Print::write;
+  int     available();
+  int     read();
+  int     read(uint8_t* buf, size_t size);
+  void    flush() {}
+  void    stop();
+  uint8_t connected();
+  operator bool() { return connected(); }
+  int     fd() const;
+  int     setNoDelay(bool nodelay);
+  int     setTimeout(uint32_t seconds);
+  IPAddress remoteIP() const;
+
+private:
+  std::shared_ptr<hostSocket> _sock;
+};
@@ -0,0 +1,8 @@
+#pragma once
+
+// Host build: WiFi is simulated, credentials are placeholders
+#define WIFI_SSID "host"
+#define WIFI_PWD  "host"
+
+#define AP_SSID "ESP32-CAM-AP"
+#define AP_PWD  "ESP32CAM123"
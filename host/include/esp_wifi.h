@@ -0,0 +1,32 @@
+#pragma once
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef enum { WIFI_IF_STA = 0, WIFI_IF_AP } wifi_interface_t;
+typedef enum { WIFI_BW_HT20 = 1, WIFI_BW_HT40 } wifi_bandwidth_t;
+typedef enum { WIFI_PS_NONE = 0, WIFI_PS_MIN_MODEM, WIFI_PS_MAX_MODEM } wifi_ps_type_t;
+typedef enum { WIFI_SECOND_CHAN_NONE = 0, WIFI_SECOND_CHAN_ABOVE, WIFI_SECOND_CHAN_BELOW } wifi_second_chan_t;
+
+#define WIFI_PROTOCOL_11B   1
+#define WIFI_PROTOCOL_11G   2
+#define WIFI_PROTOCOL_11N   4
+
+typedef struct {
+  uint8_t             bssid[6];
+  uint8_t             ssid[33];
+  uint8_t             primary;
+  wifi_second_chan_t  second;
+  int8_t              rssi;
+  uint32_t            phy_11b:1;
+  uint32_t            phy_11g:1;
+  uint32_t            phy_11n:1;
+  uint32_t            phy_lr:1;
+  uint32_t            wps:1;
+  uint32_t            reserved:27;
+} wifi_ap_record_t;
+
+esp_err_t esp_wifi_sta_get_ap_info(wifi_ap_record_t* ap_info);
+esp_err_t esp_wifi_set_bandwidth(wifi_interface_t ifx, wifi_bandwidth_t bw);
+esp_err_t esp_wifi_set_protocol(wifi_interface_t ifx, uint8_t protocol_bitmap);
+esp_err_t esp_wifi_get_protocol(wifi_interface_t ifx, uint8_t* protocol_bitmap);
+esp_err_t esp_wifi_set_ps(wifi_ps_type_t type);
@@ -0,0 +1,54 @@
+#pragma once
+//  === Host shim: FreeRTOS kernel API on top of pthreads ===========================================
+//  Only what the firmware uses. Ticks are milliseconds (CONFIG_FREERTOS_HZ=1000).
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+
+typedef int           BaseType_t;
+typedef unsigned int  UBaseType_t;
+typedef uint32_t      TickType_t;
+typedef uint32_t      StackType_t;
+
+#define pdFALSE         ((BaseType_t) 0)
+#define pdTRUE          ((BaseType_t) 1)
+#define pdPASS          pdTRUE
+#define pdFAIL          pdFALSE
+#define portMAX_DELAY   ((TickType_t) 0xffffffffUL)
+#define portTICK_PERIOD_MS    ((TickType_t) 1)
+#define portTICK_RATE_MS      portTICK_PERIOD_MS
+#define pdMS_TO_TICKS(xTimeInMs)  ((TickType_t) (xTimeInMs))
+#define pdTICKS_TO_MS(xTicks)     ((uint32_t) (xTicks))
+#define configTICK_RATE_HZ        1000
+#define configMAX_PRIORITIES      25
+#ifndef configUSE_TRACE_FACILITY
+#define configUSE_TRACE_FACILITY      1   // uxTaskGetSystemState()
+#endif
+#ifndef configGENERATE_RUN_TIME_STATS
+#define configGENERATE_RUN_TIME_STATS 1   // run time counters, see TaskStatus_t
+#endif
+#define tskIDLE_PRIORITY          ((UBaseType_t) 0U)
+#define tskNO_AFFINITY            ((BaseType_t) 0x7FFFFFFF)
+#define portNUM_PROCESSORS        2
+
+// Critical sections: a recursive mutex per portMUX_TYPE
+typedef struct {
+  pthread_mutex_t mux;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED  { PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP }
+
+static inline void vPortEnterCritical(portMUX_TYPE* m) { pthread_mutex_lock(&m->mux); }
+static inline void vPortExitCritical(portMUX_TYPE* m)  { pthread_mutex_unlock(&m->mux); }
+
+#define portENTER_CRITICAL(m)       vPortEnterCritical(m)
+#define portEXIT_CRITICAL(m)        vPortExitCritical(m)
+#define portENTER_CRITICAL_ISR(m)   vPortEnterCritical(m)
+#define portEXIT_CRITICAL_ISR(m)    vPortExitCritical(m)
+#define taskENTER_CRITICAL(m)       vPortEnterCritical(m)
+#define taskEXIT_CRITICAL(m)        vPortExitCritical(m)
+
+BaseType_t xPortGetCoreID(void);
+
+#include "freertos/task.h"
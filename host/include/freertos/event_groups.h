@@ -0,0 +1,13 @@
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+typedef struct hostEventGroup* EventGroupHandle_t;
+typedef uint32_t EventBits_t;
+
+EventGroupHandle_t xEventGroupCreate(void);
+EventBits_t        xEventGroupSetBits(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToSet);
+EventBits_t        xEventGroupClearBits(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToClear);
+EventBits_t        xEventGroupGetBits(EventGroupHandle_t xEventGroup);
+EventBits_t        xEventGroupWaitBits(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToWaitFor,
+                                       BaseType_t xClearOnExit, BaseType_t xWaitForAllBits,
+                                       TickType_t xTicksToWait);
@@ -0,0 +1,12 @@
+#pragma once
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+typedef struct hostQueue* SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount);
+BaseType_t        xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime);
+BaseType_t        xSemaphoreGive(SemaphoreHandle_t xSemaphore);
+void              vSemaphoreDelete(SemaphoreHandle_t xSemaphore);
@@ -0,0 +1,69 @@
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+typedef struct hostTask* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+typedef enum {
+  eRunning = 0,
+  eReady,
+  eBlocked,
+  eSuspended,
+  eDeleted,
+  eInvalid
+} eTaskState;
+
+typedef enum {
+  eNoAction = 0,
+  eSetBits,
+  eIncrement,
+  eSetValueWithOverwrite,
+  eSetValueWithoutOverwrite
+} eNotifyAction;
+
+// Runtime stats: the run time counter is the thread's CPU time, the total is time since start,
+// both in microseconds like the esp_timer clock ESP-IDF counts with
+typedef struct {
+  TaskHandle_t  xHandle;
+  const char*   pcTaskName;
+  UBaseType_t   xTaskNumber;
+  eTaskState    eCurrentState;
+  UBaseType_t   uxCurrentPriority;
+  UBaseType_t   uxBasePriority;
+  uint32_t      ulRunTimeCounter;
+  StackType_t*  pxStackBase;
+  uint32_t      usStackHighWaterMark;
+} TaskStatus_t;
+
+BaseType_t  xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode, const char* pcName, uint32_t usStackDepth,
+                                    void* pvParameters, UBaseType_t uxPriority, TaskHandle_t* pvCreatedTask,
+                                    BaseType_t xCoreID);
+BaseType_t  xTaskCreate(TaskFunction_t pvTaskCode, const char* pcName, uint32_t usStackDepth,
+                        void* pvParameters, UBaseType_t uxPriority, TaskHandle_t* pvCreatedTask);
+void        vTaskDelete(TaskHandle_t xTask);
+void        vTaskDelay(TickType_t xTicksToDelay);
+void        vTaskDelayUntil(TickType_t* pxPreviousWakeTime, TickType_t xTimeIncrement);
+BaseType_t  xTaskDelayUntil(TickType_t* pxPreviousWakeTime, TickType_t xTimeIncrement);
+void        vTaskSuspend(TaskHandle_t xTask);
+void        vTaskResume(TaskHandle_t xTask);
+eTaskState  eTaskGetState(TaskHandle_t xTask);
+void        vTaskPrioritySet(TaskHandle_t xTask, UBaseType_t uxNewPriority);
+UBaseType_t uxTaskPriorityGet(TaskHandle_t xTask);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+char*       pcTaskGetName(TaskHandle_t xTask);
+BaseType_t  xTaskGetAffinity(TaskHandle_t xTask);
+TickType_t  xTaskGetTickCount(void);
+UBaseType_t uxTaskGetNumberOfTasks(void);
+UBaseType_t uxTaskGetSystemState(TaskStatus_t* pxTaskStatusArray, UBaseType_t uxArraySize, uint32_t* pulTotalRunTime);
+void        taskYIELD(void);
+
+BaseType_t  xTaskGenericNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+                               uint32_t* pulPreviousNotificationValue);
+BaseType_t  xTaskNotifyWait(uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit,
+                            uint32_t* pulNotificationValue, TickType_t xTicksToWait);
+uint32_t    ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
+
+#define xTaskNotify(xTaskToNotify, ulValue, eAction)  xTaskGenericNotify((xTaskToNotify), (ulValue), (eAction), NULL)
+#define xTaskNotifyGive(xTaskToNotify)                xTaskGenericNotify((xTaskToNotify), 0, eIncrement, NULL)
+#define pcTaskGetTaskName(xTask)                      pcTaskGetName(xTask)
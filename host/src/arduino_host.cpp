@@ -0,0 +1,182 @@
+//  === Host shim: Arduino core, String, Print and ESP ===============================================
+
+#include "Arduino.h"
+
+#include <chrono>
+#include <ctype.h>
+#include <malloc.h>
+#include <unistd.h>
+
+HardwareSerial Serial;
+EspClass       ESP;
+
+static const auto bootTime = std::chrono::steady_clock::now();
+
+int64_t esp_timer_get_time(void) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+           std::chrono::steady_clock::now() - bootTime).count();
+}
+
+unsigned long millis(void) { return (unsigned long) (esp_timer_get_time() / 1000); }
+unsigned long micros(void) { return (unsigned long) esp_timer_get_time(); }
+void delay(uint32_t ms) { vTaskDelay(pdMS_TO_TICKS(ms)); }
+void yield(void) { taskYIELD(); }
+
+void pinMode(uint8_t pin, uint8_t mode) { (void) pin; (void) mode; }
+void digitalWrite(uint8_t pin, uint8_t val) { (void) pin; (void) val; }
+int  digitalRead(uint8_t pin) { (void) pin; return LOW; }
+
+bool  psramFound(void) { return true; }
+void* ps_malloc(size_t size) { return malloc(size); }
+
+// ==== Serial goes to stdout ======================================================
+size_t HardwareSerial::write(uint8_t c) {
+  return fwrite(&c, 1, 1, stdout);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+  size_t n = fwrite(buffer, 1, size, stdout);
+  fflush(stdout);
+  return n;
+}
+
+// ==== Print =====================================================================
+size_t Print::write(const uint8_t* buffer, size_t size) {
+  size_t n = 0;
+  while ( size-- ) n += write(*buffer++);
+  return n;
+}
+
+size_t Print::printf(const char* format, ...) {
+  char loc[128];
+  char* buf = loc;
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(loc, sizeof(loc), format, args);
+  va_end(args);
+  if ( len < 0 ) return 0;
+  if ( len >= (int) sizeof(loc) ) {
+    buf = (char*) malloc(len + 1);
+    if ( buf == NULL ) return 0;
+    va_start(args, format);
+    vsnprintf(buf, len + 1, format, args);
+    va_end(args);
+  }
+  size_t n = write((const uint8_t*) buf, len);
+  if ( buf != loc ) free(buf);
+  return n;
+}
+
+// ==== IPAddress =================================================================
+String IPAddress::toString() const {
+  char s[16];
+  snprintf(s, sizeof(s), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+  return String(s);
+}
+
+// ==== String ====================================================================
+static std::string fmtNum(long long v, bool neg, unsigned char base) {
+  if ( base == 10 ) return std::to_string(v);
+  std::string s;
+  unsigned long long u = neg ? (unsigned long long) -v : (unsigned long long) v;
+  do { s.insert(s.begin(), "0123456789abcdefghijklmnopqrstuvwxyz"[u % base]); u /= base; } while ( u );
+  if ( neg ) s.insert(s.begin(), '-');
+  return s;
+}
+
+String::String(int v, unsigned char base) : _s(fmtNum(v, v < 0, base)) {}
+String::String(unsigned int v, unsigned char base) : _s(fmtNum(v, false, base)) {}
+String::String(long v, unsigned char base) : _s(fmtNum(v, v < 0, base)) {}
+String::String(unsigned long v, unsigned char base) : _s(fmtNum((long long) v, false, base)) {}
+
+String::String(double v, unsigned int decimals) {
+  char s[48];
+  snprintf(s, sizeof(s), "%.*f", (int) decimals, v);
+  _s = s;
+}
+
+String::String(float v, unsigned int decimals) : String((double) v, decimals) {}
+
+bool String::equalsIgnoreCase(const String& s) const {
+  if ( _s.size() != s._s.size() ) return false;
+  for (size_t i = 0; i < _s.size(); i++) {
+    if ( tolower((unsigned char) _s[i]) != tolower((unsigned char) s._s[i]) ) return false;
+  }
+  return true;
+}
+
+bool String::endsWith(const String& s) const {
+  return _s.size() >= s._s.size() && _s.compare(_s.size() - s._s.size(), s._s.size(), s._s) == 0;
+}
+
+int String::indexOf(char c, unsigned int from) const {
+  size_t p = _s.find(c, from);
+  return p == std::string::npos ? -1 : (int) p;
+}
+
+int String::indexOf(const String& s, unsigned int from) const {
+  size_t p = _s.find(s._s, from);
+  return p == std::string::npos ? -1 : (int) p;
+}
+
+int String::lastIndexOf(char c) const {
+  size_t p = _s.rfind(c);
+  return p == std::string::npos ? -1 : (int) p;
+}
+
+String String::substring(unsigned int from) const {
+  return from >= _s.size() ? String() : String(_s.substr(from));
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+  if ( from > to ) std::swap(from, to);
+  if ( from >= _s.size() ) return String();
+  return String(_s.substr(from, to - from));
+}
+
+void String::replace(const String& find, const String& replace) {
+  if ( find._s.empty() ) return;
+  size_t p = 0;
+  while ( (p = _s.find(find._s, p)) != std::string::npos ) {
+    _s.replace(p, find._s.size(), replace._s);
+    p += replace._s.size();
+  }
+}
+
+void String::trim() {
+  size_t b = _s.find_first_not_of(" \t\r\n");
+  size_t e = _s.find_last_not_of(" \t\r\n");
+  _s = b == std::string::npos ? std::string() : _s.substr(b, e - b + 1);
+}
+
+void String::toLowerCase() {
+  for (size_t i = 0; i < _s.size(); i++) _s[i] = tolower((unsigned char) _s[i]);
+}
+
+long String::toInt() const { return strtol(_s.c_str(), NULL, 10); }
+float String::toFloat() const { return strtof(_s.c_str(), NULL); }
+
+// ==== ESP =======================================================================
+#define HOST_HEAP_SIZE   (320 * 1024)
+#define HOST_HEAP_FREE   (180 * 1024)
+#define HOST_PSRAM_SIZE  (4 * 1024 * 1024)
+
+static uint32_t psramUsed() {
+  struct mallinfo2 mi = mallinfo2();
+  return mi.uordblks > HOST_PSRAM_SIZE ? HOST_PSRAM_SIZE : (uint32_t) mi.uordblks;
+}
+
+uint32_t EspClass::getHeapSize()      { return HOST_HEAP_SIZE; }
+uint32_t EspClass::getFreeHeap()      { return HOST_HEAP_FREE; }
+uint32_t EspClass::getMinFreeHeap()   { return HOST_HEAP_FREE; }
+uint32_t EspClass::getMaxAllocHeap()  { return HOST_HEAP_FREE / 2; }
+uint32_t EspClass::getPsramSize()     { return HOST_PSRAM_SIZE; }
+uint32_t EspClass::getFreePsram()     { return HOST_PSRAM_SIZE - psramUsed(); }
+uint32_t EspClass::getMinFreePsram()  { return getFreePsram(); }
+uint32_t EspClass::getMaxAllocPsram() { return getFreePsram(); }
+
+void EspClass::restart() {
+  fprintf(stderr, "ESP.restart() called\n");
+  fflush(stdout);
+  _exit(3);
+}
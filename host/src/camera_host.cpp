@@ -0,0 +1,217 @@
+//  === Host shim: fake camera replaying a directory of JPEG files ==================================
+
+#include "Arduino.h"
+#include "esp_camera.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <dirent.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+const char*        hostCameraDir = NULL;
+float              hostCameraFps = 25.0;
+volatile uint32_t  hostCameraOutstanding = 0;
+volatile uint32_t  hostCameraStarved = 0;
+
+static std::vector<std::string>   frames;
+static std::vector<camera_fb_t>   pool;
+static std::vector<bool>          inUse;
+static std::mutex                 poolMtx;
+static std::condition_variable    poolCv;
+static size_t                     nextFrame = 0;
+static int64_t                    nextDue = 0;
+static sensor_t                   sensor;
+
+static void loadFrames() {
+  if ( hostCameraDir ) {
+    std::vector<std::string> names;
+    DIR* d = opendir(hostCameraDir);
+    if ( d ) {
+      struct dirent* e;
+      while ( (e = readdir(d)) != NULL ) {
+        std::string n = e->d_name;
+        if ( n.size() > 4 && (n.compare(n.size() - 4, 4, ".jpg") == 0 || n.compare(n.size() - 4, 4, ".JPG") == 0) ) {
+          names.push_back(std::string(hostCameraDir) + "/" + n);
+        }
+      }
+      closedir(d);
+    }
+    std::sort(names.begin(), names.end());
+    for (size_t i = 0; i < names.size(); i++) {
+      FILE* f = fopen(names[i].c_str(), "rb");
+      if ( f == NULL ) continue;
+      std::string data;
+      char buf[4096];
+      size_t n;
+      while ( (n = fread(buf, 1, sizeof(buf), f)) > 0 ) data.append(buf, n);
+      fclose(f);
+      if ( data.size() > 4 ) frames.push_back(data);
+    }
+    printf("camera: %u frames loaded from %s\n", (unsigned) frames.size(), hostCameraDir);
+  }
+
+  if ( frames.empty() ) {
+    // Placeholder: SOI, a comment segment padded to a typical HD frame size, EOI
+    std::string data("\xff\xd8\xff\xfe", 4);
+    const size_t payload = 48 * 1024;
+    data += (char) ((payload + 2) >> 8);
+    data += (char) ((payload + 2) & 0xff);
+    for (size_t i = 0; i < payload; i++) data += (char) ('a' + i % 26);
+    data += std::string("\xff\xd9", 2);
+    frames.push_back(data);
+  }
+}
+
+#define SENSOR_SETTER(fn, field) \
+  static int fn(sensor_t* s, int v) { s->status.field = v; return 0; }
+
+SENSOR_SETTER(setContrast, contrast)
+SENSOR_SETTER(setBrightness, brightness)
+SENSOR_SETTER(setSaturation, saturation)
+SENSOR_SETTER(setQuality, quality)
+SENSOR_SETTER(setColorbar, colorbar)
+SENSOR_SETTER(setWhitebal, awb)
+SENSOR_SETTER(setGainCtrl, agc)
+SENSOR_SETTER(setExposureCtrl, aec)
+SENSOR_SETTER(setHmirror, hmirror)
+SENSOR_SETTER(setVflip, vflip)
+SENSOR_SETTER(setAec2, aec2)
+SENSOR_SETTER(setAwbGain, awb_gain)
+SENSOR_SETTER(setAgcGain, agc_gain)
+SENSOR_SETTER(setAecValue, aec_value)
+SENSOR_SETTER(setSpecialEffect, special_effect)
+SENSOR_SETTER(setWbMode, wb_mode)
+SENSOR_SETTER(setAeLevel, ae_level)
+SENSOR_SETTER(setDcw, dcw)
+SENSOR_SETTER(setBpc, bpc)
+SENSOR_SETTER(setWpc, wpc)
+SENSOR_SETTER(setRawGma, raw_gma)
+SENSOR_SETTER(setLenc, lenc)
+
+const resolution_info_t resolution[FRAMESIZE_INVALID] = {
+  {   96,   96, ASPECT_RATIO_1X1   }, /* 96x96 */
+  {  160,  120, ASPECT_RATIO_4X3   }, /* QQVGA */
+  {  176,  144, ASPECT_RATIO_5X4   }, /* QCIF  */
+  {  240,  176, ASPECT_RATIO_3X2   }, /* HQVGA */
+  {  240,  240, ASPECT_RATIO_1X1   }, /* 240x240 */
+  {  320,  240, ASPECT_RATIO_4X3   }, /* QVGA  */
+  {  400,  296, ASPECT_RATIO_4X3   }, /* CIF   */
+  {  480,  320, ASPECT_RATIO_3X2   }, /* HVGA  */
+  {  640,  480, ASPECT_RATIO_4X3   }, /* VGA   */
+  {  800,  600, ASPECT_RATIO_4X3   }, /* SVGA  */
+  { 1024,  768, ASPECT_RATIO_4X3   }, /* XGA   */
+  { 1280,  720, ASPECT_RATIO_16X9  }, /* HD    */
+  { 1280, 1024, ASPECT_RATIO_5X4   }, /* SXGA  */
+  { 1600, 1200, ASPECT_RATIO_4X3   }, /* UXGA  */
+  { 1920, 1080, ASPECT_RATIO_16X9  }, /* FHD   */
+  {  720, 1280, ASPECT_RATIO_9X16  }, /* Portrait HD   */
+  {  864, 1536, ASPECT_RATIO_9X16  }, /* Portrait 3MP  */
+  { 2048, 1536, ASPECT_RATIO_4X3   }, /* QXGA  */
+  { 2560, 1440, ASPECT_RATIO_16X9  }, /* QHD    */
+  { 2560, 1600, ASPECT_RATIO_16X10 }, /* WQXGA  */
+  { 1080, 1920, ASPECT_RATIO_9X16  }, /* Portrait FHD   */
+  { 2560, 1920, ASPECT_RATIO_4X3   }, /* QSXGA  */
+};
+
+static int setFramesize(sensor_t* s, framesize_t v) { s->status.framesize = v; return 0; }
+static int setGainceiling(sensor_t* s, gainceiling_t v) { s->status.gainceiling = v; return 0; }
+
+esp_err_t esp_camera_init(const camera_config_t* config) {
+  loadFrames();
+
+  size_t cap = 0;
+  for (size_t i = 0; i < frames.size(); i++) cap = std::max(cap, frames[i].size());
+  size_t count = config->fb_count ? config->fb_count : 1;
+  pool.resize(count);
+  inUse.assign(count, false);
+  for (size_t i = 0; i < count; i++) {
+    memset(&pool[i], 0, sizeof(camera_fb_t));
+    pool[i].buf = (uint8_t*) ps_malloc(cap);
+    pool[i].format = config->pixel_format;
+    pool[i].width = 1280;
+    pool[i].height = 720;
+  }
+
+  memset(&sensor, 0, sizeof(sensor));
+  sensor.status.framesize = config->frame_size;
+  sensor.status.quality = config->jpeg_quality;
+  sensor.set_framesize = setFramesize;
+  sensor.set_contrast = setContrast;
+  sensor.set_brightness = setBrightness;
+  sensor.set_saturation = setSaturation;
+  sensor.set_gainceiling = setGainceiling;
+  sensor.set_quality = setQuality;
+  sensor.set_colorbar = setColorbar;
+  sensor.set_whitebal = setWhitebal;
+  sensor.set_gain_ctrl = setGainCtrl;
+  sensor.set_exposure_ctrl = setExposureCtrl;
+  sensor.set_hmirror = setHmirror;
+  sensor.set_vflip = setVflip;
+  sensor.set_aec2 = setAec2;
+  sensor.set_awb_gain = setAwbGain;
+  sensor.set_agc_gain = setAgcGain;
+  sensor.set_aec_value = setAecValue;
+  sensor.set_special_effect = setSpecialEffect;
+  sensor.set_wb_mode = setWbMode;
+  sensor.set_ae_level = setAeLevel;
+  sensor.set_dcw = setDcw;
+  sensor.set_bpc = setBpc;
+  sensor.set_wpc = setWpc;
+  sensor.set_raw_gma = setRawGma;
+  sensor.set_lenc = setLenc;
+  return ESP_OK;
+}
+
+esp_err_t esp_camera_deinit(void) {
+  return ESP_OK;
+}
+
+// Wait for the next sensor frame, then for a free buffer to "DMA" it into
+camera_fb_t* esp_camera_fb_get(void) {
+  int64_t now = esp_timer_get_time();
+  int64_t period = (int64_t) (1000000.0 / (hostCameraFps > 0 ? hostCameraFps : 1));
+  if ( nextDue == 0 || now - nextDue > period ) nextDue = now;
+  if ( nextDue > now ) {
+    vTaskDelay(pdMS_TO_TICKS((nextDue - now + 999) / 1000));
+  }
+  nextDue += period;
+
+  std::unique_lock<std::mutex> lk(poolMtx);
+  size_t i;
+  for (;;) {
+    for (i = 0; i < pool.size() && inUse[i]; i++) {}
+    if ( i < pool.size() ) break;
+    hostCameraStarved++;
+    if ( poolCv.wait_for(lk, std::chrono::seconds(1)) == std::cv_status::timeout ) return NULL;
+  }
+  inUse[i] = true;
+  hostCameraOutstanding++;
+  lk.unlock();
+
+  const std::string& data = frames[nextFrame++ % frames.size()];
+  camera_fb_t* fb = &pool[i];
+  memcpy(fb->buf, data.data(), data.size());
+  fb->len = data.size();
+  int64_t t = esp_timer_get_time();
+  fb->timestamp.tv_sec = t / 1000000;
+  fb->timestamp.tv_usec = t % 1000000;
+  return fb;
+}
+
+void esp_camera_fb_return(camera_fb_t* fb) {
+  std::lock_guard<std::mutex> lk(poolMtx);
+  for (size_t i = 0; i < pool.size(); i++) {
+    if ( &pool[i] == fb && inUse[i] ) {
+      inUse[i] = false;
+      hostCameraOutstanding--;
+      poolCv.notify_all();
+      return;
+    }
+  }
+}
+
+sensor_t* esp_camera_sensor_get(void) {
+  return &sensor;
+}
@@ -0,0 +1,476 @@
+//  === Host shim: FreeRTOS tasks, notifications, queues and event groups over pthreads ============
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <sched.h>
+#include <time.h>
+
+struct hostTask {
+  std::string             name;
+  TaskFunction_t          fn;
+  void*                   param;
+  UBaseType_t             priority;
+  uint32_t                stack;
+  BaseType_t              core;
+  pthread_t               thread;
+  volatile eTaskState     state;
+  bool                    suspended;
+  uint32_t                notifyValue;
+  bool                    notifyPending;
+  std::mutex              mtx;
+  std::condition_variable cv;
+};
+
+static std::mutex                 registryMtx;
+static std::vector<hostTask*>     registry;
+static thread_local hostTask*     currentTask = NULL;
+static const auto                 bootTime = std::chrono::steady_clock::now();
+
+static std::chrono::steady_clock::time_point deadline(TickType_t ticks) {
+  return std::chrono::steady_clock::now() + std::chrono::milliseconds(ticks);
+}
+
+TickType_t xTaskGetTickCount(void) {
+  return (TickType_t) std::chrono::duration_cast<std::chrono::milliseconds>(
+           std::chrono::steady_clock::now() - bootTime).count();
+}
+
+BaseType_t xPortGetCoreID(void) {
+  hostTask* t = xTaskGetCurrentTaskHandle();
+  return t->core == tskNO_AFFINITY ? 0 : t->core;
+}
+
+// Tasks started outside xTaskCreate (main thread) get a handle on first use
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+  if ( currentTask == NULL ) {
+    hostTask* t = new hostTask();
+    t->name = "loopTask";
+    t->fn = NULL;
+    t->param = NULL;
+    t->priority = 1;
+    t->stack = 8192;
+    t->core = 1;
+    t->thread = pthread_self();
+    t->state = eRunning;
+    t->suspended = false;
+    t->notifyValue = 0;
+    t->notifyPending = false;
+    std::lock_guard<std::mutex> lk(registryMtx);
+    registry.push_back(t);
+    currentTask = t;
+  }
+  return currentTask;
+}
+
+// Block here while another task has suspended us
+static void checkSuspended(hostTask* t) {
+  std::unique_lock<std::mutex> lk(t->mtx);
+  while ( t->suspended ) t->cv.wait(lk);
+  t->state = eRunning;
+}
+
+static void* taskTrampoline(void* arg) {
+  hostTask* t = (hostTask*) arg;
+  currentTask = t;
+  t->state = eRunning;
+  t->fn(t->param);
+  // FreeRTOS tasks must not return; treat it as vTaskDelete(NULL)
+  vTaskDelete(NULL);
+  return NULL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode, const char* pcName, uint32_t usStackDepth,
+                                   void* pvParameters, UBaseType_t uxPriority, TaskHandle_t* pvCreatedTask,
+                                   BaseType_t xCoreID) {
+  hostTask* t = new hostTask();
+  t->name = pcName ? pcName : "";
+  t->fn = pvTaskCode;
+  t->param = pvParameters;
+  t->priority = uxPriority;
+  t->stack = usStackDepth;
+  t->core = xCoreID;
+  t->state = eReady;
+  t->suspended = false;
+  t->notifyValue = 0;
+  t->notifyPending = false;
+  {
+    std::lock_guard<std::mutex> lk(registryMtx);
+    registry.push_back(t);
+  }
+  if ( pvCreatedTask ) *pvCreatedTask = t;
+
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  // Host frames are much larger than xtensa ones; give every task a comfortable stack
+  pthread_attr_setstacksize(&attr, 256 * 1024);
+  int rc = pthread_create(&t->thread, &attr, taskTrampoline, t);
+  pthread_attr_destroy(&attr);
+  if ( rc != 0 ) {
+    std::lock_guard<std::mutex> lk(registryMtx);
+    registry.pop_back();
+    if ( pvCreatedTask ) *pvCreatedTask = NULL;
+    delete t;
+    return pdFAIL;
+  }
+  return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t pvTaskCode, const char* pcName, uint32_t usStackDepth,
+                       void* pvParameters, UBaseType_t uxPriority, TaskHandle_t* pvCreatedTask) {
+  return xTaskCreatePinnedToCore(pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority,
+                                 pvCreatedTask, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t xTask) {
+  hostTask* t = xTask ? xTask : xTaskGetCurrentTaskHandle();
+  {
+    std::lock_guard<std::mutex> lk(registryMtx);
+    for (size_t i = 0; i < registry.size(); i++) {
+      if ( registry[i] == t ) { registry.erase(registry.begin() + i); break; }
+    }
+  }
+  t->state = eDeleted;
+  // Deleting another task is not supported on the host: it keeps running unregistered
+  if ( t == currentTask ) pthread_exit(NULL);
+}
+
+void vTaskDelay(TickType_t xTicksToDelay) {
+  hostTask* t = xTaskGetCurrentTaskHandle();
+  t->state = eBlocked;
+  if ( xTicksToDelay == 0 ) sched_yield();
+  else {
+    struct timespec ts = { (time_t) (xTicksToDelay / 1000), (long) (xTicksToDelay % 1000) * 1000000L };
+    while ( nanosleep(&ts, &ts) != 0 ) {}
+  }
+  checkSuspended(t);
+}
+
+BaseType_t xTaskDelayUntil(TickType_t* pxPreviousWakeTime, TickType_t xTimeIncrement) {
+  TickType_t wake = *pxPreviousWakeTime + xTimeIncrement;
+  TickType_t now = xTaskGetTickCount();
+  *pxPreviousWakeTime = wake;
+  if ( (int32_t) (wake - now) > 0 ) {
+    vTaskDelay(wake - now);
+    return pdTRUE;
+  }
+  checkSuspended(xTaskGetCurrentTaskHandle());
+  return pdFALSE;
+}
+
+void vTaskDelayUntil(TickType_t* pxPreviousWakeTime, TickType_t xTimeIncrement) {
+  xTaskDelayUntil(pxPreviousWakeTime, xTimeIncrement);
+}
+
+void taskYIELD(void) {
+  sched_yield();
+  checkSuspended(xTaskGetCurrentTaskHandle());
+}
+
+// Suspending another task takes effect the next time it calls into the kernel
+void vTaskSuspend(TaskHandle_t xTask) {
+  hostTask* t = xTask ? xTask : xTaskGetCurrentTaskHandle();
+  {
+    std::lock_guard<std::mutex> lk(t->mtx);
+    t->suspended = true;
+    t->state = eSuspended;
+  }
+  if ( t == currentTask ) checkSuspended(t);
+}
+
+void vTaskResume(TaskHandle_t xTask) {
+  if ( xTask == NULL ) return;
+  std::lock_guard<std::mutex> lk(xTask->mtx);
+  if ( xTask->suspended ) {
+    xTask->suspended = false;
+    xTask->state = eReady;
+    xTask->cv.notify_all();
+  }
+}
+
+eTaskState eTaskGetState(TaskHandle_t xTask) {
+  if ( xTask == NULL ) return eInvalid;
+  return xTask->state;
+}
+
+void vTaskPrioritySet(TaskHandle_t xTask, UBaseType_t uxNewPriority) {
+  hostTask* t = xTask ? xTask : xTaskGetCurrentTaskHandle();
+  t->priority = uxNewPriority;
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t xTask) {
+  hostTask* t = xTask ? xTask : xTaskGetCurrentTaskHandle();
+  return t->priority;
+}
+
+// No way to measure real stack use on the host; report half of the requested depth as free
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask) {
+  hostTask* t = xTask ? xTask : xTaskGetCurrentTaskHandle();
+  return t->stack / 2;
+}
+
+char* pcTaskGetName(TaskHandle_t xTask) {
+  hostTask* t = xTask ? xTask : xTaskGetCurrentTaskHandle();
+  return (char*) t->name.c_str();
+}
+
+BaseType_t xTaskGetAffinity(TaskHandle_t xTask) {
+  hostTask* t = xTask ? xTask : xTaskGetCurrentTaskHandle();
+  return t->core;
+}
+
+// ==== Runtime stats ==============================================================
+UBaseType_t uxTaskGetNumberOfTasks(void) {
+  std::lock_guard<std::mutex> lk(registryMtx);
+  return registry.size();
+}
+
+// Like FreeRTOS, fills nothing and returns 0 if the array cannot hold every task
+UBaseType_t uxTaskGetSystemState(TaskStatus_t* pxTaskStatusArray, UBaseType_t uxArraySize, uint32_t* pulTotalRunTime) {
+  std::lock_guard<std::mutex> lk(registryMtx);
+  if ( registry.size() > uxArraySize ) return 0;
+  UBaseType_t n = 0;
+  for (size_t i = 0; i < registry.size(); i++) {
+    hostTask* t = registry[i];
+    TaskStatus_t* s = &pxTaskStatusArray[n++];
+    struct timespec ts = { 0, 0 };
+    clockid_t clock;
+    //  A task being created has no thread yet
+    if ( t->thread && pthread_getcpuclockid(t->thread, &clock) == 0 ) clock_gettime(clock, &ts);
+    s->xHandle = t;
+    s->pcTaskName = t->name.c_str();
+    s->xTaskNumber = i + 1;
+    s->eCurrentState = t->state;
+    s->uxCurrentPriority = t->priority;
+    s->uxBasePriority = t->priority;
+    s->ulRunTimeCounter = (uint32_t) ((uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+    s->pxStackBase = NULL;
+    s->usStackHighWaterMark = t->stack / 2;
+  }
+  if ( pulTotalRunTime ) {
+    *pulTotalRunTime = (uint32_t) std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::steady_clock::now() - bootTime).count();
+  }
+  return n;
+}
+
+// ==== Direct to task notifications ==============================================
+BaseType_t xTaskGenericNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+                              uint32_t* pulPreviousNotificationValue) {
+  hostTask* t = xTaskToNotify;
+  if ( t == NULL ) return pdFAIL;
+  std::lock_guard<std::mutex> lk(t->mtx);
+  if ( pulPreviousNotificationValue ) *pulPreviousNotificationValue = t->notifyValue;
+  switch ( eAction ) {
+    case eSetBits:                  t->notifyValue |= ulValue; break;
+    case eIncrement:                t->notifyValue++; break;
+    case eSetValueWithOverwrite:    t->notifyValue = ulValue; break;
+    case eSetValueWithoutOverwrite:
+      if ( t->notifyPending ) return pdFAIL;
+      t->notifyValue = ulValue;
+      break;
+    case eNoAction:                 break;
+  }
+  t->notifyPending = true;
+  t->cv.notify_all();
+  return pdPASS;
+}
+
+BaseType_t xTaskNotifyWait(uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit,
+                           uint32_t* pulNotificationValue, TickType_t xTicksToWait) {
+  hostTask* t = xTaskGetCurrentTaskHandle();
+  std::unique_lock<std::mutex> lk(t->mtx);
+  if ( !t->notifyPending ) {
+    t->notifyValue &= ~ulBitsToClearOnEntry;
+    t->state = eBlocked;
+    if ( xTicksToWait == portMAX_DELAY ) {
+      while ( !t->notifyPending ) t->cv.wait(lk);
+    }
+    else {
+      auto until = deadline(xTicksToWait);
+      while ( !t->notifyPending ) {
+        if ( t->cv.wait_until(lk, until) == std::cv_status::timeout ) break;
+      }
+    }
+    t->state = eRunning;
+  }
+  if ( pulNotificationValue ) *pulNotificationValue = t->notifyValue;
+  if ( !t->notifyPending ) return pdFALSE;
+  t->notifyPending = false;
+  t->notifyValue &= ~ulBitsToClearOnExit;
+  return pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait) {
+  hostTask* t = xTaskGetCurrentTaskHandle();
+  std::unique_lock<std::mutex> lk(t->mtx);
+  if ( t->notifyValue == 0 ) {
+    t->state = eBlocked;
+    if ( xTicksToWait == portMAX_DELAY ) {
+      while ( t->notifyValue == 0 ) t->cv.wait(lk);
+    }
+    else {
+      auto until = deadline(xTicksToWait);
+      while ( t->notifyValue == 0 ) {
+        if ( t->cv.wait_until(lk, until) == std::cv_status::timeout ) break;
+      }
+    }
+    t->state = eRunning;
+  }
+  uint32_t v = t->notifyValue;
+  if ( v ) {
+    t->notifyValue = xClearCountOnExit ? 0 : v - 1;
+  }
+  t->notifyPending = false;
+  return v;
+}
+
+// ==== Queues and semaphores =====================================================
+struct hostQueue {
+  size_t                  length;
+  size_t                  itemSize;
+  bool                    isMutex;
+  std::deque<std::vector<uint8_t> > items;
+  std::mutex              mtx;
+  std::condition_variable cv;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize) {
+  hostQueue* q = new hostQueue();
+  q->length = uxQueueLength;
+  q->itemSize = uxItemSize;
+  q->isMutex = false;
+  return q;
+}
+
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void* pvItemToQueue, TickType_t xTicksToWait) {
+  std::unique_lock<std::mutex> lk(xQueue->mtx);
+  if ( xQueue->items.size() >= xQueue->length ) {
+    if ( xTicksToWait == 0 ) return pdFAIL;
+    auto until = deadline(xTicksToWait);
+    while ( xQueue->items.size() >= xQueue->length ) {
+      if ( xTicksToWait == portMAX_DELAY ) xQueue->cv.wait(lk);
+      else if ( xQueue->cv.wait_until(lk, until) == std::cv_status::timeout ) return pdFAIL;
+    }
+  }
+  const uint8_t* p = (const uint8_t*) pvItemToQueue;
+  xQueue->items.push_back(std::vector<uint8_t>(p, p + xQueue->itemSize));
+  xQueue->cv.notify_all();
+  return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void* pvBuffer, TickType_t xTicksToWait) {
+  std::unique_lock<std::mutex> lk(xQueue->mtx);
+  if ( xQueue->items.empty() ) {
+    if ( xTicksToWait == 0 ) return pdFAIL;
+    auto until = deadline(xTicksToWait);
+    while ( xQueue->items.empty() ) {
+      if ( xTicksToWait == portMAX_DELAY ) xQueue->cv.wait(lk);
+      else if ( xQueue->cv.wait_until(lk, until) == std::cv_status::timeout ) return pdFAIL;
+    }
+  }
+  if ( pvBuffer && xQueue->itemSize ) memcpy(pvBuffer, xQueue->items.front().data(), xQueue->itemSize);
+  xQueue->items.pop_front();
+  xQueue->cv.notify_all();
+  return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue) {
+  std::lock_guard<std::mutex> lk(xQueue->mtx);
+  return xQueue->items.size();
+}
+
+void vQueueDelete(QueueHandle_t xQueue) {
+  delete xQueue;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+  return xQueueCreate(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount) {
+  hostQueue* q = xQueueCreate(uxMaxCount, 0);
+  for (UBaseType_t i = 0; i < uxInitialCount; i++) q->items.push_back(std::vector<uint8_t>());
+  return q;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+  hostQueue* q = xQueueCreate(1, 0);
+  q->isMutex = true;
+  q->items.push_back(std::vector<uint8_t>());
+  return q;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime) {
+  return xQueueReceive(xSemaphore, NULL, xBlockTime);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore) {
+  return xQueueSend(xSemaphore, NULL, 0);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t xSemaphore) {
+  vQueueDelete(xSemaphore);
+}
+
+// ==== Event groups ==============================================================
+struct hostEventGroup {
+  EventBits_t             bits;
+  std::mutex              mtx;
+  std::condition_variable cv;
+};
+
+EventGroupHandle_t xEventGroupCreate(void) {
+  hostEventGroup* g = new hostEventGroup();
+  g->bits = 0;
+  return g;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToSet) {
+  std::lock_guard<std::mutex> lk(xEventGroup->mtx);
+  xEventGroup->bits |= uxBitsToSet;
+  xEventGroup->cv.notify_all();
+  return xEventGroup->bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToClear) {
+  std::lock_guard<std::mutex> lk(xEventGroup->mtx);
+  EventBits_t b = xEventGroup->bits;
+  xEventGroup->bits &= ~uxBitsToClear;
+  return b;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t xEventGroup) {
+  std::lock_guard<std::mutex> lk(xEventGroup->mtx);
+  return xEventGroup->bits;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToWaitFor,
+                                BaseType_t xClearOnExit, BaseType_t xWaitForAllBits,
+                                TickType_t xTicksToWait) {
+  std::unique_lock<std::mutex> lk(xEventGroup->mtx);
+  auto until = deadline(xTicksToWait);
+  for (;;) {
+    EventBits_t b = xEventGroup->bits & uxBitsToWaitFor;
+    bool ok = xWaitForAllBits ? (b == uxBitsToWaitFor) : (b != 0);
+    if ( ok ) {
+      EventBits_t r = xEventGroup->bits;
+      if ( xClearOnExit ) xEventGroup->bits &= ~uxBitsToWaitFor;
+      return r;
+    }
+    if ( xTicksToWait == 0 ) return xEventGroup->bits;
+    if ( xTicksToWait == portMAX_DELAY ) xEventGroup->cv.wait(lk);
+    else if ( xEventGroup->cv.wait_until(lk, until) == std::cv_status::timeout ) return xEventGroup->bits;
+  }
+}
@@ -0,0 +1,54 @@
+//  === Host shim: SPIFFS mapped onto a directory (data/ by default) ================================
+
+#include "FS.h"
+#include "SPIFFS.h"
+
+#include <sys/stat.h>
+
+SPIFFSFS SPIFFS;
+
+File::File(FILE* f, const String& name) : _f(f, fclose), _name(name) {
+  struct stat st;
+  _size = fstat(fileno(f), &st) == 0 ? (size_t) st.st_size : 0;
+}
+
+int File::available() {
+  if ( !_f ) return 0;
+  long pos = ftell(_f.get());
+  return pos < 0 ? 0 : (int) (_size - pos);
+}
+
+int File::read() {
+  if ( !_f ) return -1;
+  return fgetc(_f.get());
+}
+
+int File::read(uint8_t* buf, size_t size) {
+  if ( !_f ) return -1;
+  return (int) fread(buf, 1, size, _f.get());
+}
+
+size_t File::write(const uint8_t* buf, size_t size) {
+  if ( !_f ) return 0;
+  size_t n = fwrite(buf, 1, size, _f.get());
+  _size += n;
+  return n;
+}
+
+void File::close() {
+  _f.reset();
+}
+
+File fs::FS::open(const char* path, const char* mode) {
+  String full = _root + path;
+  struct stat st;
+  if ( mode[0] == 'r' && (stat(full.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) ) return File();
+  FILE* f = fopen(full.c_str(), mode[0] == 'w' ? "wb" : mode[0] == 'a' ? "ab" : "rb");
+  if ( f == NULL ) return File();
+  return File(f, String(path));
+}
+
+bool fs::FS::exists(const char* path) {
+  struct stat st;
+  return stat((_root + path).c_str(), &st) == 0;
+}
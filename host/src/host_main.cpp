@@ -0,0 +1,40 @@
+//  === Host entry point: runs the firmware's setup()/loop() on Linux ================================
+//
+//  Usage: esp32mjpeg-host [--port N] [--jpeg-dir DIR] [--fps F] [--data-dir DIR] [--nvs-dir DIR]
+
+#include "Arduino.h"
+#include "esp_camera.h"
+#include "SPIFFS.h"
+
+#include <signal.h>
+
+extern int          hostHttpPort;
+extern const char*  hostNvsDir;
+
+void setup();
+void loop();
+
+static void usage(const char* name) {
+  fprintf(stderr, "usage: %s [--port N] [--jpeg-dir DIR] [--fps F] [--data-dir DIR] [--nvs-dir DIR]\n", name);
+  exit(1);
+}
+
+int main(int argc, char** argv) {
+  for (int i = 1; i < argc; i++) {
+    if ( i + 1 >= argc ) usage(argv[0]);
+    if ( !strcmp(argv[i], "--port") ) hostHttpPort = atoi(argv[++i]);
+    else if ( !strcmp(argv[i], "--jpeg-dir") ) hostCameraDir = argv[++i];
+    else if ( !strcmp(argv[i], "--fps") ) hostCameraFps = atof(argv[++i]);
+    else if ( !strcmp(argv[i], "--data-dir") ) SPIFFS.setRoot(argv[++i]);
+    else if ( !strcmp(argv[i], "--nvs-dir") ) hostNvsDir = argv[++i];
+    else usage(argv[0]);
+  }
+  signal(SIGPIPE, SIG_IGN);
+  setvbuf(stdout, NULL, _IOLBF, 0);
+
+  // The main thread plays the Arduino loopTask
+  xTaskGetCurrentTaskHandle();
+  setup();
+  for (;;) loop();
+  return 0;
+}
@@ -0,0 +1,148 @@
+//  === Host shim: file-backed NVS ====================================================================
+//  Each namespace is a text file "<key> <type> <hex payload>" under hostNvsDir. Every put commits
+//  the file, which is when the device would write flash.
+
+#include "Preferences.h"
+
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+
+const char* hostNvsDir = ".pio/host/nvs";
+uint32_t    hostNvsCommits = 0;
+
+static std::string toHex(const void* data, size_t len) {
+  static const char* digits = "0123456789abcdef";
+  std::string s;
+  const uint8_t* p = (const uint8_t*) data;
+  for (size_t i = 0; i < len; i++) {
+    s += digits[p[i] >> 4];
+    s += digits[p[i] & 0x0f];
+  }
+  return s;
+}
+
+static std::string fromHex(const std::string& s) {
+  std::string r;
+  for (size_t i = 0; i + 1 < s.size(); i += 2) r += (char) strtol(s.substr(i, 2).c_str(), NULL, 16);
+  return r;
+}
+
+static void makeDirs(const std::string& path) {
+  for (size_t p = path.find('/', 1); p != std::string::npos; p = path.find('/', p + 1)) {
+    mkdir(path.substr(0, p).c_str(), 0755);
+  }
+  mkdir(path.c_str(), 0755);
+}
+
+bool Preferences::begin(const char* name, bool readOnly, const char* partition_label) {
+  (void) partition_label;
+  if ( _open ) end();
+  makeDirs(hostNvsDir);
+  _path = std::string(hostNvsDir) + "/" + name;
+  _readOnly = readOnly;
+  _values.clear();
+
+  std::ifstream in(_path.c_str());
+  std::string line;
+  while ( std::getline(in, line) ) {
+    std::istringstream ls(line);
+    std::string key, type, hex;
+    if ( ls >> key >> type ) {
+      ls >> hex;
+      _values[key] = type + fromHex(hex);
+    }
+  }
+  _open = true;
+  return true;
+}
+
+void Preferences::end() {
+  _open = false;
+  _values.clear();
+}
+
+bool Preferences::commit() {
+  if ( !_open || _readOnly ) return false;
+  std::ofstream out(_path.c_str(), std::ios::trunc);
+  for (std::map<std::string, std::string>::iterator it = _values.begin(); it != _values.end(); ++it) {
+    out << it->first << " " << it->second[0] << " " << toHex(it->second.data() + 1, it->second.size() - 1) << "\n";
+  }
+  hostNvsCommits++;
+  return (bool) out;
+}
+
+bool Preferences::clear() {
+  if ( !_open || _readOnly ) return false;
+  _values.clear();
+  return commit();
+}
+
+bool Preferences::remove(const char* key) {
+  if ( !_open || _readOnly ) return false;
+  _values.erase(key);
+  return commit();
+}
+
+bool Preferences::isKey(const char* key) {
+  return _values.count(key) != 0;
+}
+
+size_t Preferences::putInt(const char* key, int32_t value) {
+  if ( !_open || _readOnly ) return 0;
+  _values[key] = std::string("i") + std::string((const char*) &value, sizeof(value));
+  return commit() ? sizeof(value) : 0;
+}
+
+size_t Preferences::putUInt(const char* key, uint32_t value) {
+  if ( !_open || _readOnly ) return 0;
+  _values[key] = std::string("u") + std::string((const char*) &value, sizeof(value));
+  return commit() ? sizeof(value) : 0;
+}
+
+size_t Preferences::putString(const char* key, const char* value) {
+  if ( !_open || _readOnly ) return 0;
+  _values[key] = std::string("s") + value;
+  return commit() ? strlen(value) : 0;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t len) {
+  if ( !_open || _readOnly ) return 0;
+  _values[key] = std::string("b") + std::string((const char*) value, len);
+  return commit() ? len : 0;
+}
+
+int32_t Preferences::getInt(const char* key, int32_t defaultValue) {
+  std::map<std::string, std::string>::iterator it = _values.find(key);
+  if ( it == _values.end() || it->second[0] != 'i' || it->second.size() != 1 + sizeof(int32_t) ) return defaultValue;
+  int32_t v;
+  memcpy(&v, it->second.data() + 1, sizeof(v));
+  return v;
+}
+
+uint32_t Preferences::getUInt(const char* key, uint32_t defaultValue) {
+  std::map<std::string, std::string>::iterator it = _values.find(key);
+  if ( it == _values.end() || it->second[0] != 'u' || it->second.size() != 1 + sizeof(uint32_t) ) return defaultValue;
+  uint32_t v;
+  memcpy(&v, it->second.data() + 1, sizeof(v));
+  return v;
+}
+
+String Preferences::getString(const char* key, const String& defaultValue) {
+  std::map<std::string, std::string>::iterator it = _values.find(key);
+  if ( it == _values.end() || it->second[0] != 's' ) return defaultValue;
+  return String(it->second.substr(1));
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+  std::map<std::string, std::string>::iterator it = _values.find(key);
+  if ( it == _values.end() || it->second[0] != 'b' ) return 0;
+  return it->second.size() - 1;
+}
+
+size_t Preferences::getBytes(const char* key, void* buf, size_t maxLen) {
+  size_t len = getBytesLength(key);
+  if ( len == 0 || len > maxLen ) return 0;
+  memcpy(buf, _values[key].data() + 1, len);
+  return len;
+}
@@ -0,0 +1,263 @@
+//  === Host shim: WebServer over POSIX sockets ====================================================
+//  One request per connection (Connection: close), handled on the thread calling handleClient(),
+//  which is what the firmware's mjpeg task does on the device.
+
+#include "WebServer.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Port the host build listens on; 0 maps privileged ports to port + 8000
+int hostHttpPort = 0;
+
+static const char* reasonPhrase(int code) {
+  switch ( code ) {
+    case 200: return "OK";
+    case 204: return "No Content";
+    case 206: return "Partial Content";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 500: return "Internal Server Error";
+    case 503: return "Service Unavailable";
+    default:  return "";
+  }
+}
+
+static String urlDecode(const std::string& s) {
+  std::string r;
+  for (size_t i = 0; i < s.size(); i++) {
+    if ( s[i] == '+' ) r += ' ';
+    else if ( s[i] == '%' && i + 2 < s.size() ) {
+      r += (char) strtol(s.substr(i + 1, 2).c_str(), NULL, 16);
+      i += 2;
+    }
+    else r += s[i];
+  }
+  return String(r);
+}
+
+WebServer::WebServer(int port)
+  : _port(port), _listenFd(-1), _method(HTTP_ANY), _contentLength(CONTENT_LENGTH_NOT_SET), _chunked(false) {}
+
+WebServer::~WebServer() {
+  if ( _listenFd >= 0 ) close(_listenFd);
+}
+
+void WebServer::begin() {
+  int port = hostHttpPort ? hostHttpPort : (_port < 1024 ? _port + 8000 : _port);
+  _listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  int one = 1;
+  setsockopt(_listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+  if ( bind(_listenFd, (struct sockaddr*) &addr, sizeof(addr)) != 0 || listen(_listenFd, 16) != 0 ) {
+    fprintf(stderr, "WebServer: cannot listen on port %d: %s\n", port, strerror(errno));
+    exit(2);
+  }
+  fcntl(_listenFd, F_SETFL, fcntl(_listenFd, F_GETFL) | O_NONBLOCK);
+  printf("WebServer: listening on http://127.0.0.1:%d\n", port);
+  fflush(stdout);
+}
+
+void WebServer::on(const String& uri, HTTPMethod method, THandlerFunction fn) {
+  handler_t h;
+  h.uri = uri;
+  h.method = method;
+  h.fn = fn;
+  _handlers.push_back(h);
+}
+
+void WebServer::collectHeaders(const char* headerKeys[], const size_t headerKeysCount) {
+  // All request headers are kept on the host
+  (void) headerKeys; (void) headerKeysCount;
+}
+
+bool WebServer::readRequest(int fd) {
+  struct timeval tv = { 5, 0 };
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+  std::string req;
+  char buf[1024];
+  while ( req.find("\r\n\r\n") == std::string::npos ) {
+    ssize_t n = recv(fd, buf, sizeof(buf), 0);
+    if ( n <= 0 || req.size() > 16384 ) return false;
+    req.append(buf, n);
+  }
+
+  size_t eol = req.find("\r\n");
+  std::string line = req.substr(0, eol);
+  size_t sp1 = line.find(' ');
+  size_t sp2 = line.find(' ', sp1 + 1);
+  if ( sp1 == std::string::npos || sp2 == std::string::npos ) return false;
+
+  std::string m = line.substr(0, sp1);
+  _method = m == "GET" ? HTTP_GET : m == "HEAD" ? HTTP_HEAD : m == "POST" ? HTTP_POST :
+            m == "PUT" ? HTTP_PUT : m == "PATCH" ? HTTP_PATCH : m == "DELETE" ? HTTP_DELETE :
+            m == "OPTIONS" ? HTTP_OPTIONS : HTTP_ANY;
+
+  std::string target = line.substr(sp1 + 1, sp2 - sp1 - 1);
+  size_t q = target.find('?');
+  _uri = urlDecode(target.substr(0, q));
+  _args.clear();
+  if ( q != std::string::npos ) {
+    std::string query = target.substr(q + 1);
+    size_t p = 0;
+    while ( p <= query.size() ) {
+      size_t amp = query.find('&', p);
+      if ( amp == std::string::npos ) amp = query.size();
+      std::string kv = query.substr(p, amp - p);
+      if ( !kv.empty() ) {
+        size_t eq = kv.find('=');
+        if ( eq == std::string::npos ) _args.push_back(kv_t(urlDecode(kv), String()));
+        else _args.push_back(kv_t(urlDecode(kv.substr(0, eq)), urlDecode(kv.substr(eq + 1))));
+      }
+      p = amp + 1;
+    }
+  }
+
+  _headers.clear();
+  size_t p = eol + 2;
+  for (;;) {
+    size_t e = req.find("\r\n", p);
+    if ( e == std::string::npos || e == p ) break;
+    std::string h = req.substr(p, e - p);
+    size_t c = h.find(':');
+    if ( c != std::string::npos ) {
+      size_t v = h.find_first_not_of(' ', c + 1);
+      _headers.push_back(kv_t(String(h.substr(0, c)), String(v == std::string::npos ? "" : h.substr(v))));
+    }
+    p = e + 2;
+  }
+  return true;
+}
+
+void WebServer::handleClient() {
+  int fd = accept(_listenFd, NULL, NULL);
+  if ( fd < 0 ) return;
+
+  _client = WiFiClient(fd);
+  _responseHeaders = String();
+  _contentLength = CONTENT_LENGTH_NOT_SET;
+  _chunked = false;
+
+  if ( readRequest(fd) ) {
+    bool handled = false;
+    for (size_t i = 0; i < _handlers.size() && !handled; i++) {
+      handler_t& h = _handlers[i];
+      if ( h.uri == _uri && (h.method == HTTP_ANY || h.method == _method) ) {
+        h.fn();
+        handled = true;
+      }
+    }
+    if ( !handled ) {
+      if ( _notFound ) _notFound();
+      else send(404, "text/plain", "Not found");
+    }
+    if ( _chunked ) sendContent("", 0);
+  }
+
+  // Drop our reference: the socket closes unless a handler kept a copy of the client
+  _client = WiFiClient();
+}
+
+String WebServer::arg(const String& name) const {
+  for (size_t i = 0; i < _args.size(); i++) {
+    if ( _args[i].first == name ) return _args[i].second;
+  }
+  return String();
+}
+
+String WebServer::arg(int i) const {
+  return i >= 0 && i < (int) _args.size() ? _args[i].second : String();
+}
+
+String WebServer::argName(int i) const {
+  return i >= 0 && i < (int) _args.size() ? _args[i].first : String();
+}
+
+bool WebServer::hasArg(const String& name) const {
+  for (size_t i = 0; i < _args.size(); i++) {
+    if ( _args[i].first == name ) return true;
+  }
+  return false;
+}
+
+String WebServer::header(const String& name) const {
+  for (size_t i = 0; i < _headers.size(); i++) {
+    if ( _headers[i].first.equalsIgnoreCase(name) ) return _headers[i].second;
+  }
+  return String();
+}
+
+bool WebServer::hasHeader(const String& name) const {
+  for (size_t i = 0; i < _headers.size(); i++) {
+    if ( _headers[i].first.equalsIgnoreCase(name) ) return true;
+  }
+  return false;
+}
+
+void WebServer::sendHeader(const String& name, const String& value, bool first) {
+  String line = name + ": " + value + "\r\n";
+  if ( first ) _responseHeaders = line + _responseHeaders;
+  else _responseHeaders += line;
+}
+
+void WebServer::sendHead(int code, const char* content_type, size_t contentLength) {
+  char line[64];
+  snprintf(line, sizeof(line), "HTTP/1.1 %d %s\r\n", code, reasonPhrase(code));
+  String head = line;
+  if ( content_type && *content_type ) head += String("Content-Type: ") + content_type + "\r\n";
+  if ( contentLength == CONTENT_LENGTH_UNKNOWN ) {
+    head += "Transfer-Encoding: chunked\r\n";
+    _chunked = true;
+  }
+  else {
+    head += String("Content-Length: ") + String((unsigned long) contentLength) + "\r\n";
+  }
+  head += _responseHeaders;
+  head += "Connection: close\r\n\r\n";
+  _client.write(head.c_str(), head.length());
+  _responseHeaders = String();
+  _contentLength = CONTENT_LENGTH_NOT_SET;
+}
+
+void WebServer::send(int code, const char* content_type, const String& content) {
+  size_t len = _contentLength == CONTENT_LENGTH_NOT_SET ? content.length() : _contentLength;
+  sendHead(code, content_type, len);
+  if ( content.length() ) {
+    if ( _chunked ) sendContent(content);
+    else _client.write(content.c_str(), content.length());
+  }
+}
+
+void WebServer::send_P(int code, PGM_P content_type, PGM_P content) {
+  send_P(code, content_type, content, strlen(content));
+}
+
+void WebServer::send_P(int code, PGM_P content_type, PGM_P content, size_t contentLength) {
+  sendHead(code, content_type, contentLength);
+  _client.write(content, contentLength);
+}
+
+void WebServer::sendContent(const char* content, size_t contentLength) {
+  if ( _chunked ) {
+    char len[16];
+    int n = snprintf(len, sizeof(len), "%zx\r\n", contentLength);
+    _client.write(len, n);
+    if ( contentLength ) _client.write(content, contentLength);
+    _client.write("\r\n", 2);
+    if ( contentLength == 0 ) _chunked = false;
+  }
+  else {
+    _client.write(content, contentLength);
+  }
+}
@@ -0,0 +1,134 @@
+//  === Host shim: WiFi, esp_wifi and WiFiClient ===================================================
+
+#include "WiFi.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+WiFiClass WiFi;
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* pwd, int32_t channel, const uint8_t* bssid, bool connect) {
+  (void) pwd; (void) channel; (void) bssid; (void) connect;
+  _ssid = ssid;
+  _status = WL_CONNECTED;
+  return _status;
+}
+
+int8_t WiFiClass::RSSI() {
+  return -55;
+}
+
+int16_t WiFiClass::scanNetworks(bool async, bool hidden, bool passive, uint32_t maxMsPerChan, uint8_t channel, const char* ssid) {
+  (void) async; (void) hidden; (void) passive; (void) maxMsPerChan; (void) channel;
+  if ( ssid ) _ssid = ssid;
+  return 1;
+}
+
+esp_err_t esp_wifi_sta_get_ap_info(wifi_ap_record_t* ap_info) {
+  memset(ap_info, 0, sizeof(*ap_info));
+  ap_info->primary = 6;
+  ap_info->second = WIFI_SECOND_CHAN_ABOVE;
+  ap_info->rssi = WiFi.RSSI();
+  ap_info->phy_11b = 1;
+  ap_info->phy_11g = 1;
+  ap_info->phy_11n = 1;
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_bandwidth(wifi_interface_t ifx, wifi_bandwidth_t bw) { (void) ifx; (void) bw; return ESP_OK; }
+esp_err_t esp_wifi_set_protocol(wifi_interface_t ifx, uint8_t protocol_bitmap) { (void) ifx; (void) protocol_bitmap; return ESP_OK; }
+esp_err_t esp_wifi_set_ps(wifi_ps_type_t type) { (void) type; return ESP_OK; }
+
+esp_err_t esp_wifi_get_protocol(wifi_interface_t ifx, uint8_t* protocol_bitmap) {
+  (void) ifx;
+  *protocol_bitmap = WIFI_PROTOCOL_11B | WIFI_PROTOCOL_11G | WIFI_PROTOCOL_11N;
+  return ESP_OK;
+}
+
+// ==== WiFiClient ================================================================
+class hostSocket {
+public:
+  explicit hostSocket(int fd) : fd(fd) {}
+  ~hostSocket() { if ( fd >= 0 ) close(fd); }
+  int fd;
+};
+
+WiFiClient::WiFiClient(int fd) : _sock(std::make_shared<hostSocket>(fd)) {}
+
+int WiFiClient::fd() const {
+  return _sock ? _sock->fd : -1;
+}
+
+size_t WiFiClient::write(const uint8_t* buf, size_t size) {
+  if ( fd() < 0 ) return 0;
+  size_t sent = 0;
+  while ( sent < size ) {
+    ssize_t n = send(fd(), buf + sent, size - sent, MSG_NOSIGNAL);
+    if ( n > 0 ) { sent += n; continue; }
+    if ( n < 0 && errno == EINTR ) continue;
+    if ( n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) ) {
+      // Socket in non-blocking mode or send timeout hit: report a partial write like lwIP does
+      break;
+    }
+    stop();
+    break;
+  }
+  return sent;
+}
+
+int WiFiClient::available() {
+  if ( fd() < 0 ) return 0;
+  char b[512];
+  ssize_t n = recv(fd(), b, sizeof(b), MSG_PEEK | MSG_DONTWAIT);
+  return n > 0 ? (int) n : 0;
+}
+
+int WiFiClient::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t* buf, size_t size) {
+  if ( fd() < 0 ) return -1;
+  ssize_t n = recv(fd(), buf, size, MSG_DONTWAIT);
+  return n < 0 ? -1 : (int) n;
+}
+
+void WiFiClient::stop() {
+  if ( _sock && _sock->fd >= 0 ) {
+    shutdown(_sock->fd, SHUT_RDWR);
+  }
+  _sock.reset();
+}
+
+uint8_t WiFiClient::connected() {
+  if ( fd() < 0 ) return 0;
+  char c;
+  ssize_t n = recv(fd(), &c, 1, MSG_PEEK | MSG_DONTWAIT);
+  if ( n == 0 ) return 0;
+  if ( n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR ) return 0;
+  return 1;
+}
+
+int WiFiClient::setNoDelay(bool nodelay) {
+  int v = nodelay ? 1 : 0;
+  return setsockopt(fd(), IPPROTO_TCP, TCP_NODELAY, &v, sizeof(v));
+}
+
+int WiFiClient::setTimeout(uint32_t seconds) {
+  struct timeval tv = { (time_t) seconds, 0 };
+  setsockopt(fd(), SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  return setsockopt(fd(), SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+IPAddress WiFiClient::remoteIP() const {
+  struct sockaddr_in addr;
+  socklen_t len = sizeof(addr);
+  if ( fd() < 0 || getpeername(fd(), (struct sockaddr*) &addr, &len) != 0 ) return IPAddress();
+  return IPAddress((uint32_t) addr.sin_addr.s_addr);
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <Arduino.h>
+
+#define FAIL_IF_OOM true    // log the failure; the memory watch decides what happens (mem_watch.h)
+#define OK_IF_OOM   false   // the caller has a fallback: not logged, not counted in allocFailures
+#define PSRAM_ONLY  true
+#define ANY_MEMORY  false
+
+char* allocatePSRAM(size_t aSize);
+char* allocateMemory(char* aPtr, size_t aSize, bool fail = FAIL_IF_OOM, bool psramOnly = ANY_MEMORY);
+
+extern uint32_t allocFailures;
@@ -0,0 +1,519 @@
+#pragma once
+//  Generated by tools/assets.py from data/ - do not edit.
+//  Static assets embedded in flash, sorted by path, with their content hashes.
+
+#include "http_assets.h"
+
+// Changes whenever any asset does; asset URLs of the page carry it as ?t=
+#define ASSET_VERSION  0xac747c8fu
+
+static const uint8_t asset0Data[] PROGMEM = {
+  0x2f, 0x2a, 0x20, 0x45, 0x53, 0x50, 0x33, 0x32, 0x2d, 0x43, 0x41, 0x4d, 0x20, 0x43, 0x6f, 0x6e,
+  0x74, 0x72, 0x6f, 0x6c, 0x20, 0x50, 0x61, 0x6e, 0x65, 0x6c, 0x20, 0x53, 0x74, 0x79, 0x6c, 0x65,
+  0x73, 0x20, 0x2a, 0x2f, 0x0a, 0x62, 0x6f, 0x64, 0x79, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20,
+  0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x66, 0x61, 0x6d, 0x69, 0x6c, 0x79, 0x3a, 0x20, 0x41, 0x72, 0x69,
+  0x61, 0x6c, 0x2c, 0x20, 0x73, 0x61, 0x6e, 0x73, 0x2d, 0x73, 0x65, 0x72, 0x69, 0x66, 0x3b, 0x0a,
+  0x20, 0x20, 0x20, 0x20, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x3a, 0x20, 0x30, 0x3b, 0x0a, 0x20,
+  0x20, 0x20, 0x20, 0x70, 0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 0x3a, 0x20, 0x32, 0x30, 0x70, 0x78,
+  0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64,
+  0x3a, 0x20, 0x23, 0x66, 0x35, 0x66, 0x35, 0x66, 0x35, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x63,
+  0x6f, 0x6e, 0x74, 0x61, 0x69, 0x6e, 0x65, 0x72, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x6d,
+  0x61, 0x78, 0x2d, 0x77, 0x69, 0x64, 0x74, 0x68, 0x3a, 0x20, 0x31, 0x32, 0x30, 0x30, 0x70, 0x78,
+  0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x3a, 0x20, 0x30, 0x20,
+  0x61, 0x75, 0x74, 0x6f, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72,
+  0x6f, 0x75, 0x6e, 0x64, 0x3a, 0x20, 0x77, 0x68, 0x69, 0x74, 0x65, 0x3b, 0x0a, 0x20, 0x20, 0x20,
+  0x20, 0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x2d, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x3a, 0x20,
+  0x31, 0x30, 0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x62, 0x6f, 0x78, 0x2d, 0x73, 0x68,
+  0x61, 0x64, 0x6f, 0x77, 0x3a, 0x20, 0x30, 0x20, 0x34, 0x70, 0x78, 0x20, 0x36, 0x70, 0x78, 0x20,
+  0x72, 0x67, 0x62, 0x61, 0x28, 0x30, 0x2c, 0x30, 0x2c, 0x30, 0x2c, 0x30, 0x2e, 0x31, 0x29, 0x3b,
+  0x0a, 0x20, 0x20, 0x20, 0x20, 0x6f, 0x76, 0x65, 0x72, 0x66, 0x6c, 0x6f, 0x77, 0x3a, 0x20, 0x68,
+  0x69, 0x64, 0x64, 0x65, 0x6e, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x68, 0x65, 0x61, 0x64, 0x65,
+  0x72, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75,
+  0x6e, 0x64, 0x3a, 0x20, 0x6c, 0x69, 0x6e, 0x65, 0x61, 0x72, 0x2d, 0x67, 0x72, 0x61, 0x64, 0x69,
+  0x65, 0x6e, 0x74, 0x28, 0x31, 0x33, 0x35, 0x64, 0x65, 0x67, 0x2c, 0x20, 0x23, 0x36, 0x36, 0x37,
+  0x65, 0x65, 0x61, 0x20, 0x30, 0x25, 0x2c, 0x20, 0x23, 0x37, 0x36, 0x34, 0x62, 0x61, 0x32, 0x20,
+  0x31, 0x30, 0x30, 0x25, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72,
+  0x3a, 0x20, 0x77, 0x68, 0x69, 0x74, 0x65, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x70, 0x61, 0x64,
+  0x64, 0x69, 0x6e, 0x67, 0x3a, 0x20, 0x33, 0x30, 0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20,
+  0x74, 0x65, 0x78, 0x74, 0x2d, 0x61, 0x6c, 0x69, 0x67, 0x6e, 0x3a, 0x20, 0x63, 0x65, 0x6e, 0x74,
+  0x65, 0x72, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x68, 0x65, 0x61, 0x64, 0x65, 0x72, 0x20, 0x68,
+  0x31, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x3a, 0x20,
+  0x30, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x73, 0x69, 0x7a, 0x65,
+  0x3a, 0x20, 0x32, 0x2e, 0x35, 0x65, 0x6d, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x6e,
+  0x74, 0x2d, 0x77, 0x65, 0x69, 0x67, 0x68, 0x74, 0x3a, 0x20, 0x33, 0x30, 0x30, 0x3b, 0x0a, 0x7d,
+  0x0a, 0x0a, 0x2e, 0x68, 0x65, 0x61, 0x64, 0x65, 0x72, 0x20, 0x70, 0x20, 0x7b, 0x0a, 0x20, 0x20,
+  0x20, 0x20, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x3a, 0x20, 0x31, 0x30, 0x70, 0x78, 0x20, 0x30,
+  0x20, 0x30, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x6f, 0x70, 0x61, 0x63, 0x69, 0x74, 0x79, 0x3a,
+  0x20, 0x30, 0x2e, 0x39, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x73, 0x74, 0x72, 0x65, 0x61, 0x6d,
+  0x2d, 0x63, 0x6f, 0x6e, 0x74, 0x61, 0x69, 0x6e, 0x65, 0x72, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20,
+  0x20, 0x70, 0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 0x3a, 0x20, 0x32, 0x30, 0x70, 0x78, 0x3b, 0x0a,
+  0x20, 0x20, 0x20, 0x20, 0x74, 0x65, 0x78, 0x74, 0x2d, 0x61, 0x6c, 0x69, 0x67, 0x6e, 0x3a, 0x20,
+  0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x73, 0x74, 0x72, 0x65,
+  0x61, 0x6d, 0x2d, 0x77, 0x72, 0x61, 0x70, 0x70, 0x65, 0x72, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20,
+  0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3a, 0x20, 0x72, 0x65, 0x6c, 0x61, 0x74,
+  0x69, 0x76, 0x65, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x64, 0x69, 0x73, 0x70, 0x6c, 0x61, 0x79,
+  0x3a, 0x20, 0x69, 0x6e, 0x6c, 0x69, 0x6e, 0x65, 0x2d, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x3b, 0x0a,
+  0x20, 0x20, 0x20, 0x20, 0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x2d, 0x72, 0x61, 0x64, 0x69, 0x75,
+  0x73, 0x3a, 0x20, 0x31, 0x30, 0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x6f, 0x76, 0x65,
+  0x72, 0x66, 0x6c, 0x6f, 0x77, 0x3a, 0x20, 0x68, 0x69, 0x64, 0x64, 0x65, 0x6e, 0x3b, 0x0a, 0x20,
+  0x20, 0x20, 0x20, 0x62, 0x6f, 0x78, 0x2d, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x3a, 0x20, 0x30,
+  0x20, 0x34, 0x70, 0x78, 0x20, 0x31, 0x35, 0x70, 0x78, 0x20, 0x72, 0x67, 0x62, 0x61, 0x28, 0x30,
+  0x2c, 0x30, 0x2c, 0x30, 0x2c, 0x30, 0x2e, 0x32, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x73,
+  0x74, 0x72, 0x65, 0x61, 0x6d, 0x2d, 0x69, 0x6d, 0x67, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20,
+  0x6d, 0x61, 0x78, 0x2d, 0x77, 0x69, 0x64, 0x74, 0x68, 0x3a, 0x20, 0x31, 0x30, 0x30, 0x25, 0x3b,
+  0x0a, 0x20, 0x20, 0x20, 0x20, 0x68, 0x65, 0x69, 0x67, 0x68, 0x74, 0x3a, 0x20, 0x61, 0x75, 0x74,
+  0x6f, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x64, 0x69, 0x73, 0x70, 0x6c, 0x61, 0x79, 0x3a, 0x20,
+  0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x73, 0x74, 0x72, 0x65, 0x61,
+  0x6d, 0x2d, 0x6f, 0x76, 0x65, 0x72, 0x6c, 0x61, 0x79, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20,
+  0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3a, 0x20, 0x61, 0x62, 0x73, 0x6f, 0x6c, 0x75,
+  0x74, 0x65, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x74, 0x6f, 0x70, 0x3a, 0x20, 0x31, 0x30, 0x70,
+  0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x6c, 0x65, 0x66, 0x74, 0x3a, 0x20, 0x31, 0x30, 0x70,
+  0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e,
+  0x64, 0x3a, 0x20, 0x72, 0x67, 0x62, 0x61, 0x28, 0x30, 0x2c, 0x30, 0x2c, 0x30, 0x2c, 0x30, 0x2e,
+  0x37, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x77,
+  0x68, 0x69, 0x74, 0x65, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x70, 0x61, 0x64, 0x64, 0x69, 0x6e,
+  0x67, 0x3a, 0x20, 0x35, 0x70, 0x78, 0x20, 0x31, 0x30, 0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20,
+  0x20, 0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x2d, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x3a, 0x20,
+  0x35, 0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x73, 0x69,
+  0x7a, 0x65, 0x3a, 0x20, 0x31, 0x32, 0x70, 0x78, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x63, 0x6f,
+  0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x73, 0x2d, 0x67, 0x72, 0x69, 0x64, 0x20, 0x7b, 0x0a, 0x20, 0x20,
+  0x20, 0x20, 0x64, 0x69, 0x73, 0x70, 0x6c, 0x61, 0x79, 0x3a, 0x20, 0x67, 0x72, 0x69, 0x64, 0x3b,
+  0x0a, 0x20, 0x20, 0x20, 0x20, 0x67, 0x72, 0x69, 0x64, 0x2d, 0x74, 0x65, 0x6d, 0x70, 0x6c, 0x61,
+  0x74, 0x65, 0x2d, 0x63, 0x6f, 0x6c, 0x75, 0x6d, 0x6e, 0x73, 0x3a, 0x20, 0x72, 0x65, 0x70, 0x65,
+  0x61, 0x74, 0x28, 0x61, 0x75, 0x74, 0x6f, 0x2d, 0x66, 0x69, 0x74, 0x2c, 0x20, 0x6d, 0x69, 0x6e,
+  0x6d, 0x61, 0x78, 0x28, 0x33, 0x30, 0x30, 0x70, 0x78, 0x2c, 0x20, 0x31, 0x66, 0x72, 0x29, 0x29,
+  0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x67, 0x61, 0x70, 0x3a, 0x20, 0x32, 0x30, 0x70, 0x78, 0x3b,
+  0x0a, 0x20, 0x20, 0x20, 0x20, 0x70, 0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 0x3a, 0x20, 0x32, 0x30,
+  0x70, 0x78, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x63, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x2d,
+  0x70, 0x61, 0x6e, 0x65, 0x6c, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x62, 0x61, 0x63, 0x6b,
+  0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x3a, 0x20, 0x23, 0x66, 0x38, 0x66, 0x39, 0x66, 0x61, 0x3b,
+  0x0a, 0x20, 0x20, 0x20, 0x20, 0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x2d, 0x72, 0x61, 0x64, 0x69,
+  0x75, 0x73, 0x3a, 0x20, 0x38, 0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x70, 0x61, 0x64,
+  0x64, 0x69, 0x6e, 0x67, 0x3a, 0x20, 0x32, 0x30, 0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20,
+  0x62, 0x6f, 0x78, 0x2d, 0x73, 0x68, 0x61, 0x64, 0x6f, 0x77, 0x3a, 0x20, 0x30, 0x20, 0x32, 0x70,
+  0x78, 0x20, 0x34, 0x70, 0x78, 0x20, 0x72, 0x67, 0x62, 0x61, 0x28, 0x30, 0x2c, 0x30, 0x2c, 0x30,
+  0x2c, 0x30, 0x2e, 0x31, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x63, 0x6f, 0x6e, 0x74, 0x72,
+  0x6f, 0x6c, 0x2d, 0x70, 0x61, 0x6e, 0x65, 0x6c, 0x20, 0x68, 0x33, 0x20, 0x7b, 0x0a, 0x20, 0x20,
+  0x20, 0x20, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x3a, 0x20, 0x30, 0x20, 0x30, 0x20, 0x31, 0x35,
+  0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23,
+  0x34, 0x39, 0x35, 0x30, 0x35, 0x37, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x62, 0x6f, 0x72, 0x64,
+  0x65, 0x72, 0x2d, 0x62, 0x6f, 0x74, 0x74, 0x6f, 0x6d, 0x3a, 0x20, 0x32, 0x70, 0x78, 0x20, 0x73,
+  0x6f, 0x6c, 0x69, 0x64, 0x20, 0x23, 0x65, 0x39, 0x65, 0x63, 0x65, 0x66, 0x3b, 0x0a, 0x20, 0x20,
+  0x20, 0x20, 0x70, 0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 0x2d, 0x62, 0x6f, 0x74, 0x74, 0x6f, 0x6d,
+  0x3a, 0x20, 0x31, 0x30, 0x70, 0x78, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x63, 0x6f, 0x6e, 0x74,
+  0x72, 0x6f, 0x6c, 0x2d, 0x67, 0x72, 0x6f, 0x75, 0x70, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20,
+  0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x3a, 0x20, 0x31, 0x35, 0x70, 0x78, 0x20, 0x30, 0x3b, 0x0a,
+  0x7d, 0x0a, 0x0a, 0x2e, 0x63, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x2d, 0x67, 0x72, 0x6f, 0x75,
+  0x70, 0x20, 0x6c, 0x61, 0x62, 0x65, 0x6c, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x64, 0x69,
+  0x73, 0x70, 0x6c, 0x61, 0x79, 0x3a, 0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x3b, 0x0a, 0x20, 0x20,
+  0x20, 0x20, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x2d, 0x62, 0x6f, 0x74, 0x74, 0x6f, 0x6d, 0x3a,
+  0x20, 0x35, 0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x77,
+  0x65, 0x69, 0x67, 0x68, 0x74, 0x3a, 0x20, 0x35, 0x30, 0x30, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20,
+  0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23, 0x36, 0x63, 0x37, 0x35, 0x37, 0x64, 0x3b, 0x0a,
+  0x7d, 0x0a, 0x0a, 0x2e, 0x63, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x2d, 0x67, 0x72, 0x6f, 0x75,
+  0x70, 0x20, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x2c, 0x0a, 0x2e, 0x63, 0x6f, 0x6e, 0x74, 0x72, 0x6f,
+  0x6c, 0x2d, 0x67, 0x72, 0x6f, 0x75, 0x70, 0x20, 0x73, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x20, 0x7b,
+  0x0a, 0x20, 0x20, 0x20, 0x20, 0x77, 0x69, 0x64, 0x74, 0x68, 0x3a, 0x20, 0x31, 0x30, 0x30, 0x25,
+  0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x70, 0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 0x3a, 0x20, 0x38,
+  0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x3a, 0x20,
+  0x31, 0x70, 0x78, 0x20, 0x73, 0x6f, 0x6c, 0x69, 0x64, 0x20, 0x23, 0x64, 0x64, 0x64, 0x3b, 0x0a,
+  0x20, 0x20, 0x20, 0x20, 0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x2d, 0x72, 0x61, 0x64, 0x69, 0x75,
+  0x73, 0x3a, 0x20, 0x34, 0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x6e, 0x74,
+  0x2d, 0x73, 0x69, 0x7a, 0x65, 0x3a, 0x20, 0x31, 0x34, 0x70, 0x78, 0x3b, 0x0a, 0x7d, 0x0a, 0x2e,
+  0x63, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x2d, 0x67, 0x72, 0x6f, 0x75, 0x70, 0x20, 0x6c, 0x61,
+  0x62, 0x65, 0x6c, 0x20, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20,
+  0x77, 0x69, 0x64, 0x74, 0x68, 0x3a, 0x20, 0x75, 0x6e, 0x73, 0x65, 0x74, 0x3b, 0x0a, 0x20, 0x20,
+  0x20, 0x20, 0x76, 0x65, 0x72, 0x74, 0x69, 0x63, 0x61, 0x6c, 0x2d, 0x61, 0x6c, 0x69, 0x67, 0x6e,
+  0x3a, 0x20, 0x74, 0x6f, 0x70, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x63, 0x6f, 0x6e, 0x74, 0x72,
+  0x6f, 0x6c, 0x2d, 0x67, 0x72, 0x6f, 0x75, 0x70, 0x20, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x5b, 0x74,
+  0x79, 0x70, 0x65, 0x3d, 0x27, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x27, 0x5d, 0x20, 0x7b, 0x0a, 0x20,
+  0x20, 0x20, 0x20, 0x68, 0x65, 0x69, 0x67, 0x68, 0x74, 0x3a, 0x20, 0x36, 0x70, 0x78, 0x3b, 0x0a,
+  0x20, 0x20, 0x20, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x3a, 0x20,
+  0x23, 0x64, 0x64, 0x64, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x6f, 0x75, 0x74, 0x6c, 0x69, 0x6e,
+  0x65, 0x3a, 0x20, 0x6e, 0x6f, 0x6e, 0x65, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x62, 0x6f, 0x72,
+  0x64, 0x65, 0x72, 0x2d, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x3a, 0x20, 0x33, 0x70, 0x78, 0x3b,
+  0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x63, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x2d, 0x67, 0x72, 0x6f,
+  0x75, 0x70, 0x20, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x5b, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x27, 0x72,
+  0x61, 0x6e, 0x67, 0x65, 0x27, 0x5d, 0x3a, 0x3a, 0x2d, 0x77, 0x65, 0x62, 0x6b, 0x69, 0x74, 0x2d,
+  0x73, 0x6c, 0x69, 0x64, 0x65, 0x72, 0x2d, 0x74, 0x68, 0x75, 0x6d, 0x62, 0x20, 0x7b, 0x0a, 0x20,
+  0x20, 0x20, 0x20, 0x61, 0x70, 0x70, 0x65, 0x61, 0x72, 0x61, 0x6e, 0x63, 0x65, 0x3a, 0x20, 0x6e,
+  0x6f, 0x6e, 0x65, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x77, 0x69, 0x64, 0x74, 0x68, 0x3a, 0x20,
+  0x31, 0x38, 0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x68, 0x65, 0x69, 0x67, 0x68, 0x74,
+  0x3a, 0x20, 0x31, 0x38, 0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x62, 0x6f, 0x72, 0x64,
+  0x65, 0x72, 0x2d, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x3a, 0x20, 0x35, 0x30, 0x25, 0x3b, 0x0a,
+  0x20, 0x20, 0x20, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x3a, 0x20,
+  0x23, 0x30, 0x30, 0x37, 0x62, 0x66, 0x66, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 0x75, 0x72,
+  0x73, 0x6f, 0x72, 0x3a, 0x20, 0x70, 0x6f, 0x69, 0x6e, 0x74, 0x65, 0x72, 0x3b, 0x0a, 0x7d, 0x0a,
+  0x0a, 0x2e, 0x63, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x2d, 0x67, 0x72, 0x6f, 0x75, 0x70, 0x20,
+  0x69, 0x6e, 0x70, 0x75, 0x74, 0x5b, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x27, 0x72, 0x61, 0x6e, 0x67,
+  0x65, 0x27, 0x5d, 0x3a, 0x3a, 0x2d, 0x6d, 0x6f, 0x7a, 0x2d, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x2d,
+  0x74, 0x68, 0x75, 0x6d, 0x62, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x77, 0x69, 0x64, 0x74,
+  0x68, 0x3a, 0x20, 0x31, 0x38, 0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x68, 0x65, 0x69,
+  0x67, 0x68, 0x74, 0x3a, 0x20, 0x31, 0x38, 0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x62,
+  0x6f, 0x72, 0x64, 0x65, 0x72, 0x2d, 0x72, 0x61, 0x64, 0x69, 0x75, 0x73, 0x3a, 0x20, 0x35, 0x30,
+  0x25, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e,
+  0x64, 0x3a, 0x20, 0x23, 0x30, 0x30, 0x37, 0x62, 0x66, 0x66, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20,
+  0x63, 0x75, 0x72, 0x73, 0x6f, 0x72, 0x3a, 0x20, 0x70, 0x6f, 0x69, 0x6e, 0x74, 0x65, 0x72, 0x3b,
+  0x0a, 0x20, 0x20, 0x20, 0x20, 0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x3a, 0x20, 0x6e, 0x6f, 0x6e,
+  0x65, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x63, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x2d, 0x67,
+  0x72, 0x6f, 0x75, 0x70, 0x20, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x3a, 0x64, 0x69, 0x73, 0x61, 0x62,
+  0x6c, 0x65, 0x64, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x6f, 0x70, 0x61, 0x63, 0x69, 0x74,
+  0x79, 0x3a, 0x20, 0x30, 0x2e, 0x36, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 0x75, 0x72, 0x73,
+  0x6f, 0x72, 0x3a, 0x20, 0x6e, 0x6f, 0x74, 0x2d, 0x61, 0x6c, 0x6c, 0x6f, 0x77, 0x65, 0x64, 0x3b,
+  0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x62, 0x74, 0x6e, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x64,
+  0x69, 0x73, 0x70, 0x6c, 0x61, 0x79, 0x3a, 0x20, 0x69, 0x6e, 0x6c, 0x69, 0x6e, 0x65, 0x2d, 0x62,
+  0x6c, 0x6f, 0x63, 0x6b, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x70, 0x61, 0x64, 0x64, 0x69, 0x6e,
+  0x67, 0x3a, 0x20, 0x31, 0x30, 0x70, 0x78, 0x20, 0x32, 0x30, 0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20,
+  0x20, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x3a, 0x20, 0x23, 0x30,
+  0x30, 0x37, 0x62, 0x66, 0x66, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72,
+  0x3a, 0x20, 0x77, 0x68, 0x69, 0x74, 0x65, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x74, 0x65, 0x78,
+  0x74, 0x2d, 0x64, 0x65, 0x63, 0x6f, 0x72, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3a, 0x20, 0x6e, 0x6f,
+  0x6e, 0x65, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x2d, 0x72,
+  0x61, 0x64, 0x69, 0x75, 0x73, 0x3a, 0x20, 0x35, 0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20,
+  0x62, 0x6f, 0x72, 0x64, 0x65, 0x72, 0x3a, 0x20, 0x6e, 0x6f, 0x6e, 0x65, 0x3b, 0x0a, 0x20, 0x20,
+  0x20, 0x20, 0x63, 0x75, 0x72, 0x73, 0x6f, 0x72, 0x3a, 0x20, 0x70, 0x6f, 0x69, 0x6e, 0x74, 0x65,
+  0x72, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x73, 0x69, 0x7a, 0x65,
+  0x3a, 0x20, 0x31, 0x34, 0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x6d, 0x61, 0x72, 0x67,
+  0x69, 0x6e, 0x3a, 0x20, 0x35, 0x70, 0x78, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x62, 0x74, 0x6e,
+  0x3a, 0x68, 0x6f, 0x76, 0x65, 0x72, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x62, 0x61, 0x63,
+  0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x3a, 0x20, 0x23, 0x30, 0x30, 0x35, 0x36, 0x62, 0x33,
+  0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x62, 0x74, 0x6e, 0x2d, 0x64, 0x61, 0x6e, 0x67, 0x65, 0x72,
+  0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e,
+  0x64, 0x3a, 0x20, 0x23, 0x64, 0x63, 0x33, 0x35, 0x34, 0x35, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2e,
+  0x62, 0x74, 0x6e, 0x2d, 0x64, 0x61, 0x6e, 0x67, 0x65, 0x72, 0x3a, 0x68, 0x6f, 0x76, 0x65, 0x72,
+  0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e,
+  0x64, 0x3a, 0x20, 0x23, 0x63, 0x38, 0x32, 0x33, 0x33, 0x33, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x2e,
+  0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x2d, 0x62, 0x61, 0x72, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20,
+  0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x3a, 0x20, 0x23, 0x33, 0x34,
+  0x33, 0x61, 0x34, 0x30, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a,
+  0x20, 0x77, 0x68, 0x69, 0x74, 0x65, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x70, 0x61, 0x64, 0x64,
+  0x69, 0x6e, 0x67, 0x3a, 0x20, 0x31, 0x35, 0x70, 0x78, 0x20, 0x32, 0x30, 0x70, 0x78, 0x3b, 0x0a,
+  0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x66, 0x61, 0x6d, 0x69, 0x6c, 0x79, 0x3a,
+  0x20, 0x6d, 0x6f, 0x6e, 0x6f, 0x73, 0x70, 0x61, 0x63, 0x65, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20,
+  0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x73, 0x69, 0x7a, 0x65, 0x3a, 0x20, 0x31, 0x34, 0x70, 0x78, 0x3b,
+  0x0a, 0x7d, 0x0a, 0x0a, 0x2e, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x2d, 0x76, 0x61, 0x6c, 0x75, 0x65,
+  0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x64, 0x69, 0x73, 0x70, 0x6c, 0x61, 0x79, 0x3a, 0x20,
+  0x69, 0x6e, 0x6c, 0x69, 0x6e, 0x65, 0x2d, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x3b, 0x0a, 0x20, 0x20,
+  0x20, 0x20, 0x6d, 0x69, 0x6e, 0x2d, 0x77, 0x69, 0x64, 0x74, 0x68, 0x3a, 0x20, 0x34, 0x30, 0x70,
+  0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x74, 0x65, 0x78, 0x74, 0x2d, 0x61, 0x6c, 0x69, 0x67,
+  0x6e, 0x3a, 0x20, 0x72, 0x69, 0x67, 0x68, 0x74, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f,
+  0x6e, 0x74, 0x2d, 0x77, 0x65, 0x69, 0x67, 0x68, 0x74, 0x3a, 0x20, 0x62, 0x6f, 0x6c, 0x64, 0x3b,
+  0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23, 0x30, 0x30, 0x37,
+  0x62, 0x66, 0x66, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x6d, 0x61, 0x72, 0x67, 0x69, 0x6e, 0x2d,
+  0x6c, 0x65, 0x66, 0x74, 0x3a, 0x20, 0x31, 0x30, 0x70, 0x78, 0x3b, 0x0a, 0x7d, 0x0a,
+};
+static const uint8_t asset0Gzip[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbd, 0x56, 0x4d, 0x8f, 0xa3, 0x38,
+  0x10, 0xbd, 0xe7, 0x57, 0x58, 0x6a, 0x8d, 0xa6, 0x7b, 0x14, 0x32, 0x10, 0x20, 0x49, 0x33, 0xda,
+  0xc3, 0x68, 0xb4, 0xc7, 0x95, 0x46, 0x9a, 0xe3, 0x6a, 0x0f, 0x06, 0x1b, 0xb0, 0xda, 0xd8, 0xc8,
+  0x98, 0x4e, 0x7a, 0x46, 0xf3, 0xdf, 0xb7, 0xcc, 0x57, 0x30, 0x18, 0xf5, 0x9e, 0xb6, 0x51, 0x4b,
+  0x89, 0x53, 0x54, 0xbd, 0x7a, 0xf5, 0xaa, 0xca, 0x9f, 0x3f, 0xa1, 0x3f, 0x7f, 0x7c, 0x0f, 0x8f,
+  0xde, 0xb7, 0xaf, 0x7f, 0xa1, 0x6f, 0x52, 0x68, 0x25, 0x39, 0xfa, 0x8e, 0x05, 0xe5, 0xe8, 0x87,
+  0x7e, 0xe3, 0xb4, 0x41, 0x9f, 0x3e, 0xef, 0x52, 0x49, 0xde, 0xd0, 0xaf, 0x1d, 0x82, 0xbf, 0x1c,
+  0x4c, 0xbc, 0x1c, 0x57, 0x8c, 0xbf, 0x25, 0xe8, 0xab, 0x62, 0x98, 0xef, 0x51, 0x83, 0x45, 0xe3,
+  0x35, 0x54, 0xb1, 0xfc, 0x4b, 0x67, 0x53, 0x61, 0x55, 0x30, 0x91, 0x20, 0xbf, 0xff, 0x5a, 0x63,
+  0x42, 0x98, 0x28, 0x12, 0x74, 0xf4, 0xeb, 0x5b, 0x7f, 0x94, 0xe2, 0xec, 0xa5, 0x50, 0xb2, 0x15,
+  0x24, 0x41, 0x0f, 0x79, 0x6c, 0x9e, 0x2f, 0xbb, 0xdf, 0xbb, 0xdd, 0x21, 0x03, 0xf7, 0x98, 0x09,
+  0xaa, 0x86, 0x70, 0x15, 0xbe, 0x79, 0x57, 0x46, 0x74, 0x99, 0xa0, 0xe0, 0xe8, 0x4f, 0xef, 0x4f,
+  0x11, 0x10, 0x6e, 0xb5, 0x5c, 0xfb, 0xbc, 0x96, 0x4c, 0xd3, 0xe1, 0x58, 0x2a, 0x42, 0x95, 0xa7,
+  0x30, 0x61, 0x6d, 0x03, 0x5e, 0xee, 0x18, 0xe4, 0xcd, 0x6b, 0x4a, 0x4c, 0xe4, 0xd5, 0xf8, 0x89,
+  0xea, 0x1b, 0x3a, 0xc1, 0xbf, 0x2a, 0x52, 0xfc, 0xe8, 0xef, 0xbb, 0xe7, 0x10, 0x3c, 0xf5, 0xa6,
+  0xf2, 0x95, 0xaa, 0x9c, 0x1b, 0xc3, 0x92, 0x11, 0x42, 0x45, 0x8f, 0xb5, 0xa4, 0x98, 0x4c, 0x40,
+  0xe7, 0xd1, 0x39, 0x24, 0x80, 0x95, 0x57, 0x98, 0x98, 0x54, 0xe8, 0xc7, 0x20, 0x8c, 0x09, 0x2d,
+  0xf6, 0xe8, 0xe1, 0x74, 0x3a, 0x53, 0x8a, 0x91, 0xff, 0x01, 0x3e, 0x9f, 0x4f, 0x51, 0x8a, 0x8f,
+  0x80, 0xc7, 0xff, 0x30, 0x44, 0xc9, 0x24, 0x97, 0xca, 0xc2, 0x3e, 0x31, 0x17, 0x4e, 0xa8, 0x35,
+  0xbd, 0x69, 0x0f, 0x73, 0x56, 0x40, 0xf6, 0x19, 0x38, 0xa7, 0xca, 0x02, 0x53, 0x06, 0x13, 0x71,
+  0x56, 0x0d, 0xba, 0xb2, 0x35, 0xec, 0x27, 0x85, 0x2a, 0x1c, 0x62, 0x5a, 0xcd, 0x4e, 0xaf, 0x94,
+  0x15, 0xa5, 0x36, 0x31, 0x7c, 0xcb, 0x55, 0xbd, 0xf0, 0x64, 0x98, 0x03, 0xa2, 0x06, 0x87, 0xb2,
+  0xc6, 0x19, 0xd3, 0xa0, 0x01, 0xff, 0xf0, 0xdc, 0xbf, 0xd6, 0x68, 0x45, 0x71, 0xe5, 0x2d, 0x2b,
+  0xe8, 0xa8, 0xfe, 0x56, 0x0e, 0x83, 0x87, 0xab, 0xc2, 0x75, 0x7d, 0x7f, 0x5f, 0x36, 0x4c, 0x33,
+  0x09, 0xa6, 0x8a, 0x72, 0xac, 0xd9, 0xeb, 0xc0, 0x0d, 0x61, 0x4d, 0xcd, 0x31, 0x00, 0x60, 0xc2,
+  0xf0, 0xed, 0xa5, 0x5c, 0x66, 0x2f, 0xef, 0x94, 0x7c, 0x5d, 0x47, 0xb7, 0x10, 0x82, 0x78, 0xa9,
+  0x84, 0xe3, 0x93, 0x05, 0x91, 0x55, 0x85, 0x43, 0xa0, 0x50, 0xca, 0xde, 0x63, 0x39, 0x50, 0x7a,
+  0x17, 0xe7, 0x84, 0x76, 0x80, 0x39, 0xf3, 0x65, 0x40, 0xc1, 0x4f, 0xab, 0x74, 0x71, 0xda, 0x48,
+  0xde, 0x8e, 0x52, 0xd0, 0xb2, 0x9e, 0x67, 0xc2, 0x69, 0xae, 0x2d, 0x31, 0xcf, 0xe4, 0x67, 0x01,
+  0x3f, 0xbf, 0x2f, 0x2e, 0x93, 0xec, 0xbc, 0x2d, 0x2c, 0xf2, 0xe2, 0xf1, 0x7c, 0xa6, 0xa0, 0xe0,
+  0x68, 0x0e, 0xc7, 0x76, 0x85, 0x81, 0xd1, 0x80, 0xd6, 0x19, 0x19, 0x32, 0x98, 0x52, 0x35, 0x67,
+  0xfd, 0xbb, 0xe6, 0x93, 0xa7, 0x69, 0x05, 0xe7, 0x9a, 0x82, 0x42, 0x78, 0x5b, 0x89, 0xc6, 0x14,
+  0xb4, 0xa6, 0x58, 0x3f, 0x1a, 0x96, 0xbc, 0x9c, 0xe9, 0x3d, 0xaa, 0x98, 0x00, 0x3e, 0x1f, 0x43,
+  0xd3, 0xe8, 0x7b, 0x14, 0xe4, 0xea, 0x69, 0x40, 0x5f, 0xe0, 0x7a, 0x2e, 0xa0, 0x85, 0xa6, 0x66,
+  0x48, 0xbc, 0xba, 0x1b, 0x5d, 0xbf, 0x1c, 0x53, 0xe6, 0x92, 0x3f, 0xe7, 0xd8, 0x99, 0xe3, 0x65,
+  0xc3, 0xef, 0x5a, 0x1c, 0x90, 0x78, 0x27, 0x90, 0xd5, 0x94, 0x58, 0x43, 0x28, 0xc3, 0x65, 0x27,
+  0xc2, 0x13, 0x4c, 0x74, 0x0e, 0xf5, 0x78, 0x88, 0x9e, 0x63, 0x3f, 0x3e, 0x5b, 0xb0, 0x52, 0xa9,
+  0xb5, 0xac, 0x92, 0x2e, 0x18, 0x48, 0x00, 0x88, 0x7d, 0xa0, 0xcf, 0x34, 0xa3, 0xb9, 0x05, 0x72,
+  0x32, 0x0b, 0x56, 0x1c, 0x98, 0x9c, 0x57, 0xdd, 0x6b, 0xaa, 0xec, 0xbb, 0xec, 0x38, 0x4e, 0x27,
+  0xc6, 0x96, 0x32, 0xbd, 0x7b, 0x98, 0xc2, 0xd9, 0x82, 0x18, 0x87, 0x47, 0xec, 0xfb, 0x76, 0x5e,
+  0xa7, 0xec, 0x1c, 0x9f, 0x89, 0x2b, 0x1e, 0x13, 0x75, 0xab, 0xf7, 0xcb, 0xd3, 0x86, 0x72, 0x9a,
+  0xe9, 0x01, 0xc6, 0xaa, 0xa1, 0xa6, 0xc2, 0x5c, 0x6c, 0x99, 0x82, 0xcd, 0x9d, 0x24, 0x42, 0x88,
+  0xb3, 0xbc, 0x91, 0x4b, 0xc2, 0x51, 0x4f, 0x9a, 0x93, 0x8b, 0x0e, 0xa1, 0x0d, 0xa5, 0x15, 0x0d,
+  0xd5, 0xbd, 0x17, 0x68, 0x57, 0xcd, 0x32, 0xcc, 0xc7, 0x09, 0x06, 0x9d, 0xb9, 0x99, 0xe6, 0xdf,
+  0xfa, 0xad, 0xa6, 0x7f, 0x7c, 0x54, 0x58, 0x14, 0xf4, 0xe3, 0x3f, 0x83, 0xcb, 0x71, 0x3a, 0x9c,
+  0x9c, 0xdb, 0x70, 0xca, 0x42, 0xb6, 0xda, 0x0c, 0xb6, 0x04, 0x09, 0x29, 0xdc, 0xbb, 0x2c, 0x74,
+  0x17, 0xde, 0x11, 0x39, 0x49, 0xa0, 0x52, 0xe9, 0x0b, 0x83, 0xf4, 0x81, 0x2a, 0x70, 0xa1, 0xcb,
+  0xb6, 0x4a, 0x07, 0x3c, 0x66, 0xda, 0x62, 0x30, 0xcc, 0xac, 0x58, 0x63, 0x0d, 0x26, 0xc6, 0x47,
+  0xd8, 0xc1, 0x65, 0x6b, 0x54, 0x8c, 0xd5, 0xb2, 0xf2, 0xf1, 0xfd, 0x73, 0x9a, 0x0f, 0xd2, 0xcd,
+  0x5a, 0xd5, 0x18, 0x75, 0xd4, 0x92, 0xdd, 0xa7, 0xfe, 0x7f, 0x01, 0x5f, 0xc9, 0x9f, 0x5e, 0xf7,
+  0xcd, 0x02, 0xfe, 0xbf, 0x40, 0x9c, 0x8b, 0xad, 0x67, 0x67, 0x03, 0x74, 0x02, 0xcd, 0x83, 0x53,
+  0x4e, 0xc7, 0x39, 0x38, 0xdb, 0x90, 0x27, 0xdb, 0xb7, 0x90, 0x66, 0xfd, 0xc1, 0x1e, 0xa2, 0x43,
+  0x83, 0xa4, 0x5a, 0x2c, 0x1b, 0x70, 0xbd, 0xd5, 0xa6, 0x1e, 0xe8, 0x16, 0xf1, 0xc6, 0x5d, 0xca,
+  0x4a, 0x65, 0x35, 0xf2, 0xbb, 0xc5, 0x4b, 0x68, 0x26, 0x15, 0xee, 0x77, 0xcc, 0xa6, 0xb4, 0xe2,
+  0x65, 0x9f, 0xdd, 0x2d, 0x9d, 0x0c, 0xad, 0x5a, 0x6b, 0x3e, 0x7b, 0xe2, 0x51, 0xa7, 0x90, 0x67,
+  0x52, 0x9a, 0x7d, 0xe7, 0x1a, 0xd0, 0xbe, 0x1f, 0x9f, 0xd2, 0x70, 0x32, 0xf4, 0x88, 0xa9, 0xb7,
+  0xd3, 0x92, 0x64, 0x61, 0x1c, 0xc5, 0x4b, 0xcb, 0x6d, 0xcf, 0xd9, 0xe5, 0x18, 0x86, 0xe1, 0xb8,
+  0x74, 0xb1, 0x6e, 0x1b, 0x2f, 0xc5, 0x4e, 0xcb, 0x30, 0x0a, 0x71, 0xe4, 0xbf, 0xbb, 0x31, 0xbb,
+  0x61, 0x7a, 0xaf, 0x80, 0x75, 0x27, 0xae, 0xa4, 0x90, 0x0d, 0x94, 0x9e, 0x6e, 0xce, 0x9c, 0xdd,
+  0xa1, 0x97, 0xf2, 0x2b, 0xe6, 0x2d, 0x7d, 0xbf, 0xee, 0xb0, 0x14, 0xc7, 0x1b, 0x46, 0xe4, 0xbc,
+  0x42, 0x29, 0x23, 0x7a, 0xc7, 0x4c, 0x4e, 0x25, 0x27, 0xf6, 0x50, 0x9e, 0xab, 0x63, 0x18, 0xeb,
+  0xf3, 0x8b, 0xc4, 0xef, 0xdd, 0xbf, 0x63, 0x33, 0x24, 0xd9, 0x0e, 0x0c, 0x00, 0x00,
+};
+static const uint8_t asset1Data[] PROGMEM = {
+  0x2f, 0x2a, 0x20, 0x45, 0x53, 0x50, 0x33, 0x32, 0x2d, 0x43, 0x41, 0x4d, 0x20, 0x43, 0x6f, 0x6e,
+  0x74, 0x72, 0x6f, 0x6c, 0x20, 0x50, 0x61, 0x6e, 0x65, 0x6c, 0x20, 0x4a, 0x61, 0x76, 0x61, 0x53,
+  0x63, 0x72, 0x69, 0x70, 0x74, 0x20, 0x2a, 0x2f, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x43, 0x6f, 0x6e,
+  0x74, 0x72, 0x6f, 0x6c, 0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x66,
+  0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x73, 0x65, 0x74, 0x43, 0x6f, 0x6e, 0x74, 0x72,
+  0x6f, 0x6c, 0x28, 0x76, 0x61, 0x72, 0x69, 0x61, 0x62, 0x6c, 0x65, 0x2c, 0x20, 0x76, 0x61, 0x6c,
+  0x75, 0x65, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x65, 0x74, 0x63, 0x68, 0x28,
+  0x27, 0x2f, 0x63, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x3f, 0x76, 0x61, 0x72, 0x3d, 0x27, 0x20,
+  0x2b, 0x20, 0x65, 0x6e, 0x63, 0x6f, 0x64, 0x65, 0x55, 0x52, 0x49, 0x43, 0x6f, 0x6d, 0x70, 0x6f,
+  0x6e, 0x65, 0x6e, 0x74, 0x28, 0x76, 0x61, 0x72, 0x69, 0x61, 0x62, 0x6c, 0x65, 0x29, 0x20, 0x2b,
+  0x20, 0x27, 0x26, 0x76, 0x61, 0x6c, 0x3d, 0x27, 0x20, 0x2b, 0x20, 0x65, 0x6e, 0x63, 0x6f, 0x64,
+  0x65, 0x55, 0x52, 0x49, 0x43, 0x6f, 0x6d, 0x70, 0x6f, 0x6e, 0x65, 0x6e, 0x74, 0x28, 0x76, 0x61,
+  0x6c, 0x75, 0x65, 0x29, 0x29, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x2e, 0x74,
+  0x68, 0x65, 0x6e, 0x28, 0x72, 0x20, 0x3d, 0x3e, 0x20, 0x72, 0x2e, 0x74, 0x65, 0x78, 0x74, 0x28,
+  0x29, 0x29, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x2e, 0x74, 0x68, 0x65, 0x6e,
+  0x28, 0x28, 0x29, 0x20, 0x3d, 0x3e, 0x20, 0x7b, 0x7d, 0x29, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x2e, 0x63, 0x61, 0x74, 0x63, 0x68, 0x28, 0x28, 0x29, 0x20, 0x3d, 0x3e, 0x20,
+  0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x64, 0x6f,
+  0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x67, 0x65, 0x74, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e,
+  0x74, 0x42, 0x79, 0x49, 0x64, 0x28, 0x27, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x27, 0x29, 0x2e,
+  0x74, 0x65, 0x78, 0x74, 0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20, 0x27, 0x53,
+  0x74, 0x61, 0x74, 0x75, 0x73, 0x3a, 0x20, 0x43, 0x6f, 0x6e, 0x6e, 0x65, 0x63, 0x74, 0x69, 0x6f,
+  0x6e, 0x20, 0x45, 0x72, 0x72, 0x6f, 0x72, 0x27, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x7d, 0x29, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f,
+  0x6e, 0x20, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x52, 0x61, 0x6e, 0x67, 0x65, 0x56, 0x61, 0x6c,
+  0x75, 0x65, 0x28, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x2c,
+  0x20, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x69, 0x66,
+  0x20, 0x28, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x29, 0x20,
+  0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x45,
+  0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x74, 0x65, 0x78, 0x74, 0x43, 0x6f, 0x6e, 0x74, 0x65,
+  0x6e, 0x74, 0x20, 0x3d, 0x20, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e,
+  0x74, 0x2e, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x7d, 0x0a, 0x7d,
+  0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x53, 0x79, 0x73, 0x74, 0x65, 0x6d, 0x20, 0x66, 0x75, 0x6e, 0x63,
+  0x74, 0x69, 0x6f, 0x6e, 0x73, 0x0a, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x63,
+  0x6c, 0x65, 0x61, 0x72, 0x53, 0x65, 0x74, 0x74, 0x69, 0x6e, 0x67, 0x73, 0x28, 0x29, 0x20, 0x7b,
+  0x0a, 0x20, 0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 0x28, 0x63, 0x6f, 0x6e, 0x66, 0x69, 0x72, 0x6d,
+  0x28, 0x27, 0x43, 0x6c, 0x65, 0x61, 0x72, 0x20, 0x61, 0x6c, 0x6c, 0x20, 0x73, 0x61, 0x76, 0x65,
+  0x64, 0x20, 0x73, 0x65, 0x74, 0x74, 0x69, 0x6e, 0x67, 0x73, 0x20, 0x66, 0x72, 0x6f, 0x6d, 0x20,
+  0x6d, 0x65, 0x6d, 0x6f, 0x72, 0x79, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x72, 0x65, 0x62, 0x6f, 0x6f,
+  0x74, 0x3f, 0x27, 0x29, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x66, 0x65, 0x74, 0x63, 0x68, 0x28, 0x27, 0x2f, 0x72, 0x65, 0x73, 0x65, 0x74, 0x27, 0x29, 0x2e,
+  0x74, 0x68, 0x65, 0x6e, 0x28, 0x72, 0x65, 0x73, 0x70, 0x6f, 0x6e, 0x73, 0x65, 0x20, 0x3d, 0x3e,
+  0x20, 0x72, 0x65, 0x73, 0x70, 0x6f, 0x6e, 0x73, 0x65, 0x2e, 0x74, 0x65, 0x78, 0x74, 0x28, 0x29,
+  0x29, 0x2e, 0x74, 0x68, 0x65, 0x6e, 0x28, 0x64, 0x61, 0x74, 0x61, 0x20, 0x3d, 0x3e, 0x20, 0x61,
+  0x6c, 0x65, 0x72, 0x74, 0x28, 0x64, 0x61, 0x74, 0x61, 0x29, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x20,
+  0x20, 0x7d, 0x0a, 0x7d, 0x0a, 0x0a, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x72,
+  0x65, 0x62, 0x6f, 0x6f, 0x74, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x28, 0x29, 0x20, 0x7b, 0x0a,
+  0x20, 0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 0x28, 0x63, 0x6f, 0x6e, 0x66, 0x69, 0x72, 0x6d, 0x28,
+  0x27, 0x52, 0x65, 0x62, 0x6f, 0x6f, 0x74, 0x20, 0x74, 0x68, 0x65, 0x20, 0x63, 0x61, 0x6d, 0x65,
+  0x72, 0x61, 0x3f, 0x20, 0x54, 0x68, 0x69, 0x73, 0x20, 0x77, 0x69, 0x6c, 0x6c, 0x20, 0x64, 0x69,
+  0x73, 0x63, 0x6f, 0x6e, 0x6e, 0x65, 0x63, 0x74, 0x20, 0x61, 0x6c, 0x6c, 0x20, 0x63, 0x6c, 0x69,
+  0x65, 0x6e, 0x74, 0x73, 0x2e, 0x27, 0x29, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x66, 0x65, 0x74, 0x63, 0x68, 0x28, 0x27, 0x2f, 0x72, 0x65, 0x62, 0x6f, 0x6f,
+  0x74, 0x27, 0x29, 0x2e, 0x74, 0x68, 0x65, 0x6e, 0x28, 0x72, 0x65, 0x73, 0x70, 0x6f, 0x6e, 0x73,
+  0x65, 0x20, 0x3d, 0x3e, 0x20, 0x72, 0x65, 0x73, 0x70, 0x6f, 0x6e, 0x73, 0x65, 0x2e, 0x74, 0x65,
+  0x78, 0x74, 0x28, 0x29, 0x29, 0x2e, 0x74, 0x68, 0x65, 0x6e, 0x28, 0x64, 0x61, 0x74, 0x61, 0x20,
+  0x3d, 0x3e, 0x20, 0x61, 0x6c, 0x65, 0x72, 0x74, 0x28, 0x64, 0x61, 0x74, 0x61, 0x29, 0x29, 0x3b,
+  0x0a, 0x20, 0x20, 0x20, 0x20, 0x7d, 0x0a, 0x7d, 0x0a, 0x0a, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65,
+  0x6e, 0x74, 0x2e, 0x71, 0x75, 0x65, 0x72, 0x79, 0x53, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x6f, 0x72,
+  0x41, 0x6c, 0x6c, 0x28, 0x27, 0x5b, 0x64, 0x61, 0x74, 0x61, 0x2d, 0x76, 0x61, 0x6c, 0x75, 0x65,
+  0x5d, 0x27, 0x29, 0x2e, 0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x28, 0x65, 0x6c, 0x20, 0x3d,
+  0x3e, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x64, 0x76,
+  0x20, 0x3d, 0x20, 0x65, 0x6c, 0x2e, 0x67, 0x65, 0x74, 0x41, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75,
+  0x74, 0x65, 0x28, 0x27, 0x64, 0x61, 0x74, 0x61, 0x2d, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x27, 0x29,
+  0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 0x28, 0x64, 0x76, 0x20, 0x3d, 0x3d, 0x20,
+  0x6e, 0x75, 0x6c, 0x6c, 0x29, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b, 0x0a, 0x20, 0x20,
+  0x20, 0x20, 0x69, 0x66, 0x20, 0x28, 0x65, 0x6c, 0x2e, 0x74, 0x79, 0x70, 0x65, 0x20, 0x3d, 0x3d,
+  0x3d, 0x20, 0x27, 0x63, 0x68, 0x65, 0x63, 0x6b, 0x62, 0x6f, 0x78, 0x27, 0x29, 0x20, 0x7b, 0x0a,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x65, 0x6c, 0x2e, 0x63, 0x68, 0x65, 0x63, 0x6b,
+  0x65, 0x64, 0x20, 0x3d, 0x20, 0x28, 0x64, 0x76, 0x20, 0x3d, 0x3d, 0x3d, 0x20, 0x27, 0x31, 0x27,
+  0x29, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x7d, 0x20, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x69, 0x66,
+  0x20, 0x28, 0x65, 0x6c, 0x2e, 0x74, 0x61, 0x67, 0x4e, 0x61, 0x6d, 0x65, 0x20, 0x3d, 0x3d, 0x3d,
+  0x20, 0x27, 0x53, 0x45, 0x4c, 0x45, 0x43, 0x54, 0x27, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x65, 0x6c, 0x2e, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x20, 0x3d, 0x20,
+  0x64, 0x76, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x7d, 0x20, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x69,
+  0x66, 0x20, 0x28, 0x65, 0x6c, 0x2e, 0x74, 0x79, 0x70, 0x65, 0x20, 0x3d, 0x3d, 0x3d, 0x20, 0x27,
+  0x72, 0x61, 0x6e, 0x67, 0x65, 0x27, 0x20, 0x7c, 0x7c, 0x20, 0x65, 0x6c, 0x2e, 0x74, 0x61, 0x67,
+  0x4e, 0x61, 0x6d, 0x65, 0x20, 0x3d, 0x3d, 0x3d, 0x20, 0x27, 0x49, 0x4e, 0x50, 0x55, 0x54, 0x27,
+  0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x2f, 0x2f, 0x20, 0x66,
+  0x61, 0x6c, 0x6c, 0x62, 0x61, 0x63, 0x6b, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x69, 0x6e, 0x70, 0x75,
+  0x74, 0x73, 0x20, 0x74, 0x68, 0x61, 0x74, 0x20, 0x61, 0x6c, 0x73, 0x6f, 0x20, 0x63, 0x61, 0x72,
+  0x72, 0x79, 0x20, 0x64, 0x61, 0x74, 0x61, 0x2d, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x0a, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x65, 0x6c, 0x2e, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x20, 0x3d,
+  0x20, 0x64, 0x76, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x7d, 0x0a, 0x7d, 0x29, 0x3b, 0x0a, 0x0a,
+  0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x71, 0x75, 0x65, 0x72, 0x79, 0x53, 0x65,
+  0x6c, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x41, 0x6c, 0x6c, 0x28, 0x27, 0x69, 0x6e, 0x70, 0x75, 0x74,
+  0x5b, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x22, 0x5d, 0x27, 0x29,
+  0x2e, 0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x28, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x20, 0x3d,
+  0x3e, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x52, 0x61,
+  0x6e, 0x67, 0x65, 0x56, 0x61, 0x6c, 0x75, 0x65, 0x28, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x29, 0x3b,
+  0x0a, 0x20, 0x20, 0x20, 0x20, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x2e, 0x61, 0x64, 0x64, 0x45, 0x76,
+  0x65, 0x6e, 0x74, 0x4c, 0x69, 0x73, 0x74, 0x65, 0x6e, 0x65, 0x72, 0x28, 0x27, 0x69, 0x6e, 0x70,
+  0x75, 0x74, 0x27, 0x2c, 0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x29, 0x20,
+  0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65,
+  0x52, 0x61, 0x6e, 0x67, 0x65, 0x56, 0x61, 0x6c, 0x75, 0x65, 0x28, 0x74, 0x68, 0x69, 0x73, 0x29,
+  0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x7d, 0x29, 0x3b, 0x0a, 0x7d, 0x29, 0x3b, 0x0a,
+};
+static const uint8_t asset1Gzip[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x54, 0x4d, 0x4f, 0xdc, 0x30,
+  0x10, 0xbd, 0xe7, 0x57, 0x8c, 0x38, 0xd4, 0x09, 0x85, 0x5d, 0xb5, 0xbd, 0x15, 0x6d, 0x11, 0x5d,
+  0xe5, 0x40, 0x45, 0x11, 0x22, 0xd0, 0x0b, 0xea, 0xc1, 0xeb, 0x4c, 0x76, 0x23, 0x1c, 0x7b, 0x6b,
+  0x3b, 0x29, 0x2b, 0xd8, 0xff, 0xde, 0xb1, 0xf3, 0xb1, 0x61, 0xf9, 0x38, 0xd5, 0x52, 0x24, 0xc7,
+  0xf3, 0xf2, 0xe6, 0xcd, 0xbc, 0x71, 0xa6, 0x87, 0x90, 0x66, 0x57, 0x5f, 0x3e, 0x1f, 0xcf, 0xcf,
+  0x7e, 0xc2, 0x5c, 0x2b, 0x67, 0xb4, 0x84, 0x2b, 0xae, 0x50, 0xc2, 0x0f, 0xde, 0xf0, 0x4c, 0x98,
+  0x72, 0xed, 0xe0, 0x70, 0x1a, 0x45, 0xd3, 0xe9, 0x10, 0x2f, 0x6a, 0x25, 0x5c, 0xa9, 0x95, 0x8d,
+  0xfa, 0x1d, 0x58, 0x74, 0x5d, 0x34, 0x6e, 0xb8, 0x29, 0xf9, 0x42, 0xe2, 0x11, 0x34, 0x5c, 0xd6,
+  0x98, 0xc0, 0x63, 0x04, 0xb4, 0x0a, 0x74, 0x62, 0x15, 0xb3, 0xa9, 0x68, 0x61, 0xa7, 0x04, 0x9b,
+  0x31, 0xf8, 0x08, 0xa8, 0x84, 0xce, 0xf1, 0xf6, 0xfa, 0x7c, 0xae, 0xab, 0xb5, 0x56, 0xa8, 0xdc,
+  0xc0, 0x90, 0x50, 0x98, 0x7d, 0x20, 0x96, 0xb7, 0x81, 0x3e, 0x41, 0x12, 0xf8, 0xfd, 0x9a, 0xb8,
+  0x15, 0xaa, 0xd8, 0xc0, 0xec, 0x1b, 0x98, 0x89, 0xc3, 0x07, 0x17, 0xbf, 0x08, 0xc6, 0x89, 0x8f,
+  0x3e, 0x6e, 0x47, 0xe7, 0x82, 0x7b, 0x65, 0x5d, 0x60, 0x38, 0xf6, 0x2b, 0xd7, 0xa2, 0xae, 0x28,
+  0xd1, 0x64, 0x89, 0x2e, 0x95, 0xe8, 0xb7, 0xdf, 0x37, 0xe7, 0x79, 0xcc, 0xac, 0xe3, 0xae, 0xb6,
+  0x2c, 0x09, 0x49, 0x7c, 0xe1, 0x14, 0x81, 0x19, 0xb0, 0x2c, 0x9c, 0x7f, 0xf5, 0x9d, 0x52, 0xd8,
+  0x76, 0x26, 0x35, 0x46, 0x1b, 0x76, 0x32, 0xf0, 0x6e, 0x93, 0x93, 0x68, 0x1b, 0xed, 0x3a, 0x57,
+  0xaf, 0x73, 0xee, 0xf0, 0x9a, 0xab, 0x25, 0xfe, 0xf2, 0xe5, 0xb4, 0x45, 0x75, 0xd9, 0xf6, 0x7a,
+  0x58, 0x16, 0xf0, 0x2c, 0x9c, 0x8c, 0xf4, 0x8e, 0xcf, 0xf7, 0x64, 0x3d, 0x0b, 0x85, 0x97, 0x56,
+  0xce, 0xd6, 0x0b, 0x21, 0x5f, 0xb3, 0x8d, 0x75, 0x58, 0xbd, 0x66, 0xab, 0x90, 0xc8, 0x4d, 0x86,
+  0xce, 0x95, 0x6a, 0x69, 0xe3, 0xb1, 0x0c, 0xb2, 0xb1, 0x28, 0x4d, 0x15, 0xb3, 0xb9, 0x87, 0x00,
+  0x97, 0x12, 0x2c, 0x6f, 0x30, 0xf7, 0x93, 0x10, 0xd0, 0x50, 0x18, 0x5d, 0x41, 0x85, 0x95, 0x36,
+  0x1b, 0xe0, 0x2a, 0x07, 0x83, 0x0b, 0xad, 0xdd, 0x29, 0x4b, 0xc6, 0xaa, 0xfb, 0xa9, 0x30, 0x48,
+  0xdf, 0xf9, 0x7e, 0x06, 0x03, 0xd1, 0x92, 0xc1, 0x16, 0x83, 0x8f, 0xdd, 0xbe, 0xb7, 0xb3, 0x45,
+  0x50, 0xcb, 0xb8, 0x8f, 0x72, 0x89, 0xc6, 0x85, 0xb7, 0x24, 0x19, 0xd5, 0x34, 0xe8, 0x6f, 0x73,
+  0xce, 0x79, 0x85, 0x86, 0xbf, 0x2e, 0xff, 0x3a, 0x20, 0x80, 0x58, 0x41, 0x04, 0xd8, 0x29, 0xdc,
+  0xac, 0x4a, 0x0b, 0x7f, 0x4b, 0xaa, 0x28, 0x2f, 0xad, 0x68, 0x9d, 0x0c, 0x05, 0x0a, 0x59, 0x52,
+  0x07, 0xed, 0xe4, 0xad, 0x12, 0x3c, 0xd3, 0x7f, 0xab, 0x61, 0x98, 0xbd, 0x3f, 0x35, 0x9a, 0x4d,
+  0x86, 0x92, 0x54, 0x68, 0x73, 0x26, 0x65, 0xcc, 0xee, 0x3c, 0xf8, 0x38, 0x18, 0xf9, 0x9b, 0xf2,
+  0x15, 0xda, 0xa4, 0x9c, 0x24, 0xd0, 0x9d, 0x1d, 0x26, 0x98, 0x64, 0x5b, 0x07, 0x79, 0x43, 0xee,
+  0xa3, 0xf4, 0xe3, 0x7b, 0xe6, 0x9c, 0x29, 0x17, 0xb5, 0xc3, 0x98, 0xed, 0xbe, 0x66, 0x5d, 0x42,
+  0xdf, 0x11, 0x8f, 0x9d, 0x81, 0xaa, 0xa5, 0x4c, 0x48, 0xb0, 0xab, 0x8d, 0xda, 0xc5, 0x88, 0xc2,
+  0x6d, 0xd6, 0x54, 0x0b, 0x21, 0x98, 0x58, 0xa1, 0xb8, 0x5f, 0xe8, 0x07, 0x36, 0x6e, 0x02, 0x21,
+  0xc2, 0x39, 0x0d, 0xc0, 0xac, 0xe3, 0x22, 0xe8, 0xa7, 0x3e, 0xc1, 0x96, 0x00, 0xd4, 0x8b, 0x9e,
+  0x8b, 0x2f, 0x2f, 0xa9, 0xd7, 0x2d, 0x26, 0x4b, 0x2f, 0xd2, 0xf9, 0xcd, 0x3e, 0x59, 0x90, 0x47,
+  0x54, 0x79, 0xf3, 0x2a, 0xc1, 0x20, 0xc6, 0xf8, 0x7b, 0xc3, 0xe0, 0xe9, 0x09, 0xf6, 0x79, 0xcf,
+  0x2f, 0xaf, 0x6e, 0x9f, 0xd3, 0xd2, 0xa4, 0x17, 0x64, 0xe3, 0x82, 0x8b, 0x7b, 0xa0, 0x9e, 0x41,
+  0xa9, 0xd6, 0xb5, 0xb3, 0x64, 0x3d, 0xf7, 0xf6, 0x5a, 0x4d, 0x03, 0x60, 0x68, 0x56, 0x77, 0xed,
+  0x79, 0x57, 0x50, 0xe4, 0x2f, 0xf2, 0x7b, 0x2e, 0x05, 0xfa, 0x3b, 0x2f, 0x75, 0x76, 0x10, 0x64,
+  0x1e, 0x8c, 0xcd, 0x0a, 0xd1, 0x9d, 0x5f, 0x2f, 0xfe, 0x02, 0x21, 0xde, 0xdb, 0xe3, 0xf7, 0x13,
+  0x9e, 0xe7, 0x69, 0x43, 0xa9, 0x2e, 0x4a, 0xba, 0xad, 0x0a, 0x4d, 0x97, 0x81, 0x1d, 0x0d, 0x17,
+  0x37, 0x1e, 0x57, 0xfb, 0x82, 0xd1, 0xd1, 0x58, 0xf7, 0x76, 0xf8, 0x7f, 0x10, 0x3d, 0xff, 0x00,
+  0x7b, 0x56, 0x11, 0x05, 0xfe, 0x05, 0x00, 0x00,
+};
+static const uint8_t asset2Data[] PROGMEM = {
+  0x2f, 0x2a, 0x20, 0x45, 0x53, 0x50, 0x33, 0x32, 0x2d, 0x43, 0x41, 0x4d, 0x20, 0x53, 0x74, 0x61,
+  0x74, 0x75, 0x73, 0x20, 0x55, 0x70, 0x64, 0x61, 0x74, 0x65, 0x73, 0x20, 0x2a, 0x2f, 0x0a, 0x0a,
+  0x2f, 0x2f, 0x20, 0x47, 0x6c, 0x6f, 0x62, 0x61, 0x6c, 0x20, 0x76, 0x61, 0x72, 0x69, 0x61, 0x62,
+  0x6c, 0x65, 0x73, 0x0a, 0x6c, 0x65, 0x74, 0x20, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x55, 0x70,
+  0x64, 0x61, 0x74, 0x65, 0x54, 0x69, 0x6d, 0x65, 0x6f, 0x75, 0x74, 0x20, 0x3d, 0x20, 0x6e, 0x75,
+  0x6c, 0x6c, 0x3b, 0x0a, 0x0a, 0x0a, 0x2f, 0x2f, 0x20, 0x53, 0x74, 0x61, 0x74, 0x75, 0x73, 0x20,
+  0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x0a,
+  0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x53,
+  0x74, 0x61, 0x74, 0x75, 0x73, 0x28, 0x29, 0x20, 0x7b, 0x0a, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66,
+  0x65, 0x74, 0x63, 0x68, 0x28, 0x27, 0x2f, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x27, 0x29, 0x0a,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x2e, 0x74, 0x68, 0x65, 0x6e, 0x28, 0x72, 0x20,
+  0x3d, 0x3e, 0x20, 0x72, 0x2e, 0x6a, 0x73, 0x6f, 0x6e, 0x28, 0x29, 0x29, 0x0a, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x2e, 0x74, 0x68, 0x65, 0x6e, 0x28, 0x64, 0x20, 0x3d, 0x3e, 0x20,
+  0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x63, 0x6f,
+  0x6e, 0x73, 0x74, 0x20, 0x72, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x3d,
+  0x20, 0x64, 0x2e, 0x63, 0x75, 0x72, 0x72, 0x65, 0x6e, 0x74, 0x57, 0x69, 0x64, 0x74, 0x68, 0x20,
+  0x26, 0x26, 0x20, 0x64, 0x2e, 0x63, 0x75, 0x72, 0x72, 0x65, 0x6e, 0x74, 0x48, 0x65, 0x69, 0x67,
+  0x68, 0x74, 0x20, 0x3f, 0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x27, 0x20, 0x7c, 0x20, 0x52, 0x65, 0x73, 0x6f, 0x6c, 0x75,
+  0x74, 0x69, 0x6f, 0x6e, 0x3a, 0x20, 0x27, 0x20, 0x2b, 0x20, 0x64, 0x2e, 0x63, 0x75, 0x72, 0x72,
+  0x65, 0x6e, 0x74, 0x57, 0x69, 0x64, 0x74, 0x68, 0x20, 0x2b, 0x20, 0x27, 0x78, 0x27, 0x20, 0x2b,
+  0x20, 0x64, 0x2e, 0x63, 0x75, 0x72, 0x72, 0x65, 0x6e, 0x74, 0x48, 0x65, 0x69, 0x67, 0x68, 0x74,
+  0x20, 0x3a, 0x20, 0x27, 0x27, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x67, 0x65, 0x74, 0x45, 0x6c, 0x65, 0x6d,
+  0x65, 0x6e, 0x74, 0x42, 0x79, 0x49, 0x64, 0x28, 0x27, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x27,
+  0x29, 0x2e, 0x74, 0x65, 0x78, 0x74, 0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x20, 0x3d, 0x20,
+  0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x27, 0x43, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x20, 0x46, 0x50, 0x53, 0x3a, 0x20, 0x27, 0x20,
+  0x2b, 0x20, 0x64, 0x2e, 0x63, 0x61, 0x6d, 0x65, 0x72, 0x61, 0x46, 0x50, 0x53, 0x20, 0x2b, 0x20,
+  0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x27, 0x20, 0x7c, 0x20, 0x46, 0x72, 0x61, 0x6d, 0x65, 0x3a, 0x20, 0x27, 0x20, 0x2b, 0x20,
+  0x64, 0x2e, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x53, 0x69, 0x7a, 0x65, 0x20, 0x2b, 0x20, 0x27, 0x4b,
+  0x42, 0x27, 0x20, 0x2b, 0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x27, 0x20, 0x7c, 0x20, 0x54, 0x43, 0x50, 0x3a, 0x20, 0x27,
+  0x20, 0x2b, 0x20, 0x64, 0x2e, 0x63, 0x6c, 0x69, 0x65, 0x6e, 0x74, 0x73, 0x20, 0x2b, 0x20, 0x0a,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x27, 0x20, 0x7c, 0x20, 0x57, 0x69, 0x46, 0x69, 0x3a, 0x20, 0x27, 0x20, 0x2b, 0x20, 0x64, 0x2e,
+  0x77, 0x69, 0x66, 0x69, 0x52, 0x53, 0x53, 0x49, 0x20, 0x2b, 0x20, 0x27, 0x64, 0x42, 0x6d, 0x20,
+  0x43, 0x68, 0x27, 0x20, 0x2b, 0x20, 0x64, 0x2e, 0x77, 0x69, 0x66, 0x69, 0x43, 0x68, 0x61, 0x6e,
+  0x6e, 0x65, 0x6c, 0x20, 0x2b, 0x20, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x27, 0x20, 0x27, 0x20, 0x2b, 0x20, 0x64, 0x2e, 0x77,
+  0x69, 0x66, 0x69, 0x50, 0x48, 0x59, 0x20, 0x2b, 0x20, 0x72, 0x65, 0x73, 0x6f, 0x6c, 0x75, 0x74,
+  0x69, 0x6f, 0x6e, 0x3b, 0x0a, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x53, 0x74, 0x61, 0x74, 0x75, 0x73, 0x4c, 0x6f,
+  0x6f, 0x70, 0x28, 0x29, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x7d, 0x29, 0x0a,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x2e, 0x63, 0x61, 0x74, 0x63, 0x68, 0x28, 0x65,
+  0x20, 0x3d, 0x3e, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x67, 0x65, 0x74, 0x45, 0x6c,
+  0x65, 0x6d, 0x65, 0x6e, 0x74, 0x42, 0x79, 0x49, 0x64, 0x28, 0x27, 0x73, 0x74, 0x61, 0x74, 0x75,
+  0x73, 0x27, 0x29, 0x2e, 0x74, 0x65, 0x78, 0x74, 0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x20,
+  0x3d, 0x20, 0x27, 0x53, 0x74, 0x61, 0x74, 0x75, 0x73, 0x3a, 0x20, 0x43, 0x6f, 0x6e, 0x6e, 0x65,
+  0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x45, 0x72, 0x72, 0x6f, 0x72, 0x27, 0x3b, 0x0a, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65,
+  0x53, 0x74, 0x61, 0x74, 0x75, 0x73, 0x4c, 0x6f, 0x6f, 0x70, 0x28, 0x29, 0x0a, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x7d, 0x29, 0x3b, 0x0a, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x75,
+  0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x53, 0x74, 0x61,
+  0x74, 0x75, 0x73, 0x4c, 0x6f, 0x6f, 0x70, 0x28, 0x29, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20,
+  0x20, 0x20, 0x20, 0x20, 0x69, 0x66, 0x20, 0x28, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x55, 0x70,
+  0x64, 0x61, 0x74, 0x65, 0x54, 0x69, 0x6d, 0x65, 0x6f, 0x75, 0x74, 0x29, 0x20, 0x63, 0x6c, 0x65,
+  0x61, 0x72, 0x54, 0x69, 0x6d, 0x65, 0x6f, 0x75, 0x74, 0x28, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73,
+  0x55, 0x70, 0x64, 0x61, 0x74, 0x65, 0x54, 0x69, 0x6d, 0x65, 0x6f, 0x75, 0x74, 0x29, 0x3b, 0x0a,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x73, 0x74, 0x61, 0x74, 0x75, 0x73, 0x55, 0x70,
+  0x64, 0x61, 0x74, 0x65, 0x54, 0x69, 0x6d, 0x65, 0x6f, 0x75, 0x74, 0x20, 0x3d, 0x20, 0x73, 0x65,
+  0x74, 0x54, 0x69, 0x6d, 0x65, 0x6f, 0x75, 0x74, 0x28, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x53,
+  0x74, 0x61, 0x74, 0x75, 0x73, 0x2c, 0x20, 0x35, 0x30, 0x30, 0x30, 0x29, 0x3b, 0x0a, 0x20, 0x20,
+  0x20, 0x20, 0x7d, 0x0a, 0x7d, 0x0a, 0x0a, 0x73, 0x65, 0x74, 0x54, 0x69, 0x6d, 0x65, 0x6f, 0x75,
+  0x74, 0x28, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x53, 0x74, 0x61, 0x74, 0x75, 0x73, 0x2c, 0x20,
+  0x31, 0x30, 0x30, 0x29, 0x3b, 0x0a, 0x0a,
+};
+static const uint8_t asset2Gzip[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x53, 0xdf, 0x6f, 0xd3, 0x30,
+  0x10, 0x7e, 0xf7, 0x5f, 0x71, 0x4f, 0x4b, 0xba, 0x41, 0x52, 0x40, 0x7b, 0x59, 0x55, 0x10, 0x8d,
+  0x5a, 0x36, 0x01, 0x52, 0xb5, 0x6c, 0x9a, 0x78, 0xf4, 0x92, 0xcb, 0x62, 0xe4, 0xda, 0x93, 0x7d,
+  0x81, 0xc1, 0xe8, 0xff, 0x8e, 0x9d, 0x1f, 0x4d, 0xd3, 0xa5, 0x48, 0xdc, 0x93, 0xef, 0xbb, 0xef,
+  0x3e, 0x7f, 0xb6, 0xcf, 0xf1, 0x29, 0x2c, 0xd3, 0xf5, 0xbb, 0xb7, 0xaf, 0x93, 0x8f, 0x5f, 0x21,
+  0x25, 0x4e, 0x95, 0x85, 0xdb, 0xc7, 0x9c, 0x13, 0x5a, 0x38, 0x8d, 0x19, 0x8b, 0x63, 0xf8, 0x24,
+  0xf5, 0x3d, 0x97, 0xf0, 0x83, 0x1b, 0xc1, 0xef, 0x25, 0x5a, 0x26, 0x91, 0xc0, 0xd6, 0xd4, 0x86,
+  0x79, 0x23, 0x36, 0xa8, 0x2b, 0x82, 0x39, 0xa8, 0x4a, 0xca, 0x19, 0xab, 0xbb, 0x5a, 0xad, 0xaa,
+  0x66, 0x40, 0x51, 0xa9, 0x8c, 0x84, 0x56, 0xac, 0x5b, 0xb4, 0x85, 0x86, 0x15, 0x4e, 0xe0, 0x99,
+  0x31, 0x70, 0x51, 0x20, 0x65, 0x65, 0x18, 0xc4, 0x8d, 0x7c, 0x30, 0xa9, 0x41, 0x1f, 0x11, 0x95,
+  0xa8, 0x42, 0x03, 0xf3, 0xf7, 0x60, 0xa2, 0xef, 0x56, 0xab, 0x70, 0x72, 0x58, 0xcc, 0x7d, 0xf1,
+  0x79, 0x07, 0xfa, 0xc8, 0xb4, 0xb2, 0x04, 0x06, 0xad, 0x96, 0x55, 0xbd, 0xeb, 0x1c, 0xf2, 0x28,
+  0xab, 0x8c, 0x41, 0x45, 0x77, 0x22, 0xa7, 0x12, 0x4e, 0x4e, 0x7a, 0xe4, 0x12, 0xc5, 0x43, 0x49,
+  0xf0, 0x01, 0x06, 0x1a, 0x3e, 0x02, 0xf8, 0x03, 0xd7, 0x3b, 0x95, 0x0b, 0x97, 0x9f, 0x1d, 0x0a,
+  0x9d, 0x41, 0xf0, 0x34, 0x80, 0x5b, 0x35, 0x47, 0x0e, 0x66, 0x03, 0xc1, 0x41, 0x92, 0xeb, 0xac,
+  0xda, 0x38, 0x76, 0xf4, 0x80, 0xb4, 0x94, 0xe8, 0x97, 0x8b, 0x5f, 0x57, 0x79, 0x18, 0x74, 0x37,
+  0x10, 0x11, 0x3e, 0x51, 0xa2, 0x15, 0xb9, 0x8a, 0xb3, 0xff, 0xd2, 0x5a, 0xc2, 0x37, 0x68, 0x38,
+  0xac, 0xd6, 0xe9, 0xce, 0x57, 0x8d, 0x38, 0xc0, 0x65, 0xa3, 0x47, 0x59, 0x19, 0xc7, 0xe8, 0xd8,
+  0x85, 0x4f, 0x52, 0xf1, 0x1b, 0xfd, 0x11, 0x3e, 0x2f, 0x82, 0x63, 0x4d, 0x37, 0xc9, 0x7a, 0xb7,
+  0x81, 0x14, 0xce, 0x8d, 0x3d, 0xc6, 0xbc, 0x13, 0x2b, 0xd1, 0x51, 0x7f, 0x8a, 0x42, 0x5c, 0xa7,
+  0xe9, 0x95, 0x17, 0xcf, 0x17, 0x1b, 0x48, 0xca, 0x1e, 0x4f, 0x4a, 0xae, 0x14, 0xca, 0x71, 0x99,
+  0x9e, 0xb6, 0xbe, 0xfc, 0xe6, 0xd6, 0xfd, 0x23, 0xce, 0xd8, 0x80, 0xbe, 0x3f, 0x48, 0x5f, 0xb4,
+  0x7e, 0x0c, 0xfb, 0xb9, 0xd8, 0xee, 0x8d, 0x48, 0xc6, 0xfd, 0x64, 0xe1, 0xcb, 0x19, 0xf9, 0xdf,
+  0x17, 0x08, 0x9a, 0xad, 0x2e, 0xc0, 0x41, 0x0a, 0x9b, 0x61, 0x5e, 0x1a, 0xa3, 0xcd, 0xc1, 0x33,
+  0xff, 0xd3, 0x57, 0x7b, 0x86, 0xd1, 0xdf, 0xd0, 0x90, 0xf7, 0x5c, 0x8a, 0x02, 0xc2, 0x91, 0xff,
+  0x36, 0x81, 0x4c, 0x22, 0x37, 0x6d, 0x36, 0xca, 0xe8, 0x1d, 0x8d, 0xff, 0x57, 0x8b, 0xd4, 0xb5,
+  0xef, 0x3b, 0x78, 0x05, 0xe7, 0xd3, 0xe9, 0xb4, 0xed, 0xde, 0xb2, 0x2d, 0x63, 0x47, 0x89, 0x6f,
+  0x6a, 0x1e, 0xfb, 0x0b, 0xfb, 0xcd, 0xda, 0xb0, 0x47, 0x04, 0x00, 0x00,
+};
+
+static const httpAsset_t assetManifest[] = {
+  { "/css/main.css", "text/css", 0x67842ab2u, asset0Data, 3086, asset0Gzip, 990 },
+  { "/js/controls.js", "application/javascript", 0xe1babf40u, asset1Data, 1534, asset1Gzip, 664 },
+  { "/js/status.js", "application/javascript", 0x73a4b290u, asset2Data, 1095, asset2Gzip, 444 },
+};
+
+#define ASSET_COUNT  (sizeof(assetManifest) / sizeof(assetManifest[0]))
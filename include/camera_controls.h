@@ -0,0 +1,73 @@
+#pragma once
+#include <Arduino.h>
+#include "esp_camera.h"
+
+//  Camera controls: one descriptor per sensor setting, from the table below. /control dispatch
+//  and bounds, the settings store (NVS layout, keys of older firmware, defaults), the values the
+//  control page shows, settings applied at boot and /status are all driven by it; a control is
+//  added with one line here and its element in data/index.html.
+//  Names are found by a perfect hash: the seed is searched at compile time so that every name
+//  has a slot of its own, a lookup is one hash and one string compare.
+
+typedef enum {
+  CONTROL_RANGE = 0,    // slider
+  CONTROL_TOGGLE,       // checkbox, 0 or 1
+  CONTROL_SELECT,       // drop-down of the values min..max
+} cameraControlKind_t;
+
+//  X(ID, name, NVS key of older firmware, sensor_t setter, camera_status_t field, kind, min, max, default)
+//  The order is the layout of the settings blob in NVS: new controls go at the end
+#define CAMERA_CONTROLS(X) \
+  X(QUALITY,        "quality",        "q",    set_quality,        quality,        CONTROL_RANGE,   4,   63,  10) \
+  X(BRIGHTNESS,     "brightness",     "br",   set_brightness,     brightness,     CONTROL_RANGE,  -2,    2,   0) \
+  X(CONTRAST,       "contrast",       "ct",   set_contrast,       contrast,       CONTROL_RANGE,  -2,    2,   0) \
+  X(SATURATION,     "saturation",     "sa",   set_saturation,     saturation,     CONTROL_RANGE,  -2,    2,   0) \
+  X(GAINCEILING,    "gainceiling",    "gc",   set_gainceiling,    gainceiling,    CONTROL_SELECT,  0,    6,   0) \
+  X(COLORBAR,       "colorbar",       "cb",   set_colorbar,       colorbar,       CONTROL_TOGGLE,  0,    1,   0) \
+  X(AWB,            "awb",            "awb",  set_whitebal,       awb,            CONTROL_TOGGLE,  0,    1,   1) \
+  X(AGC,            "agc",            "agc",  set_gain_ctrl,      agc,            CONTROL_TOGGLE,  0,    1,   1) \
+  X(AEC,            "aec",            "aec",  set_exposure_ctrl,  aec,            CONTROL_TOGGLE,  0,    1,   1) \
+  X(HMIRROR,        "hmirror",        "hm",   set_hmirror,        hmirror,        CONTROL_TOGGLE,  0,    1,   0) \
+  X(VFLIP,          "vflip",          "vf",   set_vflip,          vflip,          CONTROL_TOGGLE,  0,    1,   0) \
+  X(AWB_GAIN,       "awb_gain",       "awbg", set_awb_gain,       awb_gain,       CONTROL_TOGGLE,  0,    1,   1) \
+  X(AGC_GAIN,       "agc_gain",       "agcg", set_agc_gain,       agc_gain,       CONTROL_RANGE,   0,   30,   0) \
+  X(AEC_VALUE,      "aec_value",      "aecv", set_aec_value,      aec_value,      CONTROL_RANGE,   0, 1200, 300) \
+  X(AEC2,           "aec2",           "aec2", set_aec2,           aec2,           CONTROL_TOGGLE,  0,    1,   0) \
+  X(DCW,            "dcw",            "dcw",  set_dcw,            dcw,            CONTROL_TOGGLE,  0,    1,   1) \
+  X(BPC,            "bpc",            "bpc",  set_bpc,            bpc,            CONTROL_TOGGLE,  0,    1,   0) \
+  X(WPC,            "wpc",            "wpc",  set_wpc,            wpc,            CONTROL_TOGGLE,  0,    1,   1) \
+  X(RAW_GMA,        "raw_gma",        "rg",   set_raw_gma,        raw_gma,        CONTROL_TOGGLE,  0,    1,   1) \
+  X(LENC,           "lenc",           "lenc", set_lenc,           lenc,           CONTROL_TOGGLE,  0,    1,   1) \
+  X(SPECIAL_EFFECT, "special_effect", "se",   set_special_effect, special_effect, CONTROL_SELECT,  0,    6,   0) \
+  X(WB_MODE,        "wb_mode",        "wb",   set_wb_mode,        wb_mode,        CONTROL_SELECT,  0,    4,   0) \
+  X(AE_LEVEL,       "ae_level",       "ael",  set_ae_level,       ae_level,       CONTROL_RANGE,  -2,    2,   0)
+
+#define CAMERA_CONTROL_ID(id, name, key, setter, field, kind, lo, hi, def)  CAMERA_SETTING_##id,
+typedef enum {
+  CAMERA_CONTROLS(CAMERA_CONTROL_ID)
+  CAMERA_SETTINGS
+} cameraSetting_t;
+#undef CAMERA_CONTROL_ID
+
+typedef struct {
+  const char*           name;     // /control?var= and the id of the page element
+  const char*           key;      // NVS key older firmware kept the setting under
+  int                   (*set)(sensor_t* s, int aValue);
+  int                   (*get)(const sensor_t* s);
+  cameraSetting_t       setting;  // index in cameraControls and the settings blob
+  cameraControlKind_t   kind;
+  int16_t               min;
+  int16_t               max;
+  int16_t               def;
+} cameraControl_t;
+
+extern const cameraControl_t cameraControls[CAMERA_SETTINGS];
+
+// Control named aName, NULL if there is none
+const cameraControl_t*  cameraControlFind(const char* aName);
+// Whether aValue is within the range of the control
+inline bool             cameraControlValid(const cameraControl_t* aControl, int32_t aValue) {
+  return aValue >= aControl->min && aValue <= aControl->max;
+}
+// Apply the settings the user changed to the sensor (boot)
+void                    cameraControlsApply(sensor_t* s);
@@ -0,0 +1,53 @@
+#pragma once
+#include <Arduino.h>
+#include "camera_controls.h"
+
+//  Camera settings the user changed, persisted in NVS as one versioned blob. A change is applied
+//  to the sensor at once and only marked here; the blob is written once the settings have been
+//  quiet for CAMERA_SETTINGS_SAVE_MS, so a slider drag costs one flash write instead of one per
+//  step. The web server task is the only one that changes or saves settings.
+
+// NVS namespace and key of the blob. Older firmware kept one key per setting in the same namespace
+#define CAMERA_SETTINGS_NAMESPACE   "cam"
+#define CAMERA_SETTINGS_KEY         "settings"
+#define CAMERA_SETTINGS_VERSION     1
+
+// Quiet period after the last change before the blob is written, ms
+#ifndef CAMERA_SETTINGS_SAVE_MS
+#define CAMERA_SETTINGS_SAVE_MS     2000
+#endif
+
+// Longest a change waits while settings keep changing, ms
+#ifndef CAMERA_SETTINGS_SAVE_MAX_MS
+#define CAMERA_SETTINGS_SAVE_MAX_MS 10000
+#endif
+
+typedef struct {
+  uint16_t  version;                  // CAMERA_SETTINGS_VERSION
+  uint16_t  count;                    // values that follow, a blob with fewer is still read
+  uint32_t  stored;                   // bit per setting the user changed, applied at boot
+  int16_t   value[CAMERA_SETTINGS];   // in the order of CAMERA_CONTROLS
+} cameraSettingsBlob_t;
+
+typedef struct {
+  uint32_t  changes;    // settings changed through cameraSettingsSet()
+  uint32_t  saves;      // blobs written
+  uint32_t  failures;   // blobs that could not be written
+} cameraSettingsStats_t;
+
+extern cameraSettingsStats_t cameraSettingsStats;
+
+// Read the blob, or migrate the per-setting keys of older firmware into one. Call once at boot
+void    cameraSettingsLoad();
+// True with the value in aValue if the user changed the setting
+bool    cameraSettingsStored(cameraSetting_t aSetting, int32_t* aValue);
+// Value the user set, or the default
+int32_t cameraSettingsGet(cameraSetting_t aSetting);
+// Record a change already applied to the sensor; it is saved by cameraSettingsTick()
+void    cameraSettingsSet(cameraSetting_t aSetting, int32_t aValue, uint32_t aNow);
+// Write the blob once the settings have been quiet long enough. Returns true if it did
+bool    cameraSettingsTick(uint32_t aNow);
+// Write pending changes now (before a reboot)
+bool    cameraSettingsFlush();
+// Forget every setting, in NVS and pending ones
+void    cameraSettingsClear();
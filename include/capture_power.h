@@ -0,0 +1,47 @@
+#pragma once
+#include <Arduino.h>
+
+//  Capture power states. With clients connected the camera task streams. When the last one
+//  leaves the sensor stays warm - running, but no frame is copied or published - so a client
+//  arriving shortly after gets a converged frame at once. After CAPTURE_WARM_MS without clients
+//  the sensor goes into standby (PWDN) and the camera task blocks until the next connect.
+//  The state machine only decides; the camera task applies the transitions to the hardware.
+
+// How long the sensor stays warm after the last client disconnects
+#ifndef CAPTURE_WARM_MS
+#define CAPTURE_WARM_MS         30000
+#endif
+
+// Frames thrown away after standby while exposure and white balance settle
+#ifndef CAPTURE_WAKE_SKIP
+#define CAPTURE_WAKE_SKIP       2
+#endif
+
+typedef enum {
+  CAPTURE_IDLE = 0,   // sensor in standby, camera task blocked
+  CAPTURE_WARM,       // sensor running, nothing published
+  CAPTURE_STREAMING,  // frames published to clients
+} captureState_t;
+
+typedef struct {
+  captureState_t  state;
+  uint8_t         clients;
+  uint32_t        since;      // millis() when the current state was entered
+  uint32_t        wakeAt;     // millis() of a connect that found no stream running, 0 = none
+  captureState_t  wakeFrom;   // state that connect found: idle or warm
+  uint32_t        sleeps;     // transitions into standby
+  uint32_t        wakes;      // transitions out of standby
+  uint32_t        ttffCold;   // connect-to-first-frame from standby, ms, last one
+  uint32_t        ttffWarm;   // connect-to-first-frame from warm, ms, last one
+  uint32_t        ttffColdMax;
+  uint32_t        ttffWarmMax;
+} capturePower_t;
+
+extern capturePower_t capturePower;
+
+void            capturePowerInit(uint32_t aNow);
+captureState_t  capturePowerConnect(uint32_t aNow);
+void            capturePowerDisconnect(uint32_t aNow);
+captureState_t  capturePowerTick(uint32_t aNow);
+void            capturePowerFrame(uint32_t aNow);
+const char*     capturePowerName(captureState_t aState);
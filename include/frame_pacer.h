@@ -0,0 +1,22 @@
+#pragma once
+#include <Arduino.h>
+
+//  Token-bucket pacing of a client's frame rate below the camera rate.
+//  Credit accrues with time at the target rate; a frame costs one interval of credit. The bucket
+//  holds one and a half frames, so the remainder of a late frame carries over (no drift below the
+//  target) without ever letting two frames out back to back.
+
+typedef struct {
+  uint32_t  interval;  // microseconds per frame, 0 = no pacing
+  uint32_t  own;       // interval the client asked for
+  int64_t   credit;    // microseconds of accrued credit
+  int64_t   last;      // time of the last refill, microseconds
+} framePacer_t;
+
+void      framePacerInit(framePacer_t* aPacer, float aFps, int64_t aNow);
+bool      framePacerTake(framePacer_t* aPacer, int64_t aNow);
+// Gives back the credit of the last take, when the frame could not be had after all
+void      framePacerRefund(framePacer_t* aPacer);
+uint32_t  framePacerDelayMs(const framePacer_t* aPacer, int64_t aNow);
+// Hold the pacer to at most aFps on top of its own rate, 0 = its own rate again
+void      framePacerCap(framePacer_t* aPacer, float aFps);
@@ -0,0 +1,104 @@
+#pragma once
+#include <Arduino.h>
+#include "esp_camera.h"
+#include "multipart.h"
+#include "mem_pool.h"
+
+// Number of frame slots in the ring. One slot is always being filled by the camera,
+// one is the current (published) frame, the rest can be held by slow clients.
+// A client holds at most one frame, so with a slot per client publishing never runs out
+#ifndef FRAME_RING_SLOTS
+#if defined(MAX_CLIENTS)
+#define FRAME_RING_SLOTS  (MAX_CLIENTS + 2)
+#else
+#define FRAME_RING_SLOTS  4
+#endif
+#endif
+
+// Bytes of a slot's own frame buffer, taken from a pool carved out of PSRAM at init.
+// 0: the largest JPEG of the sensor's frame size - the size of the driver's own buffers
+#ifndef FRAME_SLOT_SIZE
+#define FRAME_SLOT_SIZE   0
+#endif
+
+// Number of frame buffers the camera driver owns (camera_config_t.fb_count)
+#ifndef CAMERA_FB_COUNT
+#define CAMERA_FB_COUNT   3
+#endif
+
+// Zero-copy mode: at most this many driver frame buffers are kept by the ring, the driver
+// needs the rest to keep capturing. Beyond that frames are copied and returned at once
+#ifndef FRAME_FB_HOLD_MAX
+#define FRAME_FB_HOLD_MAX (CAMERA_FB_COUNT - 1)
+#endif
+
+// Tasks that can be notified when a frame is published (streaming tasks, dispatcher)
+#ifndef FRAME_WAITERS_MAX
+#if defined(MAX_CLIENTS)
+#define FRAME_WAITERS_MAX (MAX_CLIENTS + 1)
+#else
+#define FRAME_WAITERS_MAX 12
+#endif
+#endif
+
+// Longest a streaming task blocks waiting for a frame before it checks its connection again
+#ifndef FRAME_WAIT_MS
+#define FRAME_WAIT_MS     1000
+#endif
+
+typedef struct {
+  uint8_t   cnt;  // served to clients counter. slot could be reused when 0 and it is not the current frame
+  void*     nxt;  // next chunck
+  uint32_t  fnm;  // frame number
+  uint32_t  siz;  // frame size
+  uint8_t*  dat;  // frame pointer: either buf or the camera frame buffer
+  uint8_t*  buf;  // slot's own copy of the frame
+  uint32_t  cap;  // allocated size of buf
+  camera_fb_t* fb;  // camera frame buffer sent without copying, returned when the slot is freed
+  struct timeval tsp;  // capture time
+  int64_t   cus;  // capture time, esp_timer microseconds
+  int64_t   pus;  // publish time, esp_timer microseconds
+  uint8_t   hln;  // part header length
+  char      hdr[PART_HEADER_MAX];  // part header rendered once on publish, shared by every client
+} frameChunck_t;
+
+typedef struct {
+  uint32_t  published;  // frames made current
+  uint32_t  overruns;   // frames dropped because every slot was held by clients or no buffer was left
+  uint32_t  oversize;   // frames dropped because they are larger than a slot buffer
+  uint32_t  copies;     // frame copies into the ring
+  uint32_t  bytesCopied;  // bytes copied into the ring
+  uint32_t  zeroCopy;   // frames published straight from the camera frame buffer
+  uint32_t  notifies;   // frame-ready notifications sent to subscribed tasks
+  uint32_t  wakeups;    // times a task waiting in frameRingWait woke up, timeouts included
+  uint8_t   fbHeld;     // camera frame buffers currently kept by the ring
+} frameRingStats_t;
+
+// Camera frame buffer get/return, replaceable so the ring can run against other frame sources
+typedef struct {
+  camera_fb_t*  (*get)(void);
+  void          (*ret)(camera_fb_t* aFb);
+} frameSource_t;
+
+extern frameChunck_t*   fstFrame;       // first slot of the ring
+extern frameChunck_t*   curFrame;       // most recently published frame
+extern volatile uint32_t frameNumber;   // number of the most recently published frame
+extern frameRingStats_t frameRingStats;
+extern frameSource_t    frameSource;
+extern memPool_t        framePool;      // slot buffers
+
+bool            frameRingInit(uint8_t aSlots = FRAME_RING_SLOTS, size_t aSlotSize = FRAME_SLOT_SIZE);
+frameChunck_t*  frameRingReserve(size_t aSize);
+frameChunck_t*  frameRingAttach(camera_fb_t* aFb);
+void            frameRingPublish(frameChunck_t* aFrame);
+frameChunck_t*  frameRingAcquire(uint32_t aLastFrame);
+void            frameRingRelease(frameChunck_t* aFrame);
+void            frameRingClear(void);
+// Slots new frames go into, from 2 up to the slots of the ring (memory pressure)
+void            frameRingSetDepth(uint8_t aSlots);
+uint8_t         frameRingDepth(void);
+
+// Frame-ready notification: every publish notifies subscribed tasks with the new frame number
+bool            frameRingSubscribe(TaskHandle_t aTask);
+void            frameRingUnsubscribe(TaskHandle_t aTask);
+uint32_t        frameRingWait(uint32_t aLastFrame, TickType_t aTimeout);
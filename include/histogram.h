@@ -0,0 +1,27 @@
+#pragma once
+#include <Arduino.h>
+
+//  Log-bucket latency histogram. Values are microseconds; below 4 us every value has its own
+//  bucket, above that every power of two is split into 4 buckets, so a bucket is at most 25%
+//  wide. Updates are a relaxed atomic increment plus a compare-and-swap on the maximum, cheap
+//  enough to stay on in every task. Readers see counts that may be a few updates apart.
+//  Keep histograms in internal RAM: the atomics do not work on PSRAM.
+
+#define HISTOGRAM_SUB_BUCKETS  4
+// 104 buckets reach 2^27 - 1 us (about 134 s); longer samples land in the last bucket
+#define HISTOGRAM_BUCKETS      104
+
+typedef struct {
+  uint32_t  bucket[HISTOGRAM_BUCKETS];
+  uint32_t  max;
+} histogram_t;
+
+void      histogramAdd(histogram_t* aHist, uint32_t aValue);
+uint32_t  histogramCount(const histogram_t* aHist);
+// Upper bound of the bucket holding the aQuantile (0..1) sample, never above the maximum seen
+uint32_t  histogramPercentile(const histogram_t* aHist, float aQuantile);
+void      histogramReset(histogram_t* aHist);
+
+// Bucket arithmetic, exposed for renderers that list buckets
+uint8_t   histogramBucket(uint32_t aValue);
+uint32_t  histogramBucketUpper(uint8_t aBucket);
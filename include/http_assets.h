@@ -0,0 +1,31 @@
+#pragma once
+#include <Arduino.h>
+
+//  Static assets of the web interface, embedded in flash by tools/assets.py (asset_manifest.h).
+//  A request is served from the table without touching the filesystem. A file of the same path
+//  on SPIFFS overrides the embedded asset if its content differs; that is checked once at start.
+
+// Caching of an asset requested with the current ?t= version: the URL changes with the content.
+// Other requests for it, and SPIFFS overrides, are revalidated with the ETag
+#define ASSET_CACHE_IMMUTABLE  "public, max-age=31536000, immutable"
+#define ASSET_CACHE_REVALIDATE "no-cache"
+
+typedef struct {
+  const char*     path;       // URL path
+  const char*     mime;
+  uint32_t        hash;       // httpContentHash() of the uncompressed body
+  const uint8_t*  data;       // body as is, for clients that do not take gzip
+  uint32_t        size;
+  const uint8_t*  gzip;       // gzip-compressed body
+  uint32_t        gzipSize;
+} httpAsset_t;
+
+extern const uint32_t httpAssetVersion;   // changes whenever any asset does
+
+// Embedded asset for a URL path, NULL if there is none
+const httpAsset_t*  httpAssetFind(const char* aPath);
+
+// Look for SPIFFS overrides; call once SPIFFS is mounted
+void      httpAssetsInit(void);
+// Content hash of the SPIFFS file overriding aAsset, 0 if the embedded one is served
+uint32_t  httpAssetOverride(const httpAsset_t* aAsset);
@@ -0,0 +1,28 @@
+#pragma once
+#include <Arduino.h>
+#include <sys/time.h>
+
+//  HTTP conditional requests: entity tags and If-None-Match matching, content negotiation
+
+// Longest tag httpFrameEtag() renders, quotes and terminator included
+#define HTTP_ETAG_MAX  48
+
+// Strong tag of a published frame. The frame number restarts at boot, so the capture time
+// goes in too and a tag from before a reboot never matches a different frame
+int   httpFrameEtag(char* aBuf, size_t aSize, uint32_t aFrame, const struct timeval* aTimestamp);
+
+// Does an If-None-Match value ("*", one tag or a comma separated list, W/ prefixes allowed)
+// name aEtag? Weak comparison as RFC 9110 requires for If-None-Match. NULL or empty never matches
+bool  httpEtagMatch(const char* aIfNoneMatch, const char* aEtag);
+
+// FNV-1a over aData, continuing from aHash; tools/assets.py hashes the asset files the same way
+#define HTTP_HASH_INIT  0x811c9dc5u
+uint32_t  httpContentHash(const uint8_t* aData, size_t aSize, uint32_t aHash = HTTP_HASH_INIT);
+
+// Strong tag of a static asset from its content hash. The gzip representation is a different
+// entity and gets its own tag
+int   httpAssetEtag(char* aBuf, size_t aSize, uint32_t aHash, bool aGzip);
+
+// Does an Accept-Encoding value name gzip (in any case)? "gzip;q=0" refuses it,
+// "*" is not taken as gzip
+bool  httpAcceptsGzip(const char* aAcceptEncoding);
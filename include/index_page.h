@@ -0,0 +1,449 @@
+#pragma once
+//  Generated by tools/page_template.py from data/index.html - do not edit.
+//  Static text and typed slots of the page, rendered by pageRender().
+
+#include "page_template.h"
+
+// Settings the page shows, index into the values passed to pageRender()
+typedef enum {
+  INDEX_QUALITY,
+  INDEX_BRIGHTNESS,
+  INDEX_CONTRAST,
+  INDEX_SATURATION,
+  INDEX_AEC,
+  INDEX_AE_LEVEL,
+  INDEX_AEC_VALUE,
+  INDEX_AEC2,
+  INDEX_AGC,
+  INDEX_AGC_GAIN,
+  INDEX_GAINCEILING,
+  INDEX_AWB,
+  INDEX_AWB_GAIN,
+  INDEX_WB_MODE,
+  INDEX_SPECIAL_EFFECT,
+  INDEX_HMIRROR,
+  INDEX_VFLIP,
+  INDEX_DCW,
+  INDEX_BPC,
+  INDEX_WPC,
+  INDEX_RAW_GMA,
+  INDEX_LENC,
+  INDEX_COLORBAR,
+  INDEX_VALUES
+} indexValue_t;
+
+// Names of the settings: the element ids, lower case
+static const char* const indexValueNames[INDEX_VALUES] = {
+  "quality",
+  "brightness",
+  "contrast",
+  "saturation",
+  "aec",
+  "ae_level",
+  "aec_value",
+  "aec2",
+  "agc",
+  "agc_gain",
+  "gainceiling",
+  "awb",
+  "awb_gain",
+  "wb_mode",
+  "special_effect",
+  "hmirror",
+  "vflip",
+  "dcw",
+  "bpc",
+  "wpc",
+  "raw_gma",
+  "lenc",
+  "colorbar",
+};
+
+static const char indexText0[] PROGMEM =
+    "<!DOCTYPE html>\n"
+    "<html>\n"
+    "<head>\n"
+    "    <meta charset='utf-8'>\n"
+    "    <meta name='viewport' content='width=device-width, initial-scale=1'>\n"
+    "    <title>ESP32-CAM Control Panel</title>\n"
+    "    <link rel='stylesheet' href='/css/main.css?t=";
+static const char indexText1[] PROGMEM =
+    "'>\n"
+    "</head>\n"
+    "<body>\n"
+    "    <div class='container'>\n"
+    "        <div class='header'>\n"
+    "            <h1>ESP32-CAM Control Panel</h1>\n"
+    "            <p>Real-time streaming with camera controls</p>\n"
+    "        </div>\n"
+    "        <div class='status-bar' id='status'>Status: Loading...</div>\n"
+    "        \n"
+    "        <div class='stream-container'>\n"
+    "            <div class='stream-wrapper'>\n"
+    "                <img id='stream' class='stream-img' src='/mjpeg/1' alt='Camera Stream'>\n"
+    "            </div>\n"
+    "        </div>\n"
+    "        \n"
+    "        <div class='controls-grid'>\n"
+    "            <!-- Image Quality Panel -->\n"
+    "            <div class='control-panel'>\n"
+    "                <h3>Image Quality</h3>\n"
+    "                <div class='control-group'>\n"
+    "                    <label for='quality'>JPEG Quality: <span class='range-value' id='qualityVal'>";
+static const char indexText2[] PROGMEM =
+    "</span></label>\n"
+    "                    <input type='range' id='quality' min='4' max='63' value='";
+static const char indexText3[] PROGMEM =
+    "' data-value='";
+static const char indexText4[] PROGMEM =
+    "' autocomplete='off' onchange='setControl(\"quality\",this.value)'>\n"
+    "                </div>\n"
+    "                <div class='control-group'>\n"
+    "                    <label for='brightness'>Brightness: <span class='range-value' id='brightnessVal'>";
+static const char indexText5[] PROGMEM =
+    "</span></label>\n"
+    "                    <input type='range' id='brightness' min='-2' max='2' value='";
+static const char indexText6[] PROGMEM =
+    "' data-value='";
+static const char indexText7[] PROGMEM =
+    "' autocomplete='off' onchange='setControl(\"brightness\",this.value)'>\n"
+    "                </div>\n"
+    "                <div class='control-group'>\n"
+    "                    <label for='contrast'>Contrast: <span class='range-value' id='contrastVal'>";
+static const char indexText8[] PROGMEM =
+    "</span></label>\n"
+    "                    <input type='range' id='contrast' min='-2' max='2' value='";
+static const char indexText9[] PROGMEM =
+    "' data-value='";
+static const char indexText10[] PROGMEM =
+    "' autocomplete='off' onchange='setControl(\"contrast\",this.value)'>\n"
+    "                </div>\n"
+    "                <div class='control-group'>\n"
+    "                    <label for='saturation'>Saturation: <span class='range-value' id='saturationVal'>";
+static const char indexText11[] PROGMEM =
+    "</span></label>\n"
+    "                    <input type='range' id='saturation' min='-2' max='2' value='";
+static const char indexText12[] PROGMEM =
+    "' data-value='";
+static const char indexText13[] PROGMEM =
+    "' autocomplete='off' onchange='setControl(\"saturation\",this.value)'>\n"
+    "                </div>\n"
+    "            </div>\n"
+    "            \n"
+    "            <!-- Exposure & Gain Panel -->\n"
+    "            <div class='control-panel'>\n"
+    "                <h3>Exposure & Gain</h3>\n"
+    "                <div class='control-group'>\n"
+    "                    <label><input type='checkbox' id='aec' data-value='";
+static const char indexText14[] PROGMEM =
+    "' onchange='setControl(\"aec\", this.checked?1:0)'";
+static const char indexText15[] PROGMEM =
+    "> Auto Exposure Control</label>\n"
+    "                </div>\n"
+    "                <div class='control-group'>\n"
+    "                    <label for='ae_level'>AE Level: <span class='range-value' id='ae_levelVal'>";
+static const char indexText16[] PROGMEM =
+    "</span></label>\n"
+    "                    <input type='range' id='ae_level' min='-2' max='2' step='1' value='";
+static const char indexText17[] PROGMEM =
+    "' data-value='";
+static const char indexText18[] PROGMEM =
+    "' autocomplete='off' onchange='setControl(\"ae_level\",this.value)'>\n"
+    "                </div>\n"
+    "                <div class='control-group'>\n"
+    "                    <label for='aec_value'>AEC Value: <span class='range-value' id='aec_valueVal'>";
+static const char indexText19[] PROGMEM =
+    "</span></label>\n"
+    "                    <input type='range' id='aec_value' min='0' max='1200' value='";
+static const char indexText20[] PROGMEM =
+    "' data-value='";
+static const char indexText21[] PROGMEM =
+    "' autocomplete='off' onchange='setControl(\"aec_value\",this.value)'>\n"
+    "                </div>\n"
+    "                <div class='control-group'>\n"
+    "                    <label><input type='checkbox' id='aec2' data-value='";
+static const char indexText22[] PROGMEM =
+    "' onchange='setControl(\"aec2\", this.checked?1:0)'";
+static const char indexText23[] PROGMEM =
+    "> AEC2 (DSP)</label>\n"
+    "                </div>\n"
+    "                <div class='control-group'>\n"
+    "                    <label><input type='checkbox' id='agc' data-value='";
+static const char indexText24[] PROGMEM =
+    "' onchange='setControl(\"agc\", this.checked?1:0)'";
+static const char indexText25[] PROGMEM =
+    "> Auto Gain Control</label>\n"
+    "                </div>\n"
+    "                <div class='control-group'>\n"
+    "                    <label for='agc_gain'>AGC Gain: <span class='range-value' id='agc_gainVal'>";
+static const char indexText26[] PROGMEM =
+    "</span></label>\n"
+    "                    <input type='range' id='agc_gain' min='0' max='30' value='";
+static const char indexText27[] PROGMEM =
+    "' data-value='";
+static const char indexText28[] PROGMEM =
+    "' autocomplete='off' onchange='setControl(\"agc_gain\",this.value)'>\n"
+    "                </div>\n"
+    "                <div class='control-group'>\n"
+    "                    <label for='gainceiling'>Gain Ceiling:</label>\n"
+    "                    <select id='gainceiling' data-value='";
+static const char indexText29[] PROGMEM =
+    "' onchange='setControl(\"gainceiling\",this.value)'>\n"
+    "                        <option value='0'";
+static const char indexText30[] PROGMEM =
+    ">2x</option>\n"
+    "                        <option value='1'";
+static const char indexText31[] PROGMEM =
+    ">4x</option>\n"
+    "                        <option value='2'";
+static const char indexText32[] PROGMEM =
+    ">8x</option>\n"
+    "                        <option value='3'";
+static const char indexText33[] PROGMEM =
+    ">16x</option>\n"
+    "                        <option value='4'";
+static const char indexText34[] PROGMEM =
+    ">32x</option>\n"
+    "                        <option value='5'";
+static const char indexText35[] PROGMEM =
+    ">64x</option>\n"
+    "                        <option value='6'";
+static const char indexText36[] PROGMEM =
+    ">128x</option>\n"
+    "                    </select>\n"
+    "                </div>\n"
+    "            </div>\n"
+    "            \n"
+    "            <!-- White Balance & Color Panel -->\n"
+    "            <div class='control-panel'>\n"
+    "                <h3>White Balance & Color</h3>\n"
+    "                <div class='control-group'>\n"
+    "                    <label><input type='checkbox' id='awb' data-value='";
+static const char indexText37[] PROGMEM =
+    "' onchange='setControl(\"awb\", this.checked?1:0)'";
+static const char indexText38[] PROGMEM =
+    "> Auto White Balance</label>\n"
+    "                </div>\n"
+    "                <div class='control-group'>\n"
+    "                    <label><input type='checkbox' id='awb_gain' data-value='";
+static const char indexText39[] PROGMEM =
+    "' onchange='setControl(\"awb_gain\", this.checked?1:0)'";
+static const char indexText40[] PROGMEM =
+    "> AWB Gain</label>\n"
+    "                </div>\n"
+    "                <div class='control-group'>\n"
+    "                    <label for='wb_mode'>WB Mode:</label>\n"
+    "                    <select id='wb_mode' data-value='";
+static const char indexText41[] PROGMEM =
+    "' onchange='setControl(\"wb_mode\",this.value)'>\n"
+    "                        <option value='0'";
+static const char indexText42[] PROGMEM =
+    ">Auto</option>\n"
+    "                        <option value='1'";
+static const char indexText43[] PROGMEM =
+    ">Sunny</option>\n"
+    "                        <option value='2'";
+static const char indexText44[] PROGMEM =
+    ">Cloudy</option>\n"
+    "                        <option value='3'";
+static const char indexText45[] PROGMEM =
+    ">Office</option>\n"
+    "                        <option value='4'";
+static const char indexText46[] PROGMEM =
+    ">Home</option>\n"
+    "                    </select>\n"
+    "                </div>\n"
+    "                <div class='control-group'>\n"
+    "                    <label for='special_effect'>Special Effect:</label>\n"
+    "                    <select id='special_effect' data-value='";
+static const char indexText47[] PROGMEM =
+    "' onchange='setControl(\"special_effect\",this.value)'>\n"
+    "                        <option value='0'";
+static const char indexText48[] PROGMEM =
+    ">No Effect</option>\n"
+    "                        <option value='1'";
+static const char indexText49[] PROGMEM =
+    ">Negative</option>\n"
+    "                        <option value='2'";
+static const char indexText50[] PROGMEM =
+    ">Grayscale</option>\n"
+    "                        <option value='3'";
+static const char indexText51[] PROGMEM =
+    ">Red Tint</option>\n"
+    "                        <option value='4'";
+static const char indexText52[] PROGMEM =
+    ">Green Tint</option>\n"
+    "                        <option value='5'";
+static const char indexText53[] PROGMEM =
+    ">Blue Tint</option>\n"
+    "                        <option value='6'";
+static const char indexText54[] PROGMEM =
+    ">Sepia</option>\n"
+    "                    </select>\n"
+    "                </div>\n"
+    "            </div>\n"
+    "            \n"
+    "            <!-- Orientation & Geometry Panel -->\n"
+    "            <div class='control-panel'>\n"
+    "                <h3>Orientation & Geometry</h3>\n"
+    "                <div class='control-group'>\n"
+    "                    <label><input type='checkbox' id='hmirror' data-value='";
+static const char indexText55[] PROGMEM =
+    "' onchange='setControl(\"hmirror\", this.checked?1:0)'";
+static const char indexText56[] PROGMEM =
+    "> Horizontal Mirror</label>\n"
+    "                </div>\n"
+    "                <div class='control-group'>\n"
+    "                    <label><input type='checkbox' id='vflip' data-value='";
+static const char indexText57[] PROGMEM =
+    "' onchange='setControl(\"vflip\", this.checked?1:0)'";
+static const char indexText58[] PROGMEM =
+    "> Vertical Flip</label>\n"
+    "                </div>\n"
+    "                <div class='control-group'>\n"
+    "                    <label><input type='checkbox' id='dcw' data-value='";
+static const char indexText59[] PROGMEM =
+    "' onchange='setControl(\"dcw\", this.checked?1:0)'";
+static const char indexText60[] PROGMEM =
+    "> DCW (Downsize)</label>\n"
+    "                </div>\n"
+    "            </div>\n"
+    "            \n"
+    "            <!-- Image Processing Panel -->\n"
+    "            <div class='control-panel'>\n"
+    "                <h3>Image Processing</h3>\n"
+    "                <div class='control-group'>\n"
+    "                    <label><input type='checkbox' id='bpc' data-value='";
+static const char indexText61[] PROGMEM =
+    "' onchange='setControl(\"bpc\", this.checked?1:0)'";
+static const char indexText62[] PROGMEM =
+    "> Bad Pixel Correction</label>\n"
+    "                </div>\n"
+    "                <div class='control-group'>\n"
+    "                    <label><input type='checkbox' id='wpc' data-value='";
+static const char indexText63[] PROGMEM =
+    "' onchange='setControl(\"wpc\", this.checked?1:0)'";
+static const char indexText64[] PROGMEM =
+    "> White Pixel Correction</label>\n"
+    "                </div>\n"
+    "                <div class='control-group'>\n"
+    "                    <label><input type='checkbox' id='raw_gma' data-value='";
+static const char indexText65[] PROGMEM =
+    "' onchange='setControl(\"raw_gma\", this.checked?1:0)'";
+static const char indexText66[] PROGMEM =
+    "> Gamma Correction</label>\n"
+    "                </div>\n"
+    "                <div class='control-group'>\n"
+    "                    <label><input type='checkbox' id='lenc' data-value='";
+static const char indexText67[] PROGMEM =
+    "' onchange='setControl(\"lenc\", this.checked?1:0)'";
+static const char indexText68[] PROGMEM =
+    "> Lens Correction</label>\n"
+    "                </div>\n"
+    "            </div>\n"
+    "            \n"
+    "            <!-- Debug & Test Panel -->\n"
+    "            <div class='control-panel'>\n"
+    "                <h3>Debug & Test</h3>\n"
+    "                <div class='control-group'>\n"
+    "                    <label><input type='checkbox' id='colorbar' data-value='";
+static const char indexText69[] PROGMEM =
+    "' onchange='setControl(\"colorbar\", this.checked?1:0)'";
+static const char indexText70[] PROGMEM =
+    "> Color Bar Test</label>\n"
+    "                </div>\n"
+    "            </div>\n"
+    "        </div>\n"
+    "\n"
+    "                    <!-- System Controls Panel -->\n"
+    "                    <div class='control-panel'>\n"
+    "                        <h3>System Controls</h3>\n"
+    "                        <button class='btn' onclick='clearSettings()'>Clear Settings</button>\n"
+    "                        <button class='btn btn-danger' onclick='rebootCamera()'>Reboot Camera</button>\n"
+    "                    </div>\n"
+    "    </div>\n"
+    "    \n"
+    "    <script src='/js/controls.js?t=";
+static const char indexText71[] PROGMEM =
+    "'></script>\n"
+    "    <script src='/js/status.js?t=";
+static const char indexText72[] PROGMEM =
+    "'></script>\n"
+    "</body>\n"
+    "</html>\n";
+
+static const pageSegment_t indexPage[] = {
+  { indexText0, 222, PAGE_SLOT_VERSION, 0, 0 },
+  { indexText1, 781, PAGE_SLOT_VALUE, INDEX_QUALITY, 0 },
+  { indexText2, 93, PAGE_SLOT_VALUE, INDEX_QUALITY, 0 },
+  { indexText3, 14, PAGE_SLOT_VALUE, INDEX_QUALITY, 0 },
+  { indexText4, 234, PAGE_SLOT_VALUE, INDEX_BRIGHTNESS, 0 },
+  { indexText5, 96, PAGE_SLOT_VALUE, INDEX_BRIGHTNESS, 0 },
+  { indexText6, 14, PAGE_SLOT_VALUE, INDEX_BRIGHTNESS, 0 },
+  { indexText7, 231, PAGE_SLOT_VALUE, INDEX_CONTRAST, 0 },
+  { indexText8, 94, PAGE_SLOT_VALUE, INDEX_CONTRAST, 0 },
+  { indexText9, 14, PAGE_SLOT_VALUE, INDEX_CONTRAST, 0 },
+  { indexText10, 235, PAGE_SLOT_VALUE, INDEX_SATURATION, 0 },
+  { indexText11, 96, PAGE_SLOT_VALUE, INDEX_SATURATION, 0 },
+  { indexText12, 14, PAGE_SLOT_VALUE, INDEX_SATURATION, 0 },
+  { indexText13, 363, PAGE_SLOT_VALUE, INDEX_AEC, 0 },
+  { indexText14, 48, PAGE_SLOT_CHECKED, INDEX_AEC, 0 },
+  { indexText15, 194, PAGE_SLOT_VALUE, INDEX_AE_LEVEL, 0 },
+  { indexText16, 103, PAGE_SLOT_VALUE, INDEX_AE_LEVEL, 0 },
+  { indexText17, 14, PAGE_SLOT_VALUE, INDEX_AE_LEVEL, 0 },
+  { indexText18, 232, PAGE_SLOT_VALUE, INDEX_AEC_VALUE, 0 },
+  { indexText19, 97, PAGE_SLOT_VALUE, INDEX_AEC_VALUE, 0 },
+  { indexText20, 14, PAGE_SLOT_VALUE, INDEX_AEC_VALUE, 0 },
+  { indexText21, 207, PAGE_SLOT_VALUE, INDEX_AEC2, 0 },
+  { indexText22, 49, PAGE_SLOT_CHECKED, INDEX_AEC2, 0 },
+  { indexText23, 159, PAGE_SLOT_VALUE, INDEX_AGC, 0 },
+  { indexText24, 48, PAGE_SLOT_CHECKED, INDEX_AGC, 0 },
+  { indexText25, 190, PAGE_SLOT_VALUE, INDEX_AGC_GAIN, 0 },
+  { indexText26, 94, PAGE_SLOT_VALUE, INDEX_AGC_GAIN, 0 },
+  { indexText27, 14, PAGE_SLOT_VALUE, INDEX_AGC_GAIN, 0 },
+  { indexText28, 258, PAGE_SLOT_VALUE, INDEX_GAINCEILING, 0 },
+  { indexText29, 92, PAGE_SLOT_SELECTED, INDEX_GAINCEILING, 0 },
+  { indexText30, 54, PAGE_SLOT_SELECTED, INDEX_GAINCEILING, 1 },
+  { indexText31, 54, PAGE_SLOT_SELECTED, INDEX_GAINCEILING, 2 },
+  { indexText32, 54, PAGE_SLOT_SELECTED, INDEX_GAINCEILING, 3 },
+  { indexText33, 55, PAGE_SLOT_SELECTED, INDEX_GAINCEILING, 4 },
+  { indexText34, 55, PAGE_SLOT_SELECTED, INDEX_GAINCEILING, 5 },
+  { indexText35, 55, PAGE_SLOT_SELECTED, INDEX_GAINCEILING, 6 },
+  { indexText36, 351, PAGE_SLOT_VALUE, INDEX_AWB, 0 },
+  { indexText37, 48, PAGE_SLOT_CHECKED, INDEX_AWB, 0 },
+  { indexText38, 172, PAGE_SLOT_VALUE, INDEX_AWB_GAIN, 0 },
+  { indexText39, 53, PAGE_SLOT_CHECKED, INDEX_AWB_GAIN, 0 },
+  { indexText40, 197, PAGE_SLOT_VALUE, INDEX_WB_MODE, 0 },
+  { indexText41, 88, PAGE_SLOT_SELECTED, INDEX_WB_MODE, 0 },
+  { indexText42, 56, PAGE_SLOT_SELECTED, INDEX_WB_MODE, 1 },
+  { indexText43, 57, PAGE_SLOT_SELECTED, INDEX_WB_MODE, 2 },
+  { indexText44, 58, PAGE_SLOT_SELECTED, INDEX_WB_MODE, 3 },
+  { indexText45, 58, PAGE_SLOT_SELECTED, INDEX_WB_MODE, 4 },
+  { indexText46, 244, PAGE_SLOT_VALUE, INDEX_SPECIAL_EFFECT, 0 },
+  { indexText47, 95, PAGE_SLOT_SELECTED, INDEX_SPECIAL_EFFECT, 0 },
+  { indexText48, 61, PAGE_SLOT_SELECTED, INDEX_SPECIAL_EFFECT, 1 },
+  { indexText49, 60, PAGE_SLOT_SELECTED, INDEX_SPECIAL_EFFECT, 2 },
+  { indexText50, 61, PAGE_SLOT_SELECTED, INDEX_SPECIAL_EFFECT, 3 },
+  { indexText51, 60, PAGE_SLOT_SELECTED, INDEX_SPECIAL_EFFECT, 4 },
+  { indexText52, 62, PAGE_SLOT_SELECTED, INDEX_SPECIAL_EFFECT, 5 },
+  { indexText53, 61, PAGE_SLOT_SELECTED, INDEX_SPECIAL_EFFECT, 6 },
+  { indexText54, 358, PAGE_SLOT_VALUE, INDEX_HMIRROR, 0 },
+  { indexText55, 52, PAGE_SLOT_CHECKED, INDEX_HMIRROR, 0 },
+  { indexText56, 168, PAGE_SLOT_VALUE, INDEX_VFLIP, 0 },
+  { indexText57, 50, PAGE_SLOT_CHECKED, INDEX_VFLIP, 0 },
+  { indexText58, 162, PAGE_SLOT_VALUE, INDEX_DCW, 0 },
+  { indexText59, 48, PAGE_SLOT_CHECKED, INDEX_DCW, 0 },
+  { indexText60, 321, PAGE_SLOT_VALUE, INDEX_BPC, 0 },
+  { indexText61, 48, PAGE_SLOT_CHECKED, INDEX_BPC, 0 },
+  { indexText62, 169, PAGE_SLOT_VALUE, INDEX_WPC, 0 },
+  { indexText63, 48, PAGE_SLOT_CHECKED, INDEX_WPC, 0 },
+  { indexText64, 175, PAGE_SLOT_VALUE, INDEX_RAW_GMA, 0 },
+  { indexText65, 52, PAGE_SLOT_CHECKED, INDEX_RAW_GMA, 0 },
+  { indexText66, 166, PAGE_SLOT_VALUE, INDEX_LENC, 0 },
+  { indexText67, 49, PAGE_SLOT_CHECKED, INDEX_LENC, 0 },
+  { indexText68, 319, PAGE_SLOT_VALUE, INDEX_COLORBAR, 0 },
+  { indexText69, 53, PAGE_SLOT_CHECKED, INDEX_COLORBAR, 0 },
+  { indexText70, 506, PAGE_SLOT_VERSION, 0, 0 },
+  { indexText71, 45, PAGE_SLOT_VERSION, 0, 0 },
+  { indexText72, 28, PAGE_SLOT_END, 0, 0 },
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include <Arduino.h>
+#include "text_buffer.h"
+
+//  Minimal JSON writer into a caller-owned buffer. Commas between members are inserted by the
+//  writer, numbers are written as numbers. Nothing is allocated: floats are written as fixed
+//  point with integer conversions only (newlib allocates in its floating point printf).
+//  A document that does not fit is marked as overflowed and jsonFinish() returns 0.
+
+typedef struct {
+  textBuffer_t  out;
+  bool          comma;      // a member was written at the current level
+} jsonWriter_t;
+
+void    jsonInit(jsonWriter_t* w, char* aBuf, size_t aSize);
+// Length of the document, 0 if it did not fit. The buffer is NUL-terminated either way
+size_t  jsonFinish(jsonWriter_t* w);
+
+//  aKey is NULL for array elements and for the top-level value
+void    jsonBeginObject(jsonWriter_t* w, const char* aKey = NULL);
+void    jsonEndObject(jsonWriter_t* w);
+void    jsonBeginArray(jsonWriter_t* w, const char* aKey = NULL);
+void    jsonEndArray(jsonWriter_t* w);
+
+void    jsonString(jsonWriter_t* w, const char* aKey, const char* aValue);
+void    jsonBool(jsonWriter_t* w, const char* aKey, bool aValue);
+void    jsonInt(jsonWriter_t* w, const char* aKey, int64_t aValue);
+void    jsonUint(jsonWriter_t* w, const char* aKey, uint64_t aValue);
+// aValue rounded to aDecimals (0..6) places
+void    jsonFixed(jsonWriter_t* w, const char* aKey, float aValue, uint8_t aDecimals);
+// IPv4 address in network byte order, as a dotted string
+void    jsonIp(jsonWriter_t* w, const char* aKey, uint32_t aAddress);
@@ -1,25 +1,206 @@
 #pragma once
 #include <Arduino.h>
+#include <IPAddress.h>
+#include <stdarg.h>
+#include <type_traits>
 
 #define MILLIS_FUNCTION xTaskGetTickCount()
 // #define MILLIS_FUNCTION millis()
 
+#ifndef CR
+#define CR "\n"
+#endif
+
+// Longest log line, longer ones are cut
+#ifndef LOG_LINE_MAX
+#define LOG_LINE_MAX 256
+#endif
+
+//  Logging is asynchronous: a caller claims a slot of a lock-free ring and copies the format
+//  pointer, a timestamp and its raw arguments into it (strings are copied, they may not outlive
+//  the call). A low-priority task formats the records and writes them out, so a slow UART never
+//  stalls the camera or streaming tasks. When the ring is full a message is dropped and counted.
+//  Levels above LOG_LEVEL are compiled out: the call and its format string are gone, only
+//  arguments with side effects are still evaluated.
+
+#define LOG_LEVEL_SILENT    0
+#define LOG_LEVEL_FATAL     1
+#define LOG_LEVEL_ERROR     2
+#define LOG_LEVEL_WARNING   3
+#define LOG_LEVEL_NOTICE    4
+#define LOG_LEVEL_TRACE     5
+#define LOG_LEVEL_VERBOSE   6
+
+// Highest level compiled in
+#if defined(DISABLE_LOGGING)
+#define LOG_LEVEL_MAX       LOG_LEVEL_SILENT
+#elif defined(LOG_LEVEL)
+#define LOG_LEVEL_MAX       LOG_LEVEL
+#else
+#define LOG_LEVEL_MAX       LOG_LEVEL_VERBOSE
+#endif
+
+// Messages the ring holds, a power of 2
+#ifndef LOG_RING_SLOTS
+#define LOG_RING_SLOTS      32
+#endif
+
+// Room for the raw arguments of one message, strings included; longer strings are cut
+#ifndef LOG_RECORD_ARGS
+#define LOG_RECORD_ARGS     80
+#endif
+
+// How often the drain task looks for messages when the ring is empty, ms
+#ifndef LOG_DRAIN_MS
+#define LOG_DRAIN_MS        10
+#endif
+
+// Longest flush() waits for the drain task to finish writing, ms
+#ifndef LOG_FLUSH_MS
+#define LOG_FLUSH_MS        1000
+#endif
+
+#define LOG_TASK_PRIORITY   (tskIDLE_PRIORITY + 1)
+#define LOG_STACK_SIZE      4096
+
+#if defined(TRACE_LOG)
+// Tracing (trace.h): every message is recorded in binary, those up to this level also as text
+#ifndef TRACE_SERIAL_LEVEL
+#define TRACE_SERIAL_LEVEL  LOG_LEVEL_WARNING
+#endif
+void traceMessage(uint8_t aLevel, const char* aFormat, const uint8_t* aArgs, size_t aSize);
+#endif
+
+// Kinds of the raw arguments of a record: a tag byte, then the value
+typedef enum {
+  LOG_ARG_INT = 0,    // 32 bits
+  LOG_ARG_UINT,
+  LOG_ARG_INT64,
+  LOG_ARG_UINT64,
+  LOG_ARG_DOUBLE,
+  LOG_ARG_STRING,     // length byte, then the characters
+  LOG_ARG_POINTER,
+  LOG_ARG_IP,         // IPAddress, printed as a dotted quad whatever the conversion (%p)
+} logArg_t;
+
+typedef struct {
+  uint32_t    seq;      // ring sequence: whose turn the slot is
+  const char* format;
+  uint32_t    time;     // MILLIS_FUNCTION when logged
+  uint8_t     level;
+  uint8_t     size;     // bytes of args used
+  uint8_t     args[LOG_RECORD_ARGS];
+} logRecord_t;
+
+typedef struct {
+  uint8_t*  pos;
+  uint8_t*  end;
+  bool      full;     // an argument did not fit: it and every later one are left out
+} logArgs_t;
+
+// ==== Raw argument capture ================================================================
+void logPutArg(logArgs_t* a, uint8_t aTag, const void* aValue, size_t aSize);
+void logPutString(logArgs_t* a, const char* aValue);
+
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+logArg(logArgs_t* a, T aValue) {
+  if ( sizeof(T) > 4 ) {
+    uint64_t v = (uint64_t) aValue;
+    logPutArg(a, std::is_signed<T>::value ? LOG_ARG_INT64 : LOG_ARG_UINT64, &v, sizeof(v));
+  }
+  else {
+    uint32_t v = (uint32_t) aValue;
+    logPutArg(a, std::is_signed<T>::value || std::is_enum<T>::value ? LOG_ARG_INT : LOG_ARG_UINT, &v, sizeof(v));
+  }
+}
+inline void logArg(logArgs_t* a, double aValue) { logPutArg(a, LOG_ARG_DOUBLE, &aValue, sizeof(aValue)); }
+inline void logArg(logArgs_t* a, const char* aValue) { logPutString(a, aValue); }
+inline void logArg(logArgs_t* a, char* aValue) { logPutString(a, aValue); }
+inline void logArg(logArgs_t* a, const String& aValue) { logPutString(a, aValue.c_str()); }
+inline void logArg(logArgs_t* a, const IPAddress& aValue) {
+  uint32_t v = (uint32_t) aValue;
+  logPutArg(a, LOG_ARG_IP, &v, sizeof(v));
+}
+template <typename T>
+inline void logArg(logArgs_t* a, T* aValue) {
+  uintptr_t v = (uintptr_t) aValue;
+  logPutArg(a, LOG_ARG_POINTER, &v, sizeof(v));
+}
+
+inline void logPack(logArgs_t* a) { (void) a; }
+template <typename T, typename... R>
+inline void logPack(logArgs_t* a, const T& aFirst, const R&... aRest) {
+  logArg(a, aFirst);
+  logPack(a, aRest...);
+}
+
 // Simple logging class to replace ArduinoLog
 class SimpleLog {
 public:
+  SimpleLog();
+  // Starts the drain task; until then messages are written by the caller
   void begin(int level, Print* output);
-  void setPrefix(void (*func)(Print*));
-  void trace(const char* format, ...);
-  void verbose(const char* format, ...);
-  void notice(const char* format, ...);
-  void warning(const char* format, ...);
-  void error(const char* format, ...);
-  void fatal(const char* format, ...);
-  
+  // Write out what the ring holds now, from the calling task (before a restart)
+  void flush();
+  uint32_t dropped() const { return _dropped; }
+  TaskHandle_t task() const { return _drain; }
+
+  template <typename... A> void fatal(const char* format, const A&... args)   { log<LOG_LEVEL_FATAL>(format, args...); }
+  template <typename... A> void error(const char* format, const A&... args)   { log<LOG_LEVEL_ERROR>(format, args...); }
+  template <typename... A> void warning(const char* format, const A&... args) { log<LOG_LEVEL_WARNING>(format, args...); }
+  template <typename... A> void notice(const char* format, const A&... args)  { log<LOG_LEVEL_NOTICE>(format, args...); }
+  template <typename... A> void trace(const char* format, const A&... args)   { log<LOG_LEVEL_TRACE>(format, args...); }
+  template <typename... A> void verbose(const char* format, const A&... args) { log<LOG_LEVEL_VERBOSE>(format, args...); }
+
+  // Formats one record into aLine, with the timestamp. Returns the length
+  static size_t format(const logRecord_t* aRecord, char* aLine, size_t aSize);
+  // Formats a message from its raw arguments, without a timestamp
+  static size_t formatMessage(const char* aFormat, const uint8_t* aArgs, size_t aArgsSize, char* aLine, size_t aSize);
+
 private:
+  template <int L, typename... A>
+  void log(const char* format, const A&... args) {
+    if ( L > LOG_LEVEL_MAX || L > _level ) return;
+#if defined(TRACE_LOG)
+    uint8_t raw[LOG_RECORD_ARGS];
+    logArgs_t t = { raw, raw + sizeof(raw), false };
+    logPack(&t, args...);
+    traceMessage(L, format, sizeof...(A) ? raw : NULL, t.pos - raw);
+    if ( L > TRACE_SERIAL_LEVEL ) return;
+#endif
+    logRecord_t local;
+    logRecord_t* r = _drain ? claim() : &local;
+    if ( r == NULL ) return;
+    logArgs_t a = { r->args, r->args + sizeof(r->args), false };
+    logPack(&a, args...);
+    r->format = format;
+    r->time = MILLIS_FUNCTION;
+    r->level = L;
+    r->size = a.pos - r->args;
+    if ( r == &local ) write(r);
+    else publish(r);
+  }
+
+  logRecord_t* claim();
+  void         publish(logRecord_t* aRecord);
+  void         write(const logRecord_t* aRecord);
+  bool         drain();
+  static void  drainTask(void* aLog);
+
+#if defined(DISABLE_LOGGING)
+  int _level = 0;
+#else
   int _level = 6;
-  Print* _output = &Serial;
-  void (*_prefixFunc)(Print*) = nullptr;
+#endif
+  Print*        _output = &Serial;
+  TaskHandle_t  _drain = NULL;
+  uint32_t      _head = 0;          // next slot a producer claims
+  uint32_t      _tail = 0;          // next slot the drain reads
+  uint32_t      _dropped = 0;
+  uint32_t      _reported = 0;      // drops already reported in the log
+  uint32_t      _draining = 0;      // a task is reading the ring
+  logRecord_t   _ring[LOG_RING_SLOTS];
 };
 
 extern SimpleLog Log;
@@ -28,6 +209,5 @@ extern SimpleLog Log;
 void    setupLogging();
 
 #ifndef DISABLE_LOGGING
-void    printTimestampMillis(Print* logOutput);
 void    printBuffer(const char* aBuf, size_t aSize);
 #endif  //   #ifndef DISABLE_LOGGING
@@ -0,0 +1,38 @@
+#pragma once
+#include <Arduino.h>
+
+//  Fixed-size block pools carved out of PSRAM or internal RAM once at boot. Buffers that come
+//  and go with every connection or frame are taken from a pool instead of the heap, so the heap
+//  sees no allocation after boot for them and cannot fragment around them. A pool never grows:
+//  when every block is in use the allocation fails and is counted.
+
+// Pools /metrics reports on
+#ifndef MEM_POOLS_MAX
+#define MEM_POOLS_MAX   4
+#endif
+
+typedef struct {
+  const char* name;
+  uint8_t*    base;       // first block
+  uint32_t    size;       // block size, bytes, rounded up to 8
+  uint16_t    blocks;
+  uint16_t    used;       // blocks handed out
+  uint16_t    peak;       // most blocks handed out at once
+  uint16_t    top;        // free blocks on the stack
+  uint16_t*   stack;      // indices of the free blocks
+  uint8_t*    taken;      // per block: 1 while handed out
+  uint32_t    allocs;     // allocations served
+  uint32_t    failures;   // allocations refused, every block in use
+  uint32_t    invalid;    // frees of a pointer that is not a block in use
+} memPool_t;
+
+// Carves aBlocks blocks of aSize bytes in one allocation, PSRAM only or any memory.
+// Short of memory it settles for fewer blocks, down to aMinBlocks. Returns false without a pool
+bool    memPoolInit(memPool_t* p, const char* aName, size_t aSize, uint16_t aBlocks, uint16_t aMinBlocks, bool psramOnly);
+// A free block, NULL if every block is in use
+void*   memPoolAlloc(memPool_t* p);
+// Give a block back; NULL is ignored, anything that is not a block in use is counted and ignored
+void    memPoolFree(memPool_t* p, void* aBlock);
+
+uint8_t     memPoolCount();
+memPool_t*  memPoolAt(uint8_t aIndex);
@@ -0,0 +1,95 @@
+#pragma once
+#include <Arduino.h>
+
+//  Memory pressure tiers. A sample of free heap, largest free heap block, free PSRAM and the
+//  allocation failure count is taken every MEM_WATCH_INTERVAL_MS. Under pressure the tier goes
+//  up one step at a time, each held at least MEM_TIER_HOLD_MS to take effect; critical memory
+//  steps up at every sample. Once every figure is back above its low mark with a margin for
+//  MEM_RECOVER_MS the tier comes down one step. A restart is the last tier, taken only after
+//  MEM_RESTART_MS of critical memory with new clients already refused.
+//  The policy only decides; the web server task applies the tiers to the ring, the clients and
+//  the sensor (src/streaming.cpp).
+
+#ifndef MEM_WATCH_INTERVAL_MS
+#define MEM_WATCH_INTERVAL_MS   1000
+#endif
+
+// Low and critical marks, bytes
+#ifndef MEM_HEAP_LOW
+#define MEM_HEAP_LOW            (32 * 1024)
+#endif
+#ifndef MEM_HEAP_CRITICAL
+#define MEM_HEAP_CRITICAL       (16 * 1024)
+#endif
+#ifndef MEM_BLOCK_LOW
+#define MEM_BLOCK_LOW           (12 * 1024)
+#endif
+#ifndef MEM_BLOCK_CRITICAL
+#define MEM_BLOCK_CRITICAL      (6 * 1024)
+#endif
+#ifndef MEM_PSRAM_LOW
+#define MEM_PSRAM_LOW           (128 * 1024)
+#endif
+#ifndef MEM_PSRAM_CRITICAL
+#define MEM_PSRAM_CRITICAL      (32 * 1024)
+#endif
+
+#ifndef MEM_TIER_HOLD_MS
+#define MEM_TIER_HOLD_MS        5000
+#endif
+#ifndef MEM_RECOVER_MS
+#define MEM_RECOVER_MS          30000
+#endif
+#ifndef MEM_RESTART_MS
+#define MEM_RESTART_MS          60000
+#endif
+
+// What the tiers apply: ring slots kept, client frame rate, JPEG quality number added
+#ifndef MEM_RING_DEPTH
+#define MEM_RING_DEPTH          3
+#endif
+#ifndef MEM_FPS_CAP
+#define MEM_FPS_CAP             10
+#endif
+#ifndef MEM_QUALITY_STEP
+#define MEM_QUALITY_STEP        10
+#endif
+
+typedef enum {
+  MEM_TIER_NORMAL = 0,
+  MEM_TIER_RING,      // the frame ring keeps MEM_RING_DEPTH slots
+  MEM_TIER_FPS,       // and clients get at most MEM_FPS_CAP frames per second
+  MEM_TIER_QUALITY,   // and the JPEG quality number is raised by MEM_QUALITY_STEP: smaller frames
+  MEM_TIER_REFUSE,    // and new clients get 503
+  MEM_TIER_RESTART,   // last resort
+} memTier_t;
+
+typedef struct {
+  uint32_t  freeHeap;
+  uint32_t  largestBlock;
+  uint32_t  freePsram;
+  uint32_t  psramSize;      // 0: no PSRAM, not watched
+  uint32_t  allocFailures;  // allocations that found no memory and had no fallback, since boot
+} memSample_t;
+
+typedef struct {
+  memTier_t   tier;
+  memTier_t   worst;        // highest tier since boot
+  uint32_t    since;        // millis() the tier was entered
+  uint32_t    calmSince;    // millis() memory was last found short, for the way down
+  uint32_t    criticalSince;// millis() memory turned critical, 0 = not critical
+  uint32_t    transitions;
+  uint32_t    failures;     // allocation failures at the last sample
+  const char* reason;       // figure behind the last transition
+  memSample_t last;
+} memWatch_t;
+
+extern memWatch_t memWatch;
+
+// aFailures: allocFailures now, so failures before the watch started do not count against it
+void        memWatchInit(memWatch_t* w, uint32_t aNow, uint32_t aFailures);
+// Takes a sample, returns the tier to run in
+memTier_t   memWatchUpdate(memWatch_t* w, const memSample_t* s, uint32_t aNow);
+const char* memTierName(memTier_t aTier);
+// Frame rate every client is held to, 0 = none
+float       memWatchFpsCap();
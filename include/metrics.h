@@ -0,0 +1,12 @@
+#pragma once
+#include <Arduino.h>
+
+//  Prometheus text exposition of counters and gauges of the firmware
+
+// Room for the rendered /metrics page
+#ifndef METRICS_BUFFER_SIZE
+#define METRICS_BUFFER_SIZE  8192
+#endif
+
+// Render every metric into aBuf. Returns the length, 0 if aSize was too small
+size_t  metricsRender(char* aBuf, size_t aSize);
@@ -0,0 +1,32 @@
+#pragma once
+#include <Arduino.h>
+#include <sys/time.h>
+
+// multipart/x-mixed-replace framing shared by every streaming implementation
+extern const char* HEADER;
+extern const char* BOUNDARY;
+extern const char* CTNTTYPE;
+extern const int hdrLen;
+extern const int bdrLen;
+extern const int cntLen;
+
+// Longest part header: CTNTTYPE with a 10 digit length, X-Timestamp, X-Frame-Number and the blank line
+#define PART_HEADER_MAX  128
+
+// Add X-Timestamp (capture time) and X-Frame-Number to every published part
+#ifndef MJPEG_X_HEADERS
+#define MJPEG_X_HEADERS  1
+#endif
+
+// Wire-ready part header. aFrame 0 and aTimestamp NULL leave out X-Frame-Number and X-Timestamp
+int mjpegPartHeader(char* aBuf, size_t aSize, uint32_t aLength, uint32_t aFrame = 0,
+                    const struct timeval* aTimestamp = NULL);
+
+// Part header, frame and BOUNDARY go out as one vectored write straight from their own buffers.
+// aOffset skips what an earlier call already sent. Returns bytes written, or -1 with errno set
+int mjpegPartSend(int aSock, const char* aHdr, size_t aHdrLen, const uint8_t* aData, size_t aSize,
+                  size_t aOffset, int aFlags);
+
+// Whole part on a socket that may be non-blocking, waiting up to aTimeoutMs for buffer space each time
+bool mjpegPartSendAll(int aSock, const char* aHdr, size_t aHdrLen, const uint8_t* aData, size_t aSize,
+                      uint32_t aTimeoutMs);
@@ -0,0 +1,33 @@
+#pragma once
+#include <Arduino.h>
+
+//  Pages compiled by tools/page_template.py: static text in flash, each piece followed by a slot
+//  filled in while the page is sent. Rendering is one pass over the segments with no copy of
+//  the page; output is collected in the caller's buffer and handed to aWrite whenever it is full.
+
+// Output is collected up to one TCP segment before it is written
+#ifndef PAGE_BUFFER_SIZE
+#define PAGE_BUFFER_SIZE  1460
+#endif
+
+typedef enum {
+  PAGE_SLOT_END,        // last segment, text only
+  PAGE_SLOT_VALUE,      // the setting as a decimal number
+  PAGE_SLOT_VERSION,    // asset version for cache busting, 8 hex digits
+  PAGE_SLOT_CHECKED,    // " checked" if the setting is 1
+  PAGE_SLOT_SELECTED,   // " selected" if the setting equals arg
+} pageSlot_t;
+
+typedef struct {
+  const char* text;
+  uint16_t    len;
+  uint8_t     slot;     // pageSlot_t
+  uint8_t     value;    // index of the setting
+  int16_t     arg;
+} pageSegment_t;
+
+typedef void (*pageWrite_t)(void* aCtx, const char* aData, size_t aLen);
+
+// Render aPage with aValues into aWrite through aBuf. Returns the bytes written
+size_t pageRender(const pageSegment_t* aPage, const int32_t* aValues, uint32_t aVersion,
+                  char* aBuf, size_t aSize, pageWrite_t aWrite, void* aCtx);
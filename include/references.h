@@ -15,7 +15,6 @@
 #include <esp_sleep.h>
 #include <driver/rtc_io.h>
 
-extern SemaphoreHandle_t frameSync;
 extern WebServer server;
 extern TaskHandle_t tMjpeg;   // handles client connections to the webserver
 extern TaskHandle_t tCam;     // handles getting picture frames from the camera and storing them locally
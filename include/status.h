@@ -0,0 +1,34 @@
+#pragma once
+#include <Arduino.h>
+
+//  /status document. Values that need the sensor or the WiFi driver are sampled into a snapshot
+//  between requests, so a poll only reads memory; counters are read where they live.
+//  The document is written with the fixed-buffer JSON writer, numbers as numbers.
+
+// Room for the rendered /status document with every client slot in use
+#ifndef STATUS_BUFFER_SIZE
+#define STATUS_BUFFER_SIZE  3072
+#endif
+
+// How often the snapshot is refreshed, ms
+#ifndef STATUS_REFRESH_MS
+#define STATUS_REFRESH_MS   1000
+#endif
+
+typedef struct {
+  uint16_t    width;      // frame size of the sensor, 0 if unknown
+  uint16_t    height;
+  int8_t      rssi;       // dBm
+  uint8_t     channel;
+  const char* phy;        // "802.11n", "802.11g", "802.11b" or "Unknown"
+  uint8_t     bandwidth;  // MHz, 0 if unknown
+  uint8_t     maxSpeed;   // theoretical PHY rate, Mbps, 0 if unknown
+  uint32_t    updated;    // millis() of the last refresh
+} statusSnapshot_t;
+
+extern statusSnapshot_t statusSnapshot;
+
+// Sample the sensor and WiFi, at most every STATUS_REFRESH_MS unless aForce
+void    statusRefresh(bool aForce = false);
+// Render the document into aBuf. Returns the length, 0 if aSize was too small
+size_t  statusRender(char* aBuf, size_t aSize);
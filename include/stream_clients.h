@@ -0,0 +1,59 @@
+#pragma once
+#include <Arduino.h>
+#include "histogram.h"
+
+//  Per-client streaming statistics. Every client holds at most one frame of the ring at a time
+//  and always moves on to the newest frame, so a slow client skips frames instead of queueing
+//  them. Skipped frames are counted here together with the rate the client actually receives.
+//  For a client that asked for a lower rate (/mjpeg/1?fps=5) the frames its rate holds back count
+//  as paced; frames skipped beyond that, because it is slower still, count as dropped.
+
+#ifndef MAX_CLIENTS
+#define MAX_CLIENTS 10
+#endif
+
+typedef struct {
+  bool      used;
+  uint32_t  ip;       // peer IPv4 address, network byte order
+  uint32_t  since;    // millis() at connection
+  uint32_t  sent;     // frames sent completely
+  uint64_t  bytes;    // bytes of complete parts sent
+  uint32_t  dropped;  // published frames skipped to catch up with the newest one
+  uint32_t  paced;    // published frames skipped to hold the requested rate
+  float     target;   // requested frames per second, 0 = camera rate
+  uint32_t  ttff;     // connect to first complete frame, ms
+  uint32_t  last;     // number of the last frame sent
+  uint32_t  lastAt;   // millis() the last frame was sent
+  float     fps;      // frames received per second, updated every second
+  uint32_t  winStart; // millis() at the start of the current fps window
+  uint32_t  winSent;  // frames sent in the current fps window
+} streamClient_t;
+
+// Counts over every client since boot. Open clients are added in when read, so the
+// hot path only ever touches its own record
+typedef struct {
+  uint32_t  connects;
+  uint32_t  disconnects;
+  uint32_t  sent;     // frames of clients already closed
+  uint64_t  bytes;
+  uint32_t  dropped;
+  uint32_t  paced;
+} streamClientTotals_t;
+
+//  Always-on latency histograms of the streaming pipeline, microseconds
+typedef struct {
+  histogram_t grab;   // camera driver: waiting for and fetching a frame buffer
+  histogram_t copy;   // copying a frame into the ring (frames that are not sent zero-copy)
+  histogram_t queue;  // frame published until a client starts sending it
+  histogram_t send;   // first to last byte of a part to one client
+  histogram_t total;  // frame captured until its last byte left for a client
+} streamLatency_t;
+
+extern streamClient_t streamClients[MAX_CLIENTS];
+extern streamLatency_t streamLatency;
+
+int8_t  streamClientOpen(int aSocket, float aTarget = 0);
+void    streamClientSent(int8_t aId, uint32_t aFrame, uint32_t aBytes);
+void    streamClientClose(int8_t aId);
+float   streamClientFps(int8_t aId);
+void    streamClientTotals(streamClientTotals_t* aTotals);
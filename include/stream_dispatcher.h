@@ -0,0 +1,45 @@
+#pragma once
+#include <Arduino.h>
+#include "frame_ring.h"
+#include "multipart.h"
+#include "frame_pacer.h"
+
+//  Single streaming task serving every client: sockets are non-blocking, each client keeps
+//  its position inside the part being sent, and the task sleeps until a frame is published
+//  or a socket can take more data.
+
+#ifndef MAX_CLIENTS
+#define MAX_CLIENTS 10
+#endif
+
+// Longest sleep in select() while some client is still in the middle of a frame.
+// Clients that are done with their frame pick up a newly published one at least this often
+#ifndef DISPATCH_POLL_MS
+#define DISPATCH_POLL_MS  5
+#endif
+
+// Longest sleep with every client up to date, after which idle sockets are checked for hang-ups
+#ifndef DISPATCH_IDLE_MS
+#define DISPATCH_IDLE_MS  1000
+#endif
+
+typedef struct {
+  uint32_t  frames;     // frames sent completely
+  uint32_t  bytes;      // bytes sent
+  uint32_t  wakeups;    // dispatcher loop iterations
+  uint32_t  blocked;    // sends cut short by a full socket buffer
+  uint32_t  dropped;    // clients closed on a socket error or hang-up
+  uint8_t   clients;    // clients currently served
+} streamDispatchStats_t;
+
+extern streamDispatchStats_t streamDispatchStats;
+
+// aOnClose is called from the dispatcher task for every client it drops. NULL just closes the socket
+bool  streamDispatchInit(void (*aOnClose)(int aSocket, void* aOwner));
+
+// Hand a connected socket over to the dispatcher. HTTP response header must already be sent.
+// aOwner is passed back to the close callback, e.g. the object that owns the socket.
+// aFps below the camera rate paces the client, 0 sends every frame
+bool  streamDispatchAdd(int aSocket, void* aOwner, float aFps = 0);
+
+void  streamDispatchCB(void* pvParameters);
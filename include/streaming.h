@@ -1,32 +1,60 @@
 #pragma once
 #include "definitions.h"
 #include "references.h"
+#include "allocator.h"
+#include "multipart.h"
+#include "frame_ring.h"
+#include "stream_clients.h"
+#include "frame_pacer.h"
+#include "capture_power.h"
+#include "http_assets.h"
+#include "trace.h"
+#include "task_stats.h"
+#include "mem_pool.h"
+#include "mem_watch.h"
+
+// Longest a snapshot waits for the camera to publish a frame
+#ifndef SNAPSHOT_WAIT_MS
+#define SNAPSHOT_WAIT_MS  2000
+#endif
 
 typedef struct {
   uint32_t        frame;
   WiFiClient      *client;
   TaskHandle_t    task;
-  char*           buffer;
-  size_t          len;
+  int8_t          id;       // per-client statistics record
+  float           fps;      // requested rate (/mjpeg/1?fps=5), 0 = camera rate
+  framePacer_t    pacer;
 } streamInfo_t;
 
+// Everything a streaming connection keeps, one block of the client pool
 typedef struct {
-  uint8_t   cnt;  // served to clients counter. when equal to number of active clients, could be deleted
-  void*     nxt;  // next chunck
-  uint32_t  fnm;  // frame number
-  uint32_t  siz;  // frame size
-  uint8_t*  dat;  // frame pointer
-} frameChunck_t;
+  streamInfo_t    info;
+  WiFiClient      client;
+} streamConn_t;
+
+extern memPool_t clientPool;
+
+// A zeroed connection record from the client pool, NULL if every record is in use
+streamConn_t* streamConnOpen(void);
+void          streamConnClose(streamConn_t* aConn);
+// Sends 503 and returns true while the memory tier refuses new streams
+bool          streamRefuseLowMemory(void);
 
 
 void camCB(void* pvParameters);
 void handleJPGSstream(void);
 void handleRoot(void);
+void handleAsset(const httpAsset_t* aAsset);
 void handleNotFound(void);
 void handleControl(void);
 void handleStatus(void);
+void handleSnapshot(void);
+void handleMetrics(void);
 void handleReset(void);
 void handleReboot(void);
+void handleTrace(void);
+void handleTasks(void);
 
 // UI asset handlers
 void handleCSS(void);
@@ -35,30 +63,18 @@ void handleJSFPS(void);
 void handleJSStatus(void);
 
 void streamCB(void * pvParameters);
+void captureClientConnected(void);
+float streamRequestedFps(void);
+void startStreamDispatcher(void);
 void mjpegCB(void * pvParameters);
 
-#define FAIL_IF_OOM true
-#define OK_IF_OOM   false
-#define PSRAM_ONLY  true
-#define ANY_MEMORY  false
-char* allocateMemory(char* aPtr, size_t aSize, bool fail = FAIL_IF_OOM, bool psramOnly = ANY_MEMORY);
-
-extern const char* HEADER;
-extern const char* BOUNDARY;
-extern const char* CTNTTYPE;
-extern const int hdrLen;
-extern const int bdrLen;
-extern const int cntLen;
-extern volatile uint32_t frameNumber;
 extern volatile uint32_t clientsConnected;
 extern volatile float currentFPS;
 extern volatile float cameraFPS;
 extern volatile uint32_t currentFrameSize;
+extern volatile size_t   camSize;
 // currentFrameSizeIndex removed - framesize is now fixed at VGA in platformio.ini
 
-extern frameChunck_t* fstFrame;
-extern frameChunck_t* curFrame;
-
 // Streaming control variables
 extern QueueHandle_t streamingClients;
 extern volatile bool streamingFlag;
@@ -0,0 +1,76 @@
+#pragma once
+#include <Arduino.h>
+
+//  Per-task CPU share, stack and placement for /debug/tasks. A low-priority collector task takes
+//  a sample of every task (uxTaskGetSystemState) each TASK_STATS_INTERVAL_MS into a fixed table;
+//  the CPU share is the task's run time over the last TASK_STATS_WINDOW intervals divided by the
+//  time that passed, in percent of one core (all tasks together add up to 200 on two cores).
+//  The aggregation takes plain samples so it can be checked on the host (make task-stats-check).
+//  CPU shares need CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS and every task needs
+//  CONFIG_FREERTOS_USE_TRACE_FACILITY. The prebuilt arduino-esp32 libraries this firmware links
+//  decide both, not sdkconfig.ai-thinker-cam: without run time stats cpu is left out, without
+//  the trace facility only the firmware's own tasks (cam, mjpeg, stream, log, tasks) are listed.
+
+// Tasks tracked; a sample with more leaves the rest out and counts them
+#ifndef TASK_STATS_MAX
+#define TASK_STATS_MAX          32
+#endif
+
+// Intervals the CPU share is averaged over
+#ifndef TASK_STATS_WINDOW
+#define TASK_STATS_WINDOW       10
+#endif
+
+#ifndef TASK_STATS_INTERVAL_MS
+#define TASK_STATS_INTERVAL_MS  1000
+#endif
+
+#define TASK_STATS_NAME         16
+#define TASK_STATS_PRIORITY     (tskIDLE_PRIORITY + 1)
+#define TASK_STATS_STACK_SIZE   3072
+#define TASK_STATS_BUFFER_SIZE  4096   // /debug/tasks page
+
+typedef struct {
+  const void* handle;
+  const char* name;
+  uint32_t    runTime;      // run time counter
+  uint32_t    stackFree;    // least free stack seen, bytes
+  uint32_t    stackSize;    // stack the task was created with, 0 if not known
+  uint8_t     priority;
+  int8_t      core;         // -1: either core
+  uint8_t     state;        // eTaskState
+} taskSample_t;
+
+typedef struct {
+  const void* handle;
+  char        name[TASK_STATS_NAME];
+  uint32_t    run[TASK_STATS_WINDOW + 1];   // run time counter, by sample number
+  uint32_t    first;                        // sample number the task was first seen in
+  uint32_t    stackFree;
+  uint32_t    stackSize;
+  uint8_t     priority;
+  int8_t      core;
+  uint8_t     state;
+  bool        used;
+} taskStatsEntry_t;
+
+typedef struct {
+  taskStatsEntry_t  task[TASK_STATS_MAX];
+  uint32_t          total[TASK_STATS_WINDOW + 1];   // total run time, by sample number
+  uint32_t          samples;                        // samples taken
+  uint32_t          untracked;                      // tasks left out of a sample, table full
+} taskStats_t;
+
+// ==== Aggregation ===========================================================================
+void    taskStatsInit(taskStats_t* s);
+// One sample of every task. Tasks missing from it have ended and are dropped from the table
+void    taskStatsAdd(taskStats_t* s, const taskSample_t* aSamples, size_t aCount, uint32_t aTotalRunTime);
+// CPU share of one core over the window, percent. -1 until a task has two samples or without run time stats
+float   taskStatsCpu(const taskStats_t* s, const taskStatsEntry_t* e);
+// JSON document of the table, 0 if it does not fit
+size_t  taskStatsRender(const taskStats_t* s, char* aBuf, size_t aSize);
+
+// ==== Collector =============================================================================
+void    taskStatsStart();
+// Copy of the table as of the last sample
+void    taskStatsSnapshot(taskStats_t* aCopy);
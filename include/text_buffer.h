@@ -0,0 +1,20 @@
+#pragma once
+#include <Arduino.h>
+
+//  Bounded text appended into a caller-owned buffer, the one place the JSON writer and the
+//  /metrics renderer format into. Nothing is allocated. Text that does not fit marks the buffer
+//  as overflowed, later appends are ignored and textFinish() returns 0.
+
+typedef struct {
+  char*   buf;
+  size_t  size;
+  size_t  len;
+  bool    overflow;
+} textBuffer_t;
+
+void    textInit(textBuffer_t* t, char* aBuf, size_t aSize);
+// Length of the text, 0 if it did not fit. The buffer is NUL-terminated either way
+size_t  textFinish(const textBuffer_t* t);
+
+void    textPrintf(textBuffer_t* t, const char* aFormat, ...) __attribute__ ((format (printf, 2, 3)));
+void    textChar(textBuffer_t* t, char c);
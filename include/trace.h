@@ -0,0 +1,80 @@
+#pragma once
+#include <Arduino.h>
+#include "logging.h"
+
+//  Binary trace for profiling without the UART: with TRACE_LOG defined, every Log call and the
+//  TRACE_BEGIN / TRACE_END points of the camera and streaming tasks append a record to a buffer
+//  in PSRAM. A record holds the id of its format string, the task, a microsecond timestamp and
+//  the raw arguments, nothing is formatted on the device. The buffer keeps the latest records,
+//  /debug/trace downloads it and tools/trace_decode.cpp turns it into a log and a Chrome trace.
+//  Without TRACE_LOG the trace points compile to nothing.
+
+// Bytes of records kept: in PSRAM, or in internal RAM on a board without
+#ifndef TRACE_BUFFER_SIZE
+#define TRACE_BUFFER_SIZE           (512 * 1024)
+#endif
+#ifndef TRACE_BUFFER_SIZE_INTERNAL
+#define TRACE_BUFFER_SIZE_INTERNAL  (16 * 1024)
+#endif
+
+// Distinct format strings and span names, and tasks, a trace tells apart
+#define TRACE_FORMATS               256
+#define TRACE_TASKS                 32
+#define TRACE_TASK_NAME             16
+
+#define TRACE_MAGIC                 "ESPTRACE"
+#define TRACE_VERSION               1
+
+typedef enum {
+  TRACE_KIND_MESSAGE = 0,   // Log call: level, format, arguments
+  TRACE_KIND_BEGIN,         // span start, the format is the span name
+  TRACE_KIND_END,
+  TRACE_KIND_PAD,           // rest of the buffer unused, records go on at its start
+} traceKind_t;
+
+//  Record header, the raw arguments (see logArg_t) follow
+typedef struct __attribute__ ((packed)) {
+  uint8_t   kind;
+  uint8_t   size;       // bytes of arguments
+  uint8_t   task;       // index in the task table, TRACE_TASKS if it is full
+  uint8_t   level;
+  uint16_t  format;     // index in the format table, TRACE_FORMATS if it is full
+  uint32_t  time;       // esp_timer_get_time(), low 32 bits
+} traceRecord_t;
+
+//  /debug/trace file, little-endian:
+//    header, formats times { uint16 length, text }, tasks times { uint8 length, name },
+//    bytes of records, oldest first
+typedef struct __attribute__ ((packed)) {
+  char      magic[8];
+  uint16_t  version;
+  uint16_t  formats;
+  uint16_t  tasks;
+  uint16_t  header;     // sizeof(traceRecord_t)
+  uint32_t  bytes;
+  uint32_t  lost;       // records overwritten by newer ones
+  uint32_t  dropped;    // records not taken: no buffer, or a download was running
+} traceFileHeader_t;
+
+typedef struct {
+  uint32_t  records;
+  uint32_t  lost;
+  uint32_t  dropped;
+} traceStats_t;
+
+extern traceStats_t traceStats;
+
+// Allocate the buffer. Records before this are dropped
+void    traceInit();
+void    traceWrite(uint8_t aKind, uint8_t aLevel, const char* aFormat, const uint8_t* aArgs, size_t aSize);
+void    traceClear();
+// Stop recording and send the trace file in pieces through aSend; recording resumes after
+size_t  traceDump(void (*aSend)(void* aCtx, const char* aData, size_t aLen), void* aCtx);
+
+#if defined(TRACE_LOG)
+#define TRACE_BEGIN(name)   traceWrite(TRACE_KIND_BEGIN, 0, name, NULL, 0)
+#define TRACE_END(name)     traceWrite(TRACE_KIND_END, 0, name, NULL, 0)
+#else
+#define TRACE_BEGIN(name)
+#define TRACE_END(name)
+#endif
@@ -0,0 +1,49 @@
+#include "allocator.h"
+#include "logging.h"
+
+uint32_t allocFailures = 0;  // FAIL_IF_OOM allocations that found no memory: no fallback was left
+
+// ==== Memory allocator that takes advantage of PSRAM if present =======================
+char* allocatePSRAM(size_t aSize) {
+  if ( psramFound() && ESP.getFreePsram() > aSize ) {
+    return (char*) ps_malloc(aSize);
+  }
+  return NULL;
+}
+
+char* allocateMemory(char* aPtr, size_t aSize, bool fail, bool psramOnly) {
+
+  //  Since current buffer is too smal, free it
+  if (aPtr != NULL) {
+    free(aPtr);
+    aPtr = NULL;
+  }
+
+  char* ptr = NULL;
+
+  if ( psramOnly ) {
+    ptr = allocatePSRAM(aSize);
+  }
+  else {
+    // If memory requested is more than 2/3 of the currently free heap, try PSRAM immediately
+    if ( aSize > ESP.getFreeHeap() * 2 / 3 ) {
+      ptr = allocatePSRAM(aSize);
+    }
+    else {
+      //  Enough free heap - let's try allocating fast RAM as a buffer
+      ptr = (char*) malloc(aSize);
+
+      //  If allocation on the heap failed, let's give PSRAM one more chance:
+      if ( ptr == NULL ) ptr = allocatePSRAM(aSize);
+    }
+  }
+
+  //  No restart here: the memory watch sees the failure count and sheds load first.
+  //  OK_IF_OOM callers have a smaller or other allocation to fall back on and are not counted
+  if ( ptr == NULL && fail ) {
+    allocFailures++;
+    Log.error("allocateMemory: failed to allocate %d bytes\n", aSize);
+  }
+
+  return ptr;
+}
@@ -0,0 +1,100 @@
+//  === Camera control registry ======================================================================
+//  The descriptor table and its perfect hash are built by the compiler from CAMERA_CONTROLS:
+//  nothing is set up at run time and a name that is not in the table costs one hash.
+
+#include "camera_controls.h"
+#include "camera_settings.h"
+#include "logging.h"
+
+// Setters take int; a few sensor setters take an enum instead
+template <typename T>
+static int controlCall(int (*aSet)(sensor_t*, T), sensor_t* s, int aValue) {
+  return aSet(s, (T) aValue);
+}
+
+#define CONTROL_ACCESSORS(id, name, key, setter, field, kind, lo, hi, def) \
+  static int controlSet##id(sensor_t* s, int aValue) { return controlCall(s->setter, s, aValue); } \
+  static int controlGet##id(const sensor_t* s) { return s->status.field; }
+CAMERA_CONTROLS(CONTROL_ACCESSORS)
+
+#define CONTROL_ENTRY(id, name, key, setter, field, kind, lo, hi, def) \
+  { name, key, controlSet##id, controlGet##id, CAMERA_SETTING_##id, kind, lo, hi, def },
+constexpr cameraControl_t cameraControls[CAMERA_SETTINGS] = {
+  CAMERA_CONTROLS(CONTROL_ENTRY)
+};
+
+// ==== Perfect hash: FNV-1a from a seed, the top bits are the slot ========================
+#define CONTROL_SLOT_BITS   6
+#define CONTROL_SLOTS       (1 << CONTROL_SLOT_BITS)
+#define CONTROL_NONE        0xff
+#define CONTROL_SEED_TRIES  400   // seeds tried, within the compiler's constexpr depth
+
+static_assert(CAMERA_SETTINGS < CONTROL_SLOTS / 2, "more controls than the hash has room for, raise CONTROL_SLOT_BITS");
+
+constexpr uint32_t controlHash(const char* aName, uint32_t aHash) {
+  return *aName ? controlHash(aName + 1, (aHash ^ (uint8_t) *aName) * 0x01000193u) : aHash;
+}
+
+constexpr uint8_t controlSlot(const char* aName, uint32_t aSeed) {
+  return controlHash(aName, aSeed) >> (32 - CONTROL_SLOT_BITS);
+}
+
+// No control after aFirst shares a slot with control aIndex
+constexpr bool controlAlone(uint32_t aSeed, int aIndex, int aFirst) {
+  return aFirst >= CAMERA_SETTINGS ||
+         (controlSlot(cameraControls[aIndex].name, aSeed) != controlSlot(cameraControls[aFirst].name, aSeed) &&
+          controlAlone(aSeed, aIndex, aFirst + 1));
+}
+
+constexpr bool controlSeedPerfect(uint32_t aSeed, int aIndex) {
+  return aIndex >= CAMERA_SETTINGS || (controlAlone(aSeed, aIndex, aIndex + 1) && controlSeedPerfect(aSeed, aIndex + 1));
+}
+
+constexpr uint32_t controlFindSeed(uint32_t aSeed, uint32_t aLast) {
+  return aSeed == aLast || controlSeedPerfect(aSeed, 0) ? aSeed : controlFindSeed(aSeed + 1, aLast);
+}
+
+constexpr uint32_t controlSeed = controlFindSeed(0, CONTROL_SEED_TRIES);
+static_assert(controlSeed < CONTROL_SEED_TRIES, "no perfect hash seed for the control names, raise CONTROL_SLOT_BITS");
+
+// Control owning aSlot, searched from aIndex
+constexpr uint8_t controlOwner(int aSlot, int aIndex) {
+  return aIndex >= CAMERA_SETTINGS ? CONTROL_NONE
+       : controlSlot(cameraControls[aIndex].name, controlSeed) == aSlot ? aIndex
+       : controlOwner(aSlot, aIndex + 1);
+}
+
+// Slot table: controlSlotTable(controlSlotSequence<CONTROL_SLOTS>::type()) lists the owner of every slot
+template <int... I> struct controlSlotList {};
+template <int N, int... I> struct controlSlotSequence : controlSlotSequence<N - 1, N - 1, I...> {};
+template <int... I> struct controlSlotSequence<0, I...> { typedef controlSlotList<I...> type; };
+
+typedef struct {
+  uint8_t owner[CONTROL_SLOTS];
+} controlSlots_t;
+
+template <int... I>
+constexpr controlSlots_t controlSlotTable(controlSlotList<I...>) {
+  return controlSlots_t{ { controlOwner(I, 0)... } };
+}
+
+static constexpr controlSlots_t controlSlots = controlSlotTable(controlSlotSequence<CONTROL_SLOTS>::type());
+
+const cameraControl_t* cameraControlFind(const char* aName) {
+  uint32_t h = controlSeed;
+  for (const char* p = aName; *p; p++) h = (h ^ (uint8_t) *p) * 0x01000193u;
+  uint8_t owner = controlSlots.owner[h >> (32 - CONTROL_SLOT_BITS)];
+  if ( owner == CONTROL_NONE || strcmp(cameraControls[owner].name, aName) ) return NULL;
+  return &cameraControls[owner];
+}
+
+// ==== Boot: settings the user changed override the sensor defaults ======================
+void cameraControlsApply(sensor_t* s) {
+  for (int i = 0; i < CAMERA_SETTINGS; i++) {
+    const cameraControl_t* c = &cameraControls[i];
+    int32_t v;
+    if ( !cameraSettingsStored(c->setting, &v) ) continue;
+    if ( c->set(s, v) == 0 ) Log.notice("setup: Loaded %s = %d\n", c->name, (int) v);
+    else Log.warning("setup: Could not apply %s = %d\n", c->name, (int) v);
+  }
+}
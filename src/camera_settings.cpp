@@ -0,0 +1,144 @@
+//  === Camera settings store ========================================================================
+//  The settings live in RAM; NVS holds a copy written at most once per quiet period. On the
+//  device every Preferences put is an NVS commit, so one putBytes() of the blob is one flash
+//  write however many settings changed.
+
+#include "camera_settings.h"
+#include "logging.h"
+#include <Preferences.h>
+
+static_assert(CAMERA_SETTINGS <= 32, "cameraSettingsBlob_t.stored has a bit per setting");
+
+cameraSettingsStats_t cameraSettingsStats = { 0, 0, 0 };
+
+static cameraSettingsBlob_t settings;
+static bool     dirty = false;
+static uint32_t firstChange = 0;   // millis() of the oldest change not saved
+static uint32_t lastChange = 0;    // millis() of the newest one
+
+static void setDefaults() {
+  settings.version = CAMERA_SETTINGS_VERSION;
+  settings.count = CAMERA_SETTINGS;
+  settings.stored = 0;
+  for (int i = 0; i < CAMERA_SETTINGS; i++) settings.value[i] = cameraControls[i].def;
+}
+
+// Blob written by this or an older firmware with fewer settings, read into settings
+static bool readBlob(Preferences* aPrefs) {
+  const size_t header = offsetof(cameraSettingsBlob_t, value);
+  size_t len = aPrefs->getBytesLength(CAMERA_SETTINGS_KEY);
+  if ( len < header || len > sizeof(cameraSettingsBlob_t) ) return false;
+
+  cameraSettingsBlob_t blob;
+  if ( aPrefs->getBytes(CAMERA_SETTINGS_KEY, &blob, len) != len ) return false;
+  if ( blob.version != CAMERA_SETTINGS_VERSION || blob.count > CAMERA_SETTINGS ||
+       len != header + blob.count * sizeof(blob.value[0]) ) return false;
+
+  for (int i = 0; i < blob.count; i++) settings.value[i] = blob.value[i];
+  settings.stored = blob.stored & ((1ul << blob.count) - 1);
+  return true;
+}
+
+// Per-setting keys of older firmware: returns true if there were any
+static bool readLegacy(Preferences* aPrefs) {
+  for (int i = 0; i < CAMERA_SETTINGS; i++) {
+    if ( !aPrefs->isKey(cameraControls[i].key) ) continue;
+    settings.value[i] = aPrefs->getInt(cameraControls[i].key, cameraControls[i].def);
+    settings.stored |= 1ul << i;
+  }
+  return settings.stored != 0;
+}
+
+// Without the padding at the end, a blob is exactly as long as its count says
+static bool save(Preferences* aPrefs) {
+  const size_t len = offsetof(cameraSettingsBlob_t, value) + sizeof(settings.value);
+  if ( aPrefs->putBytes(CAMERA_SETTINGS_KEY, &settings, len) != len ) {
+    cameraSettingsStats.failures++;
+    Log.error("cameraSettings: could not write %d bytes to NVS\n", (int) len);
+    return false;
+  }
+  cameraSettingsStats.saves++;
+  return true;
+}
+
+// ==== Boot: blob, else the keys of older firmware rewritten as a blob, else defaults =====
+void cameraSettingsLoad() {
+  setDefaults();
+  dirty = false;
+
+  Preferences prefs;
+  if ( !prefs.begin(CAMERA_SETTINGS_NAMESPACE, false) ) {
+    Log.error("cameraSettings: could not open NVS, using defaults\n");
+    return;
+  }
+  if ( prefs.isKey(CAMERA_SETTINGS_KEY) ) {
+    if ( !readBlob(&prefs) ) {
+      setDefaults();
+      Log.warning("cameraSettings: unreadable settings blob, using defaults\n");
+    }
+  }
+  else if ( readLegacy(&prefs) ) {
+    //  Once: the old keys go, so the namespace only ever holds the blob
+    prefs.clear();
+    if ( save(&prefs) ) Log.notice("cameraSettings: migrated per-setting keys into one blob\n");
+  }
+  prefs.end();
+  Log.notice("cameraSettings: %d settings loaded, %d changed by the user\n",
+             CAMERA_SETTINGS, __builtin_popcount(settings.stored));
+}
+
+bool cameraSettingsStored(cameraSetting_t aSetting, int32_t* aValue) {
+  if ( !(settings.stored & (1ul << aSetting)) ) return false;
+  *aValue = settings.value[aSetting];
+  return true;
+}
+
+int32_t cameraSettingsGet(cameraSetting_t aSetting) {
+  return settings.value[aSetting];
+}
+
+// ==== A change is recorded in RAM, the save is pushed back while changes keep coming ======
+void cameraSettingsSet(cameraSetting_t aSetting, int32_t aValue, uint32_t aNow) {
+  cameraSettingsStats.changes++;
+  if ( (settings.stored & (1ul << aSetting)) && settings.value[aSetting] == aValue ) return;
+
+  settings.value[aSetting] = (int16_t) aValue;
+  settings.stored |= 1ul << aSetting;
+  if ( !dirty ) firstChange = aNow;
+  lastChange = aNow;
+  dirty = true;
+}
+
+bool cameraSettingsTick(uint32_t aNow) {
+  if ( !dirty ) return false;
+  if ( aNow - lastChange < CAMERA_SETTINGS_SAVE_MS && aNow - firstChange < CAMERA_SETTINGS_SAVE_MAX_MS ) return false;
+  return cameraSettingsFlush();
+}
+
+bool cameraSettingsFlush() {
+  if ( !dirty ) return false;
+  Preferences prefs;
+  bool saved = false;
+  if ( prefs.begin(CAMERA_SETTINGS_NAMESPACE, false) ) {
+    saved = save(&prefs);
+    prefs.end();
+  }
+  else {
+    cameraSettingsStats.failures++;
+    Log.error("cameraSettings: could not open NVS for saving\n");
+  }
+  //  A failed write stays pending and is retried after the next quiet period
+  if ( saved ) dirty = false;
+  else lastChange = firstChange = millis();
+  return saved;
+}
+
+void cameraSettingsClear() {
+  Preferences prefs;
+  if ( prefs.begin(CAMERA_SETTINGS_NAMESPACE, false) ) {
+    prefs.clear();
+    prefs.end();
+  }
+  setDefaults();
+  dirty = false;
+}
@@ -0,0 +1,96 @@
+//  === Capture power state machine ==================================================================
+//  Connects come from the web server task, disconnects from the streaming side and ticks
+//  and frames from the camera task, so every transition is taken under one lock.
+
+#include "capture_power.h"
+
+capturePower_t capturePower = { CAPTURE_WARM, 0, 0, 0, CAPTURE_WARM, 0, 0, 0, 0, 0, 0 };
+
+static portMUX_TYPE powerMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Called under powerMux
+static void enter(captureState_t aState, uint32_t aNow) {
+  if ( aState == CAPTURE_IDLE ) capturePower.sleeps++;
+  if ( capturePower.state == CAPTURE_IDLE ) capturePower.wakes++;
+  capturePower.state = aState;
+  capturePower.since = aNow;
+}
+
+// ==== Camera is running at boot: start warm and go to standby if nobody connects ========
+void capturePowerInit(uint32_t aNow) {
+  portENTER_CRITICAL(&powerMux);
+  capturePower.state = CAPTURE_WARM;
+  capturePower.clients = 0;
+  capturePower.since = aNow;
+  capturePower.wakeAt = 0;
+  portEXIT_CRITICAL(&powerMux);
+}
+
+// ==== A streaming client connected. Returns the state it found ==========================
+// CAPTURE_IDLE means the camera task has to be woken up
+captureState_t capturePowerConnect(uint32_t aNow) {
+  portENTER_CRITICAL(&powerMux);
+  captureState_t from = capturePower.state;
+  capturePower.clients++;
+  if ( from != CAPTURE_STREAMING ) {
+    //  Time to first frame is measured for the first connect only, later ones find it pending
+    if ( capturePower.wakeAt == 0 ) {
+      capturePower.wakeAt = aNow ? aNow : 1;
+      capturePower.wakeFrom = from;
+    }
+    enter(CAPTURE_STREAMING, aNow);
+  }
+  portEXIT_CRITICAL(&powerMux);
+  return from;
+}
+
+// ==== A streaming client went away ======================================================
+void capturePowerDisconnect(uint32_t aNow) {
+  portENTER_CRITICAL(&powerMux);
+  if ( capturePower.clients ) capturePower.clients--;
+  if ( capturePower.clients == 0 && capturePower.state == CAPTURE_STREAMING ) {
+    capturePower.wakeAt = 0;
+    enter(CAPTURE_WARM, aNow);
+  }
+  portEXIT_CRITICAL(&powerMux);
+}
+
+// ==== Camera task: state to run in, moving warm to idle once the warm period is over =====
+captureState_t capturePowerTick(uint32_t aNow) {
+  portENTER_CRITICAL(&powerMux);
+  if ( capturePower.state == CAPTURE_WARM && aNow - capturePower.since >= CAPTURE_WARM_MS ) {
+    enter(CAPTURE_IDLE, aNow);
+  }
+  captureState_t st = capturePower.state;
+  portEXIT_CRITICAL(&powerMux);
+  return st;
+}
+
+// ==== Camera task: a frame was published ================================================
+void capturePowerFrame(uint32_t aNow) {
+  if ( capturePower.wakeAt == 0 ) return;
+
+  portENTER_CRITICAL(&powerMux);
+  if ( capturePower.wakeAt ) {
+    uint32_t ttff = aNow - capturePower.wakeAt;
+    if ( capturePower.wakeFrom == CAPTURE_IDLE ) {
+      capturePower.ttffCold = ttff;
+      if ( ttff > capturePower.ttffColdMax ) capturePower.ttffColdMax = ttff;
+    }
+    else {
+      capturePower.ttffWarm = ttff;
+      if ( ttff > capturePower.ttffWarmMax ) capturePower.ttffWarmMax = ttff;
+    }
+    capturePower.wakeAt = 0;
+  }
+  portEXIT_CRITICAL(&powerMux);
+}
+
+const char* capturePowerName(captureState_t aState) {
+  switch ( aState ) {
+    case CAPTURE_IDLE:      return "idle";
+    case CAPTURE_WARM:      return "warm";
+    case CAPTURE_STREAMING: return "streaming";
+  }
+  return "unknown";
+}
@@ -0,0 +1,49 @@
+//  === Token-bucket frame pacing ====================================================================
+
+#include "frame_pacer.h"
+
+void framePacerInit(framePacer_t* aPacer, float aFps, int64_t aNow) {
+  aPacer->interval = aFps > 0 ? (uint32_t) (1000000.0 / aFps) : 0;
+  aPacer->own = aPacer->interval;
+  aPacer->credit = aPacer->interval;  // first frame goes out right away
+  aPacer->last = aNow;
+}
+
+static void refill(framePacer_t* aPacer, int64_t aNow) {
+  aPacer->credit += aNow - aPacer->last;
+  aPacer->last = aNow;
+  const int64_t cap = aPacer->interval + aPacer->interval / 2;
+  if ( aPacer->credit > cap ) aPacer->credit = cap;
+}
+
+// ==== Should a frame available at aNow be sent? Spends the credit if so ==================
+bool framePacerTake(framePacer_t* aPacer, int64_t aNow) {
+  if ( aPacer->interval == 0 ) return true;
+  refill(aPacer, aNow);
+  if ( aPacer->credit < (int64_t) aPacer->interval ) return false;
+  aPacer->credit -= aPacer->interval;
+  return true;
+}
+
+// ==== A taken frame was not sent: the client may have the next one instead ==============
+void framePacerRefund(framePacer_t* aPacer) {
+  aPacer->credit += aPacer->interval;
+}
+
+// ==== Milliseconds until the next frame may be sent =====================================
+uint32_t framePacerDelayMs(const framePacer_t* aPacer, int64_t aNow) {
+  if ( aPacer->interval == 0 ) return 0;
+  int64_t missing = (int64_t) aPacer->interval - (aPacer->credit + (aNow - aPacer->last));
+  return missing > 0 ? (uint32_t) ((missing + 999) / 1000) : 0;
+}
+
+// ==== Rate cap on top of the client's own rate, e.g. while memory is short ===============
+// Credit is kept within the new bucket, so lifting or lowering the cap never lets a burst out
+void framePacerCap(framePacer_t* aPacer, float aFps) {
+  uint32_t cap = aFps > 0 ? (uint32_t) (1000000.0 / aFps) : 0;
+  uint32_t interval = cap > aPacer->own ? cap : aPacer->own;
+  if ( interval == aPacer->interval ) return;
+  aPacer->interval = interval;
+  const int64_t most = interval + interval / 2;
+  if ( aPacer->credit > most ) aPacer->credit = most;
+}
@@ -0,0 +1,273 @@
+//  === Reference-counted frame ring =================================================================
+//  Camera task fills a free slot and publishes it as the current frame.
+//  Streaming tasks take a reference on the current frame, send it straight from the slot
+//  and drop the reference. The lock only guards pointer and counter updates, never a copy or a send.
+//  In zero-copy mode a slot points straight into a camera frame buffer, which goes back to the
+//  driver once the slot is neither current nor referenced by any client.
+//  Publishing notifies every subscribed task, so streaming tasks block between frames instead of polling.
+//  Slot buffers come from a pool of blocks as large as the largest frame, so a slot never has to
+//  give its buffer back to grow it.
+
+#include "frame_ring.h"
+#include "allocator.h"
+#include "logging.h"
+#include "esp_timer.h"
+
+frameChunck_t*   fstFrame = NULL;  // first slot of the frame ring
+frameChunck_t*   curFrame = NULL;  // most recently published frame
+volatile uint32_t frameNumber;
+frameRingStats_t frameRingStats = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+frameSource_t    frameSource = { esp_camera_fb_get, esp_camera_fb_return };
+memPool_t        framePool;
+
+// The driver captures a JPEG into a buffer of width * height / FRAME_JPEG_RATIO bytes
+#define FRAME_JPEG_RATIO      5
+#define FRAME_SLOT_FALLBACK   (128 * 1024)   // sensor frame size not known
+
+static portMUX_TYPE ringMux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t waiters[FRAME_WAITERS_MAX];
+static uint8_t      waiterCount = 0;
+static uint8_t      slotCount = 0;
+static uint8_t      depth = 0;      // slots a new frame may go into, the first ones of the ring
+
+// Largest frame the sensor can deliver at its frame size
+static size_t frameSlotSize() {
+  sensor_t* s = esp_camera_sensor_get();
+  framesize_t fs = s ? (framesize_t) s->status.framesize : FRAMESIZE_INVALID;
+  if ( fs >= FRAMESIZE_INVALID ) return FRAME_SLOT_FALLBACK;
+  return (size_t) resolution[fs].width * resolution[fs].height / FRAME_JPEG_RATIO;
+}
+
+// ==== Allocate ring slots and the pool of their buffers ================================
+// A slot takes a buffer from the pool on its first copy and keeps it
+bool frameRingInit(uint8_t aSlots, size_t aSlotSize) {
+  if ( fstFrame ) return true;
+  if ( aSlots < 2 ) aSlots = 2;
+
+  if ( !memPoolInit(&framePool, "frame", aSlotSize ? aSlotSize : frameSlotSize(), aSlots, 2, PSRAM_ONLY) ) {
+    return false;
+  }
+
+  frameChunck_t* slots = (frameChunck_t*) calloc(aSlots, sizeof(frameChunck_t));
+  if ( slots == NULL ) {
+    Log.error("frameRingInit: cannot allocate %d slots\n", aSlots);
+    return false;
+  }
+  for (int i = 0; i < aSlots; i++) {
+    slots[i].nxt = &slots[(i + 1) % aSlots];
+  }
+  fstFrame = slots;
+  curFrame = NULL;
+  slotCount = depth = aSlots;
+  return true;
+}
+
+// ==== Find a slot nobody is reading ====================================================
+// Only the camera task reserves and publishes, and clients only take references on the
+// current frame, so a free slot cannot be grabbed by anyone else once found.
+// Copies prefer slots that already own a buffer and zero-copy frames prefer slots that do not,
+// so buffers are only allocated for as many slots as slow clients actually keep busy
+static frameChunck_t* findFreeSlot(bool aBuffered) {
+  frameChunck_t* f = curFrame ? (frameChunck_t*) curFrame->nxt : fstFrame;
+  frameChunck_t* any = NULL;
+
+  for (frameChunck_t* p = f; ; ) {
+    if ( p != curFrame && p->cnt == 0 && p - fstFrame < depth ) {
+      if ( (p->cap > 0) == aBuffered ) return p;
+      if ( any == NULL ) any = p;
+    }
+    p = (frameChunck_t*) p->nxt;
+    if ( p == f ) return any;
+  }
+}
+
+// ==== Camera side: free slot with its own buffer of at least aSize bytes ================
+frameChunck_t* frameRingReserve(size_t aSize) {
+  if ( aSize > framePool.size ) {
+    frameRingStats.oversize++;
+    return NULL;
+  }
+
+  portENTER_CRITICAL(&ringMux);
+  frameChunck_t* found = findFreeSlot(true);
+  portEXIT_CRITICAL(&ringMux);
+
+  if ( found == NULL ) {
+    __atomic_fetch_add(&frameRingStats.overruns, 1, __ATOMIC_RELAXED);
+    return NULL;
+  }
+
+  //  A slot without a buffer yet takes one; with the pool short of blocks the frame is dropped
+  if ( found->buf == NULL ) {
+    found->buf = (uint8_t*) memPoolAlloc(&framePool);
+    if ( found->buf == NULL ) {
+      __atomic_fetch_add(&frameRingStats.overruns, 1, __ATOMIC_RELAXED);
+      return NULL;
+    }
+    found->cap = framePool.size;
+  }
+  found->dat = found->buf;
+  return found;
+}
+
+// ==== Camera side: free slot pointing at the camera frame buffer itself =================
+// Returns NULL when the ring already keeps FRAME_FB_HOLD_MAX driver buffers - the driver
+// would run out of buffers to capture into, so the caller has to copy the frame instead.
+frameChunck_t* frameRingAttach(camera_fb_t* aFb) {
+  frameChunck_t* found = NULL;
+
+  portENTER_CRITICAL(&ringMux);
+  if ( frameRingStats.fbHeld < FRAME_FB_HOLD_MAX ) {
+    found = findFreeSlot(false);
+    if ( found ) {
+      found->fb = aFb;
+      found->dat = aFb->buf;
+      found->siz = aFb->len;
+      found->tsp = aFb->timestamp;
+      frameRingStats.fbHeld++;
+    }
+  }
+  portEXIT_CRITICAL(&ringMux);
+
+  if ( found ) frameRingStats.zeroCopy++;
+  return found;
+}
+
+// Called under ringMux: detach the camera buffer of a slot that has just become free
+static camera_fb_t* retireSlot(frameChunck_t* aFrame) {
+  camera_fb_t* fb = NULL;
+  if ( aFrame && aFrame != curFrame && aFrame->cnt == 0 && aFrame->fb ) {
+    fb = aFrame->fb;
+    aFrame->fb = NULL;
+    frameRingStats.fbHeld--;
+  }
+  return fb;
+}
+
+// ==== Camera side: make a filled slot the current frame =================================
+// The slot's part header is rendered here, once, for every client to send as is.
+// Only the camera task publishes, so the next frame number is known before taking the lock
+void frameRingPublish(frameChunck_t* aFrame) {
+#if MJPEG_X_HEADERS
+  aFrame->hln = mjpegPartHeader(aFrame->hdr, sizeof(aFrame->hdr), aFrame->siz, frameNumber + 1, &aFrame->tsp);
+#else
+  aFrame->hln = mjpegPartHeader(aFrame->hdr, sizeof(aFrame->hdr), aFrame->siz);
+#endif
+
+  aFrame->pus = esp_timer_get_time();
+
+  portENTER_CRITICAL(&ringMux);
+  frameChunck_t* prev = curFrame;
+  aFrame->fnm = frameNumber + 1;
+  curFrame = aFrame;
+  frameNumber = aFrame->fnm;
+  camera_fb_t* fb = retireSlot(prev);
+  TaskHandle_t notify[FRAME_WAITERS_MAX];
+  uint8_t n = waiterCount;
+  memcpy(notify, waiters, n * sizeof(TaskHandle_t));
+  portEXIT_CRITICAL(&ringMux);
+
+  if ( fb ) frameSource.ret(fb);
+  frameRingStats.published++;
+
+  //  Wake everyone waiting for a frame. The notification stays pending for a task that is
+  //  not waiting yet, so a publish between its check and its wait is not lost
+  for (uint8_t i = 0; i < n; i++) {
+    xTaskNotify(notify[i], aFrame->fnm, eSetValueWithOverwrite);
+  }
+  __atomic_fetch_add(&frameRingStats.notifies, n, __ATOMIC_RELAXED);
+}
+
+// ==== Client side: reference the current frame if it is newer than aLastFrame ===========
+frameChunck_t* frameRingAcquire(uint32_t aLastFrame) {
+  frameChunck_t* f = NULL;
+
+  portENTER_CRITICAL(&ringMux);
+  if ( curFrame && curFrame->fnm != aLastFrame ) {
+    f = curFrame;
+    f->cnt++;
+  }
+  portEXIT_CRITICAL(&ringMux);
+  return f;
+}
+
+// ==== Client side: done sending the frame ===============================================
+void frameRingRelease(frameChunck_t* aFrame) {
+  portENTER_CRITICAL(&ringMux);
+  if ( aFrame->cnt ) aFrame->cnt--;
+  camera_fb_t* fb = retireSlot(aFrame);
+  portEXIT_CRITICAL(&ringMux);
+
+  //  Last client done with an old zero-copy frame - give the buffer back to the driver
+  if ( fb ) frameSource.ret(fb);
+}
+
+// ==== Camera side: stop offering the current frame =======================================
+// Used when capture pauses, so a client connecting later waits for a fresh frame instead of
+// getting a stale one; a zero-copy buffer goes back to the driver once nobody reads it
+void frameRingClear(void) {
+  portENTER_CRITICAL(&ringMux);
+  frameChunck_t* prev = curFrame;
+  curFrame = NULL;
+  camera_fb_t* fb = retireSlot(prev);
+  portEXIT_CRITICAL(&ringMux);
+
+  if ( fb ) frameSource.ret(fb);
+}
+
+// ==== Use only the first aSlots slots for new frames ====================================
+// Fewer slots means fewer frames in flight: a slow client skips to the newest frame instead
+// of holding an older one while the camera fills the rest. Slots beyond the depth drain as
+// their clients move on
+void frameRingSetDepth(uint8_t aSlots) {
+  if ( aSlots < 2 ) aSlots = 2;
+  portENTER_CRITICAL(&ringMux);
+  depth = aSlots < slotCount ? aSlots : slotCount;
+  portEXIT_CRITICAL(&ringMux);
+}
+
+uint8_t frameRingDepth(void) {
+  return depth;
+}
+
+// ==== Frame-ready notifications ========================================================
+bool frameRingSubscribe(TaskHandle_t aTask) {
+  bool ok = false;
+  portENTER_CRITICAL(&ringMux);
+  for (uint8_t i = 0; i < waiterCount; i++) {
+    if ( waiters[i] == aTask ) ok = true;
+  }
+  if ( !ok && waiterCount < FRAME_WAITERS_MAX ) {
+    waiters[waiterCount++] = aTask;
+    ok = true;
+  }
+  portEXIT_CRITICAL(&ringMux);
+  return ok;
+}
+
+void frameRingUnsubscribe(TaskHandle_t aTask) {
+  portENTER_CRITICAL(&ringMux);
+  for (uint8_t i = 0; i < waiterCount; i++) {
+    if ( waiters[i] == aTask ) {
+      waiters[i] = waiters[--waiterCount];
+      break;
+    }
+  }
+  portEXIT_CRITICAL(&ringMux);
+}
+
+// Block the calling (subscribed) task until a frame other than aLastFrame is published
+// or aTimeout expires. Returns the current frame number, aLastFrame while no frame is current
+uint32_t frameRingWait(uint32_t aLastFrame, TickType_t aTimeout) {
+  frameChunck_t* f = curFrame;
+  if ( f && f->fnm != aLastFrame ) return f->fnm;
+
+  uint32_t fnm;
+  if ( xTaskNotifyWait(0, 0, &fnm, aTimeout) != pdTRUE ) {
+    f = curFrame;
+    fnm = f ? f->fnm : aLastFrame;
+  }
+  //  Every subscribed task counts its own wakeups, on either core
+  __atomic_fetch_add(&frameRingStats.wakeups, 1, __ATOMIC_RELAXED);
+  return fnm;
+}
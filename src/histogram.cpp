@@ -0,0 +1,65 @@
+//  === Log-bucket latency histogram ==================================================================
+
+#include "histogram.h"
+
+uint8_t histogramBucket(uint32_t aValue) {
+  if ( aValue < HISTOGRAM_SUB_BUCKETS ) return aValue;
+  uint8_t msb = 31 - __builtin_clz(aValue);
+  uint32_t b = HISTOGRAM_SUB_BUCKETS * (msb - 1) + ((aValue >> (msb - 2)) & (HISTOGRAM_SUB_BUCKETS - 1));
+  return b < HISTOGRAM_BUCKETS ? b : HISTOGRAM_BUCKETS - 1;
+}
+
+uint32_t histogramBucketUpper(uint8_t aBucket) {
+  if ( aBucket < HISTOGRAM_SUB_BUCKETS ) return aBucket;
+  uint8_t msb = aBucket / HISTOGRAM_SUB_BUCKETS + 1;
+  uint32_t sub = aBucket % HISTOGRAM_SUB_BUCKETS;
+  return ((HISTOGRAM_SUB_BUCKETS + sub + 1) << (msb - 2)) - 1;
+}
+
+// ==== Any task, any core: no lock, one atomic add ======================================
+void histogramAdd(histogram_t* aHist, uint32_t aValue) {
+  __atomic_fetch_add(&aHist->bucket[histogramBucket(aValue)], 1, __ATOMIC_RELAXED);
+
+  uint32_t m = __atomic_load_n(&aHist->max, __ATOMIC_RELAXED);
+  while ( aValue > m &&
+          !__atomic_compare_exchange_n(&aHist->max, &m, aValue, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED) ) {
+  }
+}
+
+uint32_t histogramCount(const histogram_t* aHist) {
+  uint32_t n = 0;
+  for (int i = 0; i < HISTOGRAM_BUCKETS; i++) n += __atomic_load_n(&aHist->bucket[i], __ATOMIC_RELAXED);
+  return n;
+}
+
+// ==== Walk the buckets up to the rank of the quantile ===================================
+// Counts are read once into a local copy so the rank and the walk agree
+uint32_t histogramPercentile(const histogram_t* aHist, float aQuantile) {
+  uint32_t counts[HISTOGRAM_BUCKETS];
+  uint32_t n = 0;
+  for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+    counts[i] = __atomic_load_n(&aHist->bucket[i], __ATOMIC_RELAXED);
+    n += counts[i];
+  }
+  if ( n == 0 ) return 0;
+
+  uint32_t rank = (uint32_t) (aQuantile * n + 0.999f);
+  if ( rank < 1 ) rank = 1;
+  if ( rank > n ) rank = n;
+
+  uint32_t seen = 0;
+  uint32_t max = __atomic_load_n(&aHist->max, __ATOMIC_RELAXED);
+  for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+    seen += counts[i];
+    if ( seen >= rank ) {
+      uint32_t upper = histogramBucketUpper(i);
+      return upper < max ? upper : max;
+    }
+  }
+  return max;
+}
+
+void histogramReset(histogram_t* aHist) {
+  for (int i = 0; i < HISTOGRAM_BUCKETS; i++) __atomic_store_n(&aHist->bucket[i], 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&aHist->max, 0, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,47 @@
+//  === Embedded static assets =======================================================================
+
+#include "http_assets.h"
+#include "http_cache.h"
+#include "asset_manifest.h"
+#include "logging.h"
+#include <SPIFFS.h>
+
+const uint32_t httpAssetVersion = ASSET_VERSION;
+
+static uint32_t overrides[ASSET_COUNT];
+
+// ==== Binary search: the generator sorts the table by path ==============================
+const httpAsset_t* httpAssetFind(const char* aPath) {
+  size_t lo = 0, hi = ASSET_COUNT;
+  while ( lo < hi ) {
+    size_t mid = (lo + hi) / 2;
+    int c = strcmp(aPath, assetManifest[mid].path);
+    if ( c == 0 ) return &assetManifest[mid];
+    if ( c < 0 ) hi = mid;
+    else lo = mid + 1;
+  }
+  return NULL;
+}
+
+// ==== Hash every SPIFFS copy once; only files that differ from the firmware are served ====
+void httpAssetsInit() {
+  static uint8_t buf[512];
+  for (size_t i = 0; i < ASSET_COUNT; i++) {
+    overrides[i] = 0;
+    File f = SPIFFS.open(assetManifest[i].path, "r");
+    if ( !f ) continue;
+    uint32_t hash = HTTP_HASH_INIT;
+    int n;
+    while ( (n = f.read(buf, sizeof(buf))) > 0 ) hash = httpContentHash(buf, n, hash);
+    f.close();
+    if ( hash != assetManifest[i].hash ) {
+      //  0 means "no override"; a file hashing to 0 is taken with a neighbouring value
+      overrides[i] = hash ? hash : 1;
+      Log.notice("httpAssetsInit: %s overridden from SPIFFS\n", assetManifest[i].path);
+    }
+  }
+}
+
+uint32_t httpAssetOverride(const httpAsset_t* aAsset) {
+  return overrides[aAsset - assetManifest];
+}
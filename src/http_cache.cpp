@@ -0,0 +1,72 @@
+//  === HTTP conditional requests ====================================================================
+
+#include "http_cache.h"
+
+#include <strings.h>
+
+int httpFrameEtag(char* aBuf, size_t aSize, uint32_t aFrame, const struct timeval* aTimestamp) {
+  int n = snprintf(aBuf, aSize, "\"%u-%lx.%05lx\"", (unsigned) aFrame,
+                   (unsigned long) aTimestamp->tv_sec, (unsigned long) aTimestamp->tv_usec);
+  return n > 0 && (size_t) n < aSize ? n : 0;
+}
+
+// ==== Walk the list without copying: compare each opaque-tag with aEtag, W/ ignored =====
+bool httpEtagMatch(const char* aIfNoneMatch, const char* aEtag) {
+  if ( aIfNoneMatch == NULL || aEtag == NULL ) return false;
+  if ( aEtag[0] == 'W' && aEtag[1] == '/' ) aEtag += 2;
+  const size_t len = strlen(aEtag);
+
+  const char* p = aIfNoneMatch;
+  for (;;) {
+    while ( *p == ' ' || *p == '\t' || *p == ',' ) p++;
+    if ( *p == 0 ) return false;
+    if ( *p == '*' ) return true;
+    if ( p[0] == 'W' && p[1] == '/' ) p += 2;
+
+    //  Tag runs to its closing quote; a bare token runs to the next separator
+    const char* end = p;
+    if ( *end == '"' ) {
+      end = strchr(p + 1, '"');
+      end = end ? end + 1 : p + strlen(p);
+    }
+    else {
+      while ( *end && *end != ',' && *end != ' ' && *end != '\t' ) end++;
+    }
+    if ( (size_t) (end - p) == len && strncmp(p, aEtag, len) == 0 ) return true;
+    p = end;
+  }
+}
+
+uint32_t httpContentHash(const uint8_t* aData, size_t aSize, uint32_t aHash) {
+  for (size_t i = 0; i < aSize; i++) aHash = (aHash ^ aData[i]) * 0x01000193u;
+  return aHash;
+}
+
+int httpAssetEtag(char* aBuf, size_t aSize, uint32_t aHash, bool aGzip) {
+  int n = snprintf(aBuf, aSize, aGzip ? "\"%08x-gz\"" : "\"%08x\"", (unsigned) aHash);
+  return n > 0 && (size_t) n < aSize ? n : 0;
+}
+
+// ==== Find the gzip coding in the list and look at its q-value ==========================
+bool httpAcceptsGzip(const char* aAcceptEncoding) {
+  if ( aAcceptEncoding == NULL ) return false;
+  for (const char* p = aAcceptEncoding; *p; p++) {
+    //  Codings and parameter names are case-insensitive. Whole token only: "x-gzip" is another coding
+    if ( strncasecmp(p, "gzip", 4) ) continue;
+    if ( p != aAcceptEncoding && p[-1] != ',' && p[-1] != ' ' && p[-1] != '\t' ) continue;
+    const char* q = p + 4;
+    while ( *q == ' ' || *q == '\t' ) q++;
+    if ( *q == 0 || *q == ',' ) return true;
+    if ( *q != ';' ) continue;
+    q++;
+    while ( *q == ' ' || *q == '\t' ) q++;
+    if ( (q[0] != 'q' && q[0] != 'Q') || q[1] != '=' ) return true;
+    q += 2;
+    //  q=0, q=0.0, q=0.00 refuse; anything with a non-zero digit accepts
+    for (; *q && *q != ',' && *q != ' ' && *q != ';'; q++) {
+      if ( *q >= '1' && *q <= '9' ) return true;
+    }
+    return false;
+  }
+  return false;
+}
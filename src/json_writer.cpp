@@ -0,0 +1,108 @@
+//  === Fixed-buffer JSON writer =====================================================================
+
+#include "json_writer.h"
+
+// ==== Quoted string with the characters JSON requires escaped ===========================
+static void putString(jsonWriter_t* w, const char* aValue) {
+  textChar(&w->out, '"');
+  for (const char* p = aValue; *p; p++) {
+    unsigned char c = *p;
+    if ( c == '"' || c == '\\' ) {
+      textChar(&w->out, '\\');
+      textChar(&w->out, c);
+    }
+    else if ( c < 0x20 ) {
+      textPrintf(&w->out, "\\u%04x", c);
+    }
+    else {
+      textChar(&w->out, c);
+    }
+  }
+  textChar(&w->out, '"');
+}
+
+//  Separator and key of the next member
+static void member(jsonWriter_t* w, const char* aKey) {
+  if ( w->comma ) textChar(&w->out, ',');
+  w->comma = true;
+  if ( aKey ) {
+    putString(w, aKey);
+    textChar(&w->out, ':');
+  }
+}
+
+void jsonInit(jsonWriter_t* w, char* aBuf, size_t aSize) {
+  textInit(&w->out, aBuf, aSize);
+  w->comma = false;
+}
+
+size_t jsonFinish(jsonWriter_t* w) {
+  return textFinish(&w->out);
+}
+
+void jsonBeginObject(jsonWriter_t* w, const char* aKey) {
+  member(w, aKey);
+  textChar(&w->out, '{');
+  w->comma = false;
+}
+
+void jsonEndObject(jsonWriter_t* w) {
+  textChar(&w->out, '}');
+  w->comma = true;
+}
+
+void jsonBeginArray(jsonWriter_t* w, const char* aKey) {
+  member(w, aKey);
+  textChar(&w->out, '[');
+  w->comma = false;
+}
+
+void jsonEndArray(jsonWriter_t* w) {
+  textChar(&w->out, ']');
+  w->comma = true;
+}
+
+void jsonString(jsonWriter_t* w, const char* aKey, const char* aValue) {
+  member(w, aKey);
+  putString(w, aValue ? aValue : "");
+}
+
+void jsonBool(jsonWriter_t* w, const char* aKey, bool aValue) {
+  member(w, aKey);
+  textPrintf(&w->out, "%s", aValue ? "true" : "false");
+}
+
+void jsonInt(jsonWriter_t* w, const char* aKey, int64_t aValue) {
+  member(w, aKey);
+  textPrintf(&w->out, "%lld", (long long) aValue);
+}
+
+void jsonUint(jsonWriter_t* w, const char* aKey, uint64_t aValue) {
+  member(w, aKey);
+  textPrintf(&w->out, "%llu", (unsigned long long) aValue);
+}
+
+void jsonFixed(jsonWriter_t* w, const char* aKey, float aValue, uint8_t aDecimals) {
+  static const uint32_t scales[] = { 1, 10, 100, 1000, 10000, 100000, 1000000 };
+  if ( aDecimals > 6 ) aDecimals = 6;
+  member(w, aKey);
+
+  //  NaN and infinities have no JSON form
+  if ( aValue != aValue || aValue > 1e12f || aValue < -1e12f ) {
+    textPrintf(&w->out, "null");
+    return;
+  }
+  bool negative = aValue < 0;
+  uint64_t scaled = (uint64_t) ((negative ? -aValue : aValue) * scales[aDecimals] + 0.5f);
+  uint64_t whole = scaled / scales[aDecimals];
+  uint32_t frac = scaled % scales[aDecimals];
+  if ( negative && scaled ) textChar(&w->out, '-');
+  if ( aDecimals ) textPrintf(&w->out, "%llu.%0*u", (unsigned long long) whole, aDecimals, (unsigned) frac);
+  else textPrintf(&w->out, "%llu", (unsigned long long) whole);
+}
+
+void jsonIp(jsonWriter_t* w, const char* aKey, uint32_t aAddress) {
+  const uint8_t* ip = (const uint8_t*) &aAddress;
+  member(w, aKey);
+  textPrintf(&w->out, "\"%u.%u.%u.%u\"", ip[0], ip[1], ip[2], ip[3]);
+}
@@ -1,110 +1,309 @@
 //  === Simple logging implementation  =================================================================
+//  Producers claim ring slots with one compare-and-swap (bounded MPMC queue with per-slot
+//  sequence numbers, used here with a single consumer). The drain task is that consumer: it
+//  formats each record with the arguments the caller copied and writes the line in one go.
 #include "logging.h"
+#include "trace.h"
+#include <ctype.h>
 
-// Implementation of SimpleLog methods
-void SimpleLog::begin(int level, Print* output) {
-  _level = level;
-  _output = output;
+SimpleLog Log;
+
+SimpleLog::SimpleLog() {
+  for (uint32_t i = 0; i < LOG_RING_SLOTS; i++) _ring[i].seq = i;
 }
 
-void SimpleLog::setPrefix(void (*func)(Print*)) {
-  _prefixFunc = func;
+// ==== Raw arguments: tag byte and value ===================================================
+//  The first argument that does not fit ends the message: pos stays behind the last complete
+//  one, so the record never counts bytes it did not write, and the formatter prints <?> instead
+void logPutArg(logArgs_t* a, uint8_t aTag, const void* aValue, size_t aSize) {
+  if ( a->full || a->pos + 1 + aSize > a->end ) {
+    a->full = true;
+    return;
+  }
+  *a->pos++ = aTag;
+  memcpy(a->pos, aValue, aSize);
+  a->pos += aSize;
 }
 
-void SimpleLog::trace(const char* format, ...) {
-  if (_level >= 5) {
-    if (_prefixFunc) _prefixFunc(_output);
-    va_list args;
-    va_start(args, format);
-    _output->printf(format, args);
-    va_end(args);
+// A string is cut to the room left, as long as its tag and length fit
+void logPutString(logArgs_t* a, const char* aValue) {
+  if ( aValue == NULL ) aValue = "(null)";
+  if ( a->full || a->pos + 2 > a->end ) {
+    a->full = true;
+    return;
   }
+  size_t len = strnlen(aValue, a->end - a->pos - 2);
+  *a->pos++ = LOG_ARG_STRING;
+  *a->pos++ = (uint8_t) len;
+  memcpy(a->pos, aValue, len);
+  a->pos += len;
 }
 
-void SimpleLog::verbose(const char* format, ...) {
-  if (_level >= 6) {
-    if (_prefixFunc) _prefixFunc(_output);
-    va_list args;
-    va_start(args, format);
-    _output->printf(format, args);
-    va_end(args);
+// ==== Ring: any task claims and publishes, the drain task reads ===========================
+logRecord_t* SimpleLog::claim() {
+  uint32_t pos = __atomic_load_n(&_head, __ATOMIC_RELAXED);
+  for (;;) {
+    logRecord_t* r = &_ring[pos & (LOG_RING_SLOTS - 1)];
+    int32_t dif = (int32_t) (__atomic_load_n(&r->seq, __ATOMIC_ACQUIRE) - pos);
+    if ( dif == 0 ) {
+      if ( __atomic_compare_exchange_n(&_head, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED) ) return r;
+    }
+    else if ( dif < 0 ) {
+      //  Full: the drain has not read this slot yet
+      __atomic_fetch_add(&_dropped, 1, __ATOMIC_RELAXED);
+      return NULL;
+    }
+    else {
+      pos = __atomic_load_n(&_head, __ATOMIC_RELAXED);
+    }
   }
 }
 
-void SimpleLog::notice(const char* format, ...) {
-  if (_level >= 4) {
-    if (_prefixFunc) _prefixFunc(_output);
-    va_list args;
-    va_start(args, format);
-    _output->printf(format, args);
-    va_end(args);
+// The slot was claimed at sequence seq, readable once it is seq + 1
+void SimpleLog::publish(logRecord_t* aRecord) {
+  __atomic_store_n(&aRecord->seq, aRecord->seq + 1, __ATOMIC_RELEASE);
+}
+
+// Reads until the ring is empty. Returns false if another task is reading it
+bool SimpleLog::drain() {
+  if ( __atomic_exchange_n(&_draining, 1, __ATOMIC_ACQUIRE) ) return false;
+  for (;;) {
+    logRecord_t* r = &_ring[_tail & (LOG_RING_SLOTS - 1)];
+    if ( __atomic_load_n(&r->seq, __ATOMIC_ACQUIRE) != _tail + 1 ) break;
+    write(r);
+    __atomic_store_n(&r->seq, _tail + LOG_RING_SLOTS, __ATOMIC_RELEASE);
+    _tail++;
+  }
+  uint32_t dropped = __atomic_load_n(&_dropped, __ATOMIC_RELAXED);
+  if ( dropped != _reported && _output ) {
+    char line[64];
+    int n = snprintf(line, sizeof(line), "log: %u messages dropped, ring full\n", (unsigned) (dropped - _reported));
+    _output->write((const uint8_t*) line, n);
+    _reported = dropped;
   }
+  __atomic_store_n(&_draining, 0, __ATOMIC_RELEASE);
+  return true;
 }
 
-void SimpleLog::warning(const char* format, ...) {
-  if (_level >= 3) {
-    if (_prefixFunc) _prefixFunc(_output);
-    va_list args;
-    va_start(args, format);
-    _output->printf(format, args);
-    va_end(args);
+void SimpleLog::drainTask(void* aLog) {
+  SimpleLog* log = (SimpleLog*) aLog;
+  for (;;) {
+    log->drain();
+    vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_MS));
   }
 }
 
-void SimpleLog::error(const char* format, ...) {
-  if (_level >= 2) {
-    if (_prefixFunc) _prefixFunc(_output);
-    va_list args;
-    va_start(args, format);
-    _output->printf(format, args);
-    va_end(args);
+void SimpleLog::begin(int level, Print* output) {
+  _level = level;
+  _output = output;
+  if ( _drain == NULL && LOG_LEVEL_MAX > LOG_LEVEL_SILENT ) {
+    xTaskCreatePinnedToCore(drainTask, "log", LOG_STACK_SIZE, this, LOG_TASK_PRIORITY, &_drain, tskNO_AFFINITY);
   }
 }
 
-void SimpleLog::fatal(const char* format, ...) {
-  if (_level >= 1) {
-    if (_prefixFunc) _prefixFunc(_output);
-    va_list args;
-    va_start(args, format);
-    _output->printf(format, args);
-    va_end(args);
+// drain() only returns true once it has emptied the ring; while the drain task is writing, wait
+void SimpleLog::flush() {
+  uint32_t start = millis();
+  while ( !drain() && millis() - start < LOG_FLUSH_MS ) vTaskDelay(1);
+  if ( _output ) _output->flush();
+}
+
+void SimpleLog::write(const logRecord_t* aRecord) {
+  if ( _output == NULL ) return;
+  char line[LOG_LINE_MAX];
+  size_t n = format(aRecord, line, sizeof(line));
+  _output->write((const uint8_t*) line, n);
+}
+
+// ==== Deferred formatting =================================================================
+//  Every conversion takes the next raw argument. The length modifier comes from the stored
+//  kind, not from the format, so %d of a 64-bit value or %lu of a 32-bit one print correctly
+static void append(char* aLine, size_t aSize, size_t* aLen, const char* aFormat, ...) __attribute__ ((format (printf, 4, 5)));
+
+static void append(char* aLine, size_t aSize, size_t* aLen, const char* aFormat, ...) {
+  if ( *aLen >= aSize - 1 ) return;
+  va_list args;
+  va_start(args, aFormat);
+  int n = vsnprintf(aLine + *aLen, aSize - *aLen, aFormat, args);
+  va_end(args);
+  if ( n > 0 ) *aLen = *aLen + n < aSize - 1 ? *aLen + n : aSize - 1;
+}
+
+typedef struct {
+  uint8_t   tag;
+  int64_t   i;
+  uint64_t  u;
+  double    d;
+  char      s[LOG_RECORD_ARGS];
+} logValue_t;
+
+// Bytes after the tag byte: the value, or the length byte of a string
+static size_t argWidth(uint8_t aTag) {
+  switch ( aTag ) {
+    case LOG_ARG_STRING:  return 1;
+    case LOG_ARG_DOUBLE:  return sizeof(double);
+    case LOG_ARG_INT64:
+    case LOG_ARG_UINT64:  return sizeof(uint64_t);
+    case LOG_ARG_POINTER: return sizeof(uintptr_t);
+    default:              return sizeof(uint32_t);
   }
 }
 
-SimpleLog Log;
+//  The arguments may come from a trace file or a record cut short: nothing is read past aEnd
+static bool nextArg(const uint8_t** aPos, const uint8_t* aEnd, logValue_t* v) {
+  const uint8_t* p = *aPos;
+  if ( p >= aEnd ) return false;
+  v->tag = *p++;
+  if ( (size_t) (aEnd - p) < argWidth(v->tag) ) {
+    *aPos = aEnd;
+    return false;
+  }
+  switch ( v->tag ) {
+    case LOG_ARG_STRING: {
+      size_t len = *p++;
+      if ( len > (size_t) (aEnd - p) ) len = aEnd - p;
+      if ( len > sizeof(v->s) - 1 ) len = sizeof(v->s) - 1;
+      memcpy(v->s, p, len);
+      v->s[len] = 0;
+      p += len;
+      break;
+    }
+    case LOG_ARG_DOUBLE:
+      memcpy(&v->d, p, sizeof(double));
+      p += sizeof(double);
+      v->i = (int64_t) v->d;
+      v->u = (uint64_t) v->i;
+      break;
+    case LOG_ARG_INT64:
+    case LOG_ARG_UINT64:
+      memcpy(&v->u, p, sizeof(uint64_t));
+      p += sizeof(uint64_t);
+      v->i = (int64_t) v->u;
+      break;
+    case LOG_ARG_POINTER: {
+      uintptr_t x;
+      memcpy(&x, p, sizeof(x));
+      p += sizeof(x);
+      v->i = v->u = x;
+      break;
+    }
+    default: {
+      uint32_t x;
+      memcpy(&x, p, sizeof(x));
+      p += sizeof(x);
+      v->u = x;
+      v->i = v->tag == LOG_ARG_INT ? (int64_t) (int32_t) x : (int64_t) x;
+      break;
+    }
+  }
+  v->d = v->tag == LOG_ARG_DOUBLE ? v->d : (double) v->i;
+  *aPos = p;
+  return true;
+}
+
+size_t SimpleLog::format(const logRecord_t* aRecord, char* aLine, size_t aSize) {
+  // start-time-based timestamp
+  uint32_t mm = aRecord->time;
+  uint32_t s = mm / 1000;
+  uint32_t m = s / 60;
+  uint32_t h = m / 60;
+  size_t len = 0;
+  append(aLine, aSize, &len, "%02u:%02u:%02u:%02u.%03u ", (unsigned) (h / 24), (unsigned) (h % 24),
+         (unsigned) (m % 60), (unsigned) (s % 60), (unsigned) (mm % 1000));
+  return len + formatMessage(aRecord->format, aRecord->args, aRecord->size, aLine + len, aSize - len);
+}
+
+size_t SimpleLog::formatMessage(const char* aFormat, const uint8_t* aArgs, size_t aArgsSize, char* aLine, size_t aSize) {
+  const uint8_t* args = aArgs;
+  const uint8_t* end = aArgs + aArgsSize;
+  const char* f = aFormat;
+  size_t len = 0;
+  logValue_t v;
+
+  while ( *f && len < aSize - 1 ) {
+    if ( *f != '%' ) {
+      aLine[len++] = *f++;
+      continue;
+    }
+    if ( f[1] == '%' ) {
+      aLine[len++] = '%';
+      f += 2;
+      continue;
+    }
+
+    //  %[flags][width][.precision][length]conversion, rebuilt without the length
+    char spec[24];
+    size_t n = 0;
+    spec[n++] = *f++;
+    while ( *f && strchr("-+ #0", *f) && n < 8 ) spec[n++] = *f++;
+    while ( *f && (isdigit((uint8_t) *f) || *f == '.' || *f == '*') && n < 16 ) {
+      if ( *f == '*' ) {
+        n += snprintf(spec + n, sizeof(spec) - n, "%d", nextArg(&args, end, &v) ? (int) v.i : 0);
+        f++;
+      }
+      else spec[n++] = *f++;
+    }
+    while ( *f && strchr("hlLqjzt", *f) ) f++;
+    char conv = *f;
+    if ( conv == 0 ) break;
+    f++;
+
+    if ( !nextArg(&args, end, &v) ) {
+      append(aLine, aSize, &len, "<?>");
+      continue;
+    }
+    if ( v.tag == LOG_ARG_IP ) {
+      append(aLine, aSize, &len, "%u.%u.%u.%u", (unsigned) (v.u & 0xff), (unsigned) ((v.u >> 8) & 0xff),
+             (unsigned) ((v.u >> 16) & 0xff), (unsigned) ((v.u >> 24) & 0xff));
+      continue;
+    }
+    if ( v.tag == LOG_ARG_STRING || conv == 's' ) {
+      strcpy(spec + n, "s");
+      append(aLine, aSize, &len, spec, v.tag == LOG_ARG_STRING ? v.s : "<?>");
+      continue;
+    }
+    if ( conv == 'p' ) {
+      append(aLine, aSize, &len, "%p", (void*) (uintptr_t) v.u);
+      continue;
+    }
+    if ( strchr("fFeEgGaA", conv) ) {
+      spec[n++] = conv;
+      spec[n] = 0;
+      append(aLine, aSize, &len, spec, v.d);
+      continue;
+    }
+    if ( conv == 'c' ) {
+      strcpy(spec + n, "c");
+      append(aLine, aSize, &len, spec, (int) v.i);
+      continue;
+    }
+    //  Integer conversions; unsigned ones of a 32-bit value stay 32 bits wide
+    bool unsignedConv = strchr("uxXo", conv) != NULL;
+    snprintf(spec + n, sizeof(spec) - n, "ll%c", strchr("diuxXo", conv) ? conv : 'd');
+    if ( unsignedConv ) {
+      uint64_t u = v.tag == LOG_ARG_INT ? (uint64_t) (uint32_t) v.i : v.u;
+      append(aLine, aSize, &len, spec, (unsigned long long) u);
+    }
+    else {
+      append(aLine, aSize, &len, spec, (long long) v.i);
+    }
+  }
+  aLine[len] = 0;
+  return len;
+}
 
 // Setup default logging system
 void setupLogging() {
 #ifndef DISABLE_LOGGING
   Log.begin(LOG_LEVEL, &Serial);
-  Log.setPrefix(printTimestampMillis);
+#if defined(TRACE_LOG)
+  traceInit();
+#endif
   Log.trace("setupLogging()" CR);
 #endif  //  #ifndef DISABLE_LOGGING
 }
 
 
-// === millis() - based timestamp ==
-void printTimestamp(Print* logOutput) {
-  char c[24];
-  sprintf(c, "%10lu ", (long unsigned int) MILLIS_FUNCTION);
-  logOutput->print(c);
-}
-
-
-// start-time-based timestamp ========
-void printTimestampMillis(Print* logOutput) {
-  char c[64];
-  unsigned long mm = MILLIS_FUNCTION;
-  int ms = mm % 1000;
-  int s = mm / 1000;
-  int m = s / 60;
-  int h = m / 60;
-  int d = h / 24;
-  sprintf(c, "%02d:%02d:%02d:%02d.%03d ", d, h % 24, m % 60, s % 60, ms);
-  logOutput->print(c);
-}
-
-
 #ifndef DISABLE_LOGGING
 void printBuffer(const char* aBuf, size_t aSize) {
     Serial.println("Buffer contents:");
@@ -113,8 +312,8 @@ void printBuffer(const char* aBuf, size_t aSize) {
     String s;
     size_t cnt = 0;
 
-    for (int j = 0; j < aSize / 16 + 1; j++) {
-      Serial.printf("%04x : ", j * 16);
+    for (size_t j = 0; j < aSize / 16 + 1; j++) {
+      Serial.printf("%04x : ", (unsigned) (j * 16));
       for (int i = 0; i < 16 && cnt < aSize; i++) {
         c = aBuf[cnt++];
         Serial.printf("%02x ", c);
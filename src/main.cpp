@@ -20,6 +20,7 @@
 
 #include "credentials.h"
 #include "streaming.h"
+#include "camera_settings.h"
 
 const char *c_ssid = WIFI_SSID;
 const char *c_pwd = WIFI_PWD;
@@ -40,9 +41,6 @@ TaskHandle_t tStream;
 
 uint8_t      noActiveClients;   // number of active clients
 
-// frameSync semaphore is used to prevent streaming buffer as it is replaced with the next frame
-SemaphoreHandle_t frameSync = NULL;
-
 
 // ==== SETUP method ==================================================================
 void setup() {
@@ -90,7 +88,7 @@ void setup() {
     .pixel_format   = PIXFORMAT_JPEG,
     .frame_size     = FRAME_SIZE,  // Will be overridden below
     .jpeg_quality   = JPEG_QUALITY,
-    .fb_count       = 3,  // Increased for triple buffering
+    .fb_count       = CAMERA_FB_COUNT,  // Increased for triple buffering
     .fb_location = CAMERA_FB_IN_PSRAM,
     .grab_mode = CAMERA_GRAB_LATEST,
     .sccb_i2c_port = -1  // Use default I2C
@@ -174,46 +172,11 @@ void setup() {
   }
 
   // Load persisted camera settings from NVS and apply (overrides the optimizations above if present)
+  cameraSettingsLoad();
   {
-    Preferences prefs;
-    if (prefs.begin("cam", false)) {
-      sensor_t* s = esp_camera_sensor_get();
-      if (s != NULL) {
-        int v;
-
-        // Framesize is now fixed at VGA in platformio.ini
-
-        // Image quality
-        v = prefs.getInt("q", -10000);   if (v != -10000) { s->set_quality(s, v); Log.notice("setup: Loaded quality = %d\n", v); }
-        v = prefs.getInt("br", -10000);  if (v != -10000) { s->set_brightness(s, v); Log.notice("setup: Loaded brightness = %d\n", v); }
-        v = prefs.getInt("ct", -10000);  if (v != -10000) { s->set_contrast(s, v); Log.notice("setup: Loaded contrast = %d\n", v); }
-        v = prefs.getInt("sa", -10000);  if (v != -10000) { s->set_saturation(s, v); Log.notice("setup: Loaded saturation = %d\n", v); }
-        v = prefs.getInt("gc", -10000);  if (v != -10000) { s->set_gainceiling(s, (gainceiling_t)v); Log.notice("setup: Loaded gainceiling = %d\n", v); }
-
-        // Toggles
-        v = prefs.getInt("cb", -10000);  if (v != -10000) s->set_colorbar(s, v);
-        v = prefs.getInt("awb", -10000); if (v != -10000) s->set_whitebal(s, v);
-        v = prefs.getInt("agc", -10000); if (v != -10000) s->set_gain_ctrl(s, v);
-        v = prefs.getInt("aec", -10000); if (v != -10000) s->set_exposure_ctrl(s, v);
-        v = prefs.getInt("hm", -10000);  if (v != -10000) s->set_hmirror(s, v);
-        v = prefs.getInt("vf", -10000);  if (v != -10000) s->set_vflip(s, v);
-
-        // Advanced values
-        v = prefs.getInt("awbg", -10000); if (v != -10000) s->set_awb_gain(s, v);
-        v = prefs.getInt("agcg", -10000); if (v != -10000) s->set_agc_gain(s, v);
-        v = prefs.getInt("aecv", -10000); if (v != -10000) s->set_aec_value(s, v);
-        v = prefs.getInt("aec2", -10000); if (v != -10000) s->set_aec2(s, v);
-        v = prefs.getInt("dcw", -10000);  if (v != -10000) s->set_dcw(s, v);
-        v = prefs.getInt("bpc", -10000);  if (v != -10000) s->set_bpc(s, v);
-        v = prefs.getInt("wpc", -10000);  if (v != -10000) s->set_wpc(s, v);
-        v = prefs.getInt("rg", -10000);   if (v != -10000) s->set_raw_gma(s, v);
-        v = prefs.getInt("lenc", -10000); if (v != -10000) s->set_lenc(s, v);
-        v = prefs.getInt("se", -10000);   if (v != -10000) s->set_special_effect(s, v);
-        v = prefs.getInt("wb", -10000);   if (v != -10000) s->set_wb_mode(s, v);
-        v = prefs.getInt("ael", -10000);  if (v != -10000) s->set_ae_level(s, v);
-      }
-      prefs.end();
-    }
+    sensor_t* s = esp_camera_sensor_get();
+    // Framesize is now fixed at VGA in platformio.ini
+    if (s != NULL) cameraControlsApply(s);
   }
 
   // Configure and connect to WiFi - TURBO OPTIMIZED
@@ -363,6 +326,7 @@ void setup() {
     uint8_t protocol_bitmap;
     esp_wifi_get_protocol(WIFI_IF_STA, &protocol_bitmap);
     
+    Log.flush();  // the block below goes straight to Serial, after the queued setup lines
     Serial.printf("=== WiFi Connection Info ===\n");
     Serial.printf("IP: %s\n", ip.toString().c_str());
     Serial.printf("RSSI: %d dBm\n", WiFi.RSSI());
@@ -0,0 +1,87 @@
+//  === Fixed-size block pools ======================================================================
+//  A pool is one allocation: the blocks, a stack of free block indices and a taken flag per
+//  block. Allocating pops an index, freeing pushes it back, both in constant time under one
+//  spinlock shared by every pool - the lock only ever guards a few loads and stores.
+#include "mem_pool.h"
+#include "allocator.h"
+#include "logging.h"
+
+static portMUX_TYPE poolMux = portMUX_INITIALIZER_UNLOCKED;
+static memPool_t*   pools[MEM_POOLS_MAX];
+static uint8_t      poolCount = 0;
+
+bool memPoolInit(memPool_t* p, const char* aName, size_t aSize, uint16_t aBlocks, uint16_t aMinBlocks, bool psramOnly) {
+  memset(p, 0, sizeof(*p));
+  p->name = aName;
+  p->size = (aSize + 7) & ~7u;
+  if ( aMinBlocks < 1 ) aMinBlocks = 1;
+
+  uint8_t* mem = NULL;
+  uint16_t n;
+  for (n = aBlocks; n >= aMinBlocks; n--) {
+    //  Only the smallest pool the caller takes is a failure
+    mem = (uint8_t*) allocateMemory(NULL, (size_t) n * (p->size + sizeof(uint16_t) + 1),
+                                    n == aMinBlocks ? FAIL_IF_OOM : OK_IF_OOM, psramOnly);
+    if ( mem ) break;
+  }
+  if ( mem == NULL ) {
+    Log.error("memPoolInit: no memory for %d %s blocks of %u bytes\n", aMinBlocks, aName, (unsigned) p->size);
+    return false;
+  }
+  if ( n < aBlocks ) Log.warning("memPoolInit: %s pool has %d of %d blocks\n", aName, n, aBlocks);
+
+  p->base = mem;
+  p->blocks = n;
+  p->stack = (uint16_t*) (mem + (size_t) n * p->size);
+  p->taken = (uint8_t*) (p->stack + n);
+  //  Lowest block on top, so a lightly used pool keeps touching the same few blocks
+  for (uint16_t i = 0; i < n; i++) {
+    p->stack[i] = n - 1 - i;
+    p->taken[i] = 0;
+  }
+  p->top = n;
+
+  if ( poolCount < MEM_POOLS_MAX ) pools[poolCount++] = p;
+  Log.notice("memPoolInit: %s pool, %d blocks of %u bytes\n", aName, n, (unsigned) p->size);
+  return true;
+}
+
+void* memPoolAlloc(memPool_t* p) {
+  void* block = NULL;
+  portENTER_CRITICAL(&poolMux);
+  if ( p->top > 0 ) {
+    uint16_t i = p->stack[--p->top];
+    p->taken[i] = 1;
+    block = p->base + (size_t) i * p->size;
+    p->allocs++;
+    if ( ++p->used > p->peak ) p->peak = p->used;
+  }
+  else p->failures++;
+  portEXIT_CRITICAL(&poolMux);
+  return block;
+}
+
+void memPoolFree(memPool_t* p, void* aBlock) {
+  if ( aBlock == NULL ) return;
+  uintptr_t offset = (uintptr_t) aBlock - (uintptr_t) p->base;
+  uintptr_t i = offset / p->size;
+
+  portENTER_CRITICAL(&poolMux);
+  if ( (uint8_t*) aBlock < p->base || offset % p->size || i >= p->blocks || !p->taken[i] ) {
+    p->invalid++;
+  }
+  else {
+    p->taken[i] = 0;
+    p->stack[p->top++] = i;
+    p->used--;
+  }
+  portEXIT_CRITICAL(&poolMux);
+}
+
+uint8_t memPoolCount() {
+  return poolCount;
+}
+
+memPool_t* memPoolAt(uint8_t aIndex) {
+  return aIndex < poolCount ? pools[aIndex] : NULL;
+}
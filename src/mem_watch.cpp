@@ -0,0 +1,83 @@
+//  === Memory pressure tiers ========================================================================
+//  Pure policy over samples: no heap, sensor or clock access, so it runs the same on the host
+//  (make mem-watch-check). The web server task is the only one updating it; other tasks only
+//  read the tier.
+
+#include "mem_watch.h"
+
+memWatch_t memWatch = { MEM_TIER_NORMAL, MEM_TIER_NORMAL, 0, 0, 0, 0, 0, "start", { 0, 0, 0, 0, 0 } };
+
+// Recovery needs every figure this far above its low mark, so a tier does not flap at the mark
+#define MEM_MARGIN(x)   ((x) + (x) / 2)
+
+void memWatchInit(memWatch_t* w, uint32_t aNow, uint32_t aFailures) {
+  memset(w, 0, sizeof(*w));
+  w->failures = aFailures;
+  w->tier = MEM_TIER_NORMAL;
+  w->worst = MEM_TIER_NORMAL;
+  w->since = aNow;
+  w->calmSince = aNow;
+  w->reason = "start";
+}
+
+// The figure short of memory against the given marks, NULL if none is
+static const char* shortOf(const memSample_t* s, uint32_t aHeap, uint32_t aBlock, uint32_t aPsram) {
+  if ( s->largestBlock < aBlock ) return "largest block";
+  if ( s->freeHeap < aHeap ) return "free heap";
+  if ( s->psramSize && s->freePsram < aPsram ) return "psram";
+  return NULL;
+}
+
+static void enter(memWatch_t* w, memTier_t aTier, const char* aReason, uint32_t aNow) {
+  w->tier = aTier;
+  w->since = aNow;
+  w->calmSince = aNow;
+  w->reason = aReason;
+  w->transitions++;
+  if ( aTier > w->worst ) w->worst = aTier;
+}
+
+// ==== One sample: step up under pressure, down after a calm period =======================
+memTier_t memWatchUpdate(memWatch_t* w, const memSample_t* s, uint32_t aNow) {
+  const char* critical = shortOf(s, MEM_HEAP_CRITICAL, MEM_BLOCK_CRITICAL, MEM_PSRAM_CRITICAL);
+  const char* low = shortOf(s, MEM_HEAP_LOW, MEM_BLOCK_LOW, MEM_PSRAM_LOW);
+  const char* tight = shortOf(s, MEM_MARGIN(MEM_HEAP_LOW), MEM_MARGIN(MEM_BLOCK_LOW), MEM_MARGIN(MEM_PSRAM_LOW));
+  //  Something already went without memory: as urgent as critical, for this sample
+  if ( critical == NULL && s->allocFailures != w->failures ) critical = "allocation failed";
+  w->failures = s->allocFailures;
+  w->last = *s;
+
+  if ( critical == NULL ) w->criticalSince = 0;
+  else if ( w->criticalSince == 0 ) w->criticalSince = aNow ? aNow : 1;
+  if ( critical || tight ) w->calmSince = aNow;
+
+  if ( w->tier == MEM_TIER_RESTART ) return w->tier;
+
+  if ( w->tier == MEM_TIER_REFUSE ) {
+    //  Nothing left to shed: restart only if memory stays critical all the same
+    if ( critical && aNow - w->criticalSince >= MEM_RESTART_MS ) enter(w, MEM_TIER_RESTART, critical, aNow);
+  }
+  else if ( critical ) enter(w, (memTier_t) (w->tier + 1), critical, aNow);
+  else if ( low && aNow - w->since >= MEM_TIER_HOLD_MS ) enter(w, (memTier_t) (w->tier + 1), low, aNow);
+
+  if ( w->tier > MEM_TIER_NORMAL && w->tier < MEM_TIER_RESTART && aNow - w->calmSince >= MEM_RECOVER_MS ) {
+    enter(w, (memTier_t) (w->tier - 1), "recovered", aNow);
+  }
+  return w->tier;
+}
+
+const char* memTierName(memTier_t aTier) {
+  switch ( aTier ) {
+    case MEM_TIER_NORMAL:   return "normal";
+    case MEM_TIER_RING:     return "ring";
+    case MEM_TIER_FPS:      return "fps";
+    case MEM_TIER_QUALITY:  return "quality";
+    case MEM_TIER_REFUSE:   return "refuse";
+    case MEM_TIER_RESTART:  return "restart";
+  }
+  return "unknown";
+}
+
+float memWatchFpsCap() {
+  return memWatch.tier >= MEM_TIER_FPS ? MEM_FPS_CAP : 0;
+}
@@ -0,0 +1,153 @@
+//  === Prometheus metrics ===========================================================================
+//  Rendered straight into a buffer the caller owns: no String, no heap, whatever the number of
+//  clients. Only integer conversions are used, newlib allocates for floating point ones.
+
+#include "metrics.h"
+#include "streaming.h"
+#include "stream_dispatcher.h"
+#include "camera_settings.h"
+#include "text_buffer.h"
+
+extern volatile uint32_t clientsConnected;
+
+static void family(textBuffer_t* w, const char* aName, const char* aType, const char* aHelp) {
+  textPrintf(w, "# HELP %s %s\n# TYPE %s %s\n", aName, aHelp, aName, aType);
+}
+
+static void value(textBuffer_t* w, const char* aName, uint64_t aValue) {
+  textPrintf(w, "%s %llu\n", aName, (unsigned long long) aValue);
+}
+
+static void gauge(textBuffer_t* w, const char* aName, const char* aHelp, int64_t aValue) {
+  family(w, aName, "gauge", aHelp);
+  textPrintf(w, "%s %lld\n", aName, (long long) aValue);
+}
+
+static void counter(textBuffer_t* w, const char* aName, const char* aHelp, uint64_t aValue) {
+  family(w, aName, "counter", aHelp);
+  value(w, aName, aValue);
+}
+
+// Microseconds as seconds with six decimals
+static void seconds(textBuffer_t* w, uint32_t aMicros) {
+  textPrintf(w, "%u.%06u\n", (unsigned) (aMicros / 1000000), (unsigned) (aMicros % 1000000));
+}
+
+// ==== Latency of every stage: p50/p95/p99 and maximum in seconds, sample count ===========
+// Gauges with a quantile label rather than a summary: the histograms keep no running sum
+static void putLatency(textBuffer_t* w) {
+  static const char* names[] = { "grab", "copy", "queue", "send", "total" };
+  const histogram_t* stages[] = { &streamLatency.grab, &streamLatency.copy, &streamLatency.queue,
+                                  &streamLatency.send, &streamLatency.total };
+  static const char* quantiles[] = { "0.5", "0.95", "0.99" };
+  static const float q[] = { 0.5, 0.95, 0.99 };
+  const int n = sizeof(names) / sizeof(names[0]);
+
+  family(w, "esp32cam_latency_seconds", "gauge", "Streaming pipeline stage latency quantiles");
+  for (int s = 0; s < n; s++) {
+    for (int i = 0; i < 3; i++) {
+      textPrintf(w, "esp32cam_latency_seconds{stage=\"%s\",quantile=\"%s\"} ", names[s], quantiles[i]);
+      seconds(w, histogramPercentile(stages[s], q[i]));
+    }
+  }
+  family(w, "esp32cam_latency_max_seconds", "gauge", "Longest latency seen per stage");
+  for (int s = 0; s < n; s++) {
+    textPrintf(w, "esp32cam_latency_max_seconds{stage=\"%s\"} ", names[s]);
+    seconds(w, stages[s]->max);
+  }
+  family(w, "esp32cam_latency_samples_total", "counter", "Latency samples recorded per stage");
+  for (int s = 0; s < n; s++) {
+    textPrintf(w, "esp32cam_latency_samples_total{stage=\"%s\"} %u\n", names[s], (unsigned) histogramCount(stages[s]));
+  }
+}
+
+// ==== Connected clients, labelled by slot and address ===================================
+static void putClients(textBuffer_t* w) {
+  static const char* names[] = { "esp32cam_client_frames_sent_total", "esp32cam_client_bytes_sent_total",
+                                 "esp32cam_client_frames_dropped_total" };
+  static const char* help[] = { "Frames sent to a connected client", "Bytes sent to a connected client",
+                                "Frames a connected client skipped to stay on the newest one" };
+
+  for (int m = 0; m < 3; m++) {
+    family(w, names[m], "counter", help[m]);
+    for (int8_t i = 0; i < MAX_CLIENTS; i++) {
+      const streamClient_t* c = &streamClients[i];
+      if ( !c->used ) continue;
+      const uint8_t* ip = (const uint8_t*) &c->ip;
+      uint64_t v = m == 0 ? c->sent : m == 1 ? c->bytes : c->dropped;
+      textPrintf(w, "%s{client=\"%d\",ip=\"%u.%u.%u.%u\"} %llu\n", names[m], i, ip[0], ip[1], ip[2], ip[3],
+          (unsigned long long) v);
+    }
+  }
+}
+
+// ==== Free stack of the long-lived tasks ================================================
+static void putTasks(textBuffer_t* w) {
+  const char* names[] = { "cam", "mjpeg", "stream", "log" };
+  TaskHandle_t tasks[] = { tCam, tMjpeg, tStream, Log.task() };
+
+  family(w, "esp32cam_task_stack_free_bytes", "gauge", "Lowest free stack seen per task");
+  for (int i = 0; i < 4; i++) {
+    if ( tasks[i] == NULL ) continue;
+    textPrintf(w, "esp32cam_task_stack_free_bytes{task=\"%s\"} %u\n", names[i],
+        (unsigned) uxTaskGetStackHighWaterMark(tasks[i]));
+  }
+}
+
+// ==== Memory pools: size, blocks in use, refused allocations ============================
+static void putPools(textBuffer_t* w) {
+  static const char* names[] = { "esp32cam_pool_blocks", "esp32cam_pool_blocks_used", "esp32cam_pool_blocks_peak",
+                                 "esp32cam_pool_failures_total" };
+  static const char* help[] = { "Blocks carved out for the pool at boot", "Pool blocks in use",
+                                "Most pool blocks in use at once", "Pool allocations refused, every block in use" };
+
+  for (int m = 0; m < 4; m++) {
+    family(w, names[m], m < 3 ? "gauge" : "counter", help[m]);
+    for (uint8_t i = 0; i < memPoolCount(); i++) {
+      const memPool_t* p = memPoolAt(i);
+      uint32_t v = m == 0 ? p->blocks : m == 1 ? p->used : m == 2 ? p->peak : p->failures;
+      textPrintf(w, "%s{pool=\"%s\"} %u\n", names[m], p->name, (unsigned) v);
+    }
+  }
+}
+
+size_t metricsRender(char* aBuf, size_t aSize) {
+  textBuffer_t w;
+  textInit(&w, aBuf, aSize);
+  streamClientTotals_t t;
+  streamClientTotals(&t);
+
+  counter(&w, "esp32cam_frames_captured_total", "Frames published by the camera task", frameRingStats.published);
+  counter(&w, "esp32cam_frames_sent_total", "Complete frames sent to all clients", t.sent);
+  counter(&w, "esp32cam_bytes_sent_total", "Bytes of complete parts sent to all clients", t.bytes);
+  family(&w, "esp32cam_frames_dropped_total", "counter", "Frames not delivered, by reason");
+  textPrintf(&w, "esp32cam_frames_dropped_total{reason=\"client\"} %u\n", (unsigned) t.dropped);
+  textPrintf(&w, "esp32cam_frames_dropped_total{reason=\"paced\"} %u\n", (unsigned) t.paced);
+  textPrintf(&w, "esp32cam_frames_dropped_total{reason=\"ring\"} %u\n", (unsigned) frameRingStats.overruns);
+  textPrintf(&w, "esp32cam_frames_dropped_total{reason=\"oversize\"} %u\n", (unsigned) frameRingStats.oversize);
+  counter(&w, "esp32cam_frames_copied_total", "Frames copied into the ring instead of sent zero-copy", frameRingStats.copies);
+  counter(&w, "esp32cam_client_connects_total", "Streaming clients connected", t.connects);
+  counter(&w, "esp32cam_client_disconnects_total", "Streaming clients disconnected", t.disconnects);
+  counter(&w, "esp32cam_alloc_failures_total", "Allocations that found no memory and had no fallback", allocFailures);
+#if defined(CAMERA_DISPATCHER_TASK)
+  counter(&w, "esp32cam_send_stalls_total", "Sends cut short by a full socket buffer", streamDispatchStats.blocked);
+#endif
+  counter(&w, "esp32cam_log_dropped_total", "Log messages dropped on a full log ring", Log.dropped());
+  counter(&w, "esp32cam_memory_tier_changes_total", "Memory pressure tier transitions", memWatch.transitions);
+  counter(&w, "esp32cam_settings_saves_total", "Camera settings blobs written to NVS", cameraSettingsStats.saves);
+  putClients(&w);
+
+  gauge(&w, "esp32cam_clients", "Streaming clients connected", clientsConnected);
+  gauge(&w, "esp32cam_heap_free_bytes", "Free internal heap", ESP.getFreeHeap());
+  gauge(&w, "esp32cam_heap_min_free_bytes", "Lowest free internal heap since boot", ESP.getMinFreeHeap());
+  gauge(&w, "esp32cam_heap_largest_free_block_bytes", "Largest allocatable internal heap block", ESP.getMaxAllocHeap());
+  gauge(&w, "esp32cam_psram_free_bytes", "Free PSRAM", ESP.getFreePsram());
+  gauge(&w, "esp32cam_memory_tier", "Memory pressure tier, 0 normal to 5 restart", memWatch.tier);
+  gauge(&w, "esp32cam_wifi_rssi_dbm", "WiFi signal strength", WiFi.RSSI());
+  gauge(&w, "esp32cam_uptime_seconds", "Time since boot", millis() / 1000);
+  putTasks(&w);
+  putPools(&w);
+  putLatency(&w);
+
+  return textFinish(&w);
+}
@@ -0,0 +1,96 @@
+#include "multipart.h"
+
+#include <errno.h>
+#if defined(HOST_NATIVE)
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#else
+#include "lwip/sockets.h"
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+const char* HEADER = "HTTP/1.1 200 OK\r\n" \
+                      "Access-Control-Allow-Origin: *\r\n" \
+                      "Content-Type: multipart/x-mixed-replace; boundary=+++===123454321===+++\r\n";
+const char* BOUNDARY = "\r\n--+++===123454321===+++\r\n";
+const char* CTNTTYPE = "Content-Type: image/jpeg\r\nContent-Length: ";
+const int hdrLen = strlen(HEADER);
+const int bdrLen = strlen(BOUNDARY);
+const int cntLen = strlen(CTNTTYPE);
+
+// ==== Header of one JPEG part, followed by the frame itself and BOUNDARY ================
+// X-Timestamp is the capture time as seconds.microseconds, so recorders can measure latency
+int mjpegPartHeader(char* aBuf, size_t aSize, uint32_t aLength, uint32_t aFrame, const struct timeval* aTimestamp) {
+  int n = snprintf(aBuf, aSize, "%s%u\r\n", CTNTTYPE, (unsigned int) aLength);
+  if ( aTimestamp && n > 0 && (size_t) n < aSize ) {
+    n += snprintf(aBuf + n, aSize - n, "X-Timestamp: %lu.%06lu\r\n",
+                  (unsigned long) aTimestamp->tv_sec, (unsigned long) aTimestamp->tv_usec);
+  }
+  if ( aFrame && n > 0 && (size_t) n < aSize ) {
+    n += snprintf(aBuf + n, aSize - n, "X-Frame-Number: %u\r\n", (unsigned int) aFrame);
+  }
+  if ( n > 0 && (size_t) n < aSize ) {
+    n += snprintf(aBuf + n, aSize - n, "\r\n");
+  }
+  //  Never hand out a cut header, it would corrupt the stream
+  return n > 0 && (size_t) n < aSize ? n : 0;
+}
+
+// ==== Vectored write of one part, no intermediate buffer ================================
+// lwIP copies the data into its TCP send buffer once. NETCONN_NOCOPY is not used on purpose:
+// the frame slot may be reused as soon as this returns, long before the data is acknowledged
+int mjpegPartSend(int aSock, const char* aHdr, size_t aHdrLen, const uint8_t* aData, size_t aSize,
+                  size_t aOffset, int aFlags) {
+  struct iovec iov[3];
+  const void* base[3] = { aHdr, aData, BOUNDARY };
+  size_t      len[3]  = { aHdrLen, aSize, (size_t) bdrLen };
+  int n = 0;
+
+  for (int i = 0; i < 3; i++) {
+    if ( aOffset >= len[i] ) {
+      aOffset -= len[i];
+      continue;
+    }
+    iov[n].iov_base = (void*) ((const char*) base[i] + aOffset);
+    iov[n].iov_len = len[i] - aOffset;
+    aOffset = 0;
+    n++;
+  }
+  if ( n == 0 ) return 0;
+
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = iov;
+  msg.msg_iovlen = n;
+  return sendmsg(aSock, &msg, aFlags | MSG_NOSIGNAL);
+}
+
+bool mjpegPartSendAll(int aSock, const char* aHdr, size_t aHdrLen, const uint8_t* aData, size_t aSize,
+                      uint32_t aTimeoutMs) {
+  const size_t total = aHdrLen + aSize + bdrLen;
+  size_t off = 0;
+
+  while ( off < total ) {
+    int r = mjpegPartSend(aSock, aHdr, aHdrLen, aData, aSize, off, MSG_DONTWAIT);
+    if ( r > 0 ) {
+      off += r;
+      continue;
+    }
+    if ( r < 0 && errno == EINTR ) continue;
+    if ( r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) ) {
+      fd_set wr;
+      FD_ZERO(&wr);
+      FD_SET(aSock, &wr);
+      struct timeval tv;
+      tv.tv_sec = aTimeoutMs / 1000;
+      tv.tv_usec = (aTimeoutMs % 1000) * 1000;
+      if ( select(aSock + 1, NULL, &wr, NULL, &tv) > 0 ) continue;
+    }
+    return false;
+  }
+  return true;
+}
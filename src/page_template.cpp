@@ -0,0 +1,67 @@
+//  === Compiled page templates ======================================================================
+
+#include "page_template.h"
+
+typedef struct {
+  char*       buf;
+  size_t      size;
+  size_t      len;
+  size_t      total;
+  pageWrite_t write;
+  void*       ctx;
+} pageOut_t;
+
+static void flush(pageOut_t* o) {
+  if ( o->len ) o->write(o->ctx, o->buf, o->len);
+  o->total += o->len;
+  o->len = 0;
+}
+
+//  Small pieces are collected, text that does not fit in the buffer is written from flash directly
+static void emit(pageOut_t* o, const char* aData, size_t aLen) {
+  if ( o->len + aLen > o->size ) {
+    flush(o);
+    if ( aLen > o->size ) {
+      o->write(o->ctx, aData, aLen);
+      o->total += aLen;
+      return;
+    }
+  }
+  memcpy(o->buf + o->len, aData, aLen);
+  o->len += aLen;
+}
+
+static void emitNumber(pageOut_t* o, long aValue) {
+  char num[12];
+  int n = snprintf(num, sizeof(num), "%ld", aValue);
+  if ( n > 0 ) emit(o, num, n);
+}
+
+size_t pageRender(const pageSegment_t* aPage, const int32_t* aValues, uint32_t aVersion,
+                  char* aBuf, size_t aSize, pageWrite_t aWrite, void* aCtx) {
+  pageOut_t o = { aBuf, aSize, 0, 0, aWrite, aCtx };
+
+  for (const pageSegment_t* s = aPage; ; s++) {
+    emit(&o, s->text, s->len);
+    switch ( s->slot ) {
+      case PAGE_SLOT_VALUE:
+        emitNumber(&o, aValues[s->value]);
+        break;
+      case PAGE_SLOT_VERSION: {
+        char num[9];
+        snprintf(num, sizeof(num), "%08x", (unsigned) aVersion);
+        emit(&o, num, 8);
+        break;
+      }
+      case PAGE_SLOT_CHECKED:
+        if ( aValues[s->value] == 1 ) emit(&o, " checked", 8);
+        break;
+      case PAGE_SLOT_SELECTED:
+        if ( aValues[s->value] == s->arg ) emit(&o, " selected", 9);
+        break;
+      default:
+        flush(&o);
+        return o.total;
+    }
+  }
+}
@@ -0,0 +1,131 @@
+//  === /status document =============================================================================
+
+#include "status.h"
+#include "streaming.h"
+#include "stream_dispatcher.h"
+#include "json_writer.h"
+#include "camera_settings.h"
+
+statusSnapshot_t statusSnapshot = { 0, 0, 0, 0, "Unknown", 0, 0, 0 };
+
+// ==== Sensor frame size and link parameters, sampled by the web server task ===============
+void statusRefresh(bool aForce) {
+  if ( !aForce && statusSnapshot.updated && millis() - statusSnapshot.updated < STATUS_REFRESH_MS ) return;
+  statusSnapshot_t* st = &statusSnapshot;
+
+  sensor_t* sensor = esp_camera_sensor_get();
+  framesize_t framesize = sensor ? (framesize_t) sensor->status.framesize : FRAMESIZE_INVALID;
+  st->width = framesize < FRAMESIZE_INVALID ? resolution[framesize].width : 0;
+  st->height = framesize < FRAMESIZE_INVALID ? resolution[framesize].height : 0;
+
+  st->rssi = WiFi.RSSI();
+  st->channel = WiFi.channel();
+
+  wifi_ap_record_t ap_info;
+  if ( esp_wifi_sta_get_ap_info(&ap_info) == ESP_OK ) {
+    bool wide = ap_info.second != WIFI_SECOND_CHAN_NONE;
+    st->phy = ap_info.phy_11n ? "802.11n" : ap_info.phy_11g ? "802.11g" : "802.11b";
+    st->bandwidth = wide ? 40 : 20;
+    if ( ap_info.phy_11n ) st->maxSpeed = wide ? 150 : 72;
+    else st->maxSpeed = ap_info.phy_11g ? 54 : 11;
+  }
+  else {
+    st->phy = "Unknown";
+    st->bandwidth = 0;
+    st->maxSpeed = 0;
+  }
+  st->updated = millis();
+}
+
+size_t statusRender(char* aBuf, size_t aSize) {
+  const statusSnapshot_t* st = &statusSnapshot;
+  const uint32_t now = millis();
+  jsonWriter_t j;
+  jsonInit(&j, aBuf, aSize);
+
+  jsonBeginObject(&j);
+  jsonString(&j, "status", "OK");
+  jsonFixed(&j, "cameraFPS", cameraFPS, 1);
+  jsonUint(&j, "frameSize", currentFrameSize);
+  jsonUint(&j, "clients", clientsConnected);
+  jsonBool(&j, "tcpOnly", true);
+  jsonUint(&j, "heap", ESP.getFreeHeap() / 1024);
+  jsonUint(&j, "psram", ESP.getFreePsram() / 1024);
+  jsonUint(&j, "uptime", now / 1000);
+  jsonInt(&j, "wifiRSSI", st->rssi);
+  jsonUint(&j, "wifiChannel", st->channel);
+  jsonString(&j, "wifiPHY", st->phy);
+  jsonUint(&j, "wifiBandwidth", st->bandwidth);
+  jsonUint(&j, "wifiMaxSpeed", st->maxSpeed);
+
+  //  Streaming task wake-ups per published frame: one per waiting task when nobody polls
+#if defined(CAMERA_DISPATCHER_TASK)
+  uint32_t wakeups = streamDispatchStats.wakeups;
+#else
+  uint32_t wakeups = frameRingStats.wakeups;
+#endif
+  jsonFixed(&j, "wakeupsPerFrame", frameRingStats.published ? (float) wakeups / frameRingStats.published : 0, 2);
+  jsonUint(&j, "ringOverruns", frameRingStats.overruns);
+
+  //  Capture power state and time to first frame after a connect, from standby and from warm
+  jsonBeginObject(&j, "capture");
+  jsonString(&j, "state", capturePowerName(capturePower.state));
+  jsonUint(&j, "seconds", (now - capturePower.since) / 1000);
+  jsonUint(&j, "warmMs", CAPTURE_WARM_MS);
+  jsonUint(&j, "sleeps", capturePower.sleeps);
+  jsonUint(&j, "wakes", capturePower.wakes);
+  jsonUint(&j, "ttffCold", capturePower.ttffCold);
+  jsonUint(&j, "ttffColdMax", capturePower.ttffColdMax);
+  jsonUint(&j, "ttffWarm", capturePower.ttffWarm);
+  jsonUint(&j, "ttffWarmMax", capturePower.ttffWarmMax);
+  jsonEndObject(&j);
+
+  //  Memory pressure tier and the sample behind it; a raised tier sheds load instead of restarting
+  jsonBeginObject(&j, "memory");
+  jsonString(&j, "tier", memTierName(memWatch.tier));
+  jsonString(&j, "reason", memWatch.reason);
+  jsonUint(&j, "seconds", (now - memWatch.since) / 1000);
+  jsonUint(&j, "transitions", memWatch.transitions);
+  jsonString(&j, "worst", memTierName(memWatch.worst));
+  jsonUint(&j, "freeHeap", memWatch.last.freeHeap);
+  jsonUint(&j, "largestBlock", memWatch.last.largestBlock);
+  jsonUint(&j, "freePsram", memWatch.last.freePsram);
+  jsonUint(&j, "allocFailures", memWatch.last.allocFailures);
+  jsonUint(&j, "ringDepth", frameRingDepth());
+  jsonFixed(&j, "fpsCap", memWatchFpsCap(), 1);
+  jsonEndObject(&j);
+
+  //  Per-client delivery: frames skipped to stay on the newest frame and the rate actually received
+  jsonBeginArray(&j, "streams");
+  for (int8_t i = 0; i < MAX_CLIENTS; i++) {
+    const streamClient_t* c = &streamClients[i];
+    if ( !c->used ) continue;
+    jsonBeginObject(&j);
+    jsonIp(&j, "ip", c->ip);
+    jsonFixed(&j, "fps", streamClientFps(i), 1);
+    jsonUint(&j, "sent", c->sent);
+    jsonUint(&j, "dropped", c->dropped);
+    jsonFixed(&j, "target", c->target, 1);
+    jsonUint(&j, "paced", c->paced);
+    jsonUint(&j, "ttff", c->ttff);
+    jsonUint(&j, "seconds", (now - c->since) / 1000);
+    jsonEndObject(&j);
+  }
+  jsonEndArray(&j);
+
+  //  Camera controls as the sensor reports them, the stored settings without a sensor
+  sensor_t* sensor = esp_camera_sensor_get();
+  jsonBeginObject(&j, "controls");
+  for (int i = 0; i < CAMERA_SETTINGS; i++) {
+    const cameraControl_t* c = &cameraControls[i];
+    jsonInt(&j, c->name, sensor ? c->get(sensor) : cameraSettingsGet(c->setting));
+  }
+  jsonEndObject(&j);
+
+  jsonUint(&j, "currentWidth", st->width);
+  jsonUint(&j, "currentHeight", st->height);
+  jsonBool(&j, "settingsLoaded", true);
+  jsonEndObject(&j);
+
+  return jsonFinish(&j);
+}
@@ -0,0 +1,119 @@
+//  === Per-client streaming statistics ==============================================================
+//  A record is owned by the task streaming to that client: only it updates the counters,
+//  the web server reads them for /status.
+
+#include "stream_clients.h"
+
+#if defined(HOST_NATIVE)
+#include <netinet/in.h>
+#include <sys/socket.h>
+#else
+#include "lwip/sockets.h"
+#endif
+
+streamClient_t streamClients[MAX_CLIENTS];
+streamLatency_t streamLatency;
+static streamClientTotals_t lifetime = { 0, 0, 0, 0, 0, 0 };
+
+static portMUX_TYPE clientsMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ==== Take a free record for a new streaming connection, -1 if all are in use ===========
+int8_t streamClientOpen(int aSocket, float aTarget) {
+  int8_t id = -1;
+
+  portENTER_CRITICAL(&clientsMux);
+  for (int8_t i = 0; i < MAX_CLIENTS; i++) {
+    if ( !streamClients[i].used ) {
+      memset(&streamClients[i], 0, sizeof(streamClient_t));
+      streamClients[i].used = true;
+      lifetime.connects++;
+      id = i;
+      break;
+    }
+  }
+  portEXIT_CRITICAL(&clientsMux);
+  if ( id < 0 ) return id;
+
+  struct sockaddr_in addr;
+  socklen_t len = sizeof(addr);
+  if ( getpeername(aSocket, (struct sockaddr*) &addr, &len) == 0 && addr.sin_family == AF_INET ) {
+    streamClients[id].ip = addr.sin_addr.s_addr;
+  }
+  streamClients[id].target = aTarget;
+  streamClients[id].since = millis();
+  streamClients[id].winStart = streamClients[id].since;
+  return id;
+}
+
+// Of aSkipped frames between two sent aElapsed ms apart, those the requested rate holds back:
+// the camera published aSkipped + 1 frames in that time, one interval's worth of them is the
+// client's share. A client slower than its rate skips more, and the rest count as dropped
+static uint32_t pacedSkips(const streamClient_t* c, uint32_t aSkipped, uint32_t aElapsed) {
+  if ( c->target <= 0 ) return 0;
+  if ( aElapsed == 0 ) return aSkipped;
+  uint32_t share = (uint32_t) ((aSkipped + 1) * 1000.0 / (c->target * aElapsed) + 0.5);
+  if ( share == 0 ) return 0;
+  return share - 1 < aSkipped ? share - 1 : aSkipped;
+}
+
+// ==== A frame went out completely ========================================================
+void streamClientSent(int8_t aId, uint32_t aFrame, uint32_t aBytes) {
+  if ( aId < 0 || aId >= MAX_CLIENTS ) return;
+  streamClient_t* c = &streamClients[aId];
+
+  uint32_t now = millis();
+  if ( c->sent == 0 ) c->ttff = now - c->since;
+  if ( c->sent && aFrame > c->last + 1 ) {
+    uint32_t skipped = aFrame - c->last - 1;
+    uint32_t paced = pacedSkips(c, skipped, now - c->lastAt);
+    c->paced += paced;
+    c->dropped += skipped - paced;
+  }
+  c->last = aFrame;
+  c->lastAt = now;
+  c->sent++;
+  c->bytes += aBytes;
+  c->winSent++;
+
+  if ( now - c->winStart >= 1000 ) {
+    c->fps = c->winSent * 1000.0 / (now - c->winStart);
+    c->winStart = now;
+    c->winSent = 0;
+  }
+}
+
+void streamClientClose(int8_t aId) {
+  if ( aId < 0 || aId >= MAX_CLIENTS ) return;
+  streamClient_t* c = &streamClients[aId];
+  portENTER_CRITICAL(&clientsMux);
+  c->used = false;
+  lifetime.disconnects++;
+  lifetime.sent += c->sent;
+  lifetime.bytes += c->bytes;
+  lifetime.dropped += c->dropped;
+  lifetime.paced += c->paced;
+  portEXIT_CRITICAL(&clientsMux);
+}
+
+// ==== Totals since boot, clients still connected included ===============================
+void streamClientTotals(streamClientTotals_t* aTotals) {
+  portENTER_CRITICAL(&clientsMux);
+  *aTotals = lifetime;
+  for (int8_t i = 0; i < MAX_CLIENTS; i++) {
+    const streamClient_t* c = &streamClients[i];
+    if ( !c->used ) continue;
+    aTotals->sent += c->sent;
+    aTotals->bytes += c->bytes;
+    aTotals->dropped += c->dropped;
+    aTotals->paced += c->paced;
+  }
+  portEXIT_CRITICAL(&clientsMux);
+}
+
+// Rate over the last window, or since the last frame when the client has stalled
+float streamClientFps(int8_t aId) {
+  if ( aId < 0 || aId >= MAX_CLIENTS ) return 0.0;
+  streamClient_t* c = &streamClients[aId];
+  uint32_t elapsed = millis() - c->winStart;
+  return elapsed > 2000 ? c->winSent * 1000.0 / elapsed : c->fps;
+}
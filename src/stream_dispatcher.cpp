@@ -0,0 +1,219 @@
+//  === Event-driven streaming dispatcher ============================================================
+//  One task pushes the current frame to every client over non-blocking sockets.
+//  A client that cannot take the whole part keeps its frame reference and the offset it stopped at,
+//  and is resumed once select() reports its socket writable. Clients that are done wait for
+//  the next frame without spinning: the dispatcher is subscribed to the ring's frame-ready notifications.
+//  Builds against lwIP on the device and against POSIX sockets on the host.
+
+#include "stream_dispatcher.h"
+#include "stream_clients.h"
+#include "mem_watch.h"
+#include "trace.h"
+#include "esp_timer.h"
+
+#include <errno.h>
+#if defined(HOST_NATIVE)
+#include <fcntl.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#else
+#include "lwip/sockets.h"
+#endif
+
+typedef struct {
+  int             sock;
+  void*           owner;
+  int8_t          id;     // per-client statistics record
+  uint32_t        last;   // number of the last frame sent completely
+  frameChunck_t*  frame;  // frame being sent, referenced in the ring
+  uint32_t        off;    // bytes of the current part already sent
+  int64_t         start;  // esp_timer time the current part was started
+  framePacer_t    pacer;  // requested rate
+} dispatchClient_t;
+
+streamDispatchStats_t streamDispatchStats = { 0, 0, 0, 0, 0, 0 };
+
+static dispatchClient_t clients[MAX_CLIENTS];
+static uint8_t          clientCount = 0;
+static QueueHandle_t    newClients = NULL;
+static TaskHandle_t     dispatcher = NULL;
+static void             (*onClose)(int aSocket, void* aOwner) = NULL;
+
+bool streamDispatchInit(void (*aOnClose)(int aSocket, void* aOwner)) {
+  onClose = aOnClose;
+  if ( newClients == NULL ) newClients = xQueueCreate(MAX_CLIENTS, sizeof(dispatchClient_t));
+  return newClients != NULL;
+}
+
+// ==== Called from the web server task ===================================================
+bool streamDispatchAdd(int aSocket, void* aOwner, float aFps) {
+  if ( newClients == NULL || aSocket < 0 ) return false;
+
+  dispatchClient_t c;
+  memset(&c, 0, sizeof(c));
+  c.sock = aSocket;
+  c.owner = aOwner;
+  c.last = frameNumber - 1;
+
+  int flags = fcntl(aSocket, F_GETFL, 0);
+  if ( flags < 0 || fcntl(aSocket, F_SETFL, flags | O_NONBLOCK) < 0 ) return false;
+  c.id = streamClientOpen(aSocket, aFps);
+  framePacerInit(&c.pacer, aFps, esp_timer_get_time());
+  if ( xQueueSend(newClients, &c, 0) != pdTRUE ) {
+    streamClientClose(c.id);
+    return false;
+  }
+  if ( dispatcher ) xTaskNotifyGive(dispatcher);
+  return true;
+}
+
+// ==== Take a reference on the newest frame this client has not seen yet =================
+// A paced client whose next frame is not due yet skips it without queueing anything.
+// The dispatcher wakes on every publish, so it checks again with the next frame.
+// Short of memory every client is held to a lower rate
+static void startFrame(dispatchClient_t* c) {
+  framePacerCap(&c->pacer, memWatchFpsCap());
+  if ( curFrame == NULL || frameNumber == c->last || !framePacerTake(&c->pacer, esp_timer_get_time()) ) return;
+  TRACE_BEGIN("lock");
+  frameChunck_t* f = frameRingAcquire(c->last);
+  TRACE_END("lock");
+  if ( f == NULL ) {
+    framePacerRefund(&c->pacer);
+    return;
+  }
+  c->frame = f;
+  c->off = 0;
+  c->start = esp_timer_get_time();
+  histogramAdd(&streamLatency.queue, c->start - f->pus);
+}
+
+static void dropClient(uint8_t aIndex) {
+  dispatchClient_t* c = &clients[aIndex];
+  if ( c->frame ) frameRingRelease(c->frame);
+  streamClientClose(c->id);
+  if ( onClose ) onClose(c->sock, c->owner);
+  else close(c->sock);
+
+  clients[aIndex] = clients[--clientCount];
+  streamDispatchStats.dropped++;
+  streamDispatchStats.clients = clientCount;
+}
+
+// ==== Send as much of the current part as the socket takes ==============================
+// Returns 1 when the part is complete, 0 when the socket buffer is full, -1 on error
+static int sendPart(dispatchClient_t* c) {
+  const frameChunck_t* f = c->frame;
+  const uint32_t total = f->hln + f->siz + bdrLen;
+
+  while ( c->off < total ) {
+    int r = mjpegPartSend(c->sock, f->hdr, f->hln, f->dat, f->siz, c->off, MSG_DONTWAIT);
+    if ( r > 0 ) {
+      c->off += r;
+      streamDispatchStats.bytes += r;
+      continue;
+    }
+    if ( r < 0 && errno == EINTR ) continue;
+    if ( r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) ) {
+      streamDispatchStats.blocked++;
+      return 0;
+    }
+    return -1;
+  }
+  return 1;
+}
+
+// ==== A readable streaming socket is either the peer hanging up or data to discard ======
+static bool peerClosed(dispatchClient_t* c) {
+  char scratch[64];
+  for (;;) {
+    int r = recv(c->sock, scratch, sizeof(scratch), MSG_DONTWAIT);
+    if ( r > 0 ) continue;
+    if ( r < 0 && errno == EINTR ) continue;
+    return r == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+  }
+}
+
+// Wait up to aTimeoutMs for pending sockets to become writable or any socket readable.
+// Drops the clients that hung up
+static void waitSockets(uint32_t aTimeoutMs) {
+  fd_set rd, wr;
+  int maxFd = -1;
+
+  FD_ZERO(&rd);
+  FD_ZERO(&wr);
+  for (uint8_t i = 0; i < clientCount; i++) {
+    FD_SET(clients[i].sock, &rd);
+    if ( clients[i].frame ) FD_SET(clients[i].sock, &wr);
+    if ( clients[i].sock > maxFd ) maxFd = clients[i].sock;
+  }
+
+  struct timeval tv;
+  tv.tv_sec = aTimeoutMs / 1000;
+  tv.tv_usec = (aTimeoutMs % 1000) * 1000;
+  if ( select(maxFd + 1, &rd, &wr, NULL, &tv) <= 0 ) return;
+
+  for (uint8_t i = 0; i < clientCount; ) {
+    if ( FD_ISSET(clients[i].sock, &rd) && peerClosed(&clients[i]) ) {
+      dropClient(i);
+      continue;
+    }
+    i++;
+  }
+}
+
+// ==== Dispatcher task ======================================================================
+void streamDispatchCB(void* pvParameters) {
+  (void) pvParameters;
+  dispatcher = xTaskGetCurrentTaskHandle();
+  frameRingSubscribe(dispatcher);
+
+  for (;;) {
+    dispatchClient_t c;
+    while ( clientCount < MAX_CLIENTS && xQueueReceive(newClients, &c, 0) == pdTRUE ) {
+      clients[clientCount++] = c;
+      streamDispatchStats.clients = clientCount;
+    }
+
+    //  Push data to every client that can take it, starting a new frame where the last one is done
+    bool pending = false;
+    for (uint8_t i = 0; i < clientCount; ) {
+      dispatchClient_t* cl = &clients[i];
+      if ( cl->frame == NULL ) startFrame(cl);
+      if ( cl->frame ) {
+        TRACE_BEGIN("send");
+        int r = sendPart(cl);
+        TRACE_END("send");
+        if ( r < 0 ) {
+          dropClient(i);
+          continue;
+        }
+        if ( r > 0 ) {
+          int64_t sent = esp_timer_get_time();
+          histogramAdd(&streamLatency.send, sent - cl->start);
+          histogramAdd(&streamLatency.total, sent - cl->frame->cus);
+          cl->last = cl->frame->fnm;
+          streamClientSent(cl->id, cl->last, cl->off);
+          frameRingRelease(cl->frame);
+          cl->frame = NULL;
+          streamDispatchStats.frames++;
+        }
+        else pending = true;
+      }
+      i++;
+    }
+
+    //  Sleep until there is something to do: a socket drained, or a new frame or client arrived
+    if ( pending ) {
+      ulTaskNotifyTake(pdTRUE, 0);
+      waitSockets(DISPATCH_POLL_MS);
+    }
+    else if ( clientCount == 0 ) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+    else if ( ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(DISPATCH_IDLE_MS)) == 0 ) {
+      waitSockets(0);
+    }
+    streamDispatchStats.wakeups++;
+  }
+}
@@ -1,8 +1,14 @@
 #include "streaming.h"
 #include "camera_pins.h"
-#include <Preferences.h>
+#include "stream_dispatcher.h"
+#include "http_cache.h"
+#include "metrics.h"
+#include "status.h"
+#include "index_page.h"
+#include "camera_settings.h"
 #include <FS.h>
 #include <SPIFFS.h>
+#include <new>
 
 // Add CORS headers to response
 void addCORSHeaders() {
@@ -12,37 +18,6 @@ void addCORSHeaders() {
   server.sendHeader("Access-Control-Max-Age", "86400");
 }
 
-// Helper to insert 'checked' attribute into checkbox input with given id
-static void insertCheckedAttribute(String &html, const char* inputId, bool isChecked) {
-  if (!isChecked) return;
-  String idPattern = String("id='") + inputId + "'";
-  int idPos = html.indexOf(idPattern);
-  if (idPos < 0) return;
-  int tagEnd = html.indexOf('>', idPos);
-  if (tagEnd < 0) return;
-  // Insert before '>' if not already present
-  String before = html.substring(0, tagEnd);
-  if (before.indexOf(" checked") >= 0) return;
-  html = before + " checked" + html.substring(tagEnd);
-}
-
-// Helper to mark selected option inside a <select id='...'> block
-static void markSelectedOption(String &html, const char* selectId, int selectedValue) {
-  String idPattern = String("id='") + selectId + "'";
-  int selectStart = html.indexOf(idPattern);
-  if (selectStart < 0) return;
-  int blockEnd = html.indexOf("</select>", selectStart);
-  if (blockEnd < 0) return;
-  String block = html.substring(selectStart, blockEnd);
-  String valuePattern = String("value='") + String(selectedValue) + "'";
-  int valPos = block.indexOf(valuePattern);
-  if (valPos < 0) return;
-  // Prevent adding multiple selected
-  if (block.indexOf(" selected", valPos) >= 0) return;
-  block.replace(valuePattern, valuePattern + " selected");
-  html = html.substring(0, selectStart) + block + html.substring(blockEnd);
-}
-
 // === ФУНКЦИЯ ДЛЯ ПОЛУЧЕНИЯ ОПИСАНИЯ РАЗРЕШЕНИЯ ===
 String getFrameSizeDescription() {
   sensor_t *sensor = esp_camera_sensor_get();
@@ -126,31 +101,98 @@ void applyAdaptiveQuality() {
 }
 #endif
 
-const char* HEADER = "HTTP/1.1 200 OK\r\n" \
-                      "Access-Control-Allow-Origin: *\r\n" \
-                      "Content-Type: multipart/x-mixed-replace; boundary=+++===123454321===+++\r\n";
-const char* BOUNDARY = "\r\n--+++===123454321===+++\r\n";
-const char* CTNTTYPE = "Content-Type: image/jpeg\r\nContent-Length: ";
-const int hdrLen = strlen(HEADER);
-const int bdrLen = strlen(BOUNDARY);
-const int cntLen = strlen(CTNTTYPE);
-volatile uint32_t frameNumber;
 volatile uint32_t clientsConnected = 0;  // Track number of connected clients
 
-frameChunck_t* fstFrame = NULL;  // first frame
-frameChunck_t* curFrame = NULL;  // current frame being captured by the camera
-
 const char*  STREAMING_URL = "/mjpeg/1";
+static char* metricsBuffer = NULL;   // /metrics page, allocated once in mjpegCB
+memPool_t    clientPool;             // streaming connection records
+
+// ==== Streaming connection records ======================================================
+// Taken from the client pool carved in mjpegCB, so connects and disconnects never touch the heap
+streamConn_t* streamConnOpen() {
+  void* block = memPoolAlloc(&clientPool);
+  return block ? new (block) streamConn_t() : NULL;
+}
+
+void streamConnClose(streamConn_t* aConn) {
+  aConn->~streamConn_t();
+  memPoolFree(&clientPool, aConn);
+}
+
+// ==== Memory watch: sample the heap, apply the tier =====================================
+// Tiers add up: each keeps what the ones below it apply. Leaving a tier undoes its own part.
+// The frame rate cap is read by the streaming side itself, refusing clients by handleJPGSstream
+static void applyMemoryTier(memTier_t aFrom, memTier_t aTo) {
+  static int quality = -1;    // quality number before it was raised
+  static int raised = -1;     // quality number set by the tier
+  sensor_t* s = esp_camera_sensor_get();
+
+  if ( aFrom < MEM_TIER_RING && aTo >= MEM_TIER_RING ) frameRingSetDepth(MEM_RING_DEPTH);
+  if ( aFrom >= MEM_TIER_RING && aTo < MEM_TIER_RING ) frameRingSetDepth(FRAME_RING_SLOTS);
+
+  if ( s && aFrom < MEM_TIER_QUALITY && aTo >= MEM_TIER_QUALITY ) {
+    quality = s->status.quality;
+    raised = quality + MEM_QUALITY_STEP > 63 ? 63 : quality + MEM_QUALITY_STEP;
+    s->set_quality(s, raised);
+  }
+  if ( s && aFrom >= MEM_TIER_QUALITY && aTo < MEM_TIER_QUALITY && quality >= 0 ) {
+    //  Unless /control changed it meanwhile
+    if ( s->status.quality == raised ) s->set_quality(s, quality);
+    quality = raised = -1;
+  }
+
+  if ( aTo == MEM_TIER_RESTART ) {
+    Log.fatal("memWatch: memory still critical with new clients refused, restarting\n");
+    cameraSettingsFlush();
+    Log.flush();
+    ESP.restart();
+  }
+}
+
+static void memoryTick() {
+  static uint32_t last = 0;
+  const uint32_t now = millis();
+  if ( now - last < MEM_WATCH_INTERVAL_MS ) return;
+  last = now;
+
+  memSample_t s = { ESP.getFreeHeap(), ESP.getMaxAllocHeap(), ESP.getFreePsram(), ESP.getPsramSize(), allocFailures };
+  memTier_t from = memWatch.tier;
+  memTier_t to = memWatchUpdate(&memWatch, &s, now);
+  if ( to == from ) return;
+
+  if ( to > from ) {
+    Log.warning("memWatch: tier %s -> %s (%s), heap %u, largest block %u, psram %u\n", memTierName(from), memTierName(to),
+                memWatch.reason, (unsigned) s.freeHeap, (unsigned) s.largestBlock, (unsigned) s.freePsram);
+  }
+  else {
+    Log.notice("memWatch: tier %s -> %s (%s), heap %u, largest block %u, psram %u\n", memTierName(from), memTierName(to),
+               memWatch.reason, (unsigned) s.freeHeap, (unsigned) s.largestBlock, (unsigned) s.freePsram);
+  }
+  applyMemoryTier(from, to);
+}
+
+// New streams wait while memory is short; the streams already running keep going
+bool streamRefuseLowMemory() {
+  if ( memWatch.tier < MEM_TIER_REFUSE ) return false;
+  Log.warning("handleJPGSstream: refused, memory tier %s\n", memTierName(memWatch.tier));
+  server.sendHeader("Retry-After", String(MEM_RECOVER_MS / 1000));
+  server.send(503, "text/plain", "Low on memory");
+  return true;
+}
 
 void mjpegCB(void* pvParameters) {
-  TickType_t xLastWakeTime;
-  const TickType_t xFrequency = pdMS_TO_TICKS(WSINTERVAL);
+  // Frame ring shared between the camera task and streaming clients
+  frameRingInit();
 
-  // Creating frame synchronization semaphore and initializing it
-  frameSync = xSemaphoreCreateBinary();
-  
-  // TCP streaming only
-  xSemaphoreGive( frameSync );
+  // A record per streaming client, internal RAM if there is room
+  memPoolInit(&clientPool, "client", sizeof(streamConn_t), MAX_CLIENTS, 1, ANY_MEMORY);
+
+  // Memory pressure tiers, sampled in the loop below
+  memWatchInit(&memWatch, millis(), allocFailures);
+
+  // /metrics renders into one buffer allocated up front, PSRAM if there is any
+  metricsBuffer = allocateMemory(NULL, METRICS_BUFFER_SIZE, OK_IF_OOM, PSRAM_ONLY);
+  if ( metricsBuffer == NULL ) metricsBuffer = allocateMemory(NULL, METRICS_BUFFER_SIZE, FAIL_IF_OOM);
 
   // Initialize streaming clients queue
   streamingClients = xQueueCreate( MAX_CLIENTS, sizeof(WiFiClient*) );
@@ -165,16 +207,37 @@ void mjpegCB(void* pvParameters) {
       &tCam,        // RTOS task handle
       APP_CPU);     // dedicated core for camera operations
 
+#if defined(CAMERA_DISPATCHER_TASK)
+  //  One task streams to every client instead of a task per client
+  startStreamDispatcher();
+#endif
+
+  //  CPU share and stack of every task for /debug/tasks
+  taskStatsStart();
+
+  // Request headers the handlers look at
+  static const char* headerKeys[] = { "If-None-Match", "Accept-Encoding" };
+  server.collectHeaders(headerKeys, sizeof(headerKeys) / sizeof(headerKeys[0]));
+
   // Register webserver handling routines with CORS middleware
   server.on("/", HTTP_GET, [](){
     addCORSHeaders();
     handleRoot();
   });
   server.on(STREAMING_URL, HTTP_GET, handleJPGSstream);
+  server.on("/capture", HTTP_GET, [](){
+    addCORSHeaders();
+    handleSnapshot();
+  });
+  server.on("/jpg", HTTP_GET, [](){
+    addCORSHeaders();
+    handleSnapshot();
+  });
   server.on("/control", HTTP_GET, [](){
     addCORSHeaders();
     handleControl();
   });
+  server.on("/metrics", HTTP_GET, handleMetrics);
   server.on("/status", HTTP_GET, [](){
     addCORSHeaders();
     handleStatus();
@@ -187,6 +250,13 @@ void mjpegCB(void* pvParameters) {
     addCORSHeaders();
     handleReboot();
   });
+  server.on("/debug/tasks", HTTP_GET, [](){
+    addCORSHeaders();
+    handleTasks();
+  });
+#if defined(TRACE_LOG)
+  server.on("/debug/trace", HTTP_GET, handleTrace);
+#endif
   
   // Handle CORS preflight requests FIRST - before any other handlers
   server.on("/status", HTTP_OPTIONS, [](){
@@ -212,31 +282,16 @@ void mjpegCB(void* pvParameters) {
     server.send(200, "text/plain", "");
   });
 
-  // Serve UI assets from SPIFFS
-  server.on("/css/main.css", HTTP_GET, [](){
-    File f = SPIFFS.open("/css/main.css", "r");
-    if (!f) { server.send(404, "text/plain", "Not found"); return; }
-    server.streamFile(f, "text/css");
-    f.close();
-  });
-  server.on("/js/controls.js", HTTP_GET, [](){
-    File f = SPIFFS.open("/js/controls.js", "r");
-    if (!f) { server.send(404, "text/plain", "Not found"); return; }
-    server.streamFile(f, "application/javascript");
-    f.close();
-  });
-  server.on("/js/status.js", HTTP_GET, [](){
-    File f = SPIFFS.open("/js/status.js", "r");
-    if (!f) { server.send(404, "text/plain", "Not found"); return; }
-    server.streamFile(f, "application/javascript");
-    f.close();
-  });
-  
+  // UI assets embedded in flash (tools/assets.py) are routed by a lookup in their table.
   // Global OPTIONS handler for any unhandled preflight requests
+  httpAssetsInit();
   server.onNotFound([](){
+    const httpAsset_t* asset;
     if (server.method() == HTTP_OPTIONS) {
       addCORSHeaders();
       server.send(200, "text/plain", "");
+    } else if (server.method() == HTTP_GET && (asset = httpAssetFind(server.uri().c_str())) != NULL) {
+      handleAsset(asset);
     } else {
       handleNotFound();
     }
@@ -249,57 +304,20 @@ void mjpegCB(void* pvParameters) {
   Log.verbose ("mjpegCB: free heap (start)  : %d\n", ESP.getFreeHeap());
 
   //=== loop() section  ===================
-  xLastWakeTime = xTaskGetTickCount();
   for (;;) {
     server.handleClient();
+    //  Sensor and WiFi values for /status, sampled between requests
+    statusRefresh();
+    //  Camera settings changed through /control, saved once the controls are quiet
+    cameraSettingsTick(millis());
+    //  Heap and PSRAM against the memory pressure tiers
+    memoryTick();
 
     //  Minimal delay for better responsiveness - optimized for high FPS
     vTaskDelay(1);  // Just yield to other tasks
   }
 }
 
-// ==== Memory allocator that takes advantage of PSRAM if present =======================
-char* allocatePSRAM(size_t aSize) {
-  if ( psramFound() && ESP.getFreePsram() > aSize ) {
-    return (char*) ps_malloc(aSize);
-  }
-  return NULL;
-}
-
-char* allocateMemory(char* aPtr, size_t aSize, bool fail, bool psramOnly) {
-
-  //  Since current buffer is too smal, free it
-  if (aPtr != NULL) {
-    free(aPtr);
-    aPtr = NULL;
-  }
-
-  char* ptr = NULL;
-
-  if ( psramOnly ) {
-    ptr = allocatePSRAM(aSize);
-  }
-  else {
-    // If memory requested is more than 2/3 of the currently free heap, try PSRAM immediately
-    if ( aSize > ESP.getFreeHeap() * 2 / 3 ) {
-      ptr = allocatePSRAM(aSize);
-    }
-    else {
-      //  Enough free heap - let's try allocating fast RAM as a buffer
-      ptr = (char*) malloc(aSize);
-
-      //  If allocation on the heap failed, let's give PSRAM one more chance:
-      if ( ptr == NULL ) ptr = allocatePSRAM(aSize);
-    }
-  }
-
-  if ( ptr == NULL && fail ) {
-    Log.error("allocateMemory: failed to allocate %d bytes\n", aSize);
-    ESP.restart();
-  }
-
-  return ptr;
-}
 
 // handleJPGSstream is implemented in streaming_multiclient_task.cpp
 
@@ -314,188 +332,20 @@ void handleControl() {
   
   Log.notice("Camera control request: %s = %s (int: %d)\n", var.c_str(), val.c_str(), intVal);
   
-  delay(10);
-  
-  Preferences prefs;
-  bool prefsOpened = prefs.begin("cam", false);
-  if (prefsOpened) {
-    Log.notice("Camera control: NVS opened successfully for saving\n");
-  } else {
-    Log.error("Camera control: Failed to open NVS for saving\n");
-  }
-
-  if (var == "quality") { 
-    res = s->set_quality(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("q", intVal);
-      Log.notice("Camera control: Saved quality = %d to NVS\n", intVal);
-    }
-  }
-  else if (var == "contrast") { 
-    res = s->set_contrast(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("ct", intVal);
-      Log.notice("Camera control: Saved contrast = %d to NVS\n", intVal);
-    }
-  }
-  else if (var == "brightness") { 
-    res = s->set_brightness(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("br", intVal);
-      Log.notice("Camera control: Saved brightness = %d to NVS\n", intVal);
-    }
-  }
-  else if (var == "saturation") { 
-    res = s->set_saturation(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("sa", intVal);
-      Log.notice("Camera control: Saved saturation = %d to NVS\n", intVal);
-    }
-  }
-  else if (var == "gainceiling") { 
-    res = s->set_gainceiling(s, (gainceiling_t)intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("gc", intVal);
-      Log.notice("Camera control: Saved gainceiling = %d to NVS\n", intVal);
-    } 
-  }
-  else if (var == "colorbar") { 
-    res = s->set_colorbar(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("cb", intVal);
-      Log.notice("Camera control: Saved colorbar = %d to NVS\n", intVal);
-    } 
-  }
-  else if (var == "awb") { 
-    res = s->set_whitebal(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("awb", intVal);
-      Log.notice("Camera control: Saved awb = %d to NVS\n", intVal);
-    } 
-  }
-  else if (var == "agc") { 
-    res = s->set_gain_ctrl(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("agc", intVal);
-      Log.notice("Camera control: Saved agc = %d to NVS\n", intVal);
-    } 
-  }
-  else if (var == "aec") { 
-    res = s->set_exposure_ctrl(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("aec", intVal);
-      Log.notice("Camera control: Saved aec = %d to NVS\n", intVal);
-    } 
-  }
-  else if (var == "hmirror") { 
-    res = s->set_hmirror(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("hm", intVal);
-      Log.notice("Camera control: Saved hmirror = %d to NVS\n", intVal);
-    } 
-  }
-  else if (var == "vflip") { 
-    res = s->set_vflip(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("vf", intVal);
-      Log.notice("Camera control: Saved vflip = %d to NVS\n", intVal);
-    } 
-  }
-  else if (var == "awb_gain") { 
-    res = s->set_awb_gain(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("awbg", intVal);
-      Log.notice("Camera control: Saved awb_gain = %d to NVS\n", intVal);
-    } 
-  }
-  else if (var == "agc_gain") { 
-    res = s->set_agc_gain(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("agcg", intVal);
-      Log.notice("Camera control: Saved agc_gain = %d to NVS\n", intVal);
-    } 
-  }
-  else if (var == "aec_value") { 
-    res = s->set_aec_value(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("aecv", intVal);
-      Log.notice("Camera control: Saved aec_value = %d to NVS\n", intVal);
-    } 
-  }
-  else if (var == "aec2") { 
-    res = s->set_aec2(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("aec2", intVal);
-      Log.notice("Camera control: Saved aec2 = %d to NVS\n", intVal);
-    } 
-  }
-  else if (var == "dcw") { 
-    res = s->set_dcw(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("dcw", intVal);
-      Log.notice("Camera control: Saved dcw = %d to NVS\n", intVal);
-    } 
-  }
-  else if (var == "bpc") { 
-    res = s->set_bpc(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("bpc", intVal);
-      Log.notice("Camera control: Saved bpc = %d to NVS\n", intVal);
-    } 
-  }
-  else if (var == "wpc") { 
-    res = s->set_wpc(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("wpc", intVal);
-      Log.notice("Camera control: Saved wpc = %d to NVS\n", intVal);
-    } 
-  }
-  else if (var == "raw_gma") { 
-    res = s->set_raw_gma(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("rg", intVal);
-      Log.notice("Camera control: Saved raw_gma = %d to NVS\n", intVal);
-    } 
-  }
-  else if (var == "lenc") { 
-    res = s->set_lenc(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("lenc", intVal);
-      Log.notice("Camera control: Saved lenc = %d to NVS\n", intVal);
-    } 
-  }
-  else if (var == "special_effect") { 
-    res = s->set_special_effect(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("se", intVal);
-      Log.notice("Camera control: Saved special_effect = %d to NVS\n", intVal);
-    } 
-  }
-  else if (var == "wb_mode") { 
-    res = s->set_wb_mode(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("wb", intVal);
-      Log.notice("Camera control: Saved wb_mode = %d to NVS\n", intVal);
-    } 
-  }
-  else if (var == "ae_level") { 
-    res = s->set_ae_level(s, intVal); 
-    if (res == 0 && prefsOpened) {
-      prefs.putInt("ael", intVal);
-      Log.notice("Camera control: Saved ae_level = %d to NVS\n", intVal);
-    } 
-  }
-  else {
+  // Applied to the sensor now; the settings store saves to NVS once the controls are quiet
+  const cameraControl_t* c = cameraControlFind(var.c_str());
+  if (c == NULL) {
     Log.error("Camera control: Unknown variable %s\n", var.c_str());
     server.send(400, "text/plain", "Unknown variable");
-    if (prefsOpened) prefs.end();
     return;
   }
-
-  if (prefsOpened) {
-    prefs.end();
-    Log.notice("Camera control: NVS closed and synced to flash\n");
+  if (!cameraControlValid(c, intVal)) {
+    Log.error("Camera control: %s = %d out of range %d..%d\n", c->name, intVal, c->min, c->max);
+    server.send(400, "text/plain", "Value out of range");
+    return;
   }
+  res = c->set(s, intVal);
+  if (res == 0) cameraSettingsSet(c->setting, intVal, millis());
 
   if (res == 0) {
     Log.notice("Camera control success: %s = %s\n", var.c_str(), val.c_str());
@@ -514,102 +364,120 @@ void handleControl() {
 }
 
 // ==== Handle status requests ============================================
+// Rendered into a static buffer from the snapshot and the counters; the web server task is
+// the only caller
 void handleStatus() {
-  sensor_t *s = esp_camera_sensor_get();
-  
-  // Get actual resolution from current framesize setting
-  sensor_t *sensor = esp_camera_sensor_get();
-  framesize_t framesize = sensor->status.framesize;
-  
-  String width = "Unknown";
-  String height = "Unknown";
-  
-  // Map framesize enum to actual dimensions
-  switch(framesize) {
-    case FRAMESIZE_96X96:     width = "96";   height = "96";   break;
-    case FRAMESIZE_QQVGA:     width = "160";  height = "120";  break;
-    case FRAMESIZE_QCIF:      width = "176";  height = "144";  break;
-    case FRAMESIZE_HQVGA:     width = "240";  height = "176";  break;
-    case FRAMESIZE_240X240:   width = "240";  height = "240";  break;
-    case FRAMESIZE_QVGA:      width = "320";  height = "240";  break;
-    case FRAMESIZE_CIF:       width = "400";  height = "296";  break;
-    case FRAMESIZE_HVGA:      width = "480";  height = "320";  break;
-    case FRAMESIZE_VGA:       width = "640";  height = "480";  break;
-    case FRAMESIZE_SVGA:      width = "800";  height = "600";  break;
-    case FRAMESIZE_XGA:       width = "1024"; height = "768";  break;
-    case FRAMESIZE_HD:        width = "1280"; height = "720";  break;
-    case FRAMESIZE_SXGA:      width = "1280"; height = "1024"; break;
-    case FRAMESIZE_UXGA:      width = "1600"; height = "1200"; break;
-    case FRAMESIZE_FHD:       width = "1920"; height = "1080"; break;
-    case FRAMESIZE_P_HD:      width = "720";  height = "1280"; break;
-    case FRAMESIZE_P_3MP:     width = "864";  height = "1536"; break;
-    case FRAMESIZE_QXGA:      width = "2048"; height = "1536"; break;
-    case FRAMESIZE_QHD:       width = "2560"; height = "1440"; break;
-    case FRAMESIZE_WQXGA:     width = "2560"; height = "1600"; break;
-    case FRAMESIZE_P_FHD:     width = "1080"; height = "1920"; break;
-    case FRAMESIZE_QSXGA:     width = "2560"; height = "1920"; break;
-    default:                  width = "Unknown"; height = "Unknown"; break;
+  static char buf[STATUS_BUFFER_SIZE];
+  size_t len = statusRender(buf, sizeof(buf));
+  if ( len == 0 ) {
+    server.send(500, "text/plain", "status buffer too small");
+    return;
   }
-  
-  // Calculate uptime
-  unsigned long uptimeSeconds = millis() / 1000;
-  
-  String json = "{";
-  json += "\"status\":\"OK\",";
-  json += "\"cameraFPS\":\"" + String(cameraFPS, 1) + "\",";
-  json += "\"frameSize\":\"" + String(currentFrameSize) + "\",";
-  json += "\"clients\":\"" + String(clientsConnected) + "\",";
-  json += "\"tcpOnly\":\"true\",";
-  json += "\"heap\":\"" + String(ESP.getFreeHeap() / 1024) + "\",";
-  json += "\"psram\":\"" + String(ESP.getFreePsram() / 1024) + "\",";
-  json += "\"uptime\":\"" + String(uptimeSeconds) + "\",";
-  json += "\"wifiRSSI\":\"" + String(WiFi.RSSI()) + "\",";
-  json += "\"wifiChannel\":\"" + String(WiFi.channel()) + "\",";
-  
-  // Добавляем информацию о скорости WiFi
-  wifi_ap_record_t ap_info;
-  if (esp_wifi_sta_get_ap_info(&ap_info) == ESP_OK) {
-    json += "\"wifiPHY\":\"" + String((ap_info.phy_11n) ? "802.11n" : (ap_info.phy_11g) ? "802.11g" : "802.11b") + "\",";
-    json += "\"wifiBandwidth\":\"" + String((ap_info.second != WIFI_SECOND_CHAN_NONE) ? "40MHz" : "20MHz") + "\",";
-    
-    // Теоретическая максимальная скорость
-    int maxSpeed = 0;
-    if (ap_info.phy_11n && ap_info.second != WIFI_SECOND_CHAN_NONE) {
-      maxSpeed = 150; // 802.11n 40MHz
-    } else if (ap_info.phy_11n) {
-      maxSpeed = 72;  // 802.11n 20MHz
-    } else if (ap_info.phy_11g) {
-      maxSpeed = 54;  // 802.11g
-    } else {
-      maxSpeed = 11;  // 802.11b
-    }
-    json += "\"wifiMaxSpeed\":\"" + String(maxSpeed) + " Mbps\",";
-  } else {
-    json += "\"wifiPHY\":\"Unknown\",";
-    json += "\"wifiBandwidth\":\"Unknown\",";
-    json += "\"wifiMaxSpeed\":\"Unknown\",";
+  server.setContentLength(len);
+  server.send(200, "application/json", "");
+  server.sendContent(buf, len);
+}
+
+// ==== Per-task CPU share, stack and placement ============================================
+// Copied from the collector's table and rendered into static buffers; the web server task is
+// the only caller
+void handleTasks() {
+  static taskStats_t stats;
+  static char buf[TASK_STATS_BUFFER_SIZE];
+  taskStatsSnapshot(&stats);
+  size_t len = taskStatsRender(&stats, buf, sizeof(buf));
+  if ( len == 0 ) {
+    server.send(500, "text/plain", "task stats buffer too small");
+    return;
   }
-  
-  json += "\"currentWidth\":\"" + width + "\",";
-  json += "\"currentHeight\":\"" + height + "\",";
-  json += "\"settingsLoaded\":\"true\"";
-  
-  json += "}";
-  
-  server.send(200, "application/json", json);
+  server.setContentLength(len);
+  server.send(200, "application/json", "");
+  server.sendContent(buf, len);
+}
+
+// ==== Prometheus metrics ================================================================
+// Rendered into the buffer allocated at start and sent from there, nothing is allocated per
+// request; the web server task is the only caller
+void handleMetrics() {
+  size_t len = metricsBuffer ? metricsRender(metricsBuffer, METRICS_BUFFER_SIZE) : 0;
+  if ( len == 0 ) {
+    server.send(500, "text/plain", metricsBuffer ? "metrics buffer too small" : "no metrics buffer");
+    return;
+  }
+  server.setContentLength(len);
+  server.send(200, "text/plain; version=0.0.4", "");
+  server.sendContent(metricsBuffer, len);
+}
+
+// ==== Rate asked for by a stream request (/mjpeg/1?fps=5), 0 = camera rate =============
+// Only the rate is negotiable: all clients share one sensor, so resolution is the same for everyone
+float streamRequestedFps() {
+  if ( !server.hasArg("fps") ) return 0.0;
+  float fps = server.arg("fps").toFloat();
+  return fps > 0.0 && fps < FPS ? fps : 0.0;
+}
+
+// ==== Latest frame for a snapshot =======================================================
+// While clients stream, the current frame is fresh and is served as is. Otherwise the
+// snapshot counts as a client until the camera publishes one new frame
+static frameChunck_t* snapshotFrame() {
+  if ( capturePower.state == CAPTURE_STREAMING ) {
+    frameChunck_t* f = frameRingAcquire(0);
+    if ( f ) return f;
+  }
+
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  const uint32_t last = frameNumber;
+  ulTaskNotifyTake(pdTRUE, 0);  // a publish may have notified an earlier snapshot late
+  if ( !frameRingSubscribe(self) ) return NULL;
+  captureClientConnected();
+
+  frameChunck_t* f = NULL;
+  const uint32_t start = millis();
+  while ( f == NULL && millis() - start < SNAPSHOT_WAIT_MS ) {
+    frameRingWait(last, pdMS_TO_TICKS(SNAPSHOT_WAIT_MS));
+    f = frameRingAcquire(last);
+  }
+  frameRingUnsubscribe(self);
+  capturePowerDisconnect(millis());
+  return f;
+}
+
+// ==== Single JPEG of the latest frame (/capture, /jpg) ===================================
+// ETag names the frame, so a poller that already has it gets 304 without the image
+void handleSnapshot() {
+  frameChunck_t* f = snapshotFrame();
+  if ( f == NULL ) {
+    server.send(503, "text/plain", "No frame available");
+    return;
+  }
+
+  char etag[HTTP_ETAG_MAX];
+  httpFrameEtag(etag, sizeof(etag), f->fnm, &f->tsp);
+  server.sendHeader("ETag", etag);
+  server.sendHeader("Cache-Control", "no-cache");
+  if ( httpEtagMatch(server.header("If-None-Match").c_str(), etag) ) {
+    frameRingRelease(f);
+    server.send(304);
+    return;
+  }
+
+  //  Body goes out straight from the ring slot, the camera keeps publishing into other slots
+  server.sendHeader("Content-Disposition", "inline; filename=capture.jpg");
+  server.sendHeader("X-Frame-Number", String(f->fnm));
+  server.setContentLength(f->siz);
+  server.send(200, "image/jpeg", "");
+  server.client().write(f->dat, f->siz);
+  frameRingRelease(f);
 }
 
 // ==== Reset camera settings ============================================
 void handleReset() {
   Log.notice("Camera reset requested\n");
   
-  // Clear NVS settings
-  Preferences prefs;
-  if (prefs.begin("cam", false)) {
-    prefs.clear();
-    prefs.end();
-    Log.notice("Camera reset: NVS settings cleared\n");
-  }
+  // Clear NVS settings, and changes not saved yet
+  cameraSettingsClear();
+  Log.notice("Camera reset: NVS settings cleared\n");
   
   server.send(200, "text/plain", "Camera settings reset. Please reboot to apply defaults.");
 }
@@ -618,112 +486,97 @@ void handleReset() {
 void handleReboot() {
   Log.notice("Reboot requested\n");
   server.send(200, "text/plain", "Rebooting...");
+  cameraSettingsFlush();
   delay(1000);
+  Log.flush();
   ESP.restart();
 }
 
 // ==== Serve the main HTML page =========================================
+static void sendPageChunk(void* aCtx, const char* aData, size_t aLen) {
+  (void) aCtx;
+  server.sendContent(aData, aLen);
+}
+
+//  Page compiled from data/index.html at build time (tools/page_template.py), sent with chunked
+//  transfer encoding while the current settings are filled in: no copy of the page is made
 void handleRoot() {
-  // Read current settings from NVS
-  Preferences prefs;
-  int quality = 10, brightness = 0, contrast = 0, saturation = 0;
-  int gainceiling = 0, colorbar = 0, awb = 1, agc = 1, aec = 1;
-  int hmirror = 0, vflip = 0, awb_gain = 1, agc_gain = 0, aec_value = 300;
-  int aec2 = 0, dcw = 1, bpc = 0, wpc = 1, raw_gma = 1, lenc = 1;
-  int special_effect = 0, wb_mode = 0, ae_level = 0;
-  
-  if (prefs.begin("cam", true)) { // read-only
-    quality = prefs.getInt("q", 10);
-    brightness = prefs.getInt("br", 0);
-    contrast = prefs.getInt("ct", 0);
-    saturation = prefs.getInt("sa", 0);
-    gainceiling = prefs.getInt("gc", 0);
-    colorbar = prefs.getInt("cb", 0);
-    awb = prefs.getInt("awb", 1);
-    agc = prefs.getInt("agc", 1);
-    aec = prefs.getInt("aec", 1);
-    hmirror = prefs.getInt("hm", 0);
-    vflip = prefs.getInt("vf", 0);
-    awb_gain = prefs.getInt("awbg", 1);
-    agc_gain = prefs.getInt("agcg", 0);
-    aec_value = prefs.getInt("aecv", 300);
-    aec2 = prefs.getInt("aec2", 0);
-    dcw = prefs.getInt("dcw", 1);
-    bpc = prefs.getInt("bpc", 0);
-    wpc = prefs.getInt("wpc", 1);
-    raw_gma = prefs.getInt("rg", 1);
-    lenc = prefs.getInt("lenc", 1);
-    special_effect = prefs.getInt("se", 0);
-    wb_mode = prefs.getInt("wb", 0);
-    ae_level = prefs.getInt("ael", 0);
-    prefs.end();
+  static char buf[PAGE_BUFFER_SIZE];
+  int32_t values[INDEX_VALUES];
+
+  // Current settings, including changes not saved to NVS yet. Page values are named after controls
+  for (int i = 0; i < INDEX_VALUES; i++) {
+    const cameraControl_t* c = cameraControlFind(indexValueNames[i]);
+    values[i] = c ? cameraSettingsGet(c->setting) : 0;
   }
-  
-  String html = String();
-  File f = SPIFFS.open("/index.html", "r");
-  if (!f) { server.send(500, "text/plain", "index.html not found"); return; }
-  html.reserve(f.size());
-  while (f.available()) { html += (char)f.read(); }
-  f.close();
-
-  // Ranges and numeric values
-  html.replace("{{QUALITY}}", String(quality));
-  html.replace("{{BRIGHTNESS}}", String(brightness));
-  html.replace("{{CONTRAST}}", String(contrast));
-  html.replace("{{SATURATION}}", String(saturation));
-  html.replace("{{GAINCEILING}}", String(gainceiling));
-  html.replace("{{COLORBAR}}", String(colorbar)); // still present as data-value
-  html.replace("{{AWB}}", String(awb));
-  html.replace("{{AGC}}", String(agc));
-  html.replace("{{AEC}}", String(aec));
-  html.replace("{{HMIRROR}}", String(hmirror));
-  html.replace("{{VFLIP}}", String(vflip));
-  html.replace("{{AWB_GAIN}}", String(awb_gain));
-  html.replace("{{AGC_GAIN}}", String(agc_gain));
-  html.replace("{{AEC_VALUE}}", String(aec_value));
-  html.replace("{{AEC2}}", String(aec2));
-  html.replace("{{DCW}}", String(dcw));
-  html.replace("{{BPC}}", String(bpc));
-  html.replace("{{WPC}}", String(wpc));
-  html.replace("{{RAW_GMA}}", String(raw_gma));
-  html.replace("{{LENC}}", String(lenc));
-  html.replace("{{SPECIAL_EFFECT}}", String(special_effect));
-  html.replace("{{WB_MODE}}", String(wb_mode));
-  html.replace("{{AE_LEVEL}}", String(ae_level));
-  // TIMESTAMP for cache busting
-  String timestamp = String(millis());
-  html.replace("{{TIMESTAMP}}", timestamp);
-  html.replace("{{JS_VERSION}}", timestamp);
-  
-  // Apply checked for checkboxes before page load
-  insertCheckedAttribute(html, "colorbar", colorbar == 1);
-  insertCheckedAttribute(html, "awb", awb == 1);
-  insertCheckedAttribute(html, "agc", agc == 1);
-  insertCheckedAttribute(html, "aec", aec == 1);
-  insertCheckedAttribute(html, "hmirror", hmirror == 1);
-  insertCheckedAttribute(html, "vflip", vflip == 1);
-  insertCheckedAttribute(html, "awb_gain", awb_gain == 1);
-  insertCheckedAttribute(html, "aec2", aec2 == 1);
-  insertCheckedAttribute(html, "dcw", dcw == 1);
-  insertCheckedAttribute(html, "bpc", bpc == 1);
-  insertCheckedAttribute(html, "wpc", wpc == 1);
-  insertCheckedAttribute(html, "raw_gma", raw_gma == 1);
-  insertCheckedAttribute(html, "lenc", lenc == 1);
-
-  // Apply selected option for selects before page load (works with single quotes)
-  markSelectedOption(html, "gainceiling", gainceiling);
-  markSelectedOption(html, "special_effect", special_effect);
-  markSelectedOption(html, "wb_mode", wb_mode);
 
-  
-  // Prevent caching so the browser doesn't restore old form state
-  server.sendHeader("Cache-Control", "no-store, no-cache, must-revalidate, post-check=0, pre-check=0, max-age=0");
+  // Prevent caching so the browser doesn't restore old form state. The assets it links carry
+  // the asset version and are cached for good instead
+  server.sendHeader("Cache-Control", "no-store, no-cache, must-revalidate, max-age=0");
   server.sendHeader("Pragma", "no-cache");
   server.sendHeader("Expires", "-1");
-  server.sendHeader("Last-Modified", "Thu, 01 Jan 1970 00:00:00 GMT");
-  server.sendHeader("Vary", "*");
-  server.sendHeader("ETag", "\"" + String(millis()) + "\"");
-  server.send(200, "text/html", html);
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "text/html", "");
+
+  pageRender(indexPage, values, httpAssetVersion, buf, sizeof(buf), sendPageChunk, NULL);
+  server.sendContent("", 0);
+}
+
+// ==== Binary trace download (TRACE_LOG), decoded by tools/trace_decode.cpp ==============
+//  Recording stops while the file is sent; /debug/trace?clear=1 starts a new trace
+void handleTrace() {
+  if ( server.hasArg("clear") ) {
+    traceClear();
+    server.send(200, "text/plain", "Trace cleared");
+    return;
+  }
+  server.sendHeader("Content-Disposition", "attachment; filename=\"trace.bin\"");
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "application/octet-stream", "");
+  traceDump(sendPageChunk, NULL);
+  server.sendContent("", 0);
+}
+
+// ==== Static assets: content hash as ETag, gzip when accepted ===========================
+//  Embedded bodies are written straight from flash. An asset linked from the page carries
+//  ?t=<asset version> and never changes under that URL, unless SPIFFS overrides it
+void handleAsset(const httpAsset_t* aAsset) {
+  uint32_t override = httpAssetOverride(aAsset);
+  bool gzip = override == 0 && httpAcceptsGzip(server.header("Accept-Encoding").c_str());
+  char version[12];
+  snprintf(version, sizeof(version), "%08x", (unsigned) httpAssetVersion);
+  bool immutable = override == 0 && server.arg("t") == version;
+
+  char etag[HTTP_ETAG_MAX];
+  httpAssetEtag(etag, sizeof(etag), override ? override : aAsset->hash, gzip);
+  server.sendHeader("ETag", etag);
+  server.sendHeader("Vary", "Accept-Encoding");
+  server.sendHeader("Cache-Control", immutable ? ASSET_CACHE_IMMUTABLE : ASSET_CACHE_REVALIDATE);
+
+  if ( httpEtagMatch(server.header("If-None-Match").c_str(), etag) ) {
+    server.send(304);
+    return;
+  }
+
+  if ( override ) {
+    File f = SPIFFS.open(aAsset->path, "r");
+    if ( f ) {
+      static uint8_t buf[1460];
+      server.setContentLength(f.size());
+      server.send(200, aAsset->mime, "");
+      int n;
+      while ( (n = f.read(buf, sizeof(buf))) > 0 ) {
+        if ( server.client().write(buf, n) != (size_t) n ) break;
+      }
+      f.close();
+      return;
+    }
+  }
+
+  if ( gzip ) server.sendHeader("Content-Encoding", "gzip");
+  server.setContentLength(gzip ? aAsset->gzipSize : aAsset->size);
+  server.send(200, aAsset->mime, "");
+  server.client().write(gzip ? aAsset->gzip : aAsset->data, gzip ? aAsset->gzipSize : aAsset->size);
 }
 
 // ==== Handle invalid URL requests ============================================
@@ -0,0 +1,81 @@
+#include "streaming.h"
+#include "stream_dispatcher.h"
+#include "capture_power.h"
+
+#if defined(CAMERA_MULTICLIENT_TASK) && defined(CAMERA_DISPATCHER_TASK)
+
+// ==== Dispatcher dropped a client: release its connection ==================================
+static void dispatchClose(int aSocket, void* aOwner) {
+  streamConn_t* conn = (streamConn_t*) aOwner;
+
+  conn->client.stop();
+  streamConnClose(conn);
+  noActiveClients--;
+  clientsConnected = noActiveClients;  // Update global counter for web interface
+  capturePowerDisconnect(millis());
+  Log.notice("streamDispatch: Client disconnected, socket %d\n", aSocket);
+}
+
+// ==== Single task streaming to every connected client ======================================
+void startStreamDispatcher(void) {
+  if ( !streamDispatchInit(dispatchClose) ) {
+    Log.error("startStreamDispatcher: cannot allocate client queue - OOM\n");
+    return;
+  }
+
+  int rc = xTaskCreatePinnedToCore(
+             streamDispatchCB,
+             "stream",
+             STREAM_STACK_SIZE,
+             NULL,
+             STREAM_TASK_PRIORITY,
+             &tStream,
+             APP_CPU);
+  if ( rc != pdPASS ) {
+    Log.error("startStreamDispatcher: error creating RTOS task. rc = %d\n", rc);
+  }
+}
+
+// ==== Handle connection request from clients ===============================
+void handleJPGSstream(void)
+{
+  if ( noActiveClients >= MAX_CLIENTS ) return;
+  if ( streamRefuseLowMemory() ) return;
+
+  //  The dispatcher sends from the socket directly, the WiFiClient only keeps the socket open.
+  //  It lives in a record of the client pool, given back when the dispatcher drops the client
+  streamConn_t* conn = streamConnOpen();
+  if ( conn == NULL ) {
+    Log.error("handleJPGSstream: no free client record\n");
+    return;
+  }
+  WiFiClient* client = &conn->client;
+
+  *client = server.client();
+  client->setNoDelay(true);
+
+  //  Stream header goes out right away, the dispatcher only ever sends whole parts
+  client->write(HEADER, hdrLen);
+  client->write(BOUNDARY, bdrLen);
+
+  //  Counted before the hand-off: the dispatcher may drop the client, and count it out,
+  //  before streamDispatchAdd even returns
+  noActiveClients++;
+  clientsConnected = noActiveClients;  // Update global counter for web interface
+
+  // Wake up the camera task if nobody was streaming
+  captureClientConnected();
+
+  if ( !streamDispatchAdd(client->fd(), conn, streamRequestedFps()) ) {
+    Log.warning("handleJPGSstream: dispatcher cannot take a new client\n");
+    noActiveClients--;
+    clientsConnected = noActiveClients;
+    capturePowerDisconnect(millis());
+    client->stop();
+    streamConnClose(conn);
+    return;
+  }
+  Log.notice("handleJPGSstream: Client Connected\n");
+}
+
+#endif
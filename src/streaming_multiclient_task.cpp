@@ -1,63 +1,9 @@
-#include <Arduino.h>
-#include <WebServer.h>
-#include <WiFi.h>
-#include <WiFiClient.h>
-#include "esp_camera.h"
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
-#include "freertos/semphr.h"
-#include "freertos/queue.h"
-
-// Forward declarations
-extern WebServer server;
-extern SemaphoreHandle_t frameSync;
-extern TaskHandle_t tCam;
-extern uint8_t noActiveClients;
-extern volatile uint32_t frameNumber;
-
-// Constants
-#define KILOBYTE    1024
-#define APP_CPU     1
-#define PRO_CPU     0
-
-// Task priorities and stack sizes
-#define CAMERA_TASK_PRIORITY      (tskIDLE_PRIORITY + 6)
-#define STREAM_TASK_PRIORITY      (tskIDLE_PRIORITY + 4)
-#define NETWORK_TASK_PRIORITY     (tskIDLE_PRIORITY + 5)
-#define WEB_TASK_PRIORITY         (tskIDLE_PRIORITY + 2)
-
-#define CAMERA_STACK_SIZE         (6 * KILOBYTE)
-#define STREAM_STACK_SIZE         (5 * KILOBYTE)
-#define NETWORK_STACK_SIZE        (6 * KILOBYTE)
-#define WEB_STACK_SIZE            (4 * KILOBYTE)
-
-// Memory allocation flags
-#define FAIL_IF_OOM true
-#define OK_IF_OOM   false
-#define PSRAM_ONLY  true
-#define ANY_MEMORY  false
-
-// Stream info structure
-typedef struct {
-  uint32_t        frame;
-  WiFiClient      *client;
-  TaskHandle_t    task;
-  char*           buffer;
-  size_t          len;
-} streamInfo_t;
-
-// External variables
-extern const char* HEADER;
-extern const char* BOUNDARY;
-extern const char* CTNTTYPE;
-extern const int hdrLen;
-extern const int bdrLen;
-extern const int cntLen;
-extern volatile uint32_t clientsConnected;
-
-// Function declarations
-char* allocateMemory(char* aPtr, size_t aSize, bool fail = FAIL_IF_OOM, bool psramOnly = ANY_MEMORY);
-void streamCB(void * pvParameters);
+#include "streaming.h"
+#include "frame_ring.h"
+#include "stream_dispatcher.h"
+#include "capture_power.h"
+#include "camera_pins.h"
+#include "esp_timer.h"
 
 // Constants for FPS and MAX_CLIENTS
 #ifndef FPS
@@ -68,10 +14,14 @@ void streamCB(void * pvParameters);
 #define MAX_CLIENTS 10
 #endif
 
+// Longest wait for socket buffer space before a streaming client is dropped
+#ifndef STREAM_WRITE_TIMEOUT_MS
+#define STREAM_WRITE_TIMEOUT_MS 1000
+#endif
+
 #if defined(CAMERA_MULTICLIENT_TASK)
 
 volatile size_t   camSize;    // size of the current frame, byte
-volatile char*    camBuf;      // pointer to the current frame
 volatile float    currentFPS = 0.0;   // current delivery FPS for web interface  
 volatile float    cameraFPS = 1.0;    // actual camera capture FPS (initialized to avoid 0)
 volatile uint32_t currentFrameSize = 0;  // current frame size in KB for web interface
@@ -90,26 +40,73 @@ uint32_t lastCaptureTime = 0;
 uint32_t captureCount = 0;
 uint32_t lastPrintCam = millis();
 
-void camCB(void* pvParameters) {
+// ==== Camera driver stamps frames with esp_timer (time since boot) ======================
+// Move the stamp onto the system clock so X-Timestamp compares with other machines once
+// the clock is set
+static void stampToSystemTime(struct timeval* aStamp) {
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  int64_t age = esp_timer_get_time() - ((int64_t) aStamp->tv_sec * 1000000 + aStamp->tv_usec);
+  int64_t t = (int64_t) now.tv_sec * 1000000 + now.tv_usec - age;
+  aStamp->tv_sec = t / 1000000;
+  aStamp->tv_usec = t % 1000000;
+}
 
-  TickType_t xLastWakeTime;
+// ==== Sensor standby through the PWDN line ==============================================
+// Boards without a PWDN line keep the sensor running and only stop fetching frames
+static void sensorPower(bool aOn) {
+#if PWDN_GPIO_NUM >= 0
+  digitalWrite(PWDN_GPIO_NUM, aOn ? LOW : HIGH);
+#endif
+}
 
-  //  A running interval associated with currently desired frame rate
-  const TickType_t xFrequency = pdMS_TO_TICKS(1000 / FPS);
-  
+// ==== Nobody is streaming: stay warm for a while, then put the sensor into standby =======
+// A connect notifies the camera task, which returns here with the stream state
+static void captureStandby(captureState_t aState) {
+  frameRingClear();
+  if ( aState == CAPTURE_WARM ) {
+    uint32_t warm = millis() - capturePower.since;
+    uint32_t left = warm < CAPTURE_WARM_MS ? CAPTURE_WARM_MS - warm : 0;
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(left) + 1);
+    return;
+  }
+
+  Log.notice("camCB: sensor standby, free heap : %d\n", ESP.getFreeHeap());
+  Log.trace("camCB: min free heap             : %d\n", ESP.getMinFreeHeap());
+  Log.trace("camCB: max alloc free heap       : %d\n", ESP.getMaxAllocHeap());
+  Log.trace("camCB: tCam stack wtrmark        : %d\n", uxTaskGetStackHighWaterMark(tCam));
+  sensorPower(false);
+  while ( capturePower.state == CAPTURE_IDLE ) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  sensorPower(true);
+
+  //  Frames captured right after standby are stale or not yet exposed properly
+  for (int i = 0; i < CAPTURE_WAKE_SKIP; i++) {
+    camera_fb_t* fb = frameSource.get();
+    if ( fb ) frameSource.ret(fb);
+  }
+}
+
+// ==== A streaming client connected: wake the camera task if nobody was streaming ========
+void captureClientConnected(void) {
+  if ( capturePowerConnect(millis()) != CAPTURE_STREAMING ) xTaskNotifyGive(tCam);
+}
+
+void camCB(void* pvParameters) {
   // Set maximum priority for this camera task
   vTaskPrioritySet(NULL, CAMERA_TASK_PRIORITY);
 
-  //  Pointers to the 2 frames, their respective sizes and index of the current frame
-  char* fbs[2] = { NULL, NULL };
-  size_t fSize[2] = { 0, 0 };
-  int ifb = 0;
   frameNumber = 0;
+  capturePowerInit(millis());
 
   //=== loop() section  ===================
-  xLastWakeTime = xTaskGetTickCount();
-
   for (;;) {
+    //  Without clients there is nothing to capture for
+    captureState_t power = capturePowerTick(millis());
+    if ( power != CAPTURE_STREAMING ) {
+      captureStandby(power);
+      continue;
+    }
+
     size_t s = 0;
     //  Grab a frame from the camera and query its size
     camera_fb_t* fb = NULL;
@@ -117,24 +114,54 @@ void camCB(void* pvParameters) {
     // Always measure capture time for FPS calculation
     uint32_t benchmarkStart = micros();
 
-    s = 0;
-    fb = esp_camera_fb_get();
+    int64_t grabStart = esp_timer_get_time();
+    TRACE_BEGIN("capture");
+    fb = frameSource.get();
+    TRACE_END("capture");
     if ( fb ) {
+      histogramAdd(&streamLatency.grab, esp_timer_get_time() - grabStart);
       s = fb->len;
+      int64_t captured = (int64_t) fb->timestamp.tv_sec * 1000000 + fb->timestamp.tv_usec;
+      stampToSystemTime(&fb->timestamp);
+      frameChunck_t* f = NULL;
+
+#if defined(CAMERA_ZERO_COPY)
+      //  Publish the driver's buffer itself while the driver still has buffers left to capture into.
+      //  It is returned by whoever drops the last reference to the slot
+      f = frameRingAttach(fb);
+      if ( f ) fb = NULL;
+#endif
 
-      //  If frame size is more that we have previously allocated - request exact size for minimal memory usage
-      if (s > fSize[ifb]) {
-        fSize[ifb] = s;
-        fbs[ifb] = allocateMemory(fbs[ifb], fSize[ifb], FAIL_IF_OOM, PSRAM_ONLY);  // Force PSRAM for large buffers
+      if ( fb ) {
+        //  Copy current frame into a ring slot no client is reading from.
+        //  Clients hold references on older slots, so publishing never waits for a send
+        f = frameRingReserve(s);
+        if ( f ) {
+          int64_t copyStart = esp_timer_get_time();
+          memcpy(f->dat, fb->buf, s);
+          histogramAdd(&streamLatency.copy, esp_timer_get_time() - copyStart);
+          f->siz = s;
+          f->tsp = fb->timestamp;
+          frameRingStats.copies++;
+          frameRingStats.bytesCopied += s;
+        }
+        frameSource.ret(fb);
       }
 
-      //  Copy current frame into local buffer
-      char* b = (char *)fb->buf;
-      memcpy(fbs[ifb], b, s);
-      esp_camera_fb_return(fb);
+      if ( f ) {
+        f->cus = captured;
+        TRACE_BEGIN("publish");
+        frameRingPublish(f);
+        TRACE_END("publish");
+        capturePowerFrame(millis());
+        camSize = s;
+#if defined(CAMERA_DISPATCHER_TASK)
+        currentFrameSize = s / 1024;
+#endif
+      }
     }
     else {
-      Serial.printf("camCB: error capturing image for frame %d\n", frameNumber);
+      Log.error("camCB: error capturing image for frame %d\n", frameNumber);
       vTaskDelay(1000);
     }
 
@@ -142,40 +169,9 @@ void camCB(void* pvParameters) {
     uint32_t captureTime = micros() - benchmarkStart;
     lastCaptureTime = captureTime;
 
-    //  Only switch frames around if no frame is currently being streamed to a client
-    //  Wait on a semaphore until client operation completes
-    //    xSemaphoreTake( frameSync, portMAX_DELAY );
-
-    //  Do not allow frame copying while switching the current frame
-    // ОПТИМИЗАЦИЯ: Неблокирующий захват для максимального FPS
-    if ( xSemaphoreTake( frameSync, 0 ) ) {  // Не ждать вообще!
-      camBuf = fbs[ifb];
-      camSize = s;
-      ifb++;
-      ifb &= 1;  // this should produce 1, 0, 1, 0, 1 ... sequence
-      frameNumber++;
-      //  Let anyone waiting for a frame know that the frame is ready
-      xSemaphoreGive( frameSync );
-    } else {
-      // Если семафор занят - просто пропускаем кадр, но обновляем номер
-      frameNumber++;
-      // Log.trace("camCB: Skipping frame %d due to busy semaphore\n", frameNumber);
-    }
-
     //  Let other (streaming) tasks run with zero delay for maximum FPS
     taskYIELD();  // Просто передать управление без задержки
 
-    //  If streaming task has suspended itself (no active clients to stream to)
-    //  there is no need to grab frames from the camera. We can save some juice
-    //  by suspedning the tasks
-    if ( noActiveClients == 0 ) {
-      Serial.printf("mjpegCB: free heap           : %d\n", ESP.getFreeHeap());
-      Serial.printf("mjpegCB: min free heap)      : %d\n", ESP.getMinFreeHeap());
-      Serial.printf("mjpegCB: max alloc free heap : %d\n", ESP.getMaxAllocHeap());
-      Serial.printf("mjpegCB: tCam stack wtrmark  : %d\n", uxTaskGetStackHighWaterMark(tCam));
-      vTaskSuspend(NULL);  // passing NULL means "suspend yourself"
-    }
-
     // Always update cameraFPS for web interface (not just in BENCHMARK mode)
     captureCount++;
     if ( millis() - lastPrintCam > 1000 ) {  // Update every second
@@ -184,7 +180,7 @@ void camCB(void* pvParameters) {
       cameraFPS = (float)captureCount / timeInterval;  // frames per second
       
 #if defined(BENCHMARK)
-      Serial.printf("mjpegCB: frame capture: %d us, real camera FPS: %.2f\n", lastCaptureTime, cameraFPS);
+      Log.verbose("mjpegCB: frame capture: %d us, real camera FPS: %.2f\n", lastCaptureTime, cameraFPS);
 #endif
       
       lastPrintCam = currentTime;
@@ -195,25 +191,23 @@ void camCB(void* pvParameters) {
   }
 }
 
+#if !defined(CAMERA_DISPATCHER_TASK)
 
 // ==== Handle connection request from clients ===============================
 void handleJPGSstream(void)
 {
   if ( noActiveClients >= MAX_CLIENTS ) return;
-  Serial.printf("handleJPGSstream start: free heap  : %d\n", ESP.getFreeHeap());
-
-  streamInfo_t* info = new streamInfo_t;
-  if ( info == NULL ) {
-    Serial.printf("handleJPGSstream: cannot allocate stream info - OOM\n");
-    return;
-  }
+  if ( streamRefuseLowMemory() ) return;
+  Log.trace("handleJPGSstream start: free heap  : %d\n", ESP.getFreeHeap());
 
-  WiFiClient* client = new WiFiClient();
-  if ( client == NULL ) {
-    Serial.printf("handleJPGSstream: cannot allocate WiFi client for streaming - OOM\n");
-    free(info);
+  //  Connection record and client come from the client pool, a disconnect gives them back
+  streamConn_t* conn = streamConnOpen();
+  if ( conn == NULL ) {
+    Log.error("handleJPGSstream: no free client record\n");
     return;
   }
+  streamInfo_t* info = &conn->info;
+  WiFiClient* client = &conn->client;
 
   *client = server.client();
   
@@ -226,59 +220,68 @@ void handleJPGSstream(void)
   // Полагаемся на системные настройки TCP буферов из platformio.ini
 
   info->frame = frameNumber - 1;
+  info->fps = streamRequestedFps();
   info->client = client;
-  info->buffer = NULL;
-  info->len = 0;
+
+  //  Counted before the task starts: it may see the client gone, and count it out, right away
+  noActiveClients++;
+  clientsConnected = noActiveClients;  // Update global counter for web interface
+
+  // Wake up the camera task if nobody was streaming
+  captureClientConnected();
 
   //  Creating task to push the stream to all connected clients
   int rc = xTaskCreatePinnedToCore(
              streamCB,
              "streamCB",
              STREAM_STACK_SIZE,  // Optimized stack size
-             (void*) info,
+             (void*) conn,
              STREAM_TASK_PRIORITY,  // Optimized priority for streaming
              &info->task,
              APP_CPU);
   if ( rc != pdPASS ) {
-    Serial.printf("handleJPGSstream: error creating RTOS task. rc = %d\n", rc);
-    Serial.printf("handleJPGSstream: free heap  : %d\n", ESP.getFreeHeap());
+    Log.error("handleJPGSstream: error creating RTOS task. rc = %d\n", rc);
+    Log.error("handleJPGSstream: free heap  : %d\n", ESP.getFreeHeap());
     //    Serial.printf("stk high wm: %d\n", uxTaskGetStackHighWaterMark(tSend));
-    delete info;
+    noActiveClients--;
+    clientsConnected = noActiveClients;
+    capturePowerDisconnect(millis());
+    streamConnClose(conn);
+    return;
   }
-
-  noActiveClients++;
-  clientsConnected = noActiveClients;  // Update global counter for web interface
-
-  // Wake up streaming tasks, if they were previously suspended:
-  if ( eTaskGetState( tCam ) == eSuspended ) vTaskResume( tCam );
 }
 
 
 // ==== Actually stream content to all connected clients ========================
 void streamCB(void * pvParameters) {
-  char buf[16];
-  TickType_t xLastWakeTime;
-  TickType_t xFrequency;
-
-  streamInfo_t* info = (streamInfo_t*) pvParameters;
+  streamConn_t* conn = (streamConn_t*) pvParameters;
+  streamInfo_t* info = conn ? &conn->info : NULL;
 
   if ( info == NULL ) {
-    Serial.printf("streamCB: a NULL pointer passed");
+    Log.fatal("streamCB: a NULL pointer passed\n");
+    Log.flush();
     delay(5000);
     ESP.restart();
   }
 
-  
-  xLastWakeTime = xTaskGetTickCount();
-  xFrequency = pdMS_TO_TICKS(1000 / FPS);
-  Serial.printf("streamCB: Client Connected\n");
+  Log.notice("streamCB: Client Connected\n");
 
   //  Immediately send this client a header
   info->client->write(HEADER, hdrLen);
   info->client->write(BOUNDARY, bdrLen);
 
+  //  Sleep between frames: camCB notifies this task on every publish.
+  //  Without a subscription fall back to checking every tick
+  TickType_t frameWait = pdMS_TO_TICKS(FRAME_WAIT_MS);
+  if ( !frameRingSubscribe(xTaskGetCurrentTaskHandle()) ) {
+    Log.warning("streamCB: frame waiter table full, polling\n");
+    frameWait = 1;
+  }
+  info->id = streamClientOpen(info->client->fd(), info->fps);
+  framePacerInit(&info->pacer, info->fps, esp_timer_get_time());
+
 #if defined(BENCHMARK)
-  uint32_t streamStart = 0;
+  uint32_t streamStart = micros();
   uint32_t waitTime = 0;
   uint32_t streamTime = 0;
   uint32_t frameSize = 0;
@@ -291,113 +294,68 @@ void streamCB(void * pvParameters) {
     //  Only send anything if there is someone watching
     if ( info->client->connected() ) {
 
-      if ( info->frame != frameNumber) { // do not send same frame twice
-
-#if defined (BENCHMARK)
-        streamStart = micros();
-#endif        
-
-        // МАКСИМАЛЬНЫЙ FPS: Блокирующий захват - НЕ пропускаем кадры!
-        xSemaphoreTake( frameSync, portMAX_DELAY );
-        size_t currentSize = camSize;
+      //  Block until a newer frame is published (or time out to re-check the connection),
+      //  then take a reference on it
+      if ( frameRingWait(info->frame, frameWait) == info->frame ) continue;
+
+      //  A client on a reduced rate sleeps until its next frame is due; frames published
+      //  meanwhile are skipped before a single byte is queued for it. Short of memory every
+      //  client is held to a lower rate
+      framePacerCap(&info->pacer, memWatchFpsCap());
+      if ( !framePacerTake(&info->pacer, esp_timer_get_time()) ) {
+        vTaskDelay(pdMS_TO_TICKS(framePacerDelayMs(&info->pacer, esp_timer_get_time())) + 1);
+        continue;
+      }
+      TRACE_BEGIN("lock");
+      frameChunck_t* f = frameRingAcquire(info->frame);
+      TRACE_END("lock");
+      if ( f == NULL ) framePacerRefund(&info->pacer);
+      if ( f ) {
 
 #if defined (BENCHMARK)
         waitTime = micros() - streamStart;
-        frameSize = currentSize;
+        frameSize = f->siz;
         streamStart = micros();
 #endif
 
-
-//  ======================== OPTION1 ==================================
-//  server a copy of the buffer - overhead: have to allocate and copy a buffer for all frames
-
-/*
-        if ( info->buffer == NULL ) {
-          info->buffer = allocateMemory (info->buffer, camSize, FAIL_IF_OOM, ANY_MEMORY);
-          info->len = camSize;
+        //  Send straight from the ring slot - the camera keeps publishing into other slots meanwhile.
+        //  The part header was rendered once on publish; header, frame and boundary leave in one
+        //  vectored write, nothing is assembled or copied here
+        int64_t sendStart = esp_timer_get_time();
+        histogramAdd(&streamLatency.queue, sendStart - f->pus);
+        TRACE_BEGIN("send");
+        bool sentAll = mjpegPartSendAll(info->client->fd(), f->hdr, f->hln, f->dat, f->siz, STREAM_WRITE_TIMEOUT_MS);
+        TRACE_END("send");
+        if ( sentAll ) {
+          int64_t sent = esp_timer_get_time();
+          histogramAdd(&streamLatency.send, sent - sendStart);
+          histogramAdd(&streamLatency.total, sent - f->cus);
+          streamClientSent(info->id, f->fnm, f->hln + f->siz + bdrLen);
         }
         else {
-          if ( camSize > info->len ) {
-            info->buffer = allocateMemory (info->buffer, camSize, FAIL_IF_OOM, ANY_MEMORY);
-            info->len = camSize;
-          }
+          info->client->stop();
         }
-        memcpy(info->buffer, (const void*) camBuf, camSize);
-        
-        xSemaphoreGive( frameSync );
-
-        sprintf(buf, "%d\r\n\r\n", currentSize);
-        info->client->flush();
-        info->client->write(CTNTTYPE, cntLen);
-        info->client->write(buf, strlen(buf));
-        info->client->write((char*) info->buffer, currentSize);
-        info->client->write(BOUNDARY, bdrLen);
-        info->client->flush(); // Force immediate transmission
-*/
-
-//  ======================== OPTION2 ==================================
-//  just server the common buffer protected by mutex - MINIMAL LATENCY
-// /*
-        // МАКСИМАЛЬНАЯ ОПТИМИЗАЦИЯ: Единый буфер для всех данных
-        sprintf(buf, "%d\r\n\r\n", camSize);
-        
-        // Создаем единый буфер для всего кадра
-        size_t totalSize = cntLen + strlen(buf) + camSize + bdrLen;
-        char* singleBuffer = (char*)malloc(totalSize);
-        
-        if (singleBuffer) {
-          // Собираем все данные в один буфер
-          size_t offset = 0;
-          memcpy(singleBuffer + offset, CTNTTYPE, cntLen);
-          offset += cntLen;
-          memcpy(singleBuffer + offset, buf, strlen(buf));
-          offset += strlen(buf);
-          memcpy(singleBuffer + offset, (char*)camBuf, camSize);
-          offset += camSize;
-          
-          xSemaphoreGive( frameSync );  // Освобождаем семафор раньше
-          
-          memcpy(singleBuffer + offset, BOUNDARY, bdrLen);
-          
-          // ОДНА отправка вместо четырех!
-          info->client->write(singleBuffer, totalSize);
-          info->client->flush();
-          
-
-          
-          free(singleBuffer);
-        } else {
-          // Fallback к старому методу если не хватает памяти
-          info->client->write(CTNTTYPE, cntLen);
-          info->client->write(buf, strlen(buf));
-          info->client->write((char*) camBuf, (size_t)camSize);
-          xSemaphoreGive( frameSync );
-          info->client->write(BOUNDARY, bdrLen);
-          info->client->flush();
-        }
-// */
 
-//  ====================================================================
-        info->frame = frameNumber;
+        info->frame = f->fnm;
+        frameRingRelease(f);
 #if defined (BENCHMARK)
-          streamTime = micros() - streamStart;
-#endif        
+        streamTime = micros() - streamStart;
+        streamStart = micros();
+#endif
       }
     }
     else {
       //  client disconnected - clean up.
+      frameRingUnsubscribe(xTaskGetCurrentTaskHandle());
+      streamClientClose(info->id);
       noActiveClients--;
       clientsConnected = noActiveClients;  // Update global counter for web interface
-      Serial.printf("streamCB: Stream Task stack wtrmark  : %d\n", uxTaskGetStackHighWaterMark(info->task));
+      capturePowerDisconnect(millis());
+      Log.trace("streamCB: Stream Task stack wtrmark  : %d\n", uxTaskGetStackHighWaterMark(info->task));
       info->client->stop();
-      if ( info->buffer ) {
-        free( info->buffer );
-        info->buffer = NULL;
-      }
-      delete info->client;
-      delete info;
+      streamConnClose(conn);
       info = NULL;
-      Serial.printf("streamCB: Client disconnected\n");
+      Log.notice("streamCB: Client disconnected\n");
       vTaskDelay(100);
       vTaskDelete(NULL);
     }
@@ -421,7 +379,7 @@ void streamCB(void * pvParameters) {
 
     if ( millis() - lastPrint > BENCHMARK_PRINT_INT ) {
       lastPrint = millis();
-      Serial.printf("streamCB: wait=%d us, stream=%d us, frame size=%d bytes, fps=%.2f\n", waitTime, streamTime, frameSize, currentStreamFPS);
+      Log.verbose("streamCB: wait=%d us, stream=%d us, frame size=%d bytes, fps=%.2f\n", waitTime, streamTime, frameSize, currentStreamFPS);
     }
 #else
     // Simple FPS calculation: count frames delivered to this client
@@ -430,4 +388,6 @@ void streamCB(void * pvParameters) {
   }
 }
 
+#endif  // !CAMERA_DISPATCHER_TASK
+
 #endif
@@ -0,0 +1,232 @@
+//  === Task statistics ==============================================================================
+//  The table keeps the last TASK_STATS_WINDOW + 1 run time counters of every task, indexed by
+//  sample number, and the total run time of the same samples. Counters are unsigned and only
+//  ever subtracted, so their wrap-around (71 minutes of microseconds) does not matter.
+#include "task_stats.h"
+#include "definitions.h"
+#include "logging.h"
+#include "json_writer.h"
+#include "streaming.h"
+
+#define TASK_STATS_SLOTS  (TASK_STATS_WINDOW + 1)
+
+void taskStatsInit(taskStats_t* s) {
+  memset(s, 0, sizeof(*s));
+}
+
+static taskStatsEntry_t* findEntry(taskStats_t* s, const taskSample_t* aSample) {
+  for (int i = 0; i < TASK_STATS_MAX; i++) {
+    taskStatsEntry_t* e = &s->task[i];
+    if ( e->used && e->handle == aSample->handle && strncmp(e->name, aSample->name, TASK_STATS_NAME - 1) == 0 ) return e;
+  }
+  return NULL;
+}
+
+void taskStatsAdd(taskStats_t* s, const taskSample_t* aSamples, size_t aCount, uint32_t aTotalRunTime) {
+  const uint32_t n = s->samples;
+  const uint32_t slot = n % TASK_STATS_SLOTS;
+  bool seen[TASK_STATS_MAX] = { false };
+
+  s->total[slot] = aTotalRunTime;
+  s->untracked = 0;
+
+  //  Tasks already in the table first, so a full table keeps them
+  const taskSample_t* fresh[TASK_STATS_MAX];
+  size_t freshCount = 0;
+  for (size_t i = 0; i < aCount; i++) {
+    taskStatsEntry_t* e = findEntry(s, &aSamples[i]);
+    if ( e == NULL ) {
+      if ( freshCount < TASK_STATS_MAX ) fresh[freshCount++] = &aSamples[i];
+      else s->untracked++;
+      continue;
+    }
+    const taskSample_t* t = &aSamples[i];
+    e->run[slot] = t->runTime;
+    e->stackFree = t->stackFree;
+    e->stackSize = t->stackSize;
+    e->priority = t->priority;
+    e->core = t->core;
+    e->state = t->state;
+    seen[e - s->task] = true;
+  }
+
+  //  Ended tasks make room for new ones
+  for (int i = 0; i < TASK_STATS_MAX; i++) {
+    if ( !seen[i] ) s->task[i].used = false;
+  }
+  for (size_t i = 0; i < freshCount; i++) {
+    taskStatsEntry_t* e = NULL;
+    for (int j = 0; j < TASK_STATS_MAX && e == NULL; j++) {
+      if ( !s->task[j].used ) e = &s->task[j];
+    }
+    if ( e == NULL ) {
+      s->untracked += freshCount - i;
+      break;
+    }
+    const taskSample_t* t = fresh[i];
+    memset(e, 0, sizeof(*e));
+    e->used = true;
+    e->handle = t->handle;
+    strncpy(e->name, t->name, TASK_STATS_NAME - 1);
+    e->first = n;
+    e->run[slot] = t->runTime;
+    e->stackFree = t->stackFree;
+    e->stackSize = t->stackSize;
+    e->priority = t->priority;
+    e->core = t->core;
+    e->state = t->state;
+  }
+  s->samples = n + 1;
+}
+
+float taskStatsCpu(const taskStats_t* s, const taskStatsEntry_t* e) {
+  if ( !e->used || s->samples == 0 ) return -1.0;
+  const uint32_t last = s->samples - 1;
+  uint32_t span = last - e->first;
+  if ( span > TASK_STATS_WINDOW ) span = TASK_STATS_WINDOW;
+  if ( span == 0 ) return -1.0;
+
+  const uint32_t now = last % TASK_STATS_SLOTS;
+  const uint32_t then = (last - span) % TASK_STATS_SLOTS;
+  uint32_t total = s->total[now] - s->total[then];
+  if ( total == 0 ) return -1.0;
+  return 100.0f * (float) (e->run[now] - e->run[then]) / (float) total;
+}
+
+static const char* stateName(uint8_t aState) {
+  static const char* const names[] = { "running", "ready", "blocked", "suspended", "deleted" };
+  return aState < sizeof(names) / sizeof(names[0]) ? names[aState] : "invalid";
+}
+
+size_t taskStatsRender(const taskStats_t* s, char* aBuf, size_t aSize) {
+  jsonWriter_t w;
+  jsonInit(&w, aBuf, aSize);
+  jsonBeginObject(&w);
+  jsonUint(&w, "interval_ms", TASK_STATS_INTERVAL_MS);
+  jsonUint(&w, "window", TASK_STATS_WINDOW);
+  jsonUint(&w, "samples", s->samples);
+  jsonUint(&w, "untracked", s->untracked);
+  jsonBeginArray(&w, "tasks");
+  for (int i = 0; i < TASK_STATS_MAX; i++) {
+    const taskStatsEntry_t* e = &s->task[i];
+    if ( !e->used ) continue;
+    jsonBeginObject(&w);
+    jsonString(&w, "name", e->name);
+    jsonUint(&w, "priority", e->priority);
+    jsonInt(&w, "core", e->core);
+    jsonString(&w, "state", stateName(e->state));
+    float cpu = taskStatsCpu(s, e);
+    if ( cpu >= 0.0 ) jsonFixed(&w, "cpu", cpu, 1);
+    jsonUint(&w, "stack_free", e->stackFree);
+    if ( e->stackSize ) jsonUint(&w, "stack_size", e->stackSize);
+    jsonEndObject(&w);
+  }
+  jsonEndArray(&w);
+  jsonEndObject(&w);
+  return jsonFinish(&w);
+}
+
+// ==== Collector task ======================================================================
+//  The collector builds the next table in its own copy; statsMux only covers copying it out
+static portMUX_TYPE statsMux = portMUX_INITIALIZER_UNLOCKED;
+static taskStats_t  stats;
+static taskStats_t  building;
+
+// Stack sizes of the tasks this firmware creates, to compare the free stack against
+static uint32_t stackSizeOf(const char* aName) {
+  static const struct { const char* name; uint32_t size; } sizes[] = {
+    { "cam", CAMERA_STACK_SIZE }, { "mjpeg", NETWORK_STACK_SIZE }, { "streamCB", STREAM_STACK_SIZE },
+    { "stream", STREAM_STACK_SIZE }, { "log", LOG_STACK_SIZE }, { "tasks", TASK_STATS_STACK_SIZE },
+  };
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+    if ( strcmp(sizes[i].name, aName) == 0 ) return sizes[i].size;
+  }
+  return 0;
+}
+
+#if configUSE_TRACE_FACILITY
+//  Every task. Room for tasks beyond the table: uxTaskGetSystemState() returns nothing if the
+//  array is short
+#define TASK_STATS_SAMPLES  (TASK_STATS_MAX + 8)
+
+static size_t sampleTasks(taskSample_t* aSamples, uint32_t* aTotal) {
+  static TaskStatus_t status[TASK_STATS_SAMPLES];
+  UBaseType_t n = uxTaskGetSystemState(status, TASK_STATS_SAMPLES, aTotal);
+  for (UBaseType_t i = 0; i < n; i++) {
+    taskSample_t* t = &aSamples[i];
+    BaseType_t core = xTaskGetAffinity(status[i].xHandle);
+    t->handle = status[i].xHandle;
+    t->name = status[i].pcTaskName;
+#if configGENERATE_RUN_TIME_STATS
+    t->runTime = status[i].ulRunTimeCounter;
+#else
+    t->runTime = 0;
+#endif
+    t->stackFree = status[i].usStackHighWaterMark;
+    t->stackSize = stackSizeOf(status[i].pcTaskName);
+    t->priority = status[i].uxCurrentPriority;
+    t->core = core == tskNO_AFFINITY ? -1 : core;
+    t->state = status[i].eCurrentState;
+  }
+#if !configGENERATE_RUN_TIME_STATS
+  *aTotal = 0;  // no CPU shares
+#endif
+  return n;
+}
+#else
+//  No uxTaskGetSystemState() without the trace facility: the long-lived tasks of this firmware
+//  by handle, stack and state only
+#define TASK_STATS_SAMPLES  5
+
+static size_t sampleTasks(taskSample_t* aSamples, uint32_t* aTotal) {
+  TaskHandle_t tasks[TASK_STATS_SAMPLES] = { tCam, tMjpeg, tStream, Log.task(), xTaskGetCurrentTaskHandle() };
+  size_t n = 0;
+  for (int i = 0; i < TASK_STATS_SAMPLES; i++) {
+    if ( tasks[i] == NULL ) continue;
+    taskSample_t* t = &aSamples[n++];
+    BaseType_t core = xTaskGetAffinity(tasks[i]);
+    t->handle = tasks[i];
+    t->name = pcTaskGetTaskName(tasks[i]);
+    t->runTime = 0;
+    t->stackFree = uxTaskGetStackHighWaterMark(tasks[i]);
+    t->stackSize = stackSizeOf(t->name);
+    t->priority = uxTaskPriorityGet(tasks[i]);
+    t->core = core == tskNO_AFFINITY ? -1 : core;
+    t->state = eTaskGetState(tasks[i]);
+  }
+  *aTotal = 0;  // no CPU shares
+  return n;
+}
+#endif
+
+static void collectCB(void* pvParameters) {
+  (void) pvParameters;
+  static taskSample_t samples[TASK_STATS_SAMPLES];
+  TickType_t wake = xTaskGetTickCount();
+
+  for (;;) {
+    uint32_t total = 0;
+    size_t n = sampleTasks(samples, &total);
+    if ( n > 0 ) {
+      taskStatsAdd(&building, samples, n, total);
+      portENTER_CRITICAL(&statsMux);
+      memcpy(&stats, &building, sizeof(stats));
+      portEXIT_CRITICAL(&statsMux);
+    }
+    vTaskDelayUntil(&wake, pdMS_TO_TICKS(TASK_STATS_INTERVAL_MS));
+  }
+}
+
+void taskStatsStart() {
+  taskStatsInit(&stats);
+  taskStatsInit(&building);
+  if ( xTaskCreatePinnedToCore(collectCB, "tasks", TASK_STATS_STACK_SIZE, NULL, TASK_STATS_PRIORITY, NULL, tskNO_AFFINITY) != pdPASS ) {
+    Log.error("taskStatsStart: cannot create the collector task\n");
+  }
+}
+
+void taskStatsSnapshot(taskStats_t* aCopy) {
+  portENTER_CRITICAL(&statsMux);
+  memcpy(aCopy, &stats, sizeof(stats));
+  portEXIT_CRITICAL(&statsMux);
+}
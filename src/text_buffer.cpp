@@ -0,0 +1,38 @@
+//  === Fixed-buffer text appender ===================================================================
+
+#include "text_buffer.h"
+
+void textInit(textBuffer_t* t, char* aBuf, size_t aSize) {
+  t->buf = aBuf;
+  t->size = aSize;
+  t->len = 0;
+  t->overflow = aSize == 0;
+  if ( aSize ) aBuf[0] = 0;
+}
+
+size_t textFinish(const textBuffer_t* t) {
+  return t->overflow ? 0 : t->len;
+}
+
+void textPrintf(textBuffer_t* t, const char* aFormat, ...) {
+  if ( t->overflow ) return;
+  va_list args;
+  va_start(args, aFormat);
+  int n = vsnprintf(t->buf + t->len, t->size - t->len, aFormat, args);
+  va_end(args);
+  if ( n < 0 || (size_t) n >= t->size - t->len ) {
+    t->overflow = true;
+    return;
+  }
+  t->len += n;
+}
+
+void textChar(textBuffer_t* t, char c) {
+  if ( t->overflow ) return;
+  if ( t->len + 1 >= t->size ) {
+    t->overflow = true;
+    return;
+  }
+  t->buf[t->len++] = c;
+  t->buf[t->len] = 0;
+}
@@ -0,0 +1,238 @@
+//  === Binary trace ================================================================================
+//  Records are appended to a byte ring under a spinlock: a writer copies a header and the raw
+//  arguments, the format pointer is turned into a small id through a hash table, the calling
+//  task into an index. When a record does not fit, the oldest ones are overwritten. The format
+//  strings are literals, so the table keeps the pointers and the text is only read by the dump.
+#include "trace.h"
+#include "allocator.h"
+#include "esp_timer.h"
+
+#define TRACE_FORMAT_SLOTS  512   // hash slots for the format pointers, twice TRACE_FORMATS
+#define TRACE_OUT_CHUNK     1024  // bytes the dump collects before sending
+
+traceStats_t traceStats = { 0 };
+
+static portMUX_TYPE traceMux = portMUX_INITIALIZER_UNLOCKED;
+static uint8_t*     buffer = NULL;
+static uint32_t     bufferSize = 0;
+static uint32_t     head = 0;       // where the next record goes
+static uint32_t     tail = 0;       // oldest record
+static uint32_t     used = 0;       // bytes from tail to head, padding included
+static bool         paused = false; // a download is reading the buffer
+
+static const char*  formats[TRACE_FORMATS];
+static uint16_t     formatCount = 0;
+static uint16_t     formatSlots[TRACE_FORMAT_SLOTS];   // format index + 1, 0 = empty
+
+static TaskHandle_t taskHandles[TRACE_TASKS];
+static char         taskNames[TRACE_TASKS][TRACE_TASK_NAME];
+static uint8_t      taskCount = 0;
+
+void traceInit() {
+  if ( buffer ) return;
+  bufferSize = TRACE_BUFFER_SIZE;
+  buffer = (uint8_t*) allocateMemory(NULL, bufferSize, OK_IF_OOM, PSRAM_ONLY);
+  if ( buffer == NULL ) {
+    bufferSize = TRACE_BUFFER_SIZE_INTERNAL;
+    buffer = (uint8_t*) allocateMemory(NULL, bufferSize, FAIL_IF_OOM);
+  }
+  if ( buffer == NULL ) bufferSize = 0;
+  Log.notice("traceInit: %u bytes of trace buffer\n", (unsigned) bufferSize);
+}
+
+// ==== Ids: format pointer and task handle to table index, inside the lock =================
+static uint16_t formatId(const char* aFormat) {
+  uint32_t h = (uint32_t) (((uintptr_t) aFormat >> 2) * 2654435761u) % TRACE_FORMAT_SLOTS;
+  for (;;) {
+    uint16_t slot = formatSlots[h];
+    if ( slot == 0 ) break;
+    if ( formats[slot - 1] == aFormat ) return slot - 1;
+    h = (h + 1) % TRACE_FORMAT_SLOTS;
+  }
+  if ( formatCount >= TRACE_FORMATS ) return TRACE_FORMATS;
+  formats[formatCount] = aFormat;
+  formatSlots[h] = ++formatCount;
+  return formatCount - 1;
+}
+
+// A handle can be reused by a task created later, the name tells them apart
+static uint8_t taskId() {
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  const char* name = pcTaskGetName(self);
+  for (uint8_t i = 0; i < taskCount; i++) {
+    if ( taskHandles[i] == self && strncmp(taskNames[i], name, TRACE_TASK_NAME - 1) == 0 ) return i;
+  }
+  if ( taskCount >= TRACE_TASKS ) return TRACE_TASKS;
+  taskHandles[taskCount] = self;
+  strncpy(taskNames[taskCount], name, TRACE_TASK_NAME - 1);
+  taskNames[taskCount][TRACE_TASK_NAME - 1] = 0;
+  return taskCount++;
+}
+
+// ==== Ring ==================================================================================
+// Frees the oldest record, or the padding at the end of the buffer
+static void evict() {
+  uint32_t skip;
+  traceRecord_t r;
+  if ( bufferSize - tail < sizeof(r) ) skip = bufferSize - tail;
+  else {
+    memcpy(&r, buffer + tail, sizeof(r));
+    if ( r.kind == TRACE_KIND_PAD ) skip = bufferSize - tail;
+    else {
+      skip = sizeof(r) + r.size;
+      traceStats.lost++;
+    }
+  }
+  tail = (tail + skip) % bufferSize;
+  used -= skip;
+}
+
+void traceWrite(uint8_t aKind, uint8_t aLevel, const char* aFormat, const uint8_t* aArgs, size_t aSize) {
+  traceRecord_t r;
+  uint32_t n = sizeof(r) + aSize;
+
+  portENTER_CRITICAL(&traceMux);
+  if ( buffer == NULL || paused ) {
+    traceStats.dropped++;
+    portEXIT_CRITICAL(&traceMux);
+    return;
+  }
+  r.kind = aKind;
+  r.size = aSize;
+  r.task = taskId();
+  r.level = aLevel;
+  r.format = formatId(aFormat);
+  r.time = (uint32_t) esp_timer_get_time();
+
+  //  A record does not wrap: pad out the end of the buffer and go on at its start
+  if ( head + n > bufferSize ) {
+    while ( used > 0 && bufferSize - used < bufferSize - head ) evict();
+    if ( bufferSize - head >= sizeof(r) ) {
+      traceRecord_t pad = { TRACE_KIND_PAD, 0, 0, 0, 0, 0 };
+      memcpy(buffer + head, &pad, sizeof(pad));
+    }
+    used += bufferSize - head;
+    head = 0;
+  }
+  while ( used > 0 && bufferSize - used < n ) evict();
+  memcpy(buffer + head, &r, sizeof(r));
+  if ( aSize ) memcpy(buffer + head + sizeof(r), aArgs, aSize);
+  head = (head + n) % bufferSize;
+  used += n;
+  traceStats.records++;
+  portEXIT_CRITICAL(&traceMux);
+}
+
+void traceMessage(uint8_t aLevel, const char* aFormat, const uint8_t* aArgs, size_t aSize) {
+  traceWrite(TRACE_KIND_MESSAGE, aLevel, aFormat, aArgs, aSize);
+}
+
+void traceClear() {
+  portENTER_CRITICAL(&traceMux);
+  head = tail = used = 0;
+  traceStats.lost = 0;
+  traceStats.dropped = 0;
+  portEXIT_CRITICAL(&traceMux);
+}
+
+// ==== Download =============================================================================
+typedef struct {
+  void    (*send)(void* aCtx, const char* aData, size_t aLen);
+  void*   ctx;
+  char    buf[TRACE_OUT_CHUNK];
+  size_t  len;
+  size_t  total;
+} traceOut_t;
+
+static void outFlush(traceOut_t* o) {
+  if ( o->len ) o->send(o->ctx, o->buf, o->len);
+  o->total += o->len;
+  o->len = 0;
+}
+
+static void outWrite(traceOut_t* o, const void* aData, size_t aLen) {
+  const char* p = (const char*) aData;
+  while ( aLen ) {
+    size_t n = sizeof(o->buf) - o->len;
+    if ( n > aLen ) n = aLen;
+    memcpy(o->buf + o->len, p, n);
+    o->len += n;
+    p += n;
+    aLen -= n;
+    if ( o->len == sizeof(o->buf) ) outFlush(o);
+  }
+}
+
+// Calls aRecord for every record from the oldest, padding skipped. Recording must be paused
+static void eachRecord(void (*aRecord)(const uint8_t* aData, size_t aLen, void* aCtx), void* aCtx) {
+  uint32_t pos = tail;
+  uint32_t left = used;
+  while ( left > 0 ) {
+    traceRecord_t r;
+    uint32_t skip;
+    if ( bufferSize - pos < sizeof(r) ) skip = bufferSize - pos;
+    else {
+      memcpy(&r, buffer + pos, sizeof(r));
+      if ( r.kind == TRACE_KIND_PAD ) skip = bufferSize - pos;
+      else {
+        skip = sizeof(r) + r.size;
+        aRecord(buffer + pos, skip, aCtx);
+      }
+    }
+    pos = (pos + skip) % bufferSize;
+    left -= skip;
+  }
+}
+
+static void countRecord(const uint8_t* aData, size_t aLen, void* aCtx) {
+  (void) aData;
+  *(uint32_t*) aCtx += aLen;
+}
+
+static void sendRecord(const uint8_t* aData, size_t aLen, void* aCtx) {
+  outWrite((traceOut_t*) aCtx, aData, aLen);
+}
+
+size_t traceDump(void (*aSend)(void* aCtx, const char* aData, size_t aLen), void* aCtx) {
+  static traceOut_t out;   // the web server task is the only caller
+  out.send = aSend;
+  out.ctx = aCtx;
+  out.len = 0;
+  out.total = 0;
+
+  portENTER_CRITICAL(&traceMux);
+  paused = true;
+  portEXIT_CRITICAL(&traceMux);
+
+  traceFileHeader_t h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, TRACE_MAGIC, sizeof(h.magic));
+  h.version = TRACE_VERSION;
+  h.formats = formatCount;
+  h.tasks = taskCount;
+  h.header = sizeof(traceRecord_t);
+  uint32_t bytes = 0;
+  if ( buffer ) eachRecord(countRecord, &bytes);
+  h.bytes = bytes;
+  h.lost = traceStats.lost;
+  h.dropped = traceStats.dropped;
+  outWrite(&out, &h, sizeof(h));
+
+  for (uint16_t i = 0; i < formatCount; i++) {
+    uint16_t len = strlen(formats[i]);
+    outWrite(&out, &len, sizeof(len));
+    outWrite(&out, formats[i], len);
+  }
+  for (uint8_t i = 0; i < taskCount; i++) {
+    uint8_t len = strlen(taskNames[i]);
+    outWrite(&out, &len, sizeof(len));
+    outWrite(&out, taskNames[i], len);
+  }
+  if ( buffer ) eachRecord(sendRecord, &out);
+  outFlush(&out);
+
+  portENTER_CRITICAL(&traceMux);
+  paused = false;
+  portEXIT_CRITICAL(&traceMux);
+  return out.total;
+}
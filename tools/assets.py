@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+#  === Static asset bundle generator =================================================================
+#  Embeds every file of data/ in the firmware: include/asset_manifest.h holds, per asset and sorted
+#  by path, the URL path, MIME type, FNV-1a content hash and both bodies (as is and gzip). The
+#  sorted table is the route table: one handler looks the request path up in it. The hash is the
+#  same as httpContentHash(); it is the asset's ETag, and a hash over all of them versions the
+#  asset URLs of the page. Prints the bytes a page load saves with --report.
+#  index.html is not embedded here: it is compiled into the firmware by page_template.py.
+#
+#  Usage: assets.py [--report] [data [include/asset_manifest.h]]
+#  Also runs as a PlatformIO pre-script (extra_scripts = pre:tools/assets.py).
+
+import gzip
+import os
+import sys
+
+SKIP = ("index.html",)
+
+MIME = {
+    ".css": "text/css",
+    ".js": "application/javascript",
+    ".html": "text/html",
+    ".json": "application/json",
+    ".svg": "image/svg+xml",
+    ".png": "image/png",
+    ".jpg": "image/jpeg",
+    ".ico": "image/x-icon",
+    ".txt": "text/plain",
+}
+
+
+def fnv1a(data, h=0x811C9DC5):
+    for b in data:
+        h = ((h ^ b) * 0x01000193) & 0xFFFFFFFF
+    return h
+
+
+def collect(src):
+    found = []
+    for root, dirs, files in os.walk(src):
+        for name in files:
+            path = os.path.join(root, name)
+            rel = os.path.relpath(path, src).replace(os.sep, "/")
+            if rel in SKIP or name.startswith(".") or name.endswith(".gz"):
+                continue
+            found.append(("/" + rel, path))
+    # Byte order, as strcmp() sees it: the firmware binary-searches the table
+    return sorted(found, key=lambda f: f[0].encode())
+
+
+def array(name, data):
+    out = ["static const uint8_t %s[] PROGMEM = {" % name]
+    for i in range(0, len(data), 16):
+        out.append("  " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    out.append("};")
+    return out
+
+
+def build(src, manifest, root="."):
+    entries = []
+    body = []
+    for i, (path, file) in enumerate(collect(src)):
+        with open(file, "rb") as f:
+            raw = f.read()
+        # mtime 0 keeps the firmware reproducible
+        packed = gzip.compress(raw, 9, mtime=0)
+        mime = MIME.get(os.path.splitext(path)[1].lower(), "application/octet-stream")
+        body.extend(array("asset%dData" % i, raw))
+        body.extend(array("asset%dGzip" % i, packed))
+        entries.append((path, mime, fnv1a(raw), i, len(raw), i, len(packed)))
+
+    version = 0x811C9DC5
+    for e in entries:
+        version = fnv1a(("%s %08x\n" % (e[0], e[2])).encode(), version)
+
+    out = []
+    out.append("#pragma once")
+    out.append("//  Generated by tools/assets.py from %s/ - do not edit." % os.path.relpath(src, root).replace(os.sep, "/"))
+    out.append("//  Static assets embedded in flash, sorted by path, with their content hashes.")
+    out.append("")
+    out.append('#include "http_assets.h"')
+    out.append("")
+    out.append("// Changes whenever any asset does; asset URLs of the page carry it as ?t=")
+    out.append("#define ASSET_VERSION  0x%08xu" % version)
+    out.append("")
+    out.extend(body)
+    out.append("")
+    out.append("static const httpAsset_t assetManifest[] = {")
+    for e in entries:
+        out.append('  { "%s", "%s", 0x%08xu, asset%dData, %d, asset%dGzip, %d },' % e)
+    out.append("};")
+    out.append("")
+    out.append("#define ASSET_COUNT  (sizeof(assetManifest) / sizeof(assetManifest[0]))")
+    out.append("")
+
+    data = "\n".join(out).encode()
+    changed = True
+    if os.path.exists(manifest):
+        with open(manifest, "rb") as f:
+            changed = f.read() != data
+    if changed:
+        with open(manifest, "wb") as f:
+            f.write(data)
+        print("assets: %s -> %s (%d assets)" % (src, manifest, len(entries)))
+    return entries
+
+
+def report(entries):
+    raw = sum(e[4] for e in entries)
+    packed = sum(e[6] for e in entries)
+    print("%-24s %8s %8s" % ("asset", "bytes", "gzip"))
+    for e in entries:
+        print("%-24s %8d %8d" % (e[0], e[4], e[6]))
+    if raw:
+        print("first page load: %d -> %d bytes of assets (%d saved, %.0f%%); repeat loads: 0 (cached)"
+              % (raw, packed, raw - packed, 100.0 * (raw - packed) / raw))
+
+
+def main(argv, root="."):
+    args = [a for a in argv if not a.startswith("--")]
+    src = args[0] if len(args) > 0 else os.path.join(root, "data")
+    manifest = args[1] if len(args) > 1 else os.path.join(root, "include", "asset_manifest.h")
+    entries = build(src, manifest, root)
+    if "--report" in argv:
+        report(entries)
+
+
+try:
+    Import("env")  # noqa: F821 - defined when PlatformIO runs this as an extra script
+    main([], env.subst("$PROJECT_DIR"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        main(sys.argv[1:])
@@ -0,0 +1,166 @@
+//  === Embedded asset check ==========================================================================
+//  Decodes every asset compiled in from include/asset_manifest.h and compares it with its file
+//  in the data directory:
+//    raw:       the body served to clients without gzip is the file, byte for byte
+//    gzip:      the gzip copy is one complete gzip member (mtime 0, so builds are reproducible)
+//               that inflates to the file, byte for byte
+//    coverage:  every file tools/assets.py embeds has an entry, every entry has a file, paths
+//               are sorted as the lookup expects
+//  Exits 1 on any failure.
+//
+//  Usage: assets-check [data-dir]
+
+#include "Arduino.h"
+#include "asset_manifest.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+static int failures = 0;
+static int checks = 0;
+
+static void fail(const char* aFormat, ...) __attribute__ ((format (printf, 1, 2)));
+
+static void fail(const char* aFormat, ...) {
+  va_list args;
+  va_start(args, aFormat);
+  printf("FAIL: ");
+  vprintf(aFormat, args);
+  printf("\n");
+  va_end(args);
+  failures++;
+}
+
+static bool readFile(const std::string& aPath, std::vector<uint8_t>* aData) {
+  FILE* f = fopen(aPath.c_str(), "rb");
+  if ( f == NULL ) return false;
+  uint8_t buf[4096];
+  size_t n;
+  aData->clear();
+  while ( (n = fread(buf, 1, sizeof(buf), f)) > 0 ) aData->insert(aData->end(), buf, buf + n);
+  fclose(f);
+  return true;
+}
+
+// Inflates one gzip member; false if it is not a complete one or has bytes after it
+static bool gunzip(const uint8_t* aData, size_t aSize, std::vector<uint8_t>* aOut) {
+  z_stream z;
+  memset(&z, 0, sizeof(z));
+  if ( inflateInit2(&z, 16 + MAX_WBITS) != Z_OK ) return false;
+  z.next_in = (Bytef*) aData;
+  z.avail_in = aSize;
+  aOut->clear();
+  int rc;
+  do {
+    uint8_t buf[4096];
+    z.next_out = buf;
+    z.avail_out = sizeof(buf);
+    rc = inflate(&z, Z_NO_FLUSH);
+    aOut->insert(aOut->end(), buf, buf + sizeof(buf) - z.avail_out);
+  } while ( rc == Z_OK );
+  bool whole = rc == Z_STREAM_END && z.avail_in == 0;
+  inflateEnd(&z);
+  return whole;
+}
+
+// First differing byte of aGot against aFile, -1 if they are the same
+static long differs(const uint8_t* aGot, size_t aSize, const std::vector<uint8_t>& aFile) {
+  size_t n = aSize < aFile.size() ? aSize : aFile.size();
+  for (size_t i = 0; i < n; i++) {
+    if ( aGot[i] != aFile[i] ) return i;
+  }
+  return aSize == aFile.size() ? -1 : (long) n;
+}
+
+// ==== Every manifest entry against its file ==================================================
+static void checkAssets(const char* aDir) {
+  size_t raw = 0, packed = 0;
+  for (size_t i = 0; i < ASSET_COUNT; i++) {
+    const httpAsset_t* a = &assetManifest[i];
+    std::vector<uint8_t> file, inflated;
+    checks++;
+    if ( !readFile(std::string(aDir) + a->path, &file) ) {
+      fail("raw: %s has no file in %s", a->path, aDir);
+      continue;
+    }
+    long at = differs(a->data, a->size, file);
+    checks++;
+    if ( at >= 0 ) fail("raw: %s differs from the file at byte %ld (%u embedded, %u in the file)", a->path, at,
+                        (unsigned) a->size, (unsigned) file.size());
+
+    checks++;
+    if ( a->gzipSize < 10 || a->gzip[0] != 0x1f || a->gzip[1] != 0x8b || a->gzip[2] != 8 ) {
+      fail("gzip: %s is not gzip (deflate)", a->path);
+      continue;
+    }
+    checks++;
+    if ( a->gzip[4] | a->gzip[5] | a->gzip[6] | a->gzip[7] ) fail("gzip: %s has a modification time", a->path);
+    checks++;
+    if ( !gunzip(a->gzip, a->gzipSize, &inflated) ) {
+      fail("gzip: %s does not inflate as one complete member", a->path);
+      continue;
+    }
+    at = differs(inflated.data(), inflated.size(), file);
+    checks++;
+    if ( at >= 0 ) fail("gzip: %s inflates to something else at byte %ld (%u inflated, %u in the file)", a->path, at,
+                        (unsigned) inflated.size(), (unsigned) file.size());
+    printf("%-24s %6u bytes, gzip %6u, both match %s%s\n", a->path, (unsigned) a->size, (unsigned) a->gzipSize, aDir, a->path);
+    raw += a->size;
+    packed += a->gzipSize;
+  }
+  printf("assets: %u, %u bytes, %u gzip\n", (unsigned) ASSET_COUNT, (unsigned) raw, (unsigned) packed);
+}
+
+// ==== Files tools/assets.py embeds: all but index.html, dot files and .gz ====================
+static void listFiles(const std::string& aDir, const std::string& aRel, std::vector<std::string>* aFiles) {
+  DIR* d = opendir(aDir.c_str());
+  if ( d == NULL ) return;
+  struct dirent* e;
+  while ( (e = readdir(d)) != NULL ) {
+    std::string name = e->d_name;
+    if ( name[0] == '.' ) continue;
+    std::string path = aDir + "/" + name;
+    std::string rel = aRel + "/" + name;
+    struct stat st;
+    if ( stat(path.c_str(), &st) ) continue;
+    if ( S_ISDIR(st.st_mode) ) listFiles(path, rel, aFiles);
+    else if ( rel != "/index.html" && (name.size() < 3 || name.compare(name.size() - 3, 3, ".gz")) ) aFiles->push_back(rel);
+  }
+  closedir(d);
+}
+
+static void checkCoverage(const char* aDir) {
+  std::vector<std::string> files;
+  listFiles(aDir, "", &files);
+  checks++;
+  if ( files.empty() ) fail("coverage: no files in %s", aDir);
+  for (size_t f = 0; f < files.size(); f++) {
+    bool found = false;
+    for (size_t i = 0; i < ASSET_COUNT; i++) found |= files[f] == assetManifest[i].path;
+    checks++;
+    if ( !found ) fail("coverage: %s%s is not embedded (run make assets)", aDir, files[f].c_str());
+  }
+  checks++;
+  if ( files.size() != ASSET_COUNT ) fail("coverage: %u files, %u embedded", (unsigned) files.size(), (unsigned) ASSET_COUNT);
+  for (size_t i = 1; i < ASSET_COUNT; i++) {
+    checks++;
+    if ( strcmp(assetManifest[i - 1].path, assetManifest[i].path) >= 0 ) fail("coverage: %s not sorted before %s",
+                                                                            assetManifest[i - 1].path, assetManifest[i].path);
+  }
+}
+
+int main(int argc, char** argv) {
+  if ( argc > 2 || (argc == 2 && argv[1][0] == '-') ) {
+    fprintf(stderr, "usage: %s [data-dir]\n", argv[0]);
+    return 1;
+  }
+  const char* dir = argc == 2 ? argv[1] : "data";
+  checkAssets(dir);
+  checkCoverage(dir);
+
+  printf("%s: %d checks, %d failures\n", failures ? "FAIL" : "ok", checks, failures);
+  return failures ? 1 : 0;
+}
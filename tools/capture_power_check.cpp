@@ -0,0 +1,162 @@
+//  === Capture power check ===========================================================================
+//  Drives the capture power state machine with connect, disconnect, tick and frame sequences on a
+//  simulated millis() clock and checks
+//    boot:       warm at start, idle (standby) once CAPTURE_WARM_MS pass without a client
+//    cycle:      idle -> streaming on connect (the caller has to wake the camera), warm when the
+//                last client leaves, idle after the warm hold, with sleeps/wakes counted
+//    reconnect:  a connect during the warm hold finds it warm, streams without a wake, and the next
+//                warm hold runs from the last disconnect
+//    clients:    streaming holds until the last of several clients leaves; a stray disconnect
+//                does not underflow the count
+//    ttff:       time to first frame from standby and from warm, measured from the first connect
+//    wrap:       the warm hold works across the millis() wrap
+//  Exits 1 on any failure.
+//
+//  Usage: capture-power-check
+
+#include "Arduino.h"
+#include "capture_power.h"
+
+static int failures = 0;
+static int checks = 0;
+
+static void fail(const char* aFormat, ...) __attribute__ ((format (printf, 1, 2)));
+
+static void fail(const char* aFormat, ...) {
+  va_list args;
+  va_start(args, aFormat);
+  printf("FAIL: ");
+  vprintf(aFormat, args);
+  printf("\n");
+  va_end(args);
+  failures++;
+}
+
+static void expectState(const char* aCheck, captureState_t aGot, captureState_t aState) {
+  checks++;
+  if ( aGot != aState ) fail("%s: %s, expected %s", aCheck, capturePowerName(aGot), capturePowerName(aState));
+}
+
+static void expectCount(const char* aCheck, uint32_t aGot, uint32_t aCount) {
+  checks++;
+  if ( aGot != aCount ) fail("%s: %u, expected %u", aCheck, (unsigned) aGot, (unsigned) aCount);
+}
+
+static void reset(uint32_t aNow) {
+  memset(&capturePower, 0, sizeof(capturePower));
+  capturePowerInit(aNow);
+}
+
+static void checkBoot() {
+  reset(1000);
+  expectState("boot", capturePower.state, CAPTURE_WARM);
+  expectState("boot, hold not over", capturePowerTick(1000 + CAPTURE_WARM_MS - 1), CAPTURE_WARM);
+  expectState("boot, hold over", capturePowerTick(1000 + CAPTURE_WARM_MS), CAPTURE_IDLE);
+  expectCount("boot, sleeps", capturePower.sleeps, 1);
+  expectState("boot, stays idle", capturePowerTick(1000 + 10 * CAPTURE_WARM_MS), CAPTURE_IDLE);
+  expectCount("boot, sleeps once", capturePower.sleeps, 1);
+}
+
+static void checkCycle() {
+  uint32_t t = 1000;
+  reset(t);
+  t += CAPTURE_WARM_MS;
+  capturePowerTick(t);
+
+  t += 5000;
+  expectState("cycle, connect finds", capturePowerConnect(t), CAPTURE_IDLE);
+  expectState("cycle, connected", capturePowerTick(t), CAPTURE_STREAMING);
+  expectCount("cycle, wakes", capturePower.wakes, 1);
+  capturePowerFrame(t + 450);
+  expectCount("cycle, cold ttff", capturePower.ttffCold, 450);
+
+  t += 60000;
+  expectState("cycle, streaming goes on", capturePowerTick(t), CAPTURE_STREAMING);
+  capturePowerDisconnect(t);
+  expectState("cycle, last client left", capturePowerTick(t), CAPTURE_WARM);
+  expectState("cycle, warm hold", capturePowerTick(t + CAPTURE_WARM_MS - 1), CAPTURE_WARM);
+  expectState("cycle, after the warm hold", capturePowerTick(t + CAPTURE_WARM_MS), CAPTURE_IDLE);
+  expectCount("cycle, sleeps", capturePower.sleeps, 2);
+  expectCount("cycle, wakes", capturePower.wakes, 1);
+}
+
+static void checkReconnect() {
+  uint32_t t = 1000;
+  reset(t);
+  capturePowerConnect(t);
+  capturePowerFrame(t + 20);
+  t += 10000;
+  capturePowerDisconnect(t);
+
+  //  Back halfway through the warm hold
+  t += CAPTURE_WARM_MS / 2;
+  expectState("reconnect, connect finds", capturePowerConnect(t), CAPTURE_WARM);
+  expectState("reconnect, connected", capturePowerTick(t), CAPTURE_STREAMING);
+  capturePowerFrame(t + 35);
+  expectCount("reconnect, warm ttff", capturePower.ttffWarm, 35);
+  expectCount("reconnect, no wake", capturePower.wakes, 0);
+  expectCount("reconnect, no sleep", capturePower.sleeps, 0);
+
+  //  The next hold counts from this disconnect, not from the first one
+  t += 5000;
+  capturePowerDisconnect(t);
+  expectState("reconnect, hold restarted", capturePowerTick(t + CAPTURE_WARM_MS - 1), CAPTURE_WARM);
+  expectState("reconnect, hold over", capturePowerTick(t + CAPTURE_WARM_MS), CAPTURE_IDLE);
+}
+
+static void checkClients() {
+  uint32_t t = 1000;
+  reset(t);
+  capturePowerConnect(t);
+  expectState("clients, second connect finds", capturePowerConnect(t + 100), CAPTURE_STREAMING);
+  expectState("clients, third connect finds", capturePowerConnect(t + 200), CAPTURE_STREAMING);
+  capturePowerDisconnect(t + 300);
+  capturePowerDisconnect(t + 400);
+  expectState("clients, one left", capturePowerTick(t + 500 + CAPTURE_WARM_MS), CAPTURE_STREAMING);
+  capturePowerDisconnect(t + 600);
+  expectState("clients, none left", capturePowerTick(t + 700), CAPTURE_WARM);
+  capturePowerDisconnect(t + 800);
+  expectCount("clients, stray disconnect", capturePower.clients, 0);
+  expectState("clients, connect after a stray disconnect", capturePowerConnect(t + 900), CAPTURE_WARM);
+  expectCount("clients, counted", capturePower.clients, 1);
+}
+
+static void checkTtff() {
+  uint32_t t = 1000;
+  reset(t);
+  capturePowerTick(t + CAPTURE_WARM_MS);
+
+  //  Two clients before the first frame: measured from the first connect, and once
+  t += CAPTURE_WARM_MS + 1000;
+  capturePowerConnect(t);
+  capturePowerConnect(t + 300);
+  capturePowerFrame(t + 500);
+  capturePowerFrame(t + 900);
+  expectCount("ttff, from the first connect", capturePower.ttffCold, 500);
+  expectCount("ttff, cold max", capturePower.ttffColdMax, 500);
+  expectCount("ttff, warm untouched", capturePower.ttffWarm, 0);
+}
+
+static void checkWrap() {
+  uint32_t t = 0xFFFFFFFFu - CAPTURE_WARM_MS / 2;
+  reset(t);
+  expectState("wrap, hold not over", capturePowerTick(t + CAPTURE_WARM_MS - 1), CAPTURE_WARM);
+  expectState("wrap, hold over", capturePowerTick(t + CAPTURE_WARM_MS), CAPTURE_IDLE);
+}
+
+int main(int argc, char** argv) {
+  (void) argv;
+  if ( argc > 1 ) {
+    fprintf(stderr, "usage: capture-power-check\n");
+    return 1;
+  }
+  checkBoot();
+  checkCycle();
+  checkReconnect();
+  checkClients();
+  checkTtff();
+  checkWrap();
+
+  printf("%s: %d checks, %d failures\n", failures ? "FAIL" : "ok", checks, failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,164 @@
+//  === Camera control registry check ================================================================
+//  Runs every control of the descriptor table against the host camera and NVS:
+//    lookup:     every name finds its own descriptor, near misses and NVS keys find none
+//    round trip: min, max and default go through the setter, read back from the sensor status,
+//                are saved in the settings blob and read back from it after a reload
+//    bounds:     one past either end of the range is rejected
+//    page:       every value of the control page has a control, and every control is on the page
+//  and times name lookup against the String comparison chain handleControl used to be.
+//  Exits 1 on any failure.
+//
+//  Usage: controls-check [--lookups N]
+
+#include "Arduino.h"
+#include "esp_camera.h"
+#include "camera_controls.h"
+#include "camera_settings.h"
+#include "index_page.h"
+
+#include <chrono>
+
+extern const char* hostNvsDir;
+
+static int failures = 0;
+
+static void fail(const char* aFormat, ...) __attribute__ ((format (printf, 1, 2)));
+
+static void fail(const char* aFormat, ...) {
+  va_list args;
+  va_start(args, aFormat);
+  printf("FAIL: ");
+  vprintf(aFormat, args);
+  printf("\n");
+  va_end(args);
+  failures++;
+}
+
+// A name that is not in the table finds nothing; one that happens to be another control finds that one
+static void checkMiss(const char* aName) {
+  const cameraControl_t* c = cameraControlFind(aName);
+  if ( c && strcmp(c->name, aName) ) fail("'%s' finds %s", aName, c->name);
+}
+
+static void checkLookup() {
+  for (int i = 0; i < CAMERA_SETTINGS; i++) {
+    const cameraControl_t* c = &cameraControls[i];
+    if ( cameraControlFind(c->name) != c ) fail("%s does not find its descriptor", c->name);
+    if ( c->setting != i ) fail("%s has setting %d at index %d", c->name, c->setting, i);
+    if ( c->def < c->min || c->def > c->max ) fail("%s default %d outside %d..%d", c->name, c->def, c->min, c->max);
+    if ( c->kind == CONTROL_TOGGLE && (c->min != 0 || c->max != 1) ) fail("%s toggle is not 0..1", c->name);
+
+    //  Near misses: shorter, longer, padded, prefixed, and the NVS key
+    String name = c->name;
+    String misses[] = { name.substring(0, name.length() - 1), name + "x", name + " ", String("_") + name };
+    for (size_t m = 0; m < sizeof(misses) / sizeof(misses[0]); m++) checkMiss(misses[m].c_str());
+    checkMiss(c->key);
+  }
+  const char* unknown[] = { "", "QUALITY", "framesize", "sharpness", "denoise", "var", "val" };
+  for (size_t i = 0; i < sizeof(unknown) / sizeof(unknown[0]); i++) {
+    if ( cameraControlFind(unknown[i]) ) fail("'%s' finds a control", unknown[i]);
+  }
+}
+
+static void checkRoundTrip(sensor_t* s) {
+  int32_t expected[CAMERA_SETTINGS];
+  int checked = 0;
+  cameraSettingsClear();
+  cameraSettingsLoad();
+
+  for (int pass = 0; pass < 3; pass++) {
+    for (int i = 0; i < CAMERA_SETTINGS; i++) {
+      const cameraControl_t* c = &cameraControls[i];
+      int32_t v = pass == 0 ? c->min : pass == 1 ? c->max : c->def;
+      if ( !cameraControlValid(c, v) ) fail("%s rejects %d", c->name, (int) v);
+      if ( c->set(s, v) != 0 ) fail("%s setter failed for %d", c->name, (int) v);
+      if ( c->get(s) != v ) fail("%s set to %d, sensor reports %d", c->name, (int) v, c->get(s));
+      cameraSettingsSet(c->setting, v, 0);
+      expected[i] = v;
+    }
+    cameraSettingsFlush();
+    cameraSettingsLoad();
+    for (int i = 0; i < CAMERA_SETTINGS; i++) {
+      const cameraControl_t* c = &cameraControls[i];
+      int32_t v;
+      if ( !cameraSettingsStored(c->setting, &v) || v != expected[i] ) {
+        fail("%s saved as %d, reloaded as %d", c->name, (int) expected[i], (int) cameraSettingsGet(c->setting));
+      }
+      checked++;
+    }
+  }
+
+  for (int i = 0; i < CAMERA_SETTINGS; i++) {
+    const cameraControl_t* c = &cameraControls[i];
+    if ( cameraControlValid(c, c->min - 1) || cameraControlValid(c, c->max + 1) ) {
+      fail("%s accepts values outside %d..%d", c->name, c->min, c->max);
+    }
+  }
+  printf("round trip: %d controls, %d values through sensor and NVS\n", CAMERA_SETTINGS, checked);
+}
+
+static void checkPage() {
+  bool onPage[CAMERA_SETTINGS] = { false };
+  for (int i = 0; i < INDEX_VALUES; i++) {
+    const cameraControl_t* c = cameraControlFind(indexValueNames[i]);
+    if ( c == NULL ) fail("page value %s has no control", indexValueNames[i]);
+    else onPage[c->setting] = true;
+  }
+  for (int i = 0; i < CAMERA_SETTINGS; i++) {
+    if ( !onPage[i] ) fail("%s is not on the control page", cameraControls[i].name);
+  }
+}
+
+// ==== The dispatch before the table: String compares in handleControl's order ============
+static int chainLookup(const String& aVar) {
+  static const char* const chain[] = {
+    "quality", "contrast", "brightness", "saturation", "gainceiling", "colorbar", "awb", "agc", "aec",
+    "hmirror", "vflip", "awb_gain", "agc_gain", "aec_value", "aec2", "dcw", "bpc", "wpc", "raw_gma",
+    "lenc", "special_effect", "wb_mode", "ae_level" };
+  for (size_t i = 0; i < sizeof(chain) / sizeof(chain[0]); i++) {
+    if ( aVar == chain[i] ) return i;
+  }
+  return -1;
+}
+
+static void timeLookup(long aLookups) {
+  String names[CAMERA_SETTINGS];
+  for (int i = 0; i < CAMERA_SETTINGS; i++) names[i] = cameraControls[i].name;
+  volatile long sink = 0;
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (long n = 0; n < aLookups; n++) sink += chainLookup(names[n % CAMERA_SETTINGS]);
+  auto t1 = std::chrono::steady_clock::now();
+  for (long n = 0; n < aLookups; n++) sink += cameraControlFind(names[n % CAMERA_SETTINGS].c_str())->setting;
+  auto t2 = std::chrono::steady_clock::now();
+
+  printf("lookup: if/else chain %.1f ns, perfect hash %.1f ns per name\n",
+         std::chrono::duration<double, std::nano>(t1 - t0).count() / aLookups,
+         std::chrono::duration<double, std::nano>(t2 - t1).count() / aLookups);
+}
+
+int main(int argc, char** argv) {
+  static char dir[] = "/tmp/controls-check-XXXXXX";
+  hostNvsDir = mkdtemp(dir);
+  long lookups = 2000000;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if ( !strcmp(argv[i], "--lookups") ) lookups = atol(argv[i + 1]);
+    else {
+      fprintf(stderr, "usage: %s [--lookups N]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  camera_config_t config;
+  memset(&config, 0, sizeof(config));
+  esp_camera_init(&config);
+
+  checkLookup();
+  checkRoundTrip(esp_camera_sensor_get());
+  checkPage();
+  if ( lookups > 0 ) timeLookup(lookups);
+
+  printf("%s: %d failures\n", failures ? "FAIL" : "ok", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,417 @@
+//  === Streaming dispatcher load generator ===========================================================
+//  Runs the frame ring and the streaming dispatcher on Linux over POSIX sockets, fed by the host
+//  fake camera, opens a number of loopback clients that parse the multipart stream, and reports
+//  how much CPU the streaming side spends per delivered frame.
+//
+//  Usage: dispatch-load [--mode dispatcher|tasks|poll] [--clients N] [--slow N] [--seconds S]
+//                       [--fps F] [--jpeg-dir DIR]
+//    --mode    dispatcher: one task for all clients (CAMERA_DISPATCHER_TASK)
+//              tasks:      a task per client blocking in frameRingWait (streamCB)
+//              poll:       a task per client spinning on frameRingAcquire (streamCB before frame-ready notifications)
+//    --slow N  makes N of the clients read at ~1 MB/s so sends stop on full socket buffers
+
+#include "Arduino.h"
+#include "esp_camera.h"
+#include "stream_dispatcher.h"
+#include "stream_clients.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef struct {
+  std::atomic<uint32_t> frames;
+  std::atomic<uint32_t> bytes;
+  std::atomic<uint32_t> errors;
+  bool                  slow;
+} loadClient_t;
+
+enum loadMode_t { MODE_DISPATCHER, MODE_TASKS, MODE_POLL };
+
+static volatile bool    running = true;
+static loadMode_t       mode = MODE_DISPATCHER;
+static pthread_t        dispatcherThread;
+static pthread_t        cameraThread;
+
+//  Task-per-client modes
+static std::mutex             sendersMtx;
+static std::vector<pthread_t> senders;
+static std::atomic<uint32_t>  senderFrames(0);
+static std::atomic<uint32_t>  senderSpins(0);
+
+static double threadCpu(pthread_t aThread) {
+  clockid_t cid;
+  struct timespec ts;
+  if ( pthread_getcpuclockid(aThread, &cid) != 0 || clock_gettime(cid, &ts) != 0 ) return 0;
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double processCpu() {
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+  return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+}
+
+// ==== Camera task: same capture/publish path as camCB ====================================
+static void cameraCB(void* pvParameters) {
+  (void) pvParameters;
+  cameraThread = pthread_self();
+  while ( running ) {
+    camera_fb_t* fb = frameSource.get();
+    if ( fb == NULL ) continue;
+
+    frameChunck_t* f = frameRingAttach(fb);
+    if ( f ) fb = NULL;
+    else {
+      f = frameRingReserve(fb->len);
+      if ( f ) {
+        memcpy(f->dat, fb->buf, fb->len);
+        f->siz = fb->len;
+        f->tsp = fb->timestamp;
+      }
+      frameSource.ret(fb);
+    }
+    if ( f ) {
+      f->cus = (int64_t) f->tsp.tv_sec * 1000000 + f->tsp.tv_usec;
+      frameRingPublish(f);
+    }
+  }
+  vTaskDelete(NULL);
+}
+
+// ==== Streaming side counters for the selected mode =======================================
+static uint32_t deliveredFrames() {
+  return mode == MODE_DISPATCHER ? streamDispatchStats.frames : (uint32_t) senderFrames;
+}
+
+// Times a streaming task woke up: dispatcher loop iterations, frameRingWait returns or poll spins
+static uint32_t streamWakeups() {
+  if ( mode == MODE_DISPATCHER ) return streamDispatchStats.wakeups;
+  return mode == MODE_TASKS ? frameRingStats.wakeups : (uint32_t) senderSpins;
+}
+
+static double streamCpu() {
+  if ( mode == MODE_DISPATCHER ) return threadCpu(dispatcherThread);
+  std::lock_guard<std::mutex> lk(sendersMtx);
+  double t = 0;
+  for (size_t i = 0; i < senders.size(); i++) t += threadCpu(senders[i]);
+  return t;
+}
+
+static void dispatcherCB(void* pvParameters) {
+  dispatcherThread = pthread_self();
+  streamDispatchCB(pvParameters);
+}
+
+static bool sendAll(int aSock, const void* aData, size_t aSize) {
+  const char* p = (const char*) aData;
+  while ( aSize ) {
+    ssize_t r = send(aSock, p, aSize, MSG_NOSIGNAL);
+    if ( r <= 0 ) return false;
+    p += r;
+    aSize -= r;
+  }
+  return true;
+}
+
+// ==== Task per client: the streamCB loop over a blocking socket ==========================
+static void senderCB(void* pvParameters) {
+  int sock = (int) (intptr_t) pvParameters;
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  uint32_t last = frameNumber - 1;
+
+  {
+    std::lock_guard<std::mutex> lk(sendersMtx);
+    senders.push_back(pthread_self());
+  }
+  TickType_t frameWait = pdMS_TO_TICKS(FRAME_WAIT_MS);
+  if ( mode == MODE_TASKS && !frameRingSubscribe(self) ) frameWait = 1;
+  int8_t id = streamClientOpen(sock);
+
+  while ( running ) {
+    if ( mode == MODE_TASKS ) frameRingWait(last, frameWait);
+    else senderSpins++;
+
+    frameChunck_t* f = frameRingAcquire(last);
+    if ( f == NULL ) continue;
+    bool ok = mjpegPartSendAll(sock, f->hdr, f->hln, f->dat, f->siz, 1000);
+    uint32_t bytes = f->hln + f->siz + bdrLen;
+    last = f->fnm;
+    frameRingRelease(f);
+    if ( !ok ) break;
+    streamClientSent(id, last, bytes);
+    senderFrames++;
+  }
+
+  streamClientClose(id);
+  if ( mode == MODE_TASKS ) frameRingUnsubscribe(self);
+  close(sock);
+  vTaskDelete(NULL);
+}
+
+// ==== Server side: accept, send the response header, hand the socket over ================
+static void acceptLoop(int aListen) {
+  for (;;) {
+    int s = accept(aListen, NULL, NULL);
+    if ( s < 0 ) return;
+    //  Same send buffer as the device (CONFIG_LWIP_TCP_SND_BUF_DEFAULT) so slow clients stall sends
+    int one = 1;
+    int sndBuf = 65535;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    setsockopt(s, SOL_SOCKET, SO_SNDBUF, &sndBuf, sizeof(sndBuf));
+    if ( !sendAll(s, HEADER, hdrLen) || !sendAll(s, BOUNDARY, bdrLen) ) {
+      close(s);
+      continue;
+    }
+    if ( mode == MODE_DISPATCHER ) {
+      if ( !streamDispatchAdd(s, NULL) ) close(s);
+    }
+    else {
+      xTaskCreate(senderCB, "streamCB", 4096, (void*) (intptr_t) s, 4, NULL);
+    }
+  }
+}
+
+// ==== Client side: parse parts, check every frame is a complete JPEG =====================
+class streamReader {
+public:
+  streamReader(int aSock, bool aSlow) : sock(aSock), slow(aSlow), pos(0), len(0) {}
+
+  bool fill() {
+    if ( pos < len ) return true;
+    if ( slow ) usleep(4000);
+    int r = recv(sock, buf, slow ? 4096 : sizeof(buf), 0);
+    if ( r <= 0 ) return false;
+    pos = 0;
+    len = r;
+    total += r;
+    return true;
+  }
+
+  bool line(std::string& aLine) {
+    aLine.clear();
+    for (;;) {
+      if ( !fill() ) return false;
+      char c = buf[pos++];
+      if ( c == '\n' ) {
+        if ( !aLine.empty() && aLine[aLine.size() - 1] == '\r' ) aLine.resize(aLine.size() - 1);
+        return true;
+      }
+      aLine += c;
+    }
+  }
+
+  bool take(std::string& aData, size_t aSize) {
+    aData.clear();
+    while ( aData.size() < aSize ) {
+      if ( !fill() ) return false;
+      size_t n = std::min(aSize - aData.size(), len - pos);
+      aData.append(buf + pos, n);
+      pos += n;
+    }
+    return true;
+  }
+
+  uint64_t total = 0;
+
+private:
+  int     sock;
+  bool    slow;
+  size_t  pos;
+  size_t  len;
+  char    buf[64 * 1024];
+};
+
+static void clientLoop(uint16_t aPort, loadClient_t* aStats) {
+  int s = socket(AF_INET, SOCK_STREAM, 0);
+  if ( aStats->slow ) {
+    int rcvBuf = 16 * 1024;
+    setsockopt(s, SOL_SOCKET, SO_RCVBUF, &rcvBuf, sizeof(rcvBuf));
+  }
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(aPort);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if ( connect(s, (struct sockaddr*) &addr, sizeof(addr)) != 0 ) {
+    aStats->errors++;
+    close(s);
+    return;
+  }
+
+  streamReader rd(s, aStats->slow);
+  std::string l, jpeg;
+  unsigned long lastFnm = 0;
+  const std::string boundary = std::string(BOUNDARY).substr(2, bdrLen - 4);
+
+  //  Response header up to the blank line, then the first boundary
+  do {
+    if ( !rd.line(l) ) goto done;
+  } while ( !l.empty() );
+
+  while ( running ) {
+    if ( !rd.line(l) ) break;
+    if ( l.empty() ) continue;
+    if ( l != boundary ) {
+      aStats->errors++;
+      break;
+    }
+    long clen = -1;
+    unsigned long fnm = 0;
+    for (;;) {
+      if ( !rd.line(l) ) goto done;
+      if ( l.empty() ) break;
+      if ( l.compare(0, 16, "Content-Length: ") == 0 ) clen = atol(l.c_str() + 16);
+      if ( l.compare(0, 16, "X-Frame-Number: ") == 0 ) fnm = strtoul(l.c_str() + 16, NULL, 10);
+    }
+    //  Frames may be skipped but never repeated or reordered
+    if ( fnm && fnm <= lastFnm ) aStats->errors++;
+    lastFnm = fnm;
+    if ( clen < 4 || !rd.take(jpeg, clen) ) break;
+    if ( (uint8_t) jpeg[0] != 0xff || (uint8_t) jpeg[1] != 0xd8 ||
+         (uint8_t) jpeg[clen - 2] != 0xff || (uint8_t) jpeg[clen - 1] != 0xd9 ) {
+      aStats->errors++;
+    }
+    aStats->frames++;
+    aStats->bytes = (uint32_t) rd.total;
+  }
+done:
+  close(s);
+}
+
+static void usage(const char* name) {
+  fprintf(stderr, "usage: %s [--mode dispatcher|tasks|poll] [--clients N] [--slow N] [--seconds S] [--fps F] [--jpeg-dir DIR]\n", name);
+  exit(1);
+}
+
+int main(int argc, char** argv) {
+  int clients = 32;
+  int slow = 0;
+  int seconds = 10;
+
+  for (int i = 1; i < argc; i++) {
+    if ( i + 1 >= argc ) usage(argv[0]);
+    if ( !strcmp(argv[i], "--mode") ) {
+      const char* m = argv[++i];
+      if ( !strcmp(m, "dispatcher") ) mode = MODE_DISPATCHER;
+      else if ( !strcmp(m, "tasks") ) mode = MODE_TASKS;
+      else if ( !strcmp(m, "poll") ) mode = MODE_POLL;
+      else usage(argv[0]);
+    }
+    else if ( !strcmp(argv[i], "--clients") ) clients = atoi(argv[++i]);
+    else if ( !strcmp(argv[i], "--slow") ) slow = atoi(argv[++i]);
+    else if ( !strcmp(argv[i], "--seconds") ) seconds = atoi(argv[++i]);
+    else if ( !strcmp(argv[i], "--fps") ) hostCameraFps = atof(argv[++i]);
+    else if ( !strcmp(argv[i], "--jpeg-dir") ) hostCameraDir = argv[++i];
+    else usage(argv[0]);
+  }
+  if ( clients > MAX_CLIENTS ) {
+    fprintf(stderr, "at most %d clients (MAX_CLIENTS)\n", MAX_CLIENTS);
+    return 1;
+  }
+  signal(SIGPIPE, SIG_IGN);
+
+  camera_config_t config;
+  memset(&config, 0, sizeof(config));
+  config.fb_count = CAMERA_FB_COUNT;
+  config.frame_size = FRAMESIZE_HD;   // sizes the ring's slot buffers
+  if ( esp_camera_init(&config) != ESP_OK || !frameRingInit() || !streamDispatchInit(NULL) ) return 1;
+
+  int ls = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr;
+  socklen_t alen = sizeof(addr);
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if ( bind(ls, (struct sockaddr*) &addr, sizeof(addr)) != 0 || listen(ls, 64) != 0 ||
+       getsockname(ls, (struct sockaddr*) &addr, &alen) != 0 ) {
+    perror("listen");
+    return 1;
+  }
+  uint16_t port = ntohs(addr.sin_port);
+
+  if ( mode == MODE_DISPATCHER ) xTaskCreate(dispatcherCB, "stream", 4096, NULL, 4, NULL);
+  xTaskCreate(cameraCB, "cam", 4096, NULL, 6, NULL);
+  std::thread(acceptLoop, ls).detach();
+
+  std::vector<loadClient_t> stats(clients);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < clients; i++) {
+    stats[i].frames = 0;
+    stats[i].bytes = 0;
+    stats[i].errors = 0;
+    stats[i].slow = i < slow;
+    threads.push_back(std::thread(clientLoop, port, &stats[i]));
+  }
+
+  //  Measure after a second of warm-up so connection setup is not counted
+  delay(1000);
+  uint32_t f0 = deliveredFrames();
+  uint32_t w0 = streamWakeups();
+  uint32_t p0 = frameRingStats.published;
+  double s0 = streamCpu();
+  double c0 = threadCpu(cameraThread);
+  double t0 = processCpu();
+  std::vector<uint32_t> cf0(clients);
+  for (int i = 0; i < clients; i++) cf0[i] = stats[i].frames;
+
+  delay(seconds * 1000);
+
+  uint32_t frames = deliveredFrames() - f0;
+  uint32_t wakeups = streamWakeups() - w0;
+  uint32_t published = frameRingStats.published - p0;
+  double scpu = streamCpu() - s0;
+  double ccpu = threadCpu(cameraThread) - c0;
+  double tcpu = processCpu() - t0;
+
+  running = false;
+  uint32_t errors = 0, fast = 0, fastFrames = 0, slowFrames = 0, fastMin = UINT32_MAX;
+  for (int i = 0; i < clients; i++) {
+    errors += stats[i].errors;
+    uint32_t n = stats[i].frames - cf0[i];
+    if ( stats[i].slow ) slowFrames += n;
+    else {
+      fast++;
+      fastFrames += n;
+      fastMin = std::min(fastMin, n);
+    }
+  }
+
+  //  Frames the streaming side skipped for its clients to stay on the newest one
+  uint32_t dropped = 0;
+  for (int i = 0; i < MAX_CLIENTS; i++) {
+    if ( streamClients[i].used ) dropped += streamClients[i].dropped;
+  }
+
+  static const char* modes[] = { "dispatcher", "tasks", "poll" };
+  printf("mode               : %s\n", modes[mode]);
+  printf("clients            : %d (%d slow)\n", clients, slow);
+  printf("camera frames      : %u (%.1f fps)\n", published, published / (double) seconds);
+  printf("frames delivered   : %u (%.1f fps per fast client)\n", frames,
+         fast ? fastFrames / (double) fast / seconds : 0.0);
+  if ( fast ) printf("slowest fast client: %.1f fps\n", fastMin / (double) seconds);
+  printf("slow client frames : %u (%.1f fps each)\n", slowFrames, slow ? slowFrames / (double) slow / seconds : 0.0);
+  printf("frames skipped     : %u (all clients, whole run)\n", dropped);
+  printf("ring overruns      : %u\n", frameRingStats.overruns);
+  printf("streaming wakeups  : %u (%.2f per delivered frame)\n", wakeups, frames ? wakeups / (double) frames : 0.0);
+  if ( mode == MODE_DISPATCHER ) printf("send stalls        : %u\n", streamDispatchStats.blocked);
+  printf("streaming CPU      : %.3f s (%.1f%% of a core), %.1f us per delivered frame\n",
+         scpu, 100.0 * scpu / seconds, frames ? 1e6 * scpu / frames : 0.0);
+  printf("camera CPU         : %.3f s\n", ccpu);
+  printf("process CPU        : %.3f s (clients included)\n", tcpu);
+  printf("stream errors      : %u\n", errors);
+
+  fflush(stdout);
+  _exit(errors ? 2 : 0);
+}
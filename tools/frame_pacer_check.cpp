@@ -0,0 +1,165 @@
+//  === Frame pacer check =============================================================================
+//  Drives the token-bucket pacer with a simulated clock: a 30 fps camera whose frames arrive with
+//  a few milliseconds of jitter, a minute at a time. Checks
+//    rate:     5 and 12.5 fps clients get their rate within 1 %, with no drift below it, and never
+//              two frames closer than half an interval
+//    unpaced:  0 fps, and a rate above the camera's, gets every frame
+//    stall:    after a long stall (no frames for 10 s) exactly one frame goes out at once, then the
+//              rate picks up where it was, no burst to make up for the stall
+//    delay:    framePacerDelayMs names a time at which the next frame is taken
+//    refund:   a frame taken but not to be had (ring slot gone) costs no credit: the next camera
+//              frame goes out instead and the rate holds
+//  Exits 1 on any failure.
+//
+//  Usage: frame-pacer-check
+
+#include "Arduino.h"
+#include "frame_pacer.h"
+
+static int failures = 0;
+static int checks = 0;
+
+static void fail(const char* aFormat, ...) __attribute__ ((format (printf, 1, 2)));
+
+static void fail(const char* aFormat, ...) {
+  va_list args;
+  va_start(args, aFormat);
+  printf("FAIL: ");
+  vprintf(aFormat, args);
+  printf("\n");
+  va_end(args);
+  failures++;
+}
+
+#define CAMERA_INTERVAL   (1000000 / 30)   // microseconds
+#define JITTER            3000
+
+static uint32_t seed = 1;
+
+// Arrival time of the next camera frame
+static int64_t nextFrame(int64_t aNow) {
+  seed = seed * 1103515245u + 12345u;
+  return aNow + CAMERA_INTERVAL - JITTER + (int64_t) ((seed >> 8) % (2 * JITTER));
+}
+
+typedef struct {
+  uint32_t  frames;     // camera frames
+  uint32_t  sent;
+  int64_t   minGap;     // microseconds between two sent frames
+  int64_t   end;
+} paceResult_t;
+
+// aSeconds of camera frames through a pacer started at aStart
+static paceResult_t pace(framePacer_t* p, int64_t aStart, double aSeconds) {
+  paceResult_t r = { 0, 0, INT64_MAX, aStart };
+  int64_t last = -1;
+  for (int64_t now = aStart; now < aStart + (int64_t) (aSeconds * 1000000); now = nextFrame(now)) {
+    r.frames++;
+    if ( framePacerTake(p, now) ) {
+      if ( last >= 0 && now - last < r.minGap ) r.minGap = now - last;
+      last = now;
+      r.sent++;
+    }
+    r.end = now;
+  }
+  return r;
+}
+
+static void checkRate(float aFps) {
+  framePacer_t p;
+  framePacerInit(&p, aFps, 0);
+  paceResult_t r = pace(&p, 0, 60);
+  float fps = r.sent / 60.0f;
+  checks++;
+  if ( fps < aFps * 0.99f || fps > aFps * 1.01f ) fail("rate %.1f: %.2f fps over a minute", aFps, fps);
+  checks++;
+  if ( r.minGap < 1000000 / aFps / 2 ) fail("rate %.1f: two frames %.1f ms apart", aFps, r.minGap / 1000.0);
+  printf("rate %4.1f fps: %u of %u frames, %.2f fps, closest %.1f ms apart\n", aFps, (unsigned) r.sent,
+         (unsigned) r.frames, fps, r.minGap / 1000.0);
+}
+
+static void checkUnpaced() {
+  framePacer_t p;
+  framePacerInit(&p, 0, 0);
+  paceResult_t r = pace(&p, 0, 60);
+  checks++;
+  if ( r.sent != r.frames ) fail("unpaced: %u of %u frames", (unsigned) r.sent, (unsigned) r.frames);
+  checks++;
+  if ( framePacerDelayMs(&p, 0) != 0 ) fail("unpaced: a delay before the next frame");
+
+  //  Asking for more than the camera delivers: every frame
+  framePacerInit(&p, 60, 0);
+  r = pace(&p, 0, 60);
+  checks++;
+  if ( r.sent != r.frames ) fail("60 fps on a 30 fps camera: %u of %u frames", (unsigned) r.sent, (unsigned) r.frames);
+}
+
+static void checkStall() {
+  framePacer_t p;
+  framePacerInit(&p, 12.5, 0);
+  paceResult_t before = pace(&p, 0, 10);
+
+  //  Ten seconds without a frame, then frames again
+  int64_t resume = before.end + 10000000;
+  int burst = 0;
+  for (int i = 0; i < 3; i++) burst += framePacerTake(&p, resume + i * 1000);
+  checks++;
+  if ( burst != 1 ) fail("stall: %d frames within 3 ms after the stall", burst);
+
+  paceResult_t after = pace(&p, resume + CAMERA_INTERVAL, 10);
+  float fps = after.sent / 10.0f;
+  checks++;
+  if ( fps < 12.5f * 0.98f || fps > 12.5f * 1.02f ) fail("stall: %.2f fps after the stall", fps);
+  checks++;
+  if ( after.minGap < 1000000 / 12.5 / 2 ) fail("stall: two frames %.1f ms apart after the stall", after.minGap / 1000.0);
+  printf("stall: 1 frame at once after 10 s, then %.2f fps\n", fps);
+}
+
+static void checkDelay() {
+  framePacer_t p;
+  int wrong = 0;
+  framePacerInit(&p, 5, 0);
+  framePacerTake(&p, 0);
+  for (int64_t now = 1000; now < 10000000; now += 7919) {
+    if ( framePacerTake(&p, now) ) continue;
+    uint32_t ms = framePacerDelayMs(&p, now);
+    //  Not due before, due at the time it names (rounded up to whole milliseconds)
+    framePacer_t probe = p;
+    if ( ms == 0 || !framePacerTake(&probe, now + ms * 1000) ) wrong++;
+  }
+  checks++;
+  if ( wrong ) fail("delay: %d times the next frame was not due after the delay", wrong);
+}
+
+static void checkRefund() {
+  framePacer_t p;
+  framePacerInit(&p, 5, 0);
+  uint32_t taken = 0, sent = 0;
+  for (int64_t now = 0; now < 60000000; now = nextFrame(now)) {
+    if ( !framePacerTake(&p, now) ) continue;
+    //  Every third frame the pacer lets out is gone before the client gets it
+    if ( ++taken % 3 == 0 ) framePacerRefund(&p);
+    else sent++;
+  }
+  float fps = sent / 60.0f;
+  checks++;
+  if ( fps < 5 * 0.99f || fps > 5 * 1.01f ) fail("refund: %.2f fps with every third frame gone", fps);
+  printf("refund: %.2f fps with every third frame gone\n", fps);
+}
+
+int main(int argc, char** argv) {
+  (void) argv;
+  if ( argc > 1 ) {
+    fprintf(stderr, "usage: frame-pacer-check\n");
+    return 1;
+  }
+  checkRate(5);
+  checkRate(12.5);
+  checkUnpaced();
+  checkStall();
+  checkDelay();
+  checkRefund();
+
+  printf("%s: %d checks, %d failures\n", failures ? "FAIL" : "ok", checks, failures);
+  return failures ? 1 : 0;
+}
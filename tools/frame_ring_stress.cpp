@@ -0,0 +1,310 @@
+//  === Frame ring stress =============================================================================
+//  Runs the frame ring under pthreads: producer threads fill and publish frames, consumer threads
+//  take references on the current frame, hold them for a while as a send would, and drop them.
+//  Every frame carries its own frame number and a byte pattern derived from it, so a consumer
+//  can tell a frame that was overwritten while it held a reference. Checks that
+//    - every byte of every frame read matches its frame number, before and after the hold
+//    - the part header of every frame carries its length and frame number
+//    - each consumer only ever sees newer frames
+//    - no frame is dropped for lack of a slot (a slot per consumer plus two)
+//    - every reference is given back at the end
+//    - frameRingWait() counts every wakeup of every thread (the stats are shared by both cores)
+//  and reports the copies made per frame and how long the ring's locks are held, timed around
+//  every pthread_mutex_lock/unlock the ring makes (-Wl,--wrap=pthread_mutex_lock,...).
+//  The ring has one publisher by design (the camera task), so the producers take turns on it
+//  through a mutex of their own, which is not timed.
+//  Exits 1 on any failure.
+//
+//  Usage: frame-ring-stress [--seconds S] [--producers N] [--consumers N] [--slow N]
+//    --slow N  makes N of the consumers hold each frame 0.2-2 ms, the others move on at once
+
+#include "Arduino.h"
+#include "frame_ring.h"
+
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#define STRESS_SLOT_SIZE  (32 * 1024)
+#define STRESS_FRAME_MIN  256
+
+// ==== Lock hold time ========================================================================
+extern "C" int __real_pthread_mutex_lock(pthread_mutex_t* aMux);
+extern "C" int __real_pthread_mutex_unlock(pthread_mutex_t* aMux);
+
+static pthread_mutex_t          producerMux = PTHREAD_MUTEX_INITIALIZER;
+static std::atomic<uint64_t>    lockCount(0);
+static std::atomic<uint64_t>    lockNanos(0);
+static std::atomic<uint64_t>    lockMax(0);
+static __thread uint64_t        lockedAt = 0;
+static __thread int             lockDepth = 0;
+
+static uint64_t nanos() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+extern "C" int __wrap_pthread_mutex_lock(pthread_mutex_t* aMux) {
+  int rc = __real_pthread_mutex_lock(aMux);
+  if ( aMux != &producerMux && lockDepth++ == 0 ) lockedAt = nanos();
+  return rc;
+}
+
+extern "C" int __wrap_pthread_mutex_unlock(pthread_mutex_t* aMux) {
+  if ( aMux != &producerMux && --lockDepth == 0 ) {
+    uint64_t held = nanos() - lockedAt;
+    lockCount++;
+    lockNanos += held;
+    uint64_t most = lockMax;
+    while ( held > most && !lockMax.compare_exchange_weak(most, held) ) {}
+  }
+  return __real_pthread_mutex_unlock(aMux);
+}
+
+// ==== Checks ================================================================================
+static int failures = 0;
+static int checks = 0;
+
+static void fail(const char* aFormat, ...) __attribute__ ((format (printf, 1, 2)));
+
+static void fail(const char* aFormat, ...) {
+  va_list args;
+  va_start(args, aFormat);
+  printf("FAIL: ");
+  vprintf(aFormat, args);
+  printf("\n");
+  va_end(args);
+  failures++;
+}
+
+// What consumers find wrong, the first few printed as they happen
+static std::atomic<uint32_t> torn(0);
+static std::atomic<uint32_t> badHeaders(0);
+static std::atomic<uint32_t> backwards(0);
+
+static void found(std::atomic<uint32_t>& aCount, const char* aFormat, ...) __attribute__ ((format (printf, 2, 3)));
+
+static void found(std::atomic<uint32_t>& aCount, const char* aFormat, ...) {
+  if ( aCount++ >= 5 ) return;
+  va_list args;
+  va_start(args, aFormat);
+  printf("  ");
+  vprintf(aFormat, args);
+  printf("\n");
+  va_end(args);
+}
+
+static void expect(bool aOk, const char* aWhat) {
+  checks++;
+  if ( !aOk ) fail("%s", aWhat);
+}
+
+// Frame content: the frame number, then bytes that depend on it and on their offset
+static inline uint8_t pattern(uint32_t aFrame, size_t aOffset) {
+  return (uint8_t) (aFrame * 131u + aOffset * 7u + (aOffset >> 8));
+}
+
+static void fill(uint8_t* aBuf, size_t aSize, uint32_t aFrame) {
+  memcpy(aBuf, &aFrame, sizeof(aFrame));
+  for (size_t i = sizeof(aFrame); i < aSize; i++) aBuf[i] = pattern(aFrame, i);
+}
+
+// Offset of the first byte that does not belong to frame aFrame, aSize if none
+static size_t verify(const uint8_t* aBuf, size_t aSize, uint32_t aFrame) {
+  uint32_t fnm;
+  memcpy(&fnm, aBuf, sizeof(fnm));
+  if ( fnm != aFrame ) return 0;
+  for (size_t i = sizeof(fnm); i < aSize; i++) {
+    if ( aBuf[i] != pattern(aFrame, i) ) return i;
+  }
+  return aSize;
+}
+
+// ==== Producers =============================================================================
+static std::atomic<bool>      running(true);
+static std::atomic<uint64_t>  produced(0);
+static std::atomic<uint64_t>  bytesProduced(0);
+static std::atomic<uint64_t>  memcpys(0);
+
+static void producerLoop(uint32_t aSeed) {
+  //  Source frame, as the camera driver would hand it over
+  std::vector<uint8_t> source(STRESS_SLOT_SIZE);
+  uint32_t seed = aSeed;
+
+  while ( running ) {
+    seed = seed * 1103515245u + 12345u;
+    size_t size = STRESS_FRAME_MIN + (seed >> 8) % (STRESS_SLOT_SIZE - STRESS_FRAME_MIN);
+
+    pthread_mutex_lock(&producerMux);
+    uint32_t fnm = frameNumber + 1;   // only the publisher moves frameNumber
+    fill(source.data(), size, fnm);
+    frameChunck_t* f = frameRingReserve(size);
+    if ( f ) {
+      memcpy(f->dat, source.data(), size);
+      f->siz = size;
+      gettimeofday(&f->tsp, NULL);
+      memcpys++;
+      frameRingPublish(f);
+      produced++;
+      bytesProduced += size;
+    }
+    pthread_mutex_unlock(&producerMux);
+    sched_yield();
+  }
+}
+
+// ==== Consumers =============================================================================
+typedef struct {
+  bool                    slow;
+  std::atomic<uint64_t>   frames;
+  std::atomic<uint64_t>   bytes;
+  uint32_t                seed;
+} stressConsumer_t;
+
+static void checkFrame(const frameChunck_t* f, const char* aWhen) {
+  size_t bad = verify(f->dat, f->siz, f->fnm);
+  if ( bad != f->siz ) {
+    found(torn, "frame %u torn %s: byte %u of %u does not belong to it", (unsigned) f->fnm, aWhen, (unsigned) bad,
+         (unsigned) f->siz);
+  }
+}
+
+static void consumerLoop(stressConsumer_t* c) {
+  uint32_t last = 0;
+
+  while ( running ) {
+    frameChunck_t* f = frameRingAcquire(last);
+    if ( f == NULL ) {
+      sched_yield();
+      continue;
+    }
+    if ( f->fnm <= last ) found(backwards, "frame %u after frame %u", (unsigned) f->fnm, (unsigned) last);
+    checkFrame(f, "on acquire");
+
+    char expected[PART_HEADER_MAX];
+    snprintf(expected, sizeof(expected), "Content-Length: %u\r\n", (unsigned) f->siz);
+    if ( strstr(f->hdr, expected) == NULL || f->hln != strlen(f->hdr) ) {
+      found(badHeaders, "frame %u: part header does not carry its length", (unsigned) f->fnm);
+    }
+#if MJPEG_X_HEADERS
+    snprintf(expected, sizeof(expected), "X-Frame-Number: %u\r\n", (unsigned) f->fnm);
+    if ( strstr(f->hdr, expected) == NULL ) found(badHeaders, "frame %u: part header has another frame number", (unsigned) f->fnm);
+#endif
+
+    //  Sending: the producers go on publishing meanwhile
+    if ( c->slow ) {
+      c->seed = c->seed * 1103515245u + 12345u;
+      usleep(200 + (c->seed >> 8) % 1800);
+    }
+    checkFrame(f, "while held");
+
+    last = f->fnm;
+    c->frames++;
+    c->bytes += f->siz;
+    frameRingRelease(f);
+  }
+}
+
+// Before the first frame every frameRingWait() call waits and counts one wakeup
+#define STRESS_WAITS  20000
+
+static void waitLoop() {
+  for (int i = 0; i < STRESS_WAITS; i++) frameRingWait(0, 0);
+}
+
+static void checkWakeups(int aThreads) {
+  std::vector<std::thread> threads;
+  for (int i = 0; i < aThreads; i++) threads.push_back(std::thread(waitLoop));
+  for (size_t i = 0; i < threads.size(); i++) threads[i].join();
+  char what[128];
+  snprintf(what, sizeof(what), "%u of %u wakeups counted", (unsigned) frameRingStats.wakeups,
+           (unsigned) aThreads * STRESS_WAITS);
+  expect(frameRingStats.wakeups == (uint32_t) aThreads * STRESS_WAITS, what);
+}
+
+int main(int argc, char** argv) {
+  double seconds = 3;
+  int producers = 2;
+  int consumers = 8;
+  int slow = 4;
+
+  for (int i = 1; i < argc; i++) {
+    if ( i + 1 >= argc ) consumers = -1;
+    else if ( !strcmp(argv[i], "--seconds") ) seconds = atof(argv[++i]);
+    else if ( !strcmp(argv[i], "--producers") ) producers = atoi(argv[++i]);
+    else if ( !strcmp(argv[i], "--consumers") ) consumers = atoi(argv[++i]);
+    else if ( !strcmp(argv[i], "--slow") ) slow = atoi(argv[++i]);
+    else consumers = -1;
+  }
+  if ( seconds <= 0 || producers < 1 || producers > 8 || consumers < 1 || consumers > 64 || slow < 0 || slow > consumers ) {
+    fprintf(stderr, "usage: %s [--seconds S] [--producers 1..8] [--consumers 1..64] [--slow N]\n", argv[0]);
+    return 1;
+  }
+
+  //  A slot per consumer, one being filled, one current: publishing never runs out of slots
+  if ( !frameRingInit(consumers + 2, STRESS_SLOT_SIZE) ) {
+    fprintf(stderr, "cannot set up the ring\n");
+    return 1;
+  }
+  checkWakeups(consumers);
+  lockCount = lockNanos = lockMax = 0;
+
+  std::vector<stressConsumer_t> stats(consumers);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < consumers; i++) {
+    stats[i].slow = i < slow;
+    stats[i].frames = stats[i].bytes = 0;
+    stats[i].seed = 17 + i;
+    threads.push_back(std::thread(consumerLoop, &stats[i]));
+  }
+  for (int i = 0; i < producers; i++) threads.push_back(std::thread(producerLoop, 1 + i));
+
+  usleep((useconds_t) (seconds * 1000000));
+  running = false;
+  for (size_t i = 0; i < threads.size(); i++) threads[i].join();
+
+  uint64_t fast = 0, slowFrames = 0, consumed = 0;
+  for (int i = 0; i < consumers; i++) {
+    consumed += stats[i].frames;
+    if ( stats[i].slow ) slowFrames += stats[i].frames;
+    else fast += stats[i].frames;
+  }
+
+  printf("%d producers, %d consumers (%d slow), %.1f s\n", producers, consumers, slow, seconds);
+  printf("frames     : %llu published, %llu read by consumers (%.0f per fast, %.0f per slow consumer)\n",
+         (unsigned long long) produced.load(), (unsigned long long) consumed,
+         consumers > slow ? fast / (double) (consumers - slow) : 0.0, slow ? slowFrames / (double) slow : 0.0);
+  printf("copies     : %.2f per published frame (source into the slot), 0 per consumer (read in place), "
+         "%.1f KB average frame\n", produced ? memcpys / (double) produced : 0.0,
+         produced ? bytesProduced / 1024.0 / produced : 0.0);
+  printf("ring locks : %llu taken, %.0f ns held on average, %.1f us longest\n", (unsigned long long) lockCount.load(),
+         lockCount ? lockNanos / (double) lockCount : 0.0, lockMax / 1000.0);
+
+  char what[128];
+  snprintf(what, sizeof(what), "%u torn frames", (unsigned) torn.load());
+  expect(torn == 0, what);
+  snprintf(what, sizeof(what), "%u part headers not matching their frame", (unsigned) badHeaders.load());
+  expect(badHeaders == 0, what);
+  snprintf(what, sizeof(what), "%u frames older than one a consumer already had", (unsigned) backwards.load());
+  expect(backwards == 0, what);
+  expect(produced > 0 && consumed > 0, "no frames went through the ring");
+  expect(frameRingStats.published == produced, "published frames do not match the producers' count");
+  expect(frameRingStats.overruns == 0, "a frame found no free slot");
+  expect(memcpys == produced, "a frame was copied more than once");
+
+  bool referenced = false;
+  frameChunck_t* p = fstFrame;
+  do {
+    if ( p->cnt ) referenced = true;
+    p = (frameChunck_t*) p->nxt;
+  } while ( p != fstFrame );
+  expect(!referenced, "a slot is still referenced after every consumer released its frame");
+
+  printf("%s: %d checks, %d failures\n", failures ? "FAIL" : "ok", checks, failures);
+  return failures ? 1 : 0;
+}
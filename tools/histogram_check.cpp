@@ -0,0 +1,169 @@
+//  === Latency histogram check =======================================================================
+//  Checks the log-bucket histogram behind /metrics:
+//    buckets:     every value up to the last bucket's upper bound lands in the bucket whose bounds
+//                 hold it, buckets are contiguous and at most 25 % wide, the last one ends at
+//                 2^27 - 1 us and takes everything above
+//    percentiles: p50/p95/p99 of known samples within their bucket, never above the maximum,
+//                 0 for an empty histogram, back to 0 after a reset
+//    threads:     concurrent updates from several threads lose no count and keep the maximum
+//  Exits 1 on any failure.
+//
+//  Usage: histogram-check [--threads N] [--adds N]
+
+#include "Arduino.h"
+#include "histogram.h"
+
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+static int checks = 0;
+
+static void fail(const char* aFormat, ...) __attribute__ ((format (printf, 1, 2)));
+
+static void fail(const char* aFormat, ...) {
+  va_list args;
+  va_start(args, aFormat);
+  printf("FAIL: ");
+  vprintf(aFormat, args);
+  printf("\n");
+  va_end(args);
+  failures++;
+}
+
+static void checkBuckets() {
+  //  Bounds: contiguous from 0, at most a quarter of their lower bound wide beyond the exact ones
+  uint32_t lower = 0;
+  int wide = 0;
+  for (int b = 0; b < HISTOGRAM_BUCKETS; b++) {
+    uint32_t upper = histogramBucketUpper(b);
+    if ( upper < lower ) {
+      fail("buckets: bucket %d ends at %u, below its start %u", b, (unsigned) upper, (unsigned) lower);
+      return;
+    }
+    if ( b >= HISTOGRAM_SUB_BUCKETS && (uint64_t) (upper - lower + 1) * 4 > lower ) wide++;
+    lower = upper + 1;
+  }
+  checks++;
+  if ( wide ) fail("buckets: %d buckets wider than 25 %%", wide);
+
+  const uint32_t last = histogramBucketUpper(HISTOGRAM_BUCKETS - 1);
+  checks++;
+  if ( last != (1u << 27) - 1 ) fail("buckets: the last bucket ends at %u, not 2^27 - 1", (unsigned) last);
+  printf("buckets: %d, the last one ends at %u us (%.0f s)\n", HISTOGRAM_BUCKETS, (unsigned) last, last / 1e6);
+
+  //  Every value finds the bucket holding it
+  uint32_t misplaced = 0;
+  uint8_t b = 0;
+  for (uint32_t v = 0; v <= last; v++) {
+    while ( v > histogramBucketUpper(b) ) b++;
+    if ( histogramBucket(v) != b ) misplaced++;
+  }
+  checks++;
+  if ( misplaced ) fail("buckets: %u values in the wrong bucket", (unsigned) misplaced);
+
+  const uint32_t above[] = { last + 1, 1u << 28, 0xFFFFFFFFu };
+  for (size_t i = 0; i < sizeof(above) / sizeof(above[0]); i++) {
+    checks++;
+    if ( histogramBucket(above[i]) != HISTOGRAM_BUCKETS - 1 ) fail("buckets: %u not in the last bucket", (unsigned) above[i]);
+  }
+}
+
+static void expectPercentile(const char* aCheck, uint32_t aGot, uint32_t aExact, uint32_t aMax) {
+  checks++;
+  //  Bucket upper bound: at or above the exact value, within the bucket, never above the maximum
+  if ( aGot < aExact || aGot > histogramBucketUpper(histogramBucket(aExact)) || aGot > aMax ) {
+    fail("%s: %u for an exact %u (maximum %u)", aCheck, (unsigned) aGot, (unsigned) aExact, (unsigned) aMax);
+  }
+}
+
+static void checkPercentiles() {
+  static histogram_t h;
+  histogramReset(&h);
+  checks++;
+  if ( histogramPercentile(&h, 0.5f) != 0 || histogramCount(&h) != 0 ) fail("percentiles: empty histogram not 0");
+
+  //  1..10000 us once each
+  for (uint32_t v = 1; v <= 10000; v++) histogramAdd(&h, v);
+  expectPercentile("p50", histogramPercentile(&h, 0.50f), 5000, 10000);
+  expectPercentile("p95", histogramPercentile(&h, 0.95f), 9500, 10000);
+  expectPercentile("p99", histogramPercentile(&h, 0.99f), 9900, 10000);
+  checks++;
+  if ( histogramPercentile(&h, 1.0f) != 10000 ) fail("p100: %u, not the maximum", (unsigned) histogramPercentile(&h, 1.0f));
+  checks++;
+  if ( histogramCount(&h) != 10000 || h.max != 10000 ) fail("percentiles: count or maximum wrong");
+
+  //  One slow outlier among fast samples: p50 stays low, the maximum caps the top bucket
+  histogramReset(&h);
+  for (int i = 0; i < 999; i++) histogramAdd(&h, 120);
+  histogramAdd(&h, 250000);
+  expectPercentile("outlier p50", histogramPercentile(&h, 0.50f), 120, 250000);
+  checks++;
+  if ( histogramPercentile(&h, 1.0f) != 250000 ) fail("outlier p100: %u", (unsigned) histogramPercentile(&h, 1.0f));
+
+  //  A sample beyond the last bucket is reported as the last bucket's upper bound
+  histogramReset(&h);
+  histogramAdd(&h, 300000000);
+  checks++;
+  if ( histogramPercentile(&h, 0.5f) != histogramBucketUpper(HISTOGRAM_BUCKETS - 1) ) {
+    fail("beyond: p50 %u of a 300 s sample", (unsigned) histogramPercentile(&h, 0.5f));
+  }
+
+  histogramReset(&h);
+  checks++;
+  if ( histogramCount(&h) != 0 || h.max != 0 || histogramPercentile(&h, 0.99f) != 0 ) fail("reset: histogram not empty");
+}
+
+static void checkThreads(int aThreads, int aAdds) {
+  static histogram_t h;
+  histogramReset(&h);
+
+  //  Thread i adds values i*1000 + 0..999, and one maximum of its own
+  std::vector<std::thread> threads;
+  for (int t = 0; t < aThreads; t++) {
+    threads.push_back(std::thread([t, aAdds]() {
+      for (int i = 0; i < aAdds; i++) histogramAdd(&h, t * 1000 + i % 1000);
+      histogramAdd(&h, 5000000 + t);
+    }));
+  }
+  for (size_t i = 0; i < threads.size(); i++) threads[i].join();
+
+  static histogram_t expected;
+  histogramReset(&expected);
+  for (int t = 0; t < aThreads; t++) {
+    for (int i = 0; i < aAdds; i++) expected.bucket[histogramBucket(t * 1000 + i % 1000)]++;
+    expected.bucket[histogramBucket(5000000 + t)]++;
+  }
+
+  checks++;
+  if ( histogramCount(&h) != (uint32_t) aThreads * (aAdds + 1) ) {
+    fail("threads: %u samples counted of %u", (unsigned) histogramCount(&h), (unsigned) (aThreads * (aAdds + 1)));
+  }
+  checks++;
+  if ( memcmp(h.bucket, expected.bucket, sizeof(h.bucket)) ) fail("threads: bucket counts differ from a serial run");
+  checks++;
+  if ( h.max != (uint32_t) (5000000 + aThreads - 1) ) fail("threads: maximum %u", (unsigned) h.max);
+  printf("threads: %d x %d adds, %u counted\n", aThreads, aAdds + 1, (unsigned) histogramCount(&h));
+}
+
+int main(int argc, char** argv) {
+  int threads = 8;
+  int adds = 1000000;
+
+  for (int i = 1; i < argc; i++) {
+    if ( i + 1 >= argc ) threads = -1;
+    else if ( !strcmp(argv[i], "--threads") ) threads = atoi(argv[++i]);
+    else if ( !strcmp(argv[i], "--adds") ) adds = atoi(argv[++i]);
+    else threads = -1;
+  }
+  if ( threads < 1 || threads > 64 || adds < 1 ) {
+    fprintf(stderr, "usage: %s [--threads 1..64] [--adds N]\n", argv[0]);
+    return 1;
+  }
+  checkBuckets();
+  checkPercentiles();
+  checkThreads(threads, adds);
+
+  printf("%s: %d checks, %d failures\n", failures ? "FAIL" : "ok", checks, failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,194 @@
+//  === HTTP conditional request check ================================================================
+//  Checks the entity tags and If-None-Match matching behind /capture's 304 Not Modified:
+//    frame tags:  text of a frame's tag, a buffer too small gives 0
+//    match:       a strong tag, the same tag weak (W/) on either side, "*", comma separated lists
+//                 with and without spaces, a tag that is only a prefix or a suffix of another
+//    stale:       a tag of an older frame, or of the same frame number before a reboot, never matches
+//    missing:     no If-None-Match header (NULL) or an empty one never matches
+//    hash:        httpContentHash gives the FNV-1a values tools/assets.py gives for known inputs,
+//                 continues across pieces, and reproduces every hash and ASSET_VERSION that
+//                 tools/assets.py wrote into asset_manifest.h
+//    gzip:        Accept-Encoding with gzip among others, q-values including gzip;q=0, "*",
+//                 mixed case, x-gzip and a missing header
+//  Exits 1 on any failure.
+//
+//  Usage: http-cache-check
+
+#include "Arduino.h"
+#include "http_cache.h"
+#include "asset_manifest.h"
+
+static int failures = 0;
+static int checks = 0;
+
+static void fail(const char* aFormat, ...) __attribute__ ((format (printf, 1, 2)));
+
+static void fail(const char* aFormat, ...) {
+  va_list args;
+  va_start(args, aFormat);
+  printf("FAIL: ");
+  vprintf(aFormat, args);
+  printf("\n");
+  va_end(args);
+  failures++;
+}
+
+static void expectMatch(const char* aIfNoneMatch, const char* aEtag, bool aMatch) {
+  checks++;
+  if ( httpEtagMatch(aIfNoneMatch, aEtag) != aMatch ) {
+    fail("If-None-Match %s%s%s %s %s", aIfNoneMatch ? "'" : "", aIfNoneMatch ? aIfNoneMatch : "(missing)",
+         aIfNoneMatch ? "'" : "", aMatch ? "does not match" : "matches", aEtag);
+  }
+}
+
+// ==== Conditional requests ==================================================================
+static void checkFrameTags() {
+  struct timeval ts = { 0x6553f100, 42 };
+  char buf[HTTP_ETAG_MAX];
+  int n = httpFrameEtag(buf, sizeof(buf), 1234, &ts);
+  checks++;
+  if ( n != (int) strlen("\"1234-6553f100.0002a\"") || strcmp(buf, "\"1234-6553f100.0002a\"") ) {
+    fail("frame tag: got %d bytes %s", n, buf);
+  }
+
+  //  Largest values fit, one byte short of the terminator gives 0
+  struct timeval most = { 0xFFFFFFFF, 999999 };
+  n = httpFrameEtag(buf, sizeof(buf), 0xFFFFFFFFu, &most);
+  checks++;
+  if ( n <= 0 ) fail("frame tag: largest values do not fit %d bytes", HTTP_ETAG_MAX);
+  checks++;
+  if ( httpFrameEtag(buf, n, 0xFFFFFFFFu, &most) != 0 ) fail("frame tag: %d bytes hold a %d byte tag", n, n);
+}
+
+static void checkMatch() {
+  const char* tag = "\"1234-6553f100.0002a\"";
+  expectMatch("\"1234-6553f100.0002a\"", tag, true);
+  expectMatch("W/\"1234-6553f100.0002a\"", tag, true);
+  expectMatch("\"1234-6553f100.0002a\"", "W/\"1234-6553f100.0002a\"", true);
+  expectMatch("*", tag, true);
+  expectMatch("  *", tag, true);
+  expectMatch("\"a\",\"1234-6553f100.0002a\"", tag, true);
+  expectMatch("\"a\", W/\"b\" ,\t\"1234-6553f100.0002a\" ", tag, true);
+  expectMatch("\"a\", \"b\"", tag, false);
+  expectMatch("\"1234-6553f100.0002\"", tag, false);
+  expectMatch("\"1234-6553f100.0002a0\"", tag, false);
+  expectMatch("\"234-6553f100.0002a\"", tag, false);
+  expectMatch("1234-6553f100.0002a", tag, false);
+  expectMatch("\"1234-6553f100.0002a", tag, false);
+
+  //  Asset tags go through the same comparison
+  expectMatch("\"0a1b2c3d\", \"0a1b2c3d-gz\"", "\"0a1b2c3d-gz\"", true);
+  expectMatch("\"0a1b2c3d\"", "\"0a1b2c3d-gz\"", false);
+}
+
+static void checkStale() {
+  struct timeval ts = { 0x6553f100, 42 };
+  char current[HTTP_ETAG_MAX], older[HTTP_ETAG_MAX], reboot[HTTP_ETAG_MAX], list[3 * HTTP_ETAG_MAX];
+  httpFrameEtag(current, sizeof(current), 1234, &ts);
+  httpFrameEtag(older, sizeof(older), 1233, &ts);
+  struct timeval before = { 0x6553e000, 42 };
+  httpFrameEtag(reboot, sizeof(reboot), 1234, &before);
+
+  expectMatch(older, current, false);
+  expectMatch(reboot, current, false);
+  snprintf(list, sizeof(list), "%s, %s", older, reboot);
+  expectMatch(list, current, false);
+  snprintf(list, sizeof(list), "%s, %s", older, current);
+  expectMatch(list, current, true);
+}
+
+static void checkMissing() {
+  expectMatch(NULL, "\"1\"", false);
+  expectMatch("", "\"1\"", false);
+  expectMatch(" , ,", "\"1\"", false);
+  expectMatch("\"1\"", NULL, false);
+}
+
+// ==== Content hash against tools/assets.py =================================================
+static void expectHash(const char* aInput, uint32_t aHash) {
+  uint32_t h = httpContentHash((const uint8_t*) aInput, strlen(aInput));
+  checks++;
+  if ( h != aHash ) fail("hash: \"%s\" gives %08x, tools/assets.py %08x", aInput, (unsigned) h, (unsigned) aHash);
+}
+
+static void checkHash() {
+  //  python3 -c 'import sys; sys.path.insert(0, "tools"); import assets; print("%08x" % assets.fnv1a(b"foobar"))'
+  expectHash("", 0x811c9dc5);
+  expectHash("a", 0xe40c292c);
+  expectHash("foobar", 0xbf9cf968);
+  expectHash("gzip", 0x1a451735);
+
+  const uint8_t* text = (const uint8_t*) "foobar";
+  checks++;
+  if ( httpContentHash(text + 3, 3, httpContentHash(text, 3)) != 0xbf9cf968 ) fail("hash: not continued across pieces");
+
+  //  The manifest holds what tools/assets.py computed over the same bytes
+  uint32_t version = HTTP_HASH_INIT;
+  for (size_t i = 0; i < ASSET_COUNT; i++) {
+    const httpAsset_t* a = &assetManifest[i];
+    uint32_t h = httpContentHash(a->data, a->size);
+    checks++;
+    if ( h != a->hash ) fail("hash: %s gives %08x, the manifest %08x", a->path, (unsigned) h, (unsigned) a->hash);
+    char line[128];
+    int n = snprintf(line, sizeof(line), "%s %08x\n", a->path, (unsigned) a->hash);
+    version = httpContentHash((const uint8_t*) line, n, version);
+  }
+  checks++;
+  if ( version != ASSET_VERSION ) fail("hash: asset version %08x, the manifest %08x", (unsigned) version, (unsigned) ASSET_VERSION);
+}
+
+// ==== Accept-Encoding ========================================================================
+static void expectGzip(const char* aAcceptEncoding, bool aGzip) {
+  checks++;
+  if ( httpAcceptsGzip(aAcceptEncoding) != aGzip ) {
+    fail("Accept-Encoding %s%s%s %s gzip", aAcceptEncoding ? "'" : "", aAcceptEncoding ? aAcceptEncoding : "(missing)",
+         aAcceptEncoding ? "'" : "", aGzip ? "does not take" : "takes");
+  }
+}
+
+static void checkGzip() {
+  expectGzip("gzip", true);
+  expectGzip("gzip, deflate, br", true);
+  expectGzip("deflate,gzip", true);
+  expectGzip("br;q=1.0, gzip;q=0.8, *;q=0.1", true);
+  expectGzip("gzip ; q=0.001", true);
+  expectGzip("gzip;q=1", true);
+  expectGzip("gzip;level=9", true);
+
+  expectGzip("gzip;q=0", false);
+  expectGzip("gzip;q=0.0", false);
+  expectGzip("deflate, gzip; q=0.000", false);
+  expectGzip("*", false);
+  expectGzip("*;q=1", false);
+  expectGzip("x-gzip", false);
+  expectGzip("gzipped", false);
+  expectGzip("deflate, br", false);
+  expectGzip("identity", false);
+
+  //  Content-codings are case-insensitive, the q parameter too
+  expectGzip("GZIP", true);
+  expectGzip("Gzip, deflate", true);
+  expectGzip("deflate, gZiP;q=0.5", true);
+  expectGzip("GZIP;Q=0", false);
+  expectGzip("X-GZIP", false);
+
+  expectGzip(NULL, false);
+  expectGzip("", false);
+}
+
+int main(int argc, char** argv) {
+  (void) argv;
+  if ( argc > 1 ) {
+    fprintf(stderr, "usage: http-cache-check\n");
+    return 1;
+  }
+  checkFrameTags();
+  checkMatch();
+  checkStale();
+  checkMissing();
+  checkHash();
+  checkGzip();
+
+  printf("%s: %d checks, %d failures\n", failures ? "FAIL" : "ok", checks, failures);
+  return failures ? 1 : 0;
+}
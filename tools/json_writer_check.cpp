@@ -0,0 +1,357 @@
+//  === JSON writer and /status check =================================================================
+//  Checks the fixed-buffer JSON writer and the /status document written with it:
+//    writer:   nesting of objects and arrays with commas only between members, keys and string
+//              values escaped (quote, backslash, control characters), 64-bit integers, fixed point
+//              rounding and sign, NaN and infinities as null, dotted IP addresses
+//    short:    every buffer too small for the whole document gives 0, stays NUL-terminated and is
+//              not written past its end
+//    status:   /status with every client slot in use is valid JSON, fits STATUS_BUFFER_SIZE and
+//              carries the values set up for it; buffers too small give 0
+//    heap:     writing documents and rendering /status make no heap allocation (-Wl,--wrap=malloc)
+//  Exits 1 on any failure.
+//
+//  Usage: json-writer-check
+
+#include "Arduino.h"
+#include "json_writer.h"
+#include "status.h"
+#include "streaming.h"
+
+#include <math.h>
+#include <new>
+
+extern "C" void* __real_malloc(size_t aSize);
+extern "C" void  __real_free(void* aPtr);
+extern "C" void* __real_calloc(size_t aCount, size_t aSize);
+extern "C" void* __real_realloc(void* aPtr, size_t aSize);
+
+static bool  counting = false;
+static long  allocs = 0;
+
+static void* track(void* aPtr) {
+  if ( counting ) allocs++;
+  return aPtr;
+}
+
+extern "C" void* __wrap_malloc(size_t aSize) { return track(__real_malloc(aSize)); }
+extern "C" void* __wrap_calloc(size_t aCount, size_t aSize) { return track(__real_calloc(aCount, aSize)); }
+extern "C" void* __wrap_realloc(void* aPtr, size_t aSize) { return track(__real_realloc(aPtr, aSize)); }
+extern "C" void  __wrap_free(void* aPtr) { __real_free(aPtr); }
+void* operator new(size_t aSize) {
+  void* p = track(__real_malloc(aSize ? aSize : 1));
+  if ( p == NULL ) throw std::bad_alloc();
+  return p;
+}
+void* operator new[](size_t aSize) { return operator new(aSize); }
+void operator delete(void* aPtr) noexcept { __real_free(aPtr); }
+void operator delete[](void* aPtr) noexcept { __real_free(aPtr); }
+
+//  Defined by the streaming implementations in the firmware
+volatile float    cameraFPS = 1.0;
+volatile uint32_t currentFrameSize = 0;
+volatile uint32_t clientsConnected = 0;
+
+static int failures = 0;
+static int checks = 0;
+
+static void fail(const char* aFormat, ...) __attribute__ ((format (printf, 1, 2)));
+
+static void fail(const char* aFormat, ...) {
+  va_list args;
+  va_start(args, aFormat);
+  printf("FAIL: ");
+  vprintf(aFormat, args);
+  printf("\n");
+  va_end(args);
+  failures++;
+}
+
+// ==== Documents written through the API, with the text they must give ======================
+typedef void (*writeFn_t)(jsonWriter_t* w);
+
+static void writeNesting(jsonWriter_t* w) {
+  jsonBeginObject(w);
+  jsonBeginObject(w, "a");
+  jsonBeginArray(w, "b");
+  jsonInt(w, NULL, 1);
+  jsonInt(w, NULL, 2);
+  jsonBeginObject(w);
+  jsonEndObject(w);
+  jsonEndArray(w);
+  jsonBeginArray(w, "c");
+  jsonEndArray(w);
+  jsonEndObject(w);
+  jsonBool(w, "d", true);
+  jsonBool(w, "e", false);
+  jsonEndObject(w);
+}
+
+static void writeArray(jsonWriter_t* w) {
+  jsonBeginArray(w);
+  jsonString(w, NULL, "x");
+  jsonBeginArray(w);
+  jsonBeginArray(w);
+  jsonEndArray(w);
+  jsonEndArray(w);
+  jsonUint(w, NULL, 0);
+  jsonEndArray(w);
+}
+
+static void writeEscapes(jsonWriter_t* w) {
+  jsonBeginObject(w);
+  jsonString(w, "q\"k", "a\"b\\c/d");
+  jsonString(w, "ctl", "\n\t\x01\x1f");
+  jsonString(w, "utf8", "caf\xc3\xa9");
+  jsonString(w, "null", NULL);
+  jsonEndObject(w);
+}
+
+static void writeNumbers(jsonWriter_t* w) {
+  jsonBeginObject(w);
+  jsonInt(w, "imin", INT64_MIN);
+  jsonInt(w, "imax", INT64_MAX);
+  jsonUint(w, "umax", UINT64_MAX);
+  jsonInt(w, "neg", -55);
+  jsonFixed(w, "f1", 1.25f, 1);
+  jsonFixed(w, "f2", -2.5f, 2);
+  jsonFixed(w, "f0", 2.5f, 0);
+  jsonFixed(w, "small", 0.0004f, 3);
+  jsonFixed(w, "negzero", -0.04f, 1);
+  jsonFixed(w, "clamp", 1.5f, 9);
+  jsonFixed(w, "nan", NAN, 1);
+  jsonFixed(w, "inf", INFINITY, 1);
+  jsonFixed(w, "ninf", -INFINITY, 2);
+  jsonIp(w, "ip", 0x3201a8c0);   // 192.168.1.50 in network byte order
+  jsonEndObject(w);
+}
+
+typedef struct {
+  const char* name;
+  writeFn_t   write;
+  const char* expected;
+} document_t;
+
+static const document_t documents[] = {
+  { "nesting", writeNesting, "{\"a\":{\"b\":[1,2,{}],\"c\":[]},\"d\":true,\"e\":false}" },
+  { "array", writeArray, "[\"x\",[[]],0]" },
+  { "escapes", writeEscapes,
+    "{\"q\\\"k\":\"a\\\"b\\\\c/d\",\"ctl\":\"\\u000a\\u0009\\u0001\\u001f\",\"utf8\":\"caf\xc3\xa9\",\"null\":\"\"}" },
+  { "numbers", writeNumbers,
+    "{\"imin\":-9223372036854775808,\"imax\":9223372036854775807,\"umax\":18446744073709551615,\"neg\":-55,"
+    "\"f1\":1.3,\"f2\":-2.50,\"f0\":3,\"small\":0.000,\"negzero\":0.0,\"clamp\":1.500000,"
+    "\"nan\":null,\"inf\":null,\"ninf\":null,\"ip\":\"192.168.1.50\"}" },
+};
+static const int DOCUMENTS = sizeof(documents) / sizeof(documents[0]);
+
+static bool validJson(const char* aText);
+
+static void checkWriter() {
+  for (int d = 0; d < DOCUMENTS; d++) {
+    char buf[512];
+    jsonWriter_t w;
+    jsonInit(&w, buf, sizeof(buf));
+    documents[d].write(&w);
+    size_t n = jsonFinish(&w);
+    checks++;
+    if ( n != strlen(documents[d].expected) || strcmp(buf, documents[d].expected) ) {
+      fail("writer %s: got %u bytes %s\n  expected %u bytes %s", documents[d].name, (unsigned) n, buf,
+           (unsigned) strlen(documents[d].expected), documents[d].expected);
+    }
+    checks++;
+    if ( !validJson(buf) ) fail("writer %s: not valid JSON", documents[d].name);
+  }
+}
+
+static void checkShort() {
+  for (int d = 0; d < DOCUMENTS; d++) {
+    const size_t full = strlen(documents[d].expected);
+    int cut = 0, spilled = 0, open = 0;
+    for (size_t size = 0; size <= full; size++) {
+      char buf[512];
+      memset(buf, '#', sizeof(buf));
+      jsonWriter_t w;
+      jsonInit(&w, buf, size);
+      documents[d].write(&w);
+      if ( jsonFinish(&w) != 0 ) cut++;
+      if ( buf[size] != '#' ) spilled++;
+      if ( size && memchr(buf, 0, size) == NULL ) open++;
+    }
+    checks++;
+    if ( cut ) fail("short %s: %d buffer sizes below %u bytes gave a document", documents[d].name, cut, (unsigned) full + 1);
+    checks++;
+    if ( spilled ) fail("short %s: %d buffer sizes written past their end", documents[d].name, spilled);
+    checks++;
+    if ( open ) fail("short %s: %d buffers left without a terminator", documents[d].name, open);
+  }
+}
+
+// ==== JSON syntax ===========================================================================
+static const char* value(const char* p, int aDepth);
+
+static const char* space(const char* p) {
+  while ( *p == ' ' || *p == '\t' || *p == '\n' || *p == '\r' ) p++;
+  return p;
+}
+
+static const char* string(const char* p) {
+  if ( *p++ != '"' ) return NULL;
+  while ( *p != '"' ) {
+    if ( (unsigned char) *p < 0x20 ) return NULL;
+    if ( *p++ == '\\' ) {
+      if ( *p == 'u' ) {
+        for (int i = 1; i <= 4; i++) if ( !isxdigit((unsigned char) p[i]) ) return NULL;
+        p += 5;
+      }
+      else if ( *p == 0 || !strchr("\"\\/bfnrt", *p++) ) return NULL;
+    }
+  }
+  return p + 1;
+}
+
+static const char* number(const char* p) {
+  if ( *p == '-' ) p++;
+  if ( *p == '0' ) p++;
+  else if ( isdigit((unsigned char) *p) ) while ( isdigit((unsigned char) *p) ) p++;
+  else return NULL;
+  if ( *p == '.' ) {
+    if ( !isdigit((unsigned char) *++p) ) return NULL;
+    while ( isdigit((unsigned char) *p) ) p++;
+  }
+  return p;
+}
+
+// Skips a list of members or elements up to aClose
+static const char* list(const char* p, char aClose, bool aMembers, int aDepth) {
+  p = space(p + 1);
+  if ( *p == aClose ) return p + 1;
+  for (;;) {
+    if ( aMembers ) {
+      if ( (p = string(p)) == NULL ) return NULL;
+      p = space(p);
+      if ( *p++ != ':' ) return NULL;
+    }
+    if ( (p = value(space(p), aDepth + 1)) == NULL ) return NULL;
+    p = space(p);
+    if ( *p == aClose ) return p + 1;
+    if ( *p++ != ',' ) return NULL;
+    p = space(p);
+  }
+}
+
+static const char* value(const char* p, int aDepth) {
+  if ( aDepth > 16 ) return NULL;
+  if ( *p == '{' ) return list(p, '}', true, aDepth);
+  if ( *p == '[' ) return list(p, ']', false, aDepth);
+  if ( *p == '"' ) return string(p);
+  if ( !strncmp(p, "true", 4) ) return p + 4;
+  if ( !strncmp(p, "false", 5) ) return p + 5;
+  if ( !strncmp(p, "null", 4) ) return p + 4;
+  return number(p);
+}
+
+static bool validJson(const char* aText) {
+  const char* p = value(space(aText), 0);
+  return p && *space(p) == 0;
+}
+
+// ==== /status ================================================================================
+static void setupStatus() {
+  cameraFPS = 24.96f;
+  currentFrameSize = 57;
+  clientsConnected = MAX_CLIENTS;
+  frameRingStats.published = 1000;
+  frameRingStats.wakeups = 1500;
+  frameRingStats.overruns = 4;
+  statusSnapshot.rssi = -61;
+  statusSnapshot.phy = "802.11n";
+
+  //  Every slot in use, the longest addresses
+  for (int8_t i = 0; i < MAX_CLIENTS; i++) {
+    streamClient_t* c = &streamClients[i];
+    const uint8_t ip[] = { 192, 168, 100, (uint8_t) (200 + i) };
+    c->used = true;
+    memcpy(&c->ip, ip, 4);
+    c->since = millis();
+    c->sent = 4000000000u;
+    c->dropped = 4000000000u;
+    c->paced = 4000000000u;
+    c->ttff = 4000000000u;
+    c->target = 12.5f;
+  }
+}
+
+static void expectText(const char* aDoc, const char* aText) {
+  checks++;
+  if ( strstr(aDoc, aText) == NULL ) fail("status: no %s", aText);
+}
+
+static void checkStatus() {
+  static char doc[STATUS_BUFFER_SIZE];
+  setupStatus();
+  size_t n = statusRender(doc, sizeof(doc));
+  checks++;
+  if ( n == 0 ) {
+    fail("status: %d clients do not fit STATUS_BUFFER_SIZE %d", MAX_CLIENTS, STATUS_BUFFER_SIZE);
+    return;
+  }
+  printf("status: %d clients, %u bytes of %d\n", MAX_CLIENTS, (unsigned) n, STATUS_BUFFER_SIZE);
+  checks++;
+  if ( strlen(doc) != n || !validJson(doc) ) fail("status: not valid JSON: %s", doc);
+
+  expectText(doc, "{\"status\":\"OK\",\"cameraFPS\":25.0,\"frameSize\":57,");
+  char clients[32];
+  snprintf(clients, sizeof(clients), "\"clients\":%d,", MAX_CLIENTS);
+  expectText(doc, clients);
+  expectText(doc, "\"wifiRSSI\":-61,");
+  expectText(doc, "\"wifiPHY\":\"802.11n\"");
+  expectText(doc, "\"wakeupsPerFrame\":1.50,\"ringOverruns\":4,");
+  expectText(doc, "\"capture\":{\"state\":\"");
+  expectText(doc, "\"memory\":{\"tier\":\"");
+  expectText(doc, "\"streams\":[{\"ip\":\"192.168.100.200\",");
+  expectText(doc, "\"target\":12.5,\"paced\":4000000000,\"ttff\":4000000000,");
+  expectText(doc, "\"controls\":{");
+  checks++;
+  if ( n < 40 || strcmp(doc + n - 40, "\"currentHeight\":0,\"settingsLoaded\":true}") ) fail("status: does not end as expected");
+
+  int cut = 0;
+  for (size_t size = 0; size <= n; size += 7) {
+    static char small[STATUS_BUFFER_SIZE];
+    if ( statusRender(small, size) != 0 ) cut++;
+  }
+  checks++;
+  if ( cut ) fail("status: %d buffer sizes below %u bytes gave a document", cut, (unsigned) n + 1);
+}
+
+// ==== Heap ===================================================================================
+static void checkHeap() {
+  static char doc[STATUS_BUFFER_SIZE];
+  counting = true;
+  for (int i = 0; i < 100; i++) {
+    for (int d = 0; d < DOCUMENTS; d++) {
+      jsonWriter_t w;
+      jsonInit(&w, doc, sizeof(doc));
+      documents[d].write(&w);
+    }
+    statusRender(doc, sizeof(doc));
+  }
+  statusRender(doc, 100);
+  counting = false;
+  checks++;
+  if ( allocs ) fail("heap: %ld allocations over 100 rounds", allocs);
+  printf("heap: %ld allocations over 100 rounds of %d documents and /status\n", allocs, DOCUMENTS);
+}
+
+int main(int argc, char** argv) {
+  (void) argv;
+  if ( argc > 1 ) {
+    fprintf(stderr, "usage: json-writer-check\n");
+    return 1;
+  }
+  checkWriter();
+  checkShort();
+  checkStatus();
+  checkHeap();
+
+  printf("%s: %d checks, %d failures\n", failures ? "FAIL" : "ok", checks, failures);
+  return failures ? 1 : 0;
+}
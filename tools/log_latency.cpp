@@ -0,0 +1,245 @@
+//  === Logging latency: what a log call costs the calling task =====================================
+//  Producer threads log the streaming and camera messages at a steady rate to a simulated UART
+//  (115200 baud behind a 128 byte FIFO, a write blocks until its bytes fit), and time every call:
+//    sync:  format and write from the caller, the way SimpleLog worked before the log ring
+//    ring:  SimpleLog, the caller copies its arguments into the ring and the drain task writes
+//  and reports caller latency percentiles, lines written and messages dropped. Also checks that
+//  deferred formatting prints what printf would, and times a call to a level compiled out.
+//  Exits 1 if a line is formatted wrong or the ring loses a message without counting it.
+//
+//  Usage: log-bench [--producers N] [--messages N] [--interval US]
+
+#include "Arduino.h"
+#include "logging.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if LOG_LEVEL_MAX != LOG_LEVEL_TRACE
+#error "build with -DLOG_LEVEL=5: verbose is the level compiled out"
+#endif
+
+typedef std::chrono::steady_clock benchClock;
+
+static int producers = 4;     // tasks logging at once
+static int messages = 100;    // messages per task
+static int interval = 40000;  // us between the messages of a task
+static int failures = 0;
+
+static void fail(const char* aFormat, ...) __attribute__ ((format (printf, 1, 2)));
+
+static void fail(const char* aFormat, ...) {
+  va_list args;
+  va_start(args, aFormat);
+  printf("FAIL: ");
+  vprintf(aFormat, args);
+  printf("\n");
+  va_end(args);
+  failures++;
+}
+
+// ==== UART: 11520 bytes/s out of a 128 byte FIFO, writers wait for room ==================
+class SlowUart : public Print {
+public:
+  size_t write(uint8_t c) { return write(&c, 1); }
+  size_t write(const uint8_t* aBuffer, size_t aSize) {
+    std::lock_guard<std::mutex> lk(_mtx);
+    benchClock::time_point now = benchClock::now();
+    if ( _empty < now ) _empty = now;
+    _empty += std::chrono::nanoseconds((long long) aSize * BYTE_NS);
+    std::this_thread::sleep_until(_empty - std::chrono::nanoseconds(FIFO_BYTES * BYTE_NS));
+    if ( aSize < 5 || memcmp(aBuffer, "log: ", 5) ) _lines++;   // drop reports are not messages
+    return aSize;
+  }
+  long lines() { std::lock_guard<std::mutex> lk(_mtx); return _lines; }
+  void reset() { std::lock_guard<std::mutex> lk(_mtx); _lines = 0; _empty = benchClock::now(); }
+
+private:
+  static const long long BYTE_NS = 1000000000LL * 10 / 115200;   // start, 8 data, stop bit
+  static const long long FIFO_BYTES = 128;
+  std::mutex              _mtx;
+  benchClock::time_point  _empty;   // when the FIFO has sent what it holds
+  long                    _lines = 0;
+};
+
+static SlowUart uart;
+static SimpleLog ringLog;
+
+// ==== The caller-side path before the ring: timestamp, vsnprintf, write ===================
+static void syncLog(const char* aFormat, ...) __attribute__ ((format (printf, 1, 2)));
+
+static void syncLog(const char* aFormat, ...) {
+  char line[LOG_LINE_MAX];
+  uint32_t mm = MILLIS_FUNCTION;
+  uint32_t s = mm / 1000;
+  uint32_t m = s / 60;
+  uint32_t h = m / 60;
+  int n = snprintf(line, sizeof(line), "%02u:%02u:%02u:%02u.%03u ", (unsigned) (h / 24), (unsigned) (h % 24),
+                   (unsigned) (m % 60), (unsigned) (s % 60), (unsigned) (mm % 1000));
+  va_list args;
+  va_start(args, aFormat);
+  n += vsnprintf(line + n, sizeof(line) - n, aFormat, args);
+  va_end(args);
+  uart.write((const uint8_t*) line, std::min(n, (int) sizeof(line) - 1));
+}
+
+typedef enum { PATH_SYNC, PATH_RING } logPath_t;
+
+// The streaming and camera messages, the way streamCB and camCB log them
+static void producer(logPath_t aPath, int aId, std::vector<long>* aLatency) {
+  benchClock::time_point next = benchClock::now();
+  for (int i = 0; i < messages; i++) {
+    int wait = 1000 + i % 700, stream = 20000 + aId * 100, size = 45000 + i;
+    float fps = 25.0f + (i % 10) / 10.0f;
+    benchClock::time_point t0 = benchClock::now();
+    if ( aPath == PATH_SYNC ) {
+      if ( i & 1 ) syncLog("streamCB: wait=%d us, stream=%d us, frame size=%d bytes, fps=%.2f\n", wait, stream, size, fps);
+      else syncLog("streamCB: Stream Task stack wtrmark  : %d\n", 2048 - aId);
+    }
+    else {
+      if ( i & 1 ) ringLog.notice("streamCB: wait=%d us, stream=%d us, frame size=%d bytes, fps=%.2f\n", wait, stream, size, fps);
+      else ringLog.trace("streamCB: Stream Task stack wtrmark  : %d\n", 2048 - aId);
+    }
+    aLatency->push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(benchClock::now() - t0).count());
+    next += std::chrono::microseconds(interval);
+    std::this_thread::sleep_until(next);
+  }
+}
+
+static void run(logPath_t aPath) {
+  std::vector<std::vector<long> > latency(producers);
+  std::vector<std::thread> threads;
+  uart.reset();
+  uint32_t dropped = ringLog.dropped();
+
+  benchClock::time_point t0 = benchClock::now();
+  for (int i = 0; i < producers; i++) {
+    latency[i].reserve(messages);
+    threads.push_back(std::thread(producer, aPath, i, &latency[i]));
+  }
+  for (size_t i = 0; i < threads.size(); i++) threads[i].join();
+  double seconds = std::chrono::duration<double>(benchClock::now() - t0).count();
+  if ( aPath == PATH_RING ) ringLog.flush();
+  dropped = ringLog.dropped() - dropped;
+
+  std::vector<long> all;
+  for (size_t i = 0; i < latency.size(); i++) all.insert(all.end(), latency[i].begin(), latency[i].end());
+  std::sort(all.begin(), all.end());
+  long sent = all.size();
+  printf("%-5s %8ld %8ld %8u %10.1f %10.1f %10.1f %8.2f\n", aPath == PATH_SYNC ? "sync" : "ring", sent,
+         uart.lines(), (unsigned) dropped, all[sent / 2] / 1000.0, all[sent * 99 / 100] / 1000.0,
+         all[sent - 1] / 1000.0, seconds);
+
+  if ( uart.lines() + (long) dropped != sent ) {
+    fail("%s: %ld messages, %ld written and %u dropped", aPath == PATH_SYNC ? "sync" : "ring", sent, uart.lines(), (unsigned) dropped);
+  }
+}
+
+// ==== Deferred formatting against printf ==================================================
+//  A ring slot holds what an earlier message left in it: string tags with the longest length
+static void stale(logRecord_t* r) {
+  for (size_t i = 0; i < sizeof(r->args); i++) r->args[i] = i % 2 ? 0xff : LOG_ARG_STRING;
+}
+
+template <typename... A>
+static void checkFormat(const char* aExpected, const char* aFormat, const A&... args) {
+  logRecord_t r;
+  stale(&r);
+  logArgs_t a = { r.args, r.args + sizeof(r.args), false };
+  logPack(&a, args...);
+  r.format = aFormat;
+  r.time = 90061001;   // 1 day, 1 hour, 1 minute, 1.001 s
+  r.size = a.pos - r.args;
+
+  char line[LOG_LINE_MAX];
+  String expected = String("01:01:01:01.001 ") + aExpected;
+  SimpleLog::format(&r, line, sizeof(line));
+  if ( expected != line ) fail("'%s' printed '%s', expected '%s'", aFormat, line, expected.c_str());
+}
+
+static void checkFormats() {
+  char pointer[32];
+  int local = 0;
+  snprintf(pointer, sizeof(pointer), "%p", (void*) &local);
+
+  checkFormat("-3 7 ff abc z 1.50    42|ab   |", "%d %u %x %s %c %.2f %5d|%-5s|", -3, 7u, 255u, "abc", 'z', 1.5, 42, "ab");
+  checkFormat("4000000000 -5 -1 18446744073709551615", "%lu %ld %lld %llu", (uint32_t) 4000000000u, -5L, (long long) -1,
+              (unsigned long long) -1);
+  checkFormat("-1 4294967295 ffffffff", "%d %u %x", -1, -1, -1);
+  checkFormat("    12|0007|", "%*d|%04d|", 6, 12, 7);
+  checkFormat("IP 10.0.0.7 up", "IP %p up", IPAddress(10, 0, 0, 7));
+  checkFormat(pointer, "%p", (void*) &local);
+  checkFormat("String camera, 100% done", "String %s, %d%% done", String("camera"), 100);
+  checkFormat("1 <?>", "%d %d", 1);
+  checkFormat("(null)", "%s", (const char*) NULL);
+
+  //  A string longer than the record is cut, not overrun
+  String longText;
+  for (int i = 0; i < 200; i++) longText += 'x';
+  logRecord_t r;
+  logArgs_t a = { r.args, r.args + sizeof(r.args), false };
+  logPack(&a, 1, longText);
+  if ( a.pos > a.end ) fail("argument copy ran %d bytes past the record", (int) (a.pos - a.end));
+
+  //  Arguments after one that does not fit are left out, the record ends at the last whole one
+  //  (a long /control variable name in "Camera control request: %s = %s (int: %d)")
+  String name;
+  for (int i = 0; i < 77; i++) name += 'v';
+  checkFormat((name + " = <?> (int: <?>)").c_str(), "%s = %s (int: %d)", name, "42", 42);
+  stale(&r);
+  a = (logArgs_t) { r.args, r.args + sizeof(r.args), false };
+  logPack(&a, name, "42", 42);
+  if ( a.pos != r.args + 2 + name.length() || !a.full ) fail("cut record: %d bytes used", (int) (a.pos - r.args));
+
+  //  Raw arguments that end inside a value, or a string length past the end, are not read beyond
+  char line[LOG_LINE_MAX];
+  uint8_t cut[] = { LOG_ARG_INT, 1, 2, 3 };
+  SimpleLog::formatMessage("%d", cut, sizeof(cut), line, sizeof(line));
+  if ( strcmp(line, "<?>") ) fail("value cut short printed '%s'", line);
+  uint8_t raw[2 + LOG_RECORD_ARGS];
+  memset(raw, 'y', sizeof(raw));
+  raw[0] = LOG_ARG_STRING;
+  raw[1] = 0xff;
+  size_t n = SimpleLog::formatMessage("%s", raw, sizeof(raw), line, sizeof(line));
+  if ( n != LOG_RECORD_ARGS - 1 ) fail("string length past the end printed %u characters", (unsigned) n);
+}
+
+// ==== Compiled out: verbose with LOG_LEVEL at trace =======================================
+static void timeDisabled() {
+  const long calls = 10000000;
+  volatile int sink = 0;
+  benchClock::time_point t0 = benchClock::now();
+  for (long i = 0; i < calls; i++) ringLog.verbose("mjpegCB: frame capture: %d us\n", (int) i);
+  double ns = std::chrono::duration<double, std::nano>(benchClock::now() - t0).count() / calls;
+  sink = ringLog.dropped();
+  (void) sink;
+  printf("disabled level: %.2f ns per call\n", ns);
+}
+
+int main(int argc, char** argv) {
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if ( !strcmp(argv[i], "--producers") ) producers = atoi(argv[i + 1]);
+    else if ( !strcmp(argv[i], "--messages") ) messages = atoi(argv[i + 1]);
+    else if ( !strcmp(argv[i], "--interval") ) interval = atoi(argv[i + 1]);
+    else {
+      fprintf(stderr, "usage: %s [--producers N] [--messages N] [--interval US]\n", argv[0]);
+      return 1;
+    }
+  }
+  if ( producers < 1 || messages < 1 ) return 1;
+
+  checkFormats();
+  timeDisabled();
+
+  printf("%d producers, %d messages each, one every %d us, UART at 115200 baud\n", producers, messages, interval);
+  printf("%-5s %8s %8s %8s %10s %10s %10s %8s\n", "path", "sent", "written", "dropped", "p50 us", "p99 us", "max us", "seconds");
+  run(PATH_SYNC);
+  ringLog.begin(LOG_LEVEL_TRACE, &uart);
+  run(PATH_RING);
+
+  printf("%s: %d failures\n", failures ? "FAIL" : "ok", failures);
+  return failures ? 1 : 0;
+}
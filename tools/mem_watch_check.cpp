@@ -0,0 +1,242 @@
+//  === Memory watch check ===========================================================================
+//  Feeds the memory pressure policy synthetic samples, one per MEM_WATCH_INTERVAL_MS, and checks:
+//    normal:    plenty of memory stays in the normal tier
+//    low:       memory below a low mark steps up one tier per MEM_TIER_HOLD_MS, up to refuse
+//    critical:  critical memory, or a new allocation failure, steps up at every sample; failures
+//               from before the watch started (boot) are not new
+//    band:      memory between the low mark and its margin holds the tier, neither up nor down
+//    recover:   one tier down per MEM_RECOVER_MS of calm, a short blip starts the calm over
+//    psram:     without PSRAM (size 0) the PSRAM figure is not watched
+//    restart:   only after refuse plus MEM_RESTART_MS of critical memory, never on low memory
+//    pacer:     the frame rate cap holds a pacer to the lower rate and lets go of it again
+//  Exits 1 on any failure.
+//
+//  Usage: mem-watch-check
+
+#include "Arduino.h"
+#include "mem_watch.h"
+#include "frame_pacer.h"
+
+static int failures = 0;
+static int checks = 0;
+
+static void fail(const char* aFormat, ...) __attribute__ ((format (printf, 1, 2)));
+
+static void fail(const char* aFormat, ...) {
+  va_list args;
+  va_start(args, aFormat);
+  printf("FAIL: ");
+  vprintf(aFormat, args);
+  printf("\n");
+  va_end(args);
+  failures++;
+}
+
+static void expectTier(const char* aCheck, const memWatch_t* w, memTier_t aTier) {
+  checks++;
+  if ( w->tier != aTier ) fail("%s: tier %s, expected %s", aCheck, memTierName(w->tier), memTierName(aTier));
+}
+
+// Samples: plenty of everything, low heap, critical largest block, the low/margin band
+static const memSample_t samplePlenty   = { 120 * 1024, 60 * 1024, 2 * 1024 * 1024, 4 * 1024 * 1024, 0 };
+static const memSample_t sampleLow      = { MEM_HEAP_LOW - 1024, 60 * 1024, 2 * 1024 * 1024, 4 * 1024 * 1024, 0 };
+static const memSample_t sampleCritical = { 120 * 1024, MEM_BLOCK_CRITICAL - 512, 2 * 1024 * 1024, 4 * 1024 * 1024, 0 };
+static const memSample_t sampleBand     = { MEM_HEAP_LOW + 1024, 60 * 1024, 2 * 1024 * 1024, 4 * 1024 * 1024, 0 };
+
+static uint32_t clockNow = 0;
+
+// aMs of samples of one kind, returns the times the tier changed
+static int run(memWatch_t* w, const memSample_t* s, uint32_t aMs) {
+  int changes = 0;
+  for (uint32_t t = 0; t < aMs; t += MEM_WATCH_INTERVAL_MS) {
+    clockNow += MEM_WATCH_INTERVAL_MS;
+    memTier_t from = w->tier;
+    if ( memWatchUpdate(w, s, clockNow) != from ) changes++;
+  }
+  return changes;
+}
+
+static void start(memWatch_t* w) {
+  clockNow = 1000;
+  memWatchInit(w, clockNow, 0);
+}
+
+static void checkNormal() {
+  memWatch_t w;
+  start(&w);
+  run(&w, &samplePlenty, 10 * MEM_RECOVER_MS);
+  expectTier("normal", &w, MEM_TIER_NORMAL);
+  checks++;
+  if ( w.transitions ) fail("normal: %u transitions", (unsigned) w.transitions);
+}
+
+static void checkLow() {
+  memWatch_t w;
+  start(&w);
+  run(&w, &sampleLow, MEM_TIER_HOLD_MS - MEM_WATCH_INTERVAL_MS);
+  expectTier("low before hold", &w, MEM_TIER_NORMAL);
+  run(&w, &sampleLow, MEM_WATCH_INTERVAL_MS);
+  expectTier("low after hold", &w, MEM_TIER_RING);
+  run(&w, &sampleLow, MEM_TIER_HOLD_MS);
+  expectTier("low second hold", &w, MEM_TIER_FPS);
+  run(&w, &sampleLow, 2 * MEM_TIER_HOLD_MS);
+  expectTier("low fourth hold", &w, MEM_TIER_REFUSE);
+  checks++;
+  if ( strcmp(w.reason, "free heap") ) fail("low: reason '%s', expected 'free heap'", w.reason);
+}
+
+static void checkCritical() {
+  memWatch_t w;
+  start(&w);
+  for (int i = MEM_TIER_RING; i <= MEM_TIER_REFUSE; i++) {
+    run(&w, &sampleCritical, MEM_WATCH_INTERVAL_MS);
+    expectTier("critical step", &w, (memTier_t) i);
+  }
+  checks++;
+  if ( strcmp(w.reason, "largest block") ) fail("critical: reason '%s', expected 'largest block'", w.reason);
+
+  //  A new allocation failure on plenty of memory: one step, not one per sample after it
+  start(&w);
+  memSample_t failed = samplePlenty;
+  failed.allocFailures = 3;
+  run(&w, &failed, MEM_WATCH_INTERVAL_MS);
+  expectTier("allocation failure", &w, MEM_TIER_RING);
+  run(&w, &failed, MEM_TIER_HOLD_MS);
+  expectTier("allocation failure, no new one", &w, MEM_TIER_RING);
+  checks++;
+  if ( strcmp(w.reason, "allocation failed") ) fail("allocation failure: reason '%s'", w.reason);
+
+  //  Two failures during boot, before the watch started: normal until a third one
+  clockNow = 1000;
+  memWatchInit(&w, clockNow, 2);
+  failed.allocFailures = 2;
+  run(&w, &failed, 10 * MEM_WATCH_INTERVAL_MS);
+  expectTier("boot failures", &w, MEM_TIER_NORMAL);
+  failed.allocFailures = 3;
+  run(&w, &failed, MEM_WATCH_INTERVAL_MS);
+  expectTier("failure after boot", &w, MEM_TIER_RING);
+}
+
+static void checkBand() {
+  memWatch_t w;
+  start(&w);
+  run(&w, &sampleCritical, 2 * MEM_WATCH_INTERVAL_MS);
+  expectTier("band setup", &w, MEM_TIER_FPS);
+  run(&w, &sampleBand, 4 * MEM_RECOVER_MS);
+  expectTier("band holds", &w, MEM_TIER_FPS);
+}
+
+static void checkRecover() {
+  memWatch_t w;
+  start(&w);
+  run(&w, &sampleCritical, 3 * MEM_WATCH_INTERVAL_MS);
+  expectTier("recover setup", &w, MEM_TIER_QUALITY);
+  run(&w, &samplePlenty, MEM_RECOVER_MS - MEM_WATCH_INTERVAL_MS);
+  expectTier("recover before calm", &w, MEM_TIER_QUALITY);
+  run(&w, &samplePlenty, MEM_WATCH_INTERVAL_MS);
+  expectTier("recover one step", &w, MEM_TIER_FPS);
+
+  //  A blip into the margin band halfway: the calm period starts over
+  run(&w, &samplePlenty, MEM_RECOVER_MS / 2);
+  run(&w, &sampleBand, MEM_WATCH_INTERVAL_MS);
+  run(&w, &samplePlenty, MEM_RECOVER_MS - MEM_WATCH_INTERVAL_MS);
+  expectTier("recover after blip, before calm", &w, MEM_TIER_FPS);
+  run(&w, &samplePlenty, MEM_WATCH_INTERVAL_MS);
+  expectTier("recover after blip", &w, MEM_TIER_RING);
+  run(&w, &samplePlenty, MEM_RECOVER_MS);
+  expectTier("recover to normal", &w, MEM_TIER_NORMAL);
+  checks++;
+  if ( w.worst != MEM_TIER_QUALITY ) fail("recover: worst %s, expected quality", memTierName(w.worst));
+}
+
+static void checkPsram() {
+  memWatch_t w;
+  memSample_t none = samplePlenty;
+  none.freePsram = 0;
+  none.psramSize = 0;
+  start(&w);
+  run(&w, &none, MEM_RECOVER_MS);
+  expectTier("no psram", &w, MEM_TIER_NORMAL);
+
+  memSample_t empty = samplePlenty;
+  empty.freePsram = MEM_PSRAM_CRITICAL - 1024;
+  start(&w);
+  run(&w, &empty, MEM_WATCH_INTERVAL_MS);
+  expectTier("psram critical", &w, MEM_TIER_RING);
+}
+
+static void checkRestart() {
+  memWatch_t w;
+  start(&w);
+  run(&w, &sampleLow, 20 * MEM_RESTART_MS);
+  expectTier("low never restarts", &w, MEM_TIER_REFUSE);
+
+  start(&w);
+  run(&w, &sampleCritical, 4 * MEM_WATCH_INTERVAL_MS);
+  expectTier("restart setup", &w, MEM_TIER_REFUSE);
+  //  Critical since the first sample, three intervals before refuse
+  run(&w, &sampleCritical, MEM_RESTART_MS - 5 * MEM_WATCH_INTERVAL_MS);
+  expectTier("restart before time", &w, MEM_TIER_REFUSE);
+  run(&w, &sampleLow, MEM_WATCH_INTERVAL_MS);
+  run(&w, &sampleCritical, MEM_RESTART_MS);
+  expectTier("restart, critical broken by a low sample", &w, MEM_TIER_REFUSE);
+  run(&w, &sampleCritical, MEM_WATCH_INTERVAL_MS);
+  expectTier("restart", &w, MEM_TIER_RESTART);
+  run(&w, &samplePlenty, 2 * MEM_RECOVER_MS);
+  expectTier("restart stays", &w, MEM_TIER_RESTART);
+}
+
+static void checkPacer() {
+  framePacer_t p;
+  const int64_t frame = 1000000 / 30;
+  int64_t now = 0;
+
+  //  Unpaced client at 30 fps camera rate: every frame, a third of them under a 10 fps cap
+  framePacerInit(&p, 0, now);
+  int sent = 0;
+  framePacerCap(&p, MEM_FPS_CAP);
+  for (int i = 0; i < 300; i++, now += frame) sent += framePacerTake(&p, now);
+  checks++;
+  if ( sent < 99 || sent > 101 ) fail("pacer: %d of 300 frames under a %d fps cap", sent, MEM_FPS_CAP);
+  framePacerCap(&p, 0);
+  sent = 0;
+  for (int i = 0; i < 300; i++, now += frame) sent += framePacerTake(&p, now);
+  checks++;
+  if ( sent != 300 ) fail("pacer: %d of 300 frames with the cap lifted", sent);
+
+  //  A client's own lower rate wins over the cap
+  framePacerInit(&p, 5, now);
+  framePacerCap(&p, MEM_FPS_CAP);
+  checks++;
+  if ( p.interval != 200000 ) fail("pacer: interval %u with own 5 fps under the cap", (unsigned) p.interval);
+
+  //  Lifting the cap on a long idle pacer lets no burst out
+  framePacerInit(&p, 20, now);
+  framePacerCap(&p, 2);
+  now += 10000000;
+  framePacerTake(&p, now);
+  framePacerCap(&p, 0);
+  sent = 0;
+  for (int i = 0; i < 3; i++) sent += framePacerTake(&p, now);
+  checks++;
+  if ( sent > 1 ) fail("pacer: %d frames back to back after the cap was lifted", sent);
+}
+
+int main(int argc, char** argv) {
+  (void) argv;
+  if ( argc > 1 ) {
+    fprintf(stderr, "usage: mem-watch-check\n");
+    return 1;
+  }
+  checkNormal();
+  checkLow();
+  checkCritical();
+  checkBand();
+  checkRecover();
+  checkPsram();
+  checkRestart();
+  checkPacer();
+
+  printf("%s: %d checks, %d failures\n", failures ? "FAIL" : "ok", checks, failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,275 @@
+//  === Metrics exposition check ======================================================================
+//  Renders /metrics with clients, pools, a task and latency samples in place and checks
+//    format:      every line ends in a newline; each family has "# HELP name text" then
+//                 "# TYPE name counter|gauge", once; samples carry the name of the family they
+//                 follow, label values are quoted, values are integers or fixed point decimals;
+//                 counters end in _total
+//    values:      known counters, a 64-bit byte count, a client's slot and address labels, a pool,
+//                 a task and latency quantiles come out as set
+//    short:       every buffer too small for the whole page gives 0 and nothing is written past it
+//    heap:        rendering makes no heap allocation at all (-Wl,--wrap=malloc)
+//  Exits 1 on any failure.
+//
+//  Usage: metrics-check
+
+#include "Arduino.h"
+#include "metrics.h"
+#include "streaming.h"
+#include "camera_settings.h"
+
+#include <new>
+
+extern "C" void* __real_malloc(size_t aSize);
+extern "C" void  __real_free(void* aPtr);
+extern "C" void* __real_calloc(size_t aCount, size_t aSize);
+extern "C" void* __real_realloc(void* aPtr, size_t aSize);
+
+static bool  counting = false;
+static long  allocs = 0;
+
+static void* track(void* aPtr) {
+  if ( counting ) allocs++;
+  return aPtr;
+}
+
+extern "C" void* __wrap_malloc(size_t aSize) { return track(__real_malloc(aSize)); }
+extern "C" void* __wrap_calloc(size_t aCount, size_t aSize) { return track(__real_calloc(aCount, aSize)); }
+extern "C" void* __wrap_realloc(void* aPtr, size_t aSize) { return track(__real_realloc(aPtr, aSize)); }
+extern "C" void  __wrap_free(void* aPtr) { __real_free(aPtr); }
+void* operator new(size_t aSize) {
+  void* p = track(__real_malloc(aSize ? aSize : 1));
+  if ( p == NULL ) throw std::bad_alloc();
+  return p;
+}
+void* operator new[](size_t aSize) { return operator new(aSize); }
+void operator delete(void* aPtr) noexcept { __real_free(aPtr); }
+void operator delete[](void* aPtr) noexcept { __real_free(aPtr); }
+
+//  Defined by main.cpp and streaming.cpp in the firmware
+TaskHandle_t tCam, tMjpeg, tStream;
+volatile uint32_t clientsConnected;
+
+static int failures = 0;
+static int checks = 0;
+
+static void fail(const char* aFormat, ...) __attribute__ ((format (printf, 1, 2)));
+
+static void fail(const char* aFormat, ...) {
+  va_list args;
+  va_start(args, aFormat);
+  printf("FAIL: ");
+  vprintf(aFormat, args);
+  printf("\n");
+  va_end(args);
+  failures++;
+}
+
+static char page[METRICS_BUFFER_SIZE];
+
+static void idleCB(void* pvParameters) {
+  (void) pvParameters;
+  for (;;) vTaskDelay(1000);
+}
+
+// ==== Known state for every part of the page ================================================
+static void setup() {
+  frameRingStats.published = 1234567;
+  frameRingStats.overruns = 3;
+  allocFailures = 2;
+  cameraSettingsStats.saves = 5;
+  clientsConnected = 1;
+
+  streamClient_t* c = &streamClients[1];
+  const uint8_t ip[] = { 192, 168, 1, 50 };
+  c->used = true;
+  memcpy(&c->ip, ip, 4);
+  c->sent = 4321;
+  c->bytes = 5000000000ull;
+  c->dropped = 17;
+
+  static memPool_t pool;
+  memPoolInit(&pool, "check", 64, 8, 8, false);
+  for (int i = 0; i < 3; i++) memPoolAlloc(&pool);
+
+  for (int i = 0; i < 1000; i++) histogramAdd(&streamLatency.grab, 120);
+  histogramAdd(&streamLatency.grab, 2500000);
+
+  xTaskCreate(idleCB, "idle", 4096, NULL, 1, &tCam);
+}
+
+// ==== Exposition format =====================================================================
+static bool isName(char c, bool aFirst) {
+  return isalpha((unsigned char) c) || c == '_' || (!aFirst && isdigit((unsigned char) c));
+}
+
+// Length of the metric or label name at p, 0 if there is none
+static size_t nameLength(const char* p) {
+  size_t n = 0;
+  while ( isName(p[n], n == 0) ) n++;
+  return n;
+}
+
+// Checks one sample line of family aFamily; returns a reason or NULL
+static const char* sample(const char* p, const char* aFamily) {
+  size_t n = nameLength(p);
+  if ( n == 0 ) return "no metric name";
+  if ( n != strlen(aFamily) || strncmp(p, aFamily, n) ) return "not in the family it follows";
+  p += n;
+  if ( *p == '{' ) {
+    do {
+      p++;
+      n = nameLength(p);
+      if ( n == 0 ) return "no label name";
+      p += n;
+      if ( *p++ != '=' || *p++ != '"' ) return "label value not quoted";
+      while ( *p && *p != '"' && *p != '\n' ) {
+        if ( *p == '\\' ) return "escape in a label value";
+        p++;
+      }
+      if ( *p++ != '"' ) return "label value not closed";
+    } while ( *p == ',' );
+    if ( *p++ != '}' ) return "labels not closed";
+  }
+  if ( *p++ != ' ' ) return "no space before the value";
+  if ( *p == '-' ) p++;
+  if ( !isdigit((unsigned char) *p) ) return "no value";
+  while ( isdigit((unsigned char) *p) ) p++;
+  if ( *p == '.' ) {
+    p++;
+    if ( !isdigit((unsigned char) *p) ) return "no digits after the decimal point";
+    while ( isdigit((unsigned char) *p) ) p++;
+  }
+  if ( *p != '\n' ) return "text after the value";
+  return NULL;
+}
+
+static void checkFormat(const char* aPage, size_t aLength) {
+  char help[128] = "", family[128] = "", seen[4096] = " ";
+  int families = 0, samples = 0, bad = 0;
+
+  checks++;
+  if ( aLength == 0 || aPage[aLength - 1] != '\n' ) fail("format: the page does not end in a newline");
+
+  for (const char* line = aPage; line < aPage + aLength; ) {
+    const char* end = (const char*) memchr(line, '\n', aPage + aLength - line);
+    if ( end == NULL ) break;
+    char text[256];
+    snprintf(text, sizeof(text), "%.*s", (int) (end - line), line);
+    const char* why = NULL;
+    char name[128], type[16];
+
+    if ( !strncmp(line, "# HELP ", 7) ) {
+      size_t n = nameLength(line + 7);
+      snprintf(help, sizeof(help), "%.*s", (int) n, line + 7);
+      if ( n == 0 || line[7 + n] != ' ' || line + 8 + n >= end ) why = "HELP without a name or text";
+    }
+    else if ( sscanf(text, "# TYPE %127s %15s", name, type) == 2 ) {
+      char key[132];
+      snprintf(key, sizeof(key), " %s ", name);
+      if ( strcmp(name, help) ) why = "TYPE not right after the HELP of its family";
+      else if ( strcmp(type, "counter") && strcmp(type, "gauge") ) why = "unknown type";
+      else if ( !strcmp(type, "counter") && (strlen(name) < 6 || strcmp(name + strlen(name) - 6, "_total")) ) {
+        why = "counter name without _total";
+      }
+      else if ( strstr(seen, key) ) why = "family declared twice";
+      else if ( strlen(seen) + strlen(key) < sizeof(seen) ) strcat(seen, key + 1);
+      snprintf(family, sizeof(family), "%s", name);
+      help[0] = 0;
+      families++;
+    }
+    else if ( line[0] == '#' ) why = "comment that is neither HELP nor TYPE";
+    else if ( family[0] == 0 ) why = "sample before any TYPE";
+    else {
+      why = sample(line, family);
+      samples++;
+    }
+    if ( why ) {
+      if ( bad++ < 5 ) fail("format: %s: \"%s\"", why, text);
+    }
+    line = end + 1;
+  }
+  checks++;
+  if ( bad > 5 ) fail("format: %d lines wrong in all", bad);
+  printf("format: %d families, %d samples, %u bytes of %d\n", families, samples, (unsigned) aLength, METRICS_BUFFER_SIZE);
+}
+
+// ==== Values =================================================================================
+static void expectLine(const char* aPage, const char* aLine) {
+  char want[256];
+  snprintf(want, sizeof(want), "\n%s\n", aLine);
+  checks++;
+  if ( strstr(aPage, want) == NULL ) fail("values: no line \"%s\"", aLine);
+}
+
+static void checkValues(const char* aPage) {
+  char line[160];
+  expectLine(aPage, "esp32cam_frames_captured_total 1234567");
+  expectLine(aPage, "esp32cam_frames_dropped_total{reason=\"ring\"} 3");
+  expectLine(aPage, "esp32cam_alloc_failures_total 2");
+  expectLine(aPage, "esp32cam_settings_saves_total 5");
+  expectLine(aPage, "esp32cam_bytes_sent_total 5000000000");
+  expectLine(aPage, "esp32cam_client_frames_sent_total{client=\"1\",ip=\"192.168.1.50\"} 4321");
+  expectLine(aPage, "esp32cam_client_bytes_sent_total{client=\"1\",ip=\"192.168.1.50\"} 5000000000");
+  expectLine(aPage, "esp32cam_client_frames_dropped_total{client=\"1\",ip=\"192.168.1.50\"} 17");
+  expectLine(aPage, "esp32cam_clients 1");
+  expectLine(aPage, "esp32cam_pool_blocks{pool=\"check\"} 8");
+  expectLine(aPage, "esp32cam_pool_blocks_used{pool=\"check\"} 3");
+  snprintf(line, sizeof(line), "esp32cam_task_stack_free_bytes{task=\"cam\"} %u", (unsigned) uxTaskGetStackHighWaterMark(tCam));
+  expectLine(aPage, line);
+  checks++;
+  if ( strstr(aPage, "{task=\"mjpeg\"}") ) fail("values: a task without a handle is listed");
+
+  uint32_t p50 = histogramPercentile(&streamLatency.grab, 0.5f);
+  snprintf(line, sizeof(line), "esp32cam_latency_seconds{stage=\"grab\",quantile=\"0.5\"} 0.%06u", (unsigned) p50);
+  expectLine(aPage, line);
+  expectLine(aPage, "esp32cam_latency_max_seconds{stage=\"grab\"} 2.500000");
+  expectLine(aPage, "esp32cam_latency_samples_total{stage=\"grab\"} 1001");
+  expectLine(aPage, "esp32cam_latency_samples_total{stage=\"send\"} 0");
+}
+
+// ==== Buffers too small ======================================================================
+static void checkShort(size_t aLength) {
+  static char small[METRICS_BUFFER_SIZE + 16];
+  int cut = 0, spilled = 0;
+  for (size_t size = 0; size <= aLength; size++) {
+    memset(small, '#', sizeof(small));
+    if ( metricsRender(small, size) != 0 ) cut++;
+    if ( small[size] != '#' ) spilled++;
+  }
+  checks++;
+  if ( cut ) fail("short: %d buffer sizes below %u bytes gave a page", cut, (unsigned) aLength + 1);
+  checks++;
+  if ( spilled ) fail("short: %d buffer sizes written past their end", spilled);
+  checks++;
+  if ( metricsRender(small, aLength + 1) != aLength ) fail("short: %u bytes do not hold the page", (unsigned) aLength + 1);
+}
+
+// ==== Heap ===================================================================================
+static void checkHeap() {
+  counting = true;
+  for (int i = 0; i < 100; i++) metricsRender(page, sizeof(page));
+  metricsRender(page, 100);
+  counting = false;
+  checks++;
+  if ( allocs ) fail("heap: %ld allocations over 101 renders", allocs);
+  printf("heap: %ld allocations over 101 renders\n", allocs);
+}
+
+int main(int argc, char** argv) {
+  (void) argv;
+  if ( argc > 1 ) {
+    fprintf(stderr, "usage: metrics-check\n");
+    return 1;
+  }
+  setup();
+  size_t n = metricsRender(page, sizeof(page));
+  checks++;
+  if ( n == 0 || n >= sizeof(page) || strlen(page) != n ) fail("render: %u bytes", (unsigned) n);
+  checkFormat(page, n);
+  checkValues(page);
+  checkShort(n);
+  checkHeap();
+
+  printf("%s: %d checks, %d failures\n", failures ? "FAIL" : "ok", checks, failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,375 @@
+//  === MJPEG streaming benchmark =====================================================================
+//  Opens a number of concurrent MJPEG clients against a running server - the host build
+//  (make native-run) or a device on the network - parses the multipart stream and reports per
+//  client: frame rate, inter-frame interval and jitter percentiles, throughput, time to first
+//  frame and frames skipped by the server (gaps in X-Frame-Number).
+//
+//  Usage: mjpeg-bench [--host H] [--port N] [--path P] [--clients N] [--seconds S]
+//                     [--format text|json|csv] [--out FILE] [--min-fps F]
+//    --path     stream to open, e.g. "/mjpeg/1?fps=5" (default /mjpeg/1)
+//    --min-fps  exit with status 3 if any client received fewer frames per second
+//  Jitter is the difference between consecutive inter-frame intervals (RFC 3550 style).
+
+#include <arpa/inet.h>
+#include <math.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef struct {
+  volatile int        sock;
+  double              start;      // connect started, s
+  double              first;      // first complete frame, s (0 = none)
+  double              last;       // last complete frame, s
+  uint32_t            frames;
+  uint64_t            bytes;
+  uint32_t            skipped;    // X-Frame-Number gaps
+  uint32_t            errors;
+  std::vector<double> gaps;       // inter-frame intervals, ms
+} benchClient_t;
+
+typedef struct {
+  double  p50;
+  double  p95;
+  double  p99;
+  double  max;
+} percentiles_t;
+
+static std::atomic<bool>  running(true);
+static const char*        host = "127.0.0.1";
+static int                port = 80;
+static const char*        path = "/mjpeg/1";
+
+static double now() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Nearest-rank percentiles of a sample
+static percentiles_t percentiles(std::vector<double> aSample) {
+  percentiles_t p = { 0, 0, 0, 0 };
+  if ( aSample.empty() ) return p;
+  std::sort(aSample.begin(), aSample.end());
+  const size_t n = aSample.size();
+  p.p50 = aSample[(n - 1) * 50 / 100];
+  p.p95 = aSample[(n - 1) * 95 / 100];
+  p.p99 = aSample[(n - 1) * 99 / 100];
+  p.max = aSample[n - 1];
+  return p;
+}
+
+static std::vector<double> jitter(const std::vector<double>& aGaps) {
+  std::vector<double> j;
+  for (size_t i = 1; i < aGaps.size(); i++) j.push_back(fabs(aGaps[i] - aGaps[i - 1]));
+  return j;
+}
+
+// ==== Buffered reader over a blocking socket ============================================
+class streamReader {
+public:
+  explicit streamReader(benchClient_t* aClient) : c(aClient), pos(0), len(0) {}
+
+  bool fill() {
+    if ( pos < len ) return true;
+    ssize_t r = recv(c->sock, buf, sizeof(buf), 0);
+    if ( r <= 0 ) return false;
+    pos = 0;
+    len = r;
+    c->bytes += r;
+    return true;
+  }
+
+  bool line(std::string& aLine) {
+    aLine.clear();
+    for (;;) {
+      if ( !fill() ) return false;
+      char ch = buf[pos++];
+      if ( ch == '\n' ) {
+        if ( !aLine.empty() && aLine[aLine.size() - 1] == '\r' ) aLine.resize(aLine.size() - 1);
+        return true;
+      }
+      if ( aLine.size() > 1024 ) return false;
+      aLine += ch;
+    }
+  }
+
+  // Keep only the first and last two bytes of the body: enough to check the JPEG markers
+  bool skip(size_t aSize, uint8_t aEnds[4]) {
+    for (size_t done = 0; done < aSize; ) {
+      if ( !fill() ) return false;
+      size_t n = std::min(aSize - done, len - pos);
+      for (size_t i = 0; i < n; i++) {
+        size_t at = done + i;
+        if ( at < 2 ) aEnds[at] = buf[pos + i];
+        if ( at >= aSize - 2 ) aEnds[2 + at - (aSize - 2)] = buf[pos + i];
+      }
+      pos += n;
+      done += n;
+    }
+    return true;
+  }
+
+private:
+  benchClient_t*  c;
+  size_t          pos;
+  size_t          len;
+  char            buf[32 * 1024];
+};
+
+static bool startsWith(const std::string& aLine, const char* aPrefix) {
+  return strncasecmp(aLine.c_str(), aPrefix, strlen(aPrefix)) == 0;
+}
+
+// ==== One client: connect, request the stream, time every complete part ==================
+static void clientLoop(benchClient_t* c) {
+  struct addrinfo hints, *ai = NULL;
+  char service[8];
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  snprintf(service, sizeof(service), "%d", port);
+
+  c->start = now();
+  if ( getaddrinfo(host, service, &hints, &ai) != 0 ) {
+    c->errors++;
+    return;
+  }
+  c->sock = socket(ai->ai_family, ai->ai_socktype, 0);
+  if ( c->sock < 0 || connect(c->sock, ai->ai_addr, ai->ai_addrlen) != 0 ) {
+    freeaddrinfo(ai);
+    c->errors++;
+    return;
+  }
+  freeaddrinfo(ai);
+
+  std::string req = std::string("GET ") + path + " HTTP/1.1\r\nHost: " + host + "\r\nConnection: close\r\n\r\n";
+  if ( send(c->sock, req.data(), req.size(), MSG_NOSIGNAL) != (ssize_t) req.size() ) {
+    c->errors++;
+    return;
+  }
+
+  streamReader rd(c);
+  std::string l, boundary;
+  unsigned long lastFnm = 0;
+
+  //  Status line and response header: the boundary comes from Content-Type
+  if ( !rd.line(l) || l.find(" 200") == std::string::npos ) {
+    c->errors++;
+    return;
+  }
+  for (;;) {
+    if ( !rd.line(l) ) return;
+    if ( l.empty() ) break;
+    size_t b = l.find("boundary=");
+    if ( startsWith(l, "Content-Type:") && b != std::string::npos ) boundary = "--" + l.substr(b + 9);
+  }
+  if ( boundary.empty() ) {
+    c->errors++;
+    return;
+  }
+
+  while ( running ) {
+    if ( !rd.line(l) ) break;
+    if ( l.empty() ) continue;
+    if ( l != boundary ) {
+      c->errors++;
+      break;
+    }
+    long clen = -1;
+    unsigned long fnm = 0;
+    for (;;) {
+      if ( !rd.line(l) ) return;
+      if ( l.empty() ) break;
+      if ( startsWith(l, "Content-Length:") ) clen = atol(l.c_str() + 15);
+      if ( startsWith(l, "X-Frame-Number:") ) fnm = strtoul(l.c_str() + 15, NULL, 10);
+    }
+    uint8_t ends[4];
+    if ( clen < 4 || !rd.skip(clen, ends) ) break;
+    if ( ends[0] != 0xff || ends[1] != 0xd8 || ends[2] != 0xff || ends[3] != 0xd9 ) c->errors++;
+
+    double t = now();
+    if ( c->frames ) c->gaps.push_back(1000.0 * (t - c->last));
+    else c->first = t;
+    c->last = t;
+    c->frames++;
+
+    //  Frames may be skipped but never repeated or reordered
+    if ( fnm && lastFnm ) {
+      if ( fnm <= lastFnm ) c->errors++;
+      else c->skipped += fnm - lastFnm - 1;
+    }
+    lastFnm = fnm;
+  }
+}
+
+// ==== Report ==============================================================================
+static double clientFps(const benchClient_t& c) {
+  return c.frames > 1 && c.last > c.first ? (c.frames - 1) / (c.last - c.first) : 0.0;
+}
+
+static double clientTtff(const benchClient_t& c) {
+  return c.frames ? 1000.0 * (c.first - c.start) : -1.0;
+}
+
+static void report(FILE* out, const char* aFormat, std::vector<benchClient_t>& aClients, double aSeconds) {
+  std::vector<double> allGaps;
+  uint64_t bytes = 0;
+  uint32_t frames = 0, skipped = 0, errors = 0;
+  double minFps = 1e9, maxTtff = 0;
+  for (size_t i = 0; i < aClients.size(); i++) {
+    const benchClient_t& c = aClients[i];
+    allGaps.insert(allGaps.end(), c.gaps.begin(), c.gaps.end());
+    bytes += c.bytes;
+    frames += c.frames;
+    skipped += c.skipped;
+    errors += c.errors;
+    minFps = std::min(minFps, clientFps(c));
+    maxTtff = std::max(maxTtff, clientTtff(c));
+  }
+  if ( aClients.empty() ) minFps = 0;
+  percentiles_t gap = percentiles(allGaps);
+  std::vector<double> allJitter;
+  for (size_t i = 0; i < aClients.size(); i++) {
+    std::vector<double> j = jitter(aClients[i].gaps);
+    allJitter.insert(allJitter.end(), j.begin(), j.end());
+  }
+  percentiles_t jit = percentiles(allJitter);
+
+  if ( !strcmp(aFormat, "csv") ) {
+    fprintf(out, "client,frames,fps,bytes_per_s,ttff_ms,skipped,errors,"
+                 "gap_p50_ms,gap_p95_ms,gap_p99_ms,gap_max_ms,jitter_p50_ms,jitter_p95_ms,jitter_p99_ms\n");
+    for (size_t i = 0; i < aClients.size(); i++) {
+      const benchClient_t& c = aClients[i];
+      percentiles_t g = percentiles(c.gaps);
+      percentiles_t j = percentiles(jitter(c.gaps));
+      fprintf(out, "%u,%u,%.2f,%.0f,%.1f,%u,%u,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f\n",
+              (unsigned) i, c.frames, clientFps(c), c.bytes / aSeconds, clientTtff(c), c.skipped, c.errors,
+              g.p50, g.p95, g.p99, g.max, j.p50, j.p95, j.p99);
+    }
+    return;
+  }
+
+  if ( !strcmp(aFormat, "json") ) {
+    fprintf(out, "{\"target\":\"%s:%d%s\",\"clients\":%u,\"seconds\":%.1f,\n", host, port, path,
+            (unsigned) aClients.size(), aSeconds);
+    fprintf(out, " \"summary\":{\"frames\":%u,\"minFps\":%.2f,\"bytesPerSecond\":%.0f,\"maxTtffMs\":%.1f,"
+                 "\"skipped\":%u,\"errors\":%u,\n", frames, minFps, bytes / aSeconds, maxTtff, skipped, errors);
+    fprintf(out, "  \"gapMs\":{\"p50\":%.2f,\"p95\":%.2f,\"p99\":%.2f,\"max\":%.2f},", gap.p50, gap.p95, gap.p99, gap.max);
+    fprintf(out, "\"jitterMs\":{\"p50\":%.2f,\"p95\":%.2f,\"p99\":%.2f,\"max\":%.2f}},\n", jit.p50, jit.p95, jit.p99, jit.max);
+    fprintf(out, " \"streams\":[");
+    for (size_t i = 0; i < aClients.size(); i++) {
+      const benchClient_t& c = aClients[i];
+      percentiles_t g = percentiles(c.gaps);
+      percentiles_t j = percentiles(jitter(c.gaps));
+      fprintf(out, "%s\n  {\"frames\":%u,\"fps\":%.2f,\"bytesPerSecond\":%.0f,\"ttffMs\":%.1f,\"skipped\":%u,\"errors\":%u,"
+                   "\"gapMs\":{\"p50\":%.2f,\"p95\":%.2f,\"p99\":%.2f,\"max\":%.2f},"
+                   "\"jitterMs\":{\"p50\":%.2f,\"p95\":%.2f,\"p99\":%.2f,\"max\":%.2f}}",
+              i ? "," : "", c.frames, clientFps(c), c.bytes / aSeconds, clientTtff(c), c.skipped, c.errors,
+              g.p50, g.p95, g.p99, g.max, j.p50, j.p95, j.p99, j.max);
+    }
+    fprintf(out, "]}\n");
+    return;
+  }
+
+  fprintf(out, "target             : %s:%d%s\n", host, port, path);
+  fprintf(out, "clients            : %u, %.1f s\n", (unsigned) aClients.size(), aSeconds);
+  fprintf(out, "client  frames    fps    KB/s  ttff ms  skipped  gap p50/p95/p99 ms    jitter p50/p95/p99 ms\n");
+  for (size_t i = 0; i < aClients.size(); i++) {
+    const benchClient_t& c = aClients[i];
+    percentiles_t g = percentiles(c.gaps);
+    percentiles_t j = percentiles(jitter(c.gaps));
+    fprintf(out, "%6u %7u %6.1f %7.0f %8.1f %8u  %5.1f/%5.1f/%5.1f     %5.1f/%5.1f/%5.1f%s\n",
+            (unsigned) i, c.frames, clientFps(c), c.bytes / aSeconds / 1024, clientTtff(c), c.skipped,
+            g.p50, g.p95, g.p99, j.p50, j.p95, j.p99, c.errors ? "  ERRORS" : "");
+  }
+  fprintf(out, "slowest client     : %.1f fps\n", minFps);
+  fprintf(out, "throughput         : %.0f KB/s total\n", bytes / aSeconds / 1024);
+  fprintf(out, "time to first frame: %.1f ms worst\n", maxTtff);
+  fprintf(out, "frame interval     : p50 %.1f  p95 %.1f  p99 %.1f  max %.1f ms\n", gap.p50, gap.p95, gap.p99, gap.max);
+  fprintf(out, "jitter             : p50 %.1f  p95 %.1f  p99 %.1f  max %.1f ms\n", jit.p50, jit.p95, jit.p99, jit.max);
+  fprintf(out, "frames skipped     : %u\n", skipped);
+  fprintf(out, "stream errors      : %u\n", errors);
+}
+
+static void usage(const char* name) {
+  fprintf(stderr, "usage: %s [--host H] [--port N] [--path P] [--clients N] [--seconds S] "
+                  "[--format text|json|csv] [--out FILE] [--min-fps F]\n", name);
+  exit(1);
+}
+
+int main(int argc, char** argv) {
+  int clients = 4;
+  double seconds = 10;
+  double minFps = 0;
+  const char* format = "text";
+  const char* outName = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    if ( i + 1 >= argc ) usage(argv[0]);
+    if ( !strcmp(argv[i], "--host") ) host = argv[++i];
+    else if ( !strcmp(argv[i], "--port") ) port = atoi(argv[++i]);
+    else if ( !strcmp(argv[i], "--path") ) path = argv[++i];
+    else if ( !strcmp(argv[i], "--clients") ) clients = atoi(argv[++i]);
+    else if ( !strcmp(argv[i], "--seconds") ) seconds = atof(argv[++i]);
+    else if ( !strcmp(argv[i], "--format") ) format = argv[++i];
+    else if ( !strcmp(argv[i], "--out") ) outName = argv[++i];
+    else if ( !strcmp(argv[i], "--min-fps") ) minFps = atof(argv[++i]);
+    else usage(argv[0]);
+  }
+  if ( clients < 1 || seconds <= 0 ) usage(argv[0]);
+  if ( strcmp(format, "text") && strcmp(format, "json") && strcmp(format, "csv") ) usage(argv[0]);
+  signal(SIGPIPE, SIG_IGN);
+
+  std::vector<benchClient_t> stats(clients);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < clients; i++) {
+    stats[i].sock = -1;
+    stats[i].start = stats[i].first = stats[i].last = 0;
+    stats[i].frames = stats[i].skipped = stats[i].errors = 0;
+    stats[i].bytes = 0;
+    threads.push_back(std::thread(clientLoop, &stats[i]));
+  }
+
+  //  Run for the set time, then unblock every reader
+  double t0 = now();
+  usleep((useconds_t) (seconds * 1e6));
+  running = false;
+  for (int i = 0; i < clients; i++) {
+    if ( stats[i].sock >= 0 ) shutdown(stats[i].sock, SHUT_RDWR);
+  }
+  for (size_t i = 0; i < threads.size(); i++) threads[i].join();
+  double elapsed = now() - t0;
+  for (int i = 0; i < clients; i++) {
+    if ( stats[i].sock >= 0 ) close(stats[i].sock);
+  }
+
+  FILE* out = stdout;
+  if ( outName && (out = fopen(outName, "w")) == NULL ) {
+    perror(outName);
+    return 1;
+  }
+  report(out, format, stats, elapsed);
+  if ( out != stdout ) fclose(out);
+
+  uint32_t errors = 0;
+  bool slow = false;
+  for (int i = 0; i < clients; i++) {
+    errors += stats[i].errors;
+    if ( clientFps(stats[i]) < minFps ) slow = true;
+  }
+  if ( errors ) return 2;
+  return slow ? 3 : 0;
+}
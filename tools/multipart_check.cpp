@@ -0,0 +1,101 @@
+//  === Multipart part header check ===================================================================
+//  Checks the part header mjpegPartHeader renders once per published frame:
+//    fields:   Content-Type, Content-Length, X-Timestamp (seconds.microseconds, zero-padded) and
+//              X-Frame-Number in that order, ending in a blank line; the return value is its length
+//    optional: frame 0 leaves out X-Frame-Number, no timestamp leaves out X-Timestamp
+//    limits:   the largest values fit in PART_HEADER_MAX
+//    short:    every buffer too small for the whole header gives 0, never a cut header
+//  Exits 1 on any failure.
+//
+//  Usage: multipart-check
+
+#include "Arduino.h"
+#include "multipart.h"
+
+static int failures = 0;
+static int checks = 0;
+
+static void fail(const char* aFormat, ...) __attribute__ ((format (printf, 1, 2)));
+
+static void fail(const char* aFormat, ...) {
+  va_list args;
+  va_start(args, aFormat);
+  printf("FAIL: ");
+  vprintf(aFormat, args);
+  printf("\n");
+  va_end(args);
+  failures++;
+}
+
+// Renders a header and compares it with the expected text, length included
+static void expectHeader(const char* aCheck, const char* aExpected, uint32_t aLength, uint32_t aFrame,
+                         const struct timeval* aTimestamp) {
+  char buf[PART_HEADER_MAX];
+  memset(buf, '#', sizeof(buf));
+  int n = mjpegPartHeader(buf, sizeof(buf), aLength, aFrame, aTimestamp);
+  checks++;
+  if ( n != (int) strlen(aExpected) || memcmp(buf, aExpected, n) ) {
+    fail("%s: got %d bytes \"%.*s\", expected %d bytes \"%s\"", aCheck, n, n > 0 ? n : 0, buf,
+         (int) strlen(aExpected), aExpected);
+  }
+}
+
+static void checkFields() {
+  struct timeval ts = { 1700000000, 42 };
+  expectHeader("all fields",
+               "Content-Type: image/jpeg\r\nContent-Length: 51234\r\n"
+               "X-Timestamp: 1700000000.000042\r\nX-Frame-Number: 7\r\n\r\n", 51234, 7, &ts);
+  expectHeader("no frame number",
+               "Content-Type: image/jpeg\r\nContent-Length: 51234\r\n"
+               "X-Timestamp: 1700000000.000042\r\n\r\n", 51234, 0, &ts);
+  expectHeader("no timestamp",
+               "Content-Type: image/jpeg\r\nContent-Length: 1\r\nX-Frame-Number: 4294967295\r\n\r\n", 1, 4294967295u, NULL);
+  expectHeader("length only", "Content-Type: image/jpeg\r\nContent-Length: 0\r\n\r\n", 0, 0, NULL);
+
+  //  CTNTTYPE is what the streaming code sends before a length it formats itself
+  checks++;
+  if ( cntLen != (int) strlen(CTNTTYPE) || strcmp(CTNTTYPE, "Content-Type: image/jpeg\r\nContent-Length: ") ) {
+    fail("CTNTTYPE \"%s\" or its length %d changed", CTNTTYPE, cntLen);
+  }
+}
+
+static void checkLimits() {
+  //  Longest header: 10 digit length and frame number, 10 digit seconds
+  struct timeval ts = { 4294967295u, 999999 };
+  char buf[PART_HEADER_MAX];
+  int n = mjpegPartHeader(buf, sizeof(buf), 4294967295u, 4294967295u, &ts);
+  checks++;
+  if ( n <= 0 || n >= PART_HEADER_MAX ) fail("limits: longest header gives %d in %d bytes", n, PART_HEADER_MAX);
+  else printf("limits: longest header %d of %d bytes\n", n, PART_HEADER_MAX);
+}
+
+static void checkShort() {
+  struct timeval ts = { 1700000000, 42 };
+  char buf[PART_HEADER_MAX];
+  int full = mjpegPartHeader(buf, sizeof(buf), 51234, 7, &ts);
+
+  //  The terminating zero needs a byte too: one short of full + 1 already cannot hold it
+  int cut = 0;
+  for (int size = 0; size <= full; size++) {
+    char small[PART_HEADER_MAX];
+    if ( mjpegPartHeader(small, size, 51234, 7, &ts) != 0 ) cut++;
+  }
+  checks++;
+  if ( cut ) fail("short: %d buffer sizes below %d bytes gave a header", cut, full + 1);
+  checks++;
+  if ( mjpegPartHeader(buf, full + 1, 51234, 7, &ts) != full ) fail("short: %d bytes do not hold the %d byte header", full + 1, full);
+}
+
+int main(int argc, char** argv) {
+  (void) argv;
+  if ( argc > 1 ) {
+    fprintf(stderr, "usage: multipart-check\n");
+    return 1;
+  }
+  checkFields();
+  checkLimits();
+  checkShort();
+
+  printf("%s: %d checks, %d failures\n", failures ? "FAIL" : "ok", checks, failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,200 @@
+//  === Page render benchmark =========================================================================
+//  Renders the control page both ways with the same settings and reports time, heap allocations
+//  and peak heap per page:
+//    legacy:   read data/index.html into a String byte by byte, replace every {{...}} over the whole
+//              page, then splice checked/selected attributes in with substring (old handleRoot).
+//              It stops adding " checked" after the first checked box, so its page is a little shorter
+//    compiled: pageRender() over the segments of include/index_page.h through a PAGE_BUFFER_SIZE buffer
+//  Heap use is tracked by replacing operator new/delete and wrapping malloc (-Wl,--wrap=malloc).
+//
+//  Usage: page-render-bench [--pages N] [--html data/index.html]
+
+#include "Arduino.h"
+#include "index_page.h"
+
+#include <malloc.h>
+#include <chrono>
+#include <new>
+
+extern "C" void* __real_malloc(size_t aSize);
+extern "C" void  __real_free(void* aPtr);
+
+static bool    counting = false;
+static long    allocs = 0;
+static size_t  live = 0;
+static size_t  peak = 0;
+
+static void* track(void* aPtr) {
+  if ( aPtr && counting ) {
+    allocs++;
+    live += malloc_usable_size(aPtr);
+    if ( live > peak ) peak = live;
+  }
+  return aPtr;
+}
+
+static void untrack(void* aPtr) {
+  if ( aPtr && counting ) {
+    size_t n = malloc_usable_size(aPtr);
+    live = live > n ? live - n : 0;
+  }
+}
+
+extern "C" void* __wrap_malloc(size_t aSize) { return track(__real_malloc(aSize)); }
+extern "C" void  __wrap_free(void* aPtr) { untrack(aPtr); __real_free(aPtr); }
+
+void* operator new(size_t aSize) {
+  void* p = track(__real_malloc(aSize ? aSize : 1));
+  if ( p == NULL ) throw std::bad_alloc();
+  return p;
+}
+void* operator new[](size_t aSize) { return operator new(aSize); }
+void operator delete(void* aPtr) noexcept { untrack(aPtr); __real_free(aPtr); }
+void operator delete[](void* aPtr) noexcept { operator delete(aPtr); }
+void operator delete(void* aPtr, size_t) noexcept { operator delete(aPtr); }
+void operator delete[](void* aPtr, size_t) noexcept { operator delete(aPtr); }
+
+//  Settings as the page would show them: non-defaults so every slot kind produces output
+static const struct { const char* name; int32_t value; } settings[] = {
+  { "QUALITY", 12 },     { "BRIGHTNESS", 1 },   { "CONTRAST", -1 },    { "SATURATION", 0 },
+  { "GAINCEILING", 3 },  { "COLORBAR", 0 },     { "AWB", 1 },          { "AGC", 1 },
+  { "AEC", 0 },          { "HMIRROR", 1 },      { "VFLIP", 0 },        { "AWB_GAIN", 1 },
+  { "AGC_GAIN", 5 },     { "AEC_VALUE", 300 },  { "AEC2", 0 },         { "DCW", 1 },
+  { "BPC", 0 },          { "WPC", 1 },          { "RAW_GMA", 1 },      { "LENC", 1 },
+  { "SPECIAL_EFFECT", 2 }, { "WB_MODE", 4 },    { "AE_LEVEL", -2 },
+};
+static const int32_t* compiledValues() {
+  static int32_t values[INDEX_VALUES];
+  values[INDEX_QUALITY] = 12;     values[INDEX_BRIGHTNESS] = 1;   values[INDEX_CONTRAST] = -1;
+  values[INDEX_SATURATION] = 0;   values[INDEX_GAINCEILING] = 3;  values[INDEX_COLORBAR] = 0;
+  values[INDEX_AWB] = 1;          values[INDEX_AGC] = 1;          values[INDEX_AEC] = 0;
+  values[INDEX_HMIRROR] = 1;      values[INDEX_VFLIP] = 0;        values[INDEX_AWB_GAIN] = 1;
+  values[INDEX_AGC_GAIN] = 5;     values[INDEX_AEC_VALUE] = 300;  values[INDEX_AEC2] = 0;
+  values[INDEX_DCW] = 1;          values[INDEX_BPC] = 0;          values[INDEX_WPC] = 1;
+  values[INDEX_RAW_GMA] = 1;      values[INDEX_LENC] = 1;         values[INDEX_SPECIAL_EFFECT] = 2;
+  values[INDEX_WB_MODE] = 4;      values[INDEX_AE_LEVEL] = -2;
+  return values;
+}
+
+// ==== The handler before the page was compiled ===========================================
+static void insertCheckedAttribute(String &html, const char* inputId, bool isChecked) {
+  if (!isChecked) return;
+  String idPattern = String("id='") + inputId + "'";
+  int idPos = html.indexOf(idPattern);
+  if (idPos < 0) return;
+  int tagEnd = html.indexOf('>', idPos);
+  if (tagEnd < 0) return;
+  String before = html.substring(0, tagEnd);
+  if (before.indexOf(" checked") >= 0) return;
+  html = before + " checked" + html.substring(tagEnd);
+}
+
+static void markSelectedOption(String &html, const char* selectId, int selectedValue) {
+  String idPattern = String("id='") + selectId + "'";
+  int selectStart = html.indexOf(idPattern);
+  if (selectStart < 0) return;
+  int blockEnd = html.indexOf("</select>", selectStart);
+  if (blockEnd < 0) return;
+  String block = html.substring(selectStart, blockEnd);
+  String valuePattern = String("value='") + String(selectedValue) + "'";
+  int valPos = block.indexOf(valuePattern);
+  if (valPos < 0) return;
+  if (block.indexOf(" selected", valPos) >= 0) return;
+  block.replace(valuePattern, valuePattern + " selected");
+  html = html.substring(0, selectStart) + block + html.substring(blockEnd);
+}
+
+static size_t renderLegacy(const char* aPath) {
+  FILE* f = fopen(aPath, "rb");
+  if ( f == NULL ) return 0;
+  fseek(f, 0, SEEK_END);
+  String html = String();
+  html.reserve(ftell(f));
+  fseek(f, 0, SEEK_SET);
+  int c;
+  while ( (c = fgetc(f)) != EOF ) html += (char) c;
+  fclose(f);
+
+  for (size_t i = 0; i < sizeof(settings) / sizeof(settings[0]); i++) {
+    html.replace(String("{{") + settings[i].name + "}}", String((int) settings[i].value));
+  }
+  String timestamp = String(millis());
+  html.replace("{{TIMESTAMP}}", timestamp);
+  html.replace("{{JS_VERSION}}", timestamp);
+
+  static const struct { const char* id; int32_t value; } checkboxes[] = {
+    { "colorbar", 0 }, { "awb", 1 }, { "agc", 1 }, { "aec", 0 }, { "hmirror", 1 }, { "vflip", 0 },
+    { "awb_gain", 1 }, { "aec2", 0 }, { "dcw", 1 }, { "bpc", 0 }, { "wpc", 1 }, { "raw_gma", 1 }, { "lenc", 1 } };
+  for (size_t i = 0; i < sizeof(checkboxes) / sizeof(checkboxes[0]); i++) {
+    insertCheckedAttribute(html, checkboxes[i].id, checkboxes[i].value == 1);
+  }
+  markSelectedOption(html, "gainceiling", 3);
+  markSelectedOption(html, "special_effect", 2);
+  markSelectedOption(html, "wb_mode", 4);
+
+  return html.length();
+}
+
+static void countChunk(void* aCtx, const char* aData, size_t aLen) {
+  (void) aData;
+  *(size_t*) aCtx += aLen;
+}
+
+typedef struct {
+  long    allocs;
+  size_t  peak;
+  size_t  bytes;
+  double  usec;
+} benchResult_t;
+
+template <typename F>
+static benchResult_t run(int aPages, F aRender) {
+  benchResult_t r = { 0, 0, 0, 0 };
+  auto t0 = std::chrono::steady_clock::now();
+  allocs = 0;
+  live = 0;
+  peak = 0;
+  counting = true;
+  for (int i = 0; i < aPages; i++) r.bytes = aRender();
+  counting = false;
+  r.allocs = allocs;
+  r.peak = peak;
+  r.usec = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+  return r;
+}
+
+static void report(const char* aName, const benchResult_t& aRes, int aPages, size_t aStack) {
+  printf("%-9s: %7.1f us/page, %6.1f allocations/page, %6u bytes peak heap, %5u bytes buffer, %u bytes\n",
+         aName, aRes.usec / aPages, aRes.allocs / (double) aPages, (unsigned) aRes.peak, (unsigned) aStack,
+         (unsigned) aRes.bytes);
+}
+
+int main(int argc, char** argv) {
+  int pages = 2000;
+  const char* path = "data/index.html";
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if ( !strcmp(argv[i], "--pages") ) pages = atoi(argv[i + 1]);
+    else if ( !strcmp(argv[i], "--html") ) path = argv[i + 1];
+    else {
+      fprintf(stderr, "usage: %s [--pages N] [--html data/index.html]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  if ( renderLegacy(path) == 0 ) {
+    fprintf(stderr, "cannot read %s\n", path);
+    return 1;
+  }
+  static char buf[PAGE_BUFFER_SIZE];
+  const int32_t* values = compiledValues();
+
+  printf("%d pages\n", pages);
+  report("legacy", run(pages, [&]() { return renderLegacy(path); }), pages, 0);
+  report("compiled", run(pages, [&]() {
+    size_t n = 0;
+    pageRender(indexPage, values, millis(), buf, sizeof(buf), countChunk, &n);
+    return n;
+  }), pages, sizeof(buf));
+  return 0;
+}
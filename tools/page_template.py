@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+#  === HTML page template compiler ===================================================================
+#  Splits a page into static text and typed slots so the firmware renders it in one pass:
+#    {{NAME}}                             value slot: the integer setting NAME
+#    {{TIMESTAMP}}, {{JS_VERSION}}        version slot: asset version for cache busting
+#    <input type='checkbox' id='x' ...>   checked slot before '>': " checked" if setting X is 1
+#    <select id='x'> <option value='n'    selected slot after the value: " selected" if X is n
+#  Setting names are the upper-cased element ids. The output is a header with the page segments
+#  and an enum of the settings it needs, in order of first use, with their names in lower case.
+#
+#  Usage: page_template.py [data/index.html [include/index_page.h]]
+#  Also runs as a PlatformIO pre-script (extra_scripts = pre:tools/page_template.py).
+
+import os
+import re
+import sys
+
+VERSION_SLOTS = ("TIMESTAMP", "JS_VERSION")
+
+PLACEHOLDER = re.compile(r"\{\{([A-Z0-9_]+)\}\}")
+CHECKBOX = re.compile(r"<input\b[^>]*\btype='checkbox'[^>]*>")
+ELEMENT_ID = re.compile(r"\bid='([A-Za-z0-9_]+)'")
+SELECT = re.compile(r"<select\b[^>]*\bid='([A-Za-z0-9_]+)'[^>]*>(.*?)</select>", re.S)
+OPTION_VALUE = re.compile(r"<option\b[^>]*?\bvalue='(-?[0-9]+)'")
+
+
+def slots(html):
+    """(offset, kind, name, arg) of every slot; placeholders are removed from the text"""
+    found = []
+    for m in PLACEHOLDER.finditer(html):
+        name = m.group(1)
+        kind = "PAGE_SLOT_VERSION" if name in VERSION_SLOTS else "PAGE_SLOT_VALUE"
+        found.append((m.start(), m.end(), kind, name, 0))
+    for m in CHECKBOX.finditer(html):
+        el = ELEMENT_ID.search(m.group(0))
+        if el:
+            found.append((m.end() - 1, m.end() - 1, "PAGE_SLOT_CHECKED", el.group(1).upper(), 0))
+    for m in SELECT.finditer(html):
+        for o in OPTION_VALUE.finditer(m.group(2)):
+            at = m.start(2) + o.end()
+            found.append((at, at, "PAGE_SLOT_SELECTED", m.group(1).upper(), int(o.group(1))))
+    return sorted(found, key=lambda s: s[0])
+
+
+def literal(text):
+    """C string literal, one source line per line of text"""
+    out = []
+    for line in text.splitlines(True):
+        s = line.replace("\\", "\\\\").replace('"', '\\"').replace("\t", "\\t")
+        s = s.replace("\r", "\\r").replace("\n", "\\n")
+        s = s.replace("??", "?\\?")
+        out.append('"%s"' % s)
+    return "\n    ".join(out) if out else '""'
+
+
+def compile_page(src, dst, root="."):
+    with open(src, encoding="utf-8") as f:
+        html = f.read()
+    name = os.path.splitext(os.path.basename(src))[0]
+
+    found = slots(html)
+    values = []
+    for s in found:
+        if s[2] != "PAGE_SLOT_VERSION" and s[3] not in values:
+            values.append(s[3])
+    undefined = [s[3] for s in found if s[2] in ("PAGE_SLOT_CHECKED", "PAGE_SLOT_SELECTED")
+                 and not any(p[2] == "PAGE_SLOT_VALUE" and p[3] == s[3] for p in found)]
+    if undefined:
+        raise SystemExit("%s: controls without a {{...}} value: %s" % (src, ", ".join(sorted(set(undefined)))))
+
+    prefix = name.upper()
+    out = []
+    out.append("#pragma once")
+    out.append("//  Generated by tools/page_template.py from %s - do not edit." % os.path.relpath(src, root).replace(os.sep, "/"))
+    out.append("//  Static text and typed slots of the page, rendered by pageRender().")
+    out.append("")
+    out.append('#include "page_template.h"')
+    out.append("")
+    out.append("// Settings the page shows, index into the values passed to pageRender()")
+    out.append("typedef enum {")
+    for v in values:
+        out.append("  %s_%s," % (prefix, v))
+    out.append("  %s_VALUES" % prefix)
+    out.append("} %sValue_t;" % name)
+    out.append("")
+    out.append("// Names of the settings: the element ids, lower case")
+    out.append("static const char* const %sValueNames[%s_VALUES] = {" % (name, prefix))
+    for v in values:
+        out.append('  "%s",' % v.lower())
+    out.append("};")
+    out.append("")
+
+    segments = []
+    pos = 0
+    for i, (start, end, kind, slot, arg) in enumerate(found):
+        text = html[pos:start]
+        out.append("static const char %sText%d[] PROGMEM =\n    %s;" % (name, i, literal(text)))
+        value = "%s_%s" % (prefix, slot) if kind != "PAGE_SLOT_VERSION" else "0"
+        segments.append("  { %sText%d, %d, %s, %s, %d }," % (name, i, len(text.encode("utf-8")), kind, value, arg))
+        pos = end
+    text = html[pos:]
+    out.append("static const char %sText%d[] PROGMEM =\n    %s;" % (name, len(found), literal(text)))
+    segments.append("  { %sText%d, %d, PAGE_SLOT_END, 0, 0 }," % (name, len(found), len(text.encode("utf-8"))))
+    out.append("")
+    out.append("static const pageSegment_t %sPage[] = {" % name)
+    out.extend(segments)
+    out.append("};")
+    out.append("")
+
+    result = "\n".join(out)
+    if os.path.exists(dst):
+        with open(dst, encoding="utf-8") as f:
+            if f.read() == result:
+                return
+    with open(dst, "w", encoding="utf-8") as f:
+        f.write(result)
+    print("page_template: %s -> %s (%d slots, %d settings)" % (src, dst, len(found), len(values)))
+
+
+def main(argv, root="."):
+    src = argv[1] if len(argv) > 1 else os.path.join(root, "data", "index.html")
+    dst = argv[2] if len(argv) > 2 else os.path.join(root, "include", "index_page.h")
+    compile_page(src, dst, root)
+
+
+try:
+    Import("env")  # noqa: F821 - defined when PlatformIO runs this as an extra script
+    main([], env.subst("$PROJECT_DIR"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        main(sys.argv)
@@ -0,0 +1,159 @@
+//  === Part write benchmark ==========================================================================
+//  Sends the same frames over a loopback socket two ways and counts, per frame, the heap
+//  allocations, user-space bytes copied and send calls on the sending thread:
+//    assembled: malloc a buffer, copy header, JPEG and boundary into it, one send (old streamCB OPTION2)
+//    separate:  header, JPEG and boundary in three sends (streamCB on WiFiClient::write)
+//    vectored:  mjpegPartSend() straight from the header buffer, the frame and BOUNDARY
+//  Allocations are counted by wrapping malloc (linked with -Wl,--wrap=malloc).
+//
+//  Usage: part-write-bench [--frames N] [--size BYTES]
+
+#include "Arduino.h"
+#include "multipart.h"
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <thread>
+
+extern "C" void* __real_malloc(size_t aSize);
+
+static thread_local bool  counting = false;
+static thread_local long  allocs = 0;
+
+extern "C" void* __wrap_malloc(size_t aSize) {
+  if ( counting ) allocs++;
+  return __real_malloc(aSize);
+}
+
+static void drain(int aSock) {
+  static char buf[256 * 1024];
+  while ( recv(aSock, buf, sizeof(buf), 0) > 0 ) {}
+}
+
+typedef struct {
+  long    allocs;
+  double  copied;
+  long    sends;
+  double  usec;
+} benchResult_t;
+
+static bool sendAll(int aSock, const void* aData, size_t aSize, benchResult_t& aRes) {
+  const char* p = (const char*) aData;
+  while ( aSize ) {
+    ssize_t w = send(aSock, p, aSize, 0);
+    aRes.sends++;
+    if ( w <= 0 ) return false;
+    p += w;
+    aSize -= w;
+  }
+  return true;
+}
+
+static benchResult_t runAssembled(int aSock, const uint8_t* aFrame, size_t aSize, int aFrames) {
+  benchResult_t r = { 0, 0, 0, 0 };
+  char hdr[PART_HEADER_MAX];
+  auto t0 = std::chrono::steady_clock::now();
+
+  allocs = 0;
+  counting = true;
+  for (int i = 0; i < aFrames; i++) {
+    int n = snprintf(hdr, sizeof(hdr), "%u\r\n\r\n", (unsigned int) aSize);
+    size_t len = cntLen + n + aSize + bdrLen;
+    char* buf = (char*) malloc(len);
+    memcpy(buf, CTNTTYPE, cntLen);
+    memcpy(buf + cntLen, hdr, n);
+    memcpy(buf + cntLen + n, aFrame, aSize);
+    memcpy(buf + cntLen + n + aSize, BOUNDARY, bdrLen);
+    r.copied += len;
+    sendAll(aSock, buf, len, r);
+    free(buf);
+  }
+  counting = false;
+
+  r.allocs = allocs;
+  r.usec = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+  return r;
+}
+
+static benchResult_t runSeparate(int aSock, const uint8_t* aFrame, size_t aSize, int aFrames) {
+  benchResult_t r = { 0, 0, 0, 0 };
+  char hdr[PART_HEADER_MAX];
+  auto t0 = std::chrono::steady_clock::now();
+
+  allocs = 0;
+  counting = true;
+  for (int i = 0; i < aFrames; i++) {
+    int n = mjpegPartHeader(hdr, sizeof(hdr), aSize);
+    sendAll(aSock, hdr, n, r) && sendAll(aSock, aFrame, aSize, r) && sendAll(aSock, BOUNDARY, bdrLen, r);
+  }
+  counting = false;
+
+  r.allocs = allocs;
+  r.usec = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+  return r;
+}
+
+static benchResult_t runVectored(int aSock, const uint8_t* aFrame, size_t aSize, int aFrames) {
+  benchResult_t r = { 0, 0, 0, 0 };
+  char hdr[PART_HEADER_MAX];
+  auto t0 = std::chrono::steady_clock::now();
+
+  allocs = 0;
+  counting = true;
+  for (int i = 0; i < aFrames; i++) {
+    int n = mjpegPartHeader(hdr, sizeof(hdr), aSize);
+    const size_t total = n + aSize + bdrLen;
+    for (size_t off = 0; off < total; ) {
+      int w = mjpegPartSend(aSock, hdr, n, aFrame, aSize, off, 0);
+      r.sends++;
+      if ( w <= 0 ) break;
+      off += w;
+    }
+  }
+  counting = false;
+
+  r.allocs = allocs;
+  r.usec = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+  return r;
+}
+
+static void report(const char* aName, const benchResult_t& aRes, int aFrames) {
+  printf("%-10s: %5.2f allocations/frame, %8.0f bytes copied/frame, %5.2f sends/frame, %6.1f us/frame\n", aName,
+         aRes.allocs / (double) aFrames, aRes.copied / aFrames, aRes.sends / (double) aFrames, aRes.usec / aFrames);
+}
+
+int main(int argc, char** argv) {
+  int frames = 2000;
+  size_t size = 48 * 1024;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if ( !strcmp(argv[i], "--frames") ) frames = atoi(argv[i + 1]);
+    else if ( !strcmp(argv[i], "--size") ) size = atol(argv[i + 1]);
+    else {
+      fprintf(stderr, "usage: %s [--frames N] [--size BYTES]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  int sv[2];
+  if ( socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0 ) {
+    perror("socketpair");
+    return 1;
+  }
+  std::thread(drain, sv[1]).detach();
+
+  uint8_t* frame = (uint8_t*) malloc(size);
+  for (size_t i = 0; i < size; i++) frame[i] = (uint8_t) i;
+
+  printf("%d frames of %u bytes\n", frames, (unsigned int) size);
+  report("assembled", runAssembled(sv[0], frame, size, frames), frames);
+  report("separate", runSeparate(sv[0], frame, size, frames), frames);
+  report("vectored", runVectored(sv[0], frame, size, frames), frames);
+
+  close(sv[0]);
+  free(frame);
+  return 0;
+}
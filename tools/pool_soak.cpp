@@ -0,0 +1,319 @@
+//  === Memory pool soak ==============================================================================
+//  Runs millions of connect / frame / disconnect cycles with heap use tracked (-Wl,--wrap=malloc),
+//  both ways:
+//    legacy:   a new streamInfo_t and WiFiClient per connection, and a ring slot buffer freed and
+//              allocated again whenever a frame is larger than it (allocateMemory before the pools)
+//    pools:    connection records from a client pool, frames through frameRingReserve() into slot
+//              buffers of the frame pool, clients taking and dropping references on the frames
+//  Every cycle one client disconnects and a new one connects, then a few frames of random size
+//  are published to all of them; every other client keeps its frame over the next publish.
+//  Checks that the pools
+//    - make no heap allocation at all after the first cycle, so the heap cannot fragment
+//    - get every client record back and never run out of frame buffers
+//    - refuse and count the allocation beyond the last block, ignore double and foreign frees
+//    - drop and count a frame larger than a slot buffer
+//  Exits 1 on any failure.
+//
+//  Usage: pool-soak [--cycles N] [--frames N] [--clients N] [--seed N]
+
+#include "Arduino.h"
+#include "frame_ring.h"
+#include "streaming.h"
+
+#include <malloc.h>
+#include <chrono>
+#include <new>
+#include <vector>
+
+extern "C" void* __real_malloc(size_t aSize);
+extern "C" void  __real_free(void* aPtr);
+extern "C" void* __real_calloc(size_t aCount, size_t aSize);
+
+static bool    counting = false;
+static long    allocs = 0;
+static size_t  live = 0;
+static size_t  peak = 0;
+
+static void* track(void* aPtr) {
+  if ( aPtr && counting ) {
+    allocs++;
+    live += malloc_usable_size(aPtr);
+    if ( live > peak ) peak = live;
+  }
+  return aPtr;
+}
+
+static void untrack(void* aPtr) {
+  if ( aPtr && counting ) {
+    size_t n = malloc_usable_size(aPtr);
+    live = live > n ? live - n : 0;
+  }
+}
+
+extern "C" void* __wrap_malloc(size_t aSize) { return track(__real_malloc(aSize)); }
+extern "C" void* __wrap_calloc(size_t aCount, size_t aSize) { return track(__real_calloc(aCount, aSize)); }
+extern "C" void  __wrap_free(void* aPtr) { untrack(aPtr); __real_free(aPtr); }
+void* operator new(size_t aSize) {
+  void* p = track(__real_malloc(aSize ? aSize : 1));
+  if ( p == NULL ) throw std::bad_alloc();
+  return p;
+}
+void operator delete(void* aPtr) noexcept { untrack(aPtr); __real_free(aPtr); }
+
+// The sensor's largest JPEG at HD: what the firmware sizes its slot buffers to
+#define SOAK_SLOT_SIZE  (1280 * 720 / 5)
+
+static int failures = 0;
+static int checks = 0;
+
+static void fail(const char* aFormat, ...) __attribute__ ((format (printf, 1, 2)));
+
+static void fail(const char* aFormat, ...) {
+  va_list args;
+  va_start(args, aFormat);
+  printf("FAIL: ");
+  vprintf(aFormat, args);
+  printf("\n");
+  va_end(args);
+  failures++;
+}
+
+static void expect(bool aOk, const char* aWhat) {
+  checks++;
+  if ( !aOk ) fail("%s", aWhat);
+}
+
+// JPEG sizes of a busy scene: mostly 30-70 KB, now and then a larger one
+static uint32_t seed = 1;
+
+static size_t frameSize() {
+  seed = seed * 1103515245u + 12345u;
+  uint32_t r = (seed >> 8) & 0xFFFF;
+  if ( r % 997 == 0 ) return SOAK_SLOT_SIZE / 2 + r % (SOAK_SLOT_SIZE / 2);
+  return 30 * 1024 + r % (40 * 1024);
+}
+
+typedef struct {
+  long    allocs;
+  size_t  warm;     // heap in use after the first cycle
+  size_t  end;      // heap in use after the last cycle
+  size_t  peak;
+  double  usec;
+} soakResult_t;
+
+static void report(const char* aName, const soakResult_t& r, long aCycles) {
+  printf("%-7s: %6.2f allocations/cycle, heap in use %7u bytes after the first cycle, %7u at the end, "
+         "%7u peak, %.2f us/cycle\n", aName, r.allocs / (double) aCycles, (unsigned) r.warm, (unsigned) r.end,
+         (unsigned) r.peak, r.usec / aCycles);
+}
+
+// ==== Before the pools ======================================================================
+static soakResult_t soakLegacy(long aCycles, int aFrames, int aClients) {
+  std::vector<streamInfo_t*> clients;
+  std::vector<uint8_t*> slots(aClients + 2, (uint8_t*) NULL);
+  std::vector<size_t> caps(aClients + 2, 0);
+  size_t next = 0;
+  soakResult_t r;
+
+  allocs = 0;
+  live = peak = 0;
+  counting = true;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (long c = 0; c < aCycles; c++) {
+    if ( (int) clients.size() >= aClients ) {
+      streamInfo_t* info = clients.front();
+      clients.erase(clients.begin());
+      delete info->client;
+      delete info;
+    }
+    streamInfo_t* info = new streamInfo_t;
+    info->client = new WiFiClient();
+    clients.push_back(info);
+
+    for (int f = 0; f < aFrames; f++) {
+      size_t s = frameSize();
+      size_t i = next++ % slots.size();
+      if ( s > caps[i] ) {
+        free(slots[i]);
+        slots[i] = (uint8_t*) malloc(s);
+        caps[i] = s;
+      }
+      slots[i][0] = 0xFF;
+    }
+    if ( c == 0 ) r.warm = live;
+  }
+  r.usec = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  r.end = live;
+  r.allocs = allocs;
+  r.peak = peak;
+  counting = false;
+
+  for (size_t i = 0; i < clients.size(); i++) {
+    delete clients[i]->client;
+    delete clients[i];
+  }
+  for (size_t i = 0; i < slots.size(); i++) free(slots[i]);
+  return r;
+}
+
+// ==== From the pools, through the frame ring =================================================
+static memPool_t pool;   // the firmware's client pool lives in streaming.cpp
+
+static streamConn_t* connOpen() {
+  void* block = memPoolAlloc(&pool);
+  return block ? new (block) streamConn_t() : NULL;
+}
+
+static void connClose(streamConn_t* aConn) {
+  aConn->~streamConn_t();
+  memPoolFree(&pool, aConn);
+}
+
+typedef struct {
+  streamConn_t*   conn;
+  frameChunck_t*  held;
+} soakClient_t;
+
+static void publish() {
+  frameChunck_t* f = frameRingReserve(frameSize());
+  if ( f == NULL ) return;
+  f->dat[0] = 0xFF;
+  f->siz = 1;
+  frameRingPublish(f);
+}
+
+// Every client moves on to the newest frame; the odd ones only every other publish
+static void serve(std::vector<soakClient_t>& aClients, int aFrame) {
+  for (size_t i = 0; i < aClients.size(); i++) {
+    soakClient_t& c = aClients[i];
+    if ( c.held && (i % 2 == 0 || aFrame % 2 == 0) ) {
+      c.conn->info.frame = c.held->fnm;
+      frameRingRelease(c.held);
+      c.held = NULL;
+    }
+    if ( c.held == NULL ) c.held = frameRingAcquire(c.conn->info.frame);
+  }
+}
+
+static soakResult_t soakPools(long aCycles, int aFrames, int aClients) {
+  std::vector<soakClient_t> clients;
+  clients.reserve(aClients);
+  soakResult_t r;
+  long warmAllocs = 0;
+
+  allocs = 0;
+  live = peak = 0;
+  counting = true;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (long c = 0; c < aCycles; c++) {
+    if ( (int) clients.size() >= aClients ) {
+      soakClient_t& old = clients.front();
+      if ( old.held ) frameRingRelease(old.held);
+      connClose(old.conn);
+      clients.erase(clients.begin());
+    }
+    soakClient_t n = { connOpen(), NULL };
+    if ( n.conn == NULL ) {
+      fail("pools: no client record for client %u at cycle %ld", (unsigned) clients.size(), c);
+      break;
+    }
+    n.conn->info.frame = frameNumber;
+    clients.push_back(n);
+
+    for (int f = 0; f < aFrames; f++) {
+      publish();
+      serve(clients, f);
+    }
+    if ( c == 0 ) {
+      r.warm = live;
+      warmAllocs = allocs;
+    }
+  }
+  r.usec = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  r.end = live;
+  r.allocs = allocs;
+  r.peak = peak;
+  long after = allocs - warmAllocs;
+  counting = false;
+
+  char what[128];
+  snprintf(what, sizeof(what), "pools: %ld heap allocations after the first cycle", after);
+  expect(r.end == r.warm && after == 0, what);
+  expect(frameRingStats.overruns == 0 && framePool.failures == 0, "pools: a frame found no free slot or buffer");
+  expect(pool.peak <= aClients && pool.used == clients.size(), "pools: client records in use do not match the clients");
+
+  for (size_t i = 0; i < clients.size(); i++) {
+    if ( clients[i].held ) frameRingRelease(clients[i].held);
+    connClose(clients[i].conn);
+  }
+  expect(pool.used == 0, "pools: client records left in use");
+  expect(framePool.used <= framePool.blocks && framePool.invalid == 0 && pool.invalid == 0, "pools: blocks freed twice");
+  printf("pools  : %u bytes carved at init; frame pool %u of %u blocks used, %u peak; client pool %u of %u peak; "
+         "%u frames published\n", (unsigned) (framePool.blocks * framePool.size + pool.blocks * pool.size),
+         (unsigned) framePool.used, (unsigned) framePool.blocks, (unsigned) framePool.peak, (unsigned) pool.peak,
+         (unsigned) pool.blocks, (unsigned) frameRingStats.published);
+  return r;
+}
+
+// ==== Limits of a pool =======================================================================
+static void checkLimits() {
+  memPool_t p;
+  expect(memPoolInit(&p, "check", 100, 3, 1, ANY_MEMORY), "limits: no pool");
+  expect(p.size == 104, "limits: block size not rounded up to 8");
+  void* a = memPoolAlloc(&p);
+  void* b = memPoolAlloc(&p);
+  void* c = memPoolAlloc(&p);
+  expect(a && b && c && a != b && b != c && a != c, "limits: three distinct blocks");
+  expect(memPoolAlloc(&p) == NULL && p.failures == 1, "limits: a fourth block handed out or not counted");
+
+  memPoolFree(&p, b);
+  memPoolFree(&p, b);
+  memPoolFree(&p, (uint8_t*) a + 1);
+  static uint8_t other[8];
+  memPoolFree(&p, other);
+  memPoolFree(&p, NULL);
+  expect(p.invalid == 3 && p.used == 2, "limits: double, misaligned or foreign free not ignored");
+  expect(memPoolAlloc(&p) == b, "limits: the freed block is not handed out again");
+  expect(p.peak == 3 && p.allocs == 4, "limits: peak or allocations wrong");
+
+  uint32_t before = frameRingStats.oversize;
+  expect(frameRingReserve(framePool.size + 1) == NULL && frameRingStats.oversize == before + 1,
+         "limits: a frame larger than a slot buffer not dropped");
+}
+
+int main(int argc, char** argv) {
+  long cycles = 1000000;
+  int frames = 3;
+  int clients = 6;
+
+  for (int i = 1; i < argc; i++) {
+    if ( i + 1 >= argc ) clients = -1;
+    else if ( !strcmp(argv[i], "--cycles") ) cycles = atol(argv[++i]);
+    else if ( !strcmp(argv[i], "--frames") ) frames = atoi(argv[++i]);
+    else if ( !strcmp(argv[i], "--clients") ) clients = atoi(argv[++i]);
+    else if ( !strcmp(argv[i], "--seed") ) seed = atoi(argv[++i]);
+    else clients = -1;
+  }
+  if ( cycles < 1 || frames < 1 || clients < 1 || clients > 64 ) {
+    fprintf(stderr, "usage: %s [--cycles N] [--frames N] [--clients 1..64] [--seed N]\n", argv[0]);
+    return 1;
+  }
+
+  //  Ring and pools are carved once, as at boot
+  if ( !frameRingInit(clients + 2, SOAK_SLOT_SIZE) || !memPoolInit(&pool, "client", sizeof(streamConn_t), clients, 1, ANY_MEMORY) ) {
+    fprintf(stderr, "cannot set up the ring and pools\n");
+    return 1;
+  }
+
+  printf("%ld cycles of %d frames, %d clients\n", cycles, frames, clients);
+  uint32_t first = seed;
+  soakResult_t legacy = soakLegacy(cycles, frames, clients);
+  seed = first;
+  soakResult_t pools = soakPools(cycles, frames, clients);
+  report("legacy", legacy, cycles);
+  report("pools", pools, cycles);
+  checkLimits();
+
+  printf("%s: %d checks, %d failures\n", failures ? "FAIL" : "ok", checks, failures);
+  return failures ? 1 : 0;
+}
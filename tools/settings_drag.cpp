@@ -0,0 +1,136 @@
+//  === Settings persistence: NVS writes for a slider drag ===========================================
+//  Replays slider drags the way the control page sends them, one /control request per input
+//  event, against the host NVS (every commit there is a flash write on the device), and counts
+//  commits:
+//    legacy: putInt of the setting on every request (handleControl before the settings store)
+//    store:  cameraSettingsSet() on every request, cameraSettingsTick() from the server loop
+//  Then reloads the blob and checks every value survived, and migrates per-setting keys of
+//  older firmware. Exits 1 if the store writes more than once per drag or loses a value.
+//
+//  Usage: settings-drag [--steps N] [--interval MS] [--drags N] [--nvs-dir DIR]
+
+#include "Arduino.h"
+#include "camera_settings.h"
+#include <Preferences.h>
+
+extern const char* hostNvsDir;
+
+static int steps = 100;       // input events per drag
+static int interval = 16;     // ms between them, one per display frame
+static int drags = 5;         // drags, each of another setting, a few seconds apart
+
+//  Settings dragged in turn, with their legacy key and range
+static const struct { cameraSetting_t setting; const char* key; int lo; int hi; } sliders[] = {
+  { CAMERA_SETTING_BRIGHTNESS, "br", -2, 2 },   { CAMERA_SETTING_AEC_VALUE, "aecv", 0, 1200 },
+  { CAMERA_SETTING_QUALITY, "q", 4, 63 },       { CAMERA_SETTING_AGC_GAIN, "agcg", 0, 30 },
+  { CAMERA_SETTING_CONTRAST, "ct", -2, 2 },
+};
+#define SLIDERS  (int) (sizeof(sliders) / sizeof(sliders[0]))
+
+// Value of a drag step: up and back down over the range
+static int sliderValue(int aSlider, int aStep) {
+  int span = sliders[aSlider].hi - sliders[aSlider].lo;
+  int pos = (aStep * 2 * span) / steps;
+  return sliders[aSlider].lo + (pos <= span ? pos : 2 * span - pos);
+}
+
+static uint32_t dragLegacy() {
+  uint32_t before = hostNvsCommits;
+  for (int d = 0; d < drags; d++) {
+    int sl = d % SLIDERS;
+    for (int i = 0; i <= steps; i++) {
+      Preferences prefs;
+      prefs.begin("legacy", false);
+      prefs.putInt(sliders[sl].key, sliderValue(sl, i));
+      prefs.end();
+    }
+  }
+  return hostNvsCommits - before;
+}
+
+// Simulated clock: the server loop ticks the store every 10 ms between requests
+static uint32_t dragStore(int32_t* aExpected) {
+  uint32_t before = hostNvsCommits;
+  uint32_t now = 1000;
+  for (int d = 0; d < drags; d++) {
+    int sl = d % SLIDERS;
+    for (int i = 0; i <= steps; i++) {
+      int v = sliderValue(sl, i);
+      cameraSettingsSet(sliders[sl].setting, v, now);
+      aExpected[sliders[sl].setting] = v;
+      for (int t = 0; t < interval; t += 10) cameraSettingsTick(now + t);
+      now += interval;
+    }
+    for (uint32_t end = now + 3000; now < end; now += 10) cameraSettingsTick(now);
+  }
+  return hostNvsCommits - before;
+}
+
+int main(int argc, char** argv) {
+  static char dir[] = "/tmp/settings-drag-XXXXXX";
+  hostNvsDir = mkdtemp(dir);
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if ( !strcmp(argv[i], "--steps") ) steps = atoi(argv[i + 1]);
+    else if ( !strcmp(argv[i], "--interval") ) interval = atoi(argv[i + 1]);
+    else if ( !strcmp(argv[i], "--drags") ) drags = atoi(argv[i + 1]);
+    else if ( !strcmp(argv[i], "--nvs-dir") ) hostNvsDir = argv[i + 1];
+    else {
+      fprintf(stderr, "usage: %s [--steps N] [--interval MS] [--drags N] [--nvs-dir DIR]\n", argv[0]);
+      return 1;
+    }
+  }
+  if ( steps < 1 || interval < 1 || drags < 1 ) return 1;
+  int failed = 0;
+
+  printf("%d drags of %d steps, %d ms apart (%d ms per drag)\n", drags, steps + 1, interval, steps * interval);
+  uint32_t legacy = dragLegacy();
+  printf("legacy: %5u NVS writes, %.1f per drag\n", (unsigned) legacy, legacy / (double) drags);
+
+  int32_t expected[CAMERA_SETTINGS];
+  cameraSettingsClear();
+  cameraSettingsLoad();
+  for (int i = 0; i < CAMERA_SETTINGS; i++) expected[i] = cameraSettingsGet((cameraSetting_t) i);
+  uint32_t store = dragStore(expected);
+  printf("store:  %5u NVS writes, %.1f per drag, %u changes, %u saves\n", (unsigned) store,
+         store / (double) drags, (unsigned) cameraSettingsStats.changes, (unsigned) cameraSettingsStats.saves);
+  if ( store > (uint32_t) drags ) {
+    printf("FAIL: more than one write per drag\n");
+    failed = 1;
+  }
+
+  //  What the next boot sees
+  cameraSettingsLoad();
+  for (int i = 0; i < CAMERA_SETTINGS; i++) {
+    if ( cameraSettingsGet((cameraSetting_t) i) != expected[i] ) {
+      printf("FAIL: setting %d reloaded as %d, expected %d\n", i, (int) cameraSettingsGet((cameraSetting_t) i),
+             (int) expected[i]);
+      failed = 1;
+    }
+  }
+
+  //  Older firmware: one key per setting, rewritten as the blob on the first boot
+  cameraSettingsClear();
+  {
+    Preferences prefs;
+    prefs.begin(CAMERA_SETTINGS_NAMESPACE, false);
+    prefs.putInt("q", 12);
+    prefs.putInt("aecv", 900);
+    prefs.putInt("vf", 1);
+    prefs.end();
+  }
+  uint32_t before = hostNvsCommits;
+  cameraSettingsLoad();
+  uint32_t migration = hostNvsCommits - before;
+  before = hostNvsCommits;
+  cameraSettingsLoad();
+  int32_t v;
+  bool migrated = cameraSettingsStored(CAMERA_SETTING_QUALITY, &v) && v == 12 &&
+                  cameraSettingsStored(CAMERA_SETTING_AEC_VALUE, &v) && v == 900 &&
+                  cameraSettingsStored(CAMERA_SETTING_VFLIP, &v) && v == 1 &&
+                  !cameraSettingsStored(CAMERA_SETTING_BRIGHTNESS, &v) && hostNvsCommits == before;
+  printf("migration: %s, %u NVS writes once, none on later boots\n", migrated ? "ok" : "FAIL", (unsigned) migration);
+  if ( !migrated ) failed = 1;
+
+  return failed;
+}
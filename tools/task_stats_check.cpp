@@ -0,0 +1,243 @@
+//  === Task statistics check ========================================================================
+//  Feeds the /debug/tasks aggregation synthetic samples with known run times and checks:
+//    steady:   CPU shares of tasks with a fixed load
+//    window:   a load change shows up interval by interval and is complete after the window
+//    new:      a task has no share in its first sample, the share of its own time after that
+//    ended:    a task missing from a sample leaves the table, a new task on its handle starts over
+//    wrap:     run time counters wrapping around 2^32 give the same shares
+//    no stats: without run time stats (counters stay 0) no share is reported
+//    full:     tasks beyond the table are counted as untracked, the tracked ones keep their slot
+//    render:   the JSON lists every task, and a buffer too small gives 0
+//  Exits 1 on any failure.
+//
+//  Usage: task-stats-check
+
+#include "Arduino.h"
+#include "task_stats.h"
+
+#include <math.h>
+
+static int failures = 0;
+static int checks = 0;
+
+static void fail(const char* aFormat, ...) __attribute__ ((format (printf, 1, 2)));
+
+static void fail(const char* aFormat, ...) {
+  va_list args;
+  va_start(args, aFormat);
+  printf("FAIL: ");
+  vprintf(aFormat, args);
+  printf("\n");
+  va_end(args);
+  failures++;
+}
+
+// Synthetic tasks: a handle, a name and the share of each interval they run
+typedef struct {
+  uintptr_t   handle;
+  const char* name;
+  float       load;       // percent of the interval
+  uint32_t    runTime;
+} fakeTask_t;
+
+static uint32_t clockNow = 0;
+
+// One interval of aMicros: every task runs its share of it, then a sample is taken
+static void step(taskStats_t* s, fakeTask_t* aTasks, size_t aCount, uint32_t aMicros = 1000000) {
+  taskSample_t samples[TASK_STATS_MAX + 8];
+  clockNow += aMicros;
+  for (size_t i = 0; i < aCount; i++) {
+    aTasks[i].runTime += (uint32_t) (aMicros * aTasks[i].load / 100.0f);
+    samples[i].handle = (const void*) aTasks[i].handle;
+    samples[i].name = aTasks[i].name;
+    samples[i].runTime = aTasks[i].runTime;
+    samples[i].stackFree = 1000 + i;
+    samples[i].stackSize = 4096;
+    samples[i].priority = i;
+    samples[i].core = i % 3 - 1;
+    samples[i].state = 2;
+  }
+  taskStatsAdd(s, samples, aCount, clockNow);
+}
+
+static const taskStatsEntry_t* entry(const taskStats_t* s, uintptr_t aHandle, const char* aName) {
+  for (int i = 0; i < TASK_STATS_MAX; i++) {
+    const taskStatsEntry_t* e = &s->task[i];
+    if ( e->used && e->handle == (const void*) aHandle && !strcmp(e->name, aName) ) return e;
+  }
+  return NULL;
+}
+
+static void expectCpu(const taskStats_t* s, uintptr_t aHandle, const char* aName, float aExpected, const char* aCase) {
+  checks++;
+  const taskStatsEntry_t* e = entry(s, aHandle, aName);
+  if ( e == NULL ) {
+    fail("%s: %s is not in the table", aCase, aName);
+    return;
+  }
+  float cpu = taskStatsCpu(s, e);
+  if ( (aExpected < 0 && cpu >= 0) || (aExpected >= 0 && fabsf(cpu - aExpected) > 0.05f) ) {
+    fail("%s: %s at %.2f%%, expected %.2f%%", aCase, aName, cpu, aExpected);
+  }
+}
+
+static void checkSteady() {
+  taskStats_t s;
+  taskStatsInit(&s);
+  fakeTask_t t[] = { { 1, "cam", 25, 0 }, { 2, "streamCB", 50, 0 }, { 3, "IDLE0", 0, 0 } };
+  step(&s, t, 3);
+  expectCpu(&s, 1, "cam", -1, "steady, first sample");
+  for (int i = 0; i < 3; i++) step(&s, t, 3);
+  expectCpu(&s, 1, "cam", 25, "steady");
+  expectCpu(&s, 2, "streamCB", 50, "steady");
+  expectCpu(&s, 3, "IDLE0", 0, "steady");
+}
+
+static void checkWindow() {
+  taskStats_t s;
+  taskStatsInit(&s);
+  fakeTask_t t[] = { { 1, "cam", 10, 0 } };
+  for (int i = 0; i < TASK_STATS_WINDOW + 2; i++) step(&s, t, 1);
+  expectCpu(&s, 1, "cam", 10, "window, before");
+
+  t[0].load = 90;
+  for (int k = 1; k <= TASK_STATS_WINDOW + 3; k++) {
+    step(&s, t, 1);
+    int changed = k < TASK_STATS_WINDOW ? k : TASK_STATS_WINDOW;
+    float expected = (changed * 90.0f + (TASK_STATS_WINDOW - changed) * 10.0f) / TASK_STATS_WINDOW;
+    char name[32];
+    snprintf(name, sizeof(name), "window, %d after", k);
+    expectCpu(&s, 1, "cam", expected, name);
+  }
+
+  //  Intervals of different length weigh by their length
+  taskStatsInit(&s);
+  t[0].load = 0;
+  step(&s, t, 1);
+  t[0].load = 100;
+  step(&s, t, 1, 3000000);
+  t[0].load = 0;
+  step(&s, t, 1, 1000000);
+  expectCpu(&s, 1, "cam", 75, "window, uneven intervals");
+}
+
+static void checkNewAndEnded() {
+  taskStats_t s;
+  taskStatsInit(&s);
+  fakeTask_t t[] = { { 1, "cam", 20, 0 }, { 2, "streamCB", 30, 0 } };
+  for (int i = 0; i < 5; i++) step(&s, t, 1);
+  step(&s, t, 2);
+  expectCpu(&s, 2, "streamCB", -1, "new, first sample");
+  step(&s, t, 2);
+  expectCpu(&s, 2, "streamCB", 30, "new, second sample");
+  expectCpu(&s, 1, "cam", 20, "new, others unchanged");
+
+  //  The client leaves, another one gets a task on the same handle with another name
+  step(&s, t, 1);
+  checks++;
+  if ( entry(&s, 2, "streamCB") ) fail("ended: streamCB still in the table");
+  fakeTask_t u[] = { { 1, "cam", 20, t[0].runTime }, { 2, "other", 60, 0 } };
+  step(&s, u, 2);
+  expectCpu(&s, 2, "other", -1, "ended, handle reused");
+  step(&s, u, 2);
+  expectCpu(&s, 2, "other", 60, "ended, handle reused");
+  expectCpu(&s, 1, "cam", 20, "ended, others unchanged");
+}
+
+static void checkWrap() {
+  taskStats_t s;
+  taskStatsInit(&s);
+  clockNow = 0xFFFFFFFFu - 2500000;
+  fakeTask_t t[] = { { 1, "cam", 40, 0xFFFFFFFFu - 1000000 } };
+  for (int i = 0; i < 6; i++) step(&s, t, 1);
+  expectCpu(&s, 1, "cam", 40, "wrap");
+  clockNow = 0;
+}
+
+static void checkNoStats() {
+  taskStats_t s;
+  taskStatsInit(&s);
+  taskSample_t sample = { (const void*) 1, "cam", 0, 1000, 4096, 6, 1, 2 };
+  for (int i = 0; i < 3; i++) taskStatsAdd(&s, &sample, 1, 0);
+  expectCpu(&s, 1, "cam", -1, "no run time stats");
+}
+
+static void checkFull() {
+  taskStats_t s;
+  taskStatsInit(&s);
+  static fakeTask_t t[TASK_STATS_MAX + 5];
+  static char names[TASK_STATS_MAX + 5][TASK_STATS_NAME];
+  for (int i = 0; i < TASK_STATS_MAX + 5; i++) {
+    snprintf(names[i], sizeof(names[i]), "task%d", i);
+    t[i].handle = 100 + i;
+    t[i].name = names[i];
+    t[i].load = 1;
+    t[i].runTime = 0;
+  }
+  step(&s, t, TASK_STATS_MAX + 5);
+  step(&s, t, TASK_STATS_MAX + 5);
+  checks++;
+  if ( s.untracked != 5 ) fail("full: %u untracked, expected 5", (unsigned) s.untracked);
+  expectCpu(&s, 100, "task0", 1, "full, first task");
+  expectCpu(&s, 100 + TASK_STATS_MAX - 1, names[TASK_STATS_MAX - 1], 1, "full, last task tracked");
+
+  //  A tracked task ends, an untracked one takes its slot and starts over
+  t[0] = t[TASK_STATS_MAX + 4];
+  step(&s, t, TASK_STATS_MAX + 4);
+  checks++;
+  if ( s.untracked != 4 ) fail("full: %u untracked after one ended, expected 4", (unsigned) s.untracked);
+  expectCpu(&s, 100 + TASK_STATS_MAX + 4, names[TASK_STATS_MAX + 4], -1, "full, slot taken over");
+  expectCpu(&s, 101, "task1", 1, "full, tracked task kept");
+}
+
+static void checkRender() {
+  taskStats_t s;
+  taskStatsInit(&s);
+  fakeTask_t t[] = { { 1, "cam", 25, 0 }, { 2, "streamCB", 12.5, 0 } };
+  step(&s, t, 2);
+  step(&s, t, 2);
+  char buf[TASK_STATS_BUFFER_SIZE];
+  size_t len = taskStatsRender(&s, buf, sizeof(buf));
+  checks++;
+  if ( len == 0 || strlen(buf) != len ) fail("render: no document");
+  else if ( !strstr(buf, "\"name\":\"cam\"") || !strstr(buf, "\"cpu\":25.0") || !strstr(buf, "\"cpu\":12.5") ||
+            !strstr(buf, "\"stack_size\":4096") ) {
+    fail("render: %s", buf);
+  }
+  checks++;
+  if ( taskStatsRender(&s, buf, 64) != 0 ) fail("render: a 64 byte buffer is enough");
+
+  //  Every task of a full table fits the page buffer
+  static fakeTask_t full[TASK_STATS_MAX];
+  for (int i = 0; i < TASK_STATS_MAX; i++) {
+    full[i].handle = 100 + i;
+    full[i].name = "streamCB-long-n";
+    full[i].load = 3.3;
+    full[i].runTime = 0;
+  }
+  taskStatsInit(&s);
+  step(&s, full, TASK_STATS_MAX);
+  step(&s, full, TASK_STATS_MAX);
+  len = taskStatsRender(&s, buf, sizeof(buf));
+  checks++;
+  if ( len == 0 ) fail("render: %d tasks do not fit %d bytes", TASK_STATS_MAX, TASK_STATS_BUFFER_SIZE);
+  else printf("render: %d tasks in %u of %d bytes\n", TASK_STATS_MAX, (unsigned) len, TASK_STATS_BUFFER_SIZE);
+}
+
+int main(int argc, char** argv) {
+  (void) argv;
+  if ( argc > 1 ) {
+    fprintf(stderr, "usage: task-stats-check\n");
+    return 1;
+  }
+  checkSteady();
+  checkWindow();
+  checkNewAndEnded();
+  checkWrap();
+  checkNoStats();
+  checkFull();
+  checkRender();
+
+  printf("%s: %d checks, %d failures\n", failures ? "FAIL" : "ok", checks, failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,246 @@
+//  === Trace decoder: /debug/trace file to a log and a Chrome trace =================================
+//  Reads the file a TRACE_LOG build sends from /debug/trace (see include/trace.h) and writes
+//    log:     every Log message, formatted the way the device would, with its time and task
+//    spans:   per task and span name: count, total, mean and longest time
+//    chrome:  the records as Chrome trace events (chrome://tracing, ui.perfetto.dev): spans as
+//             begin/end pairs on the thread of their task, messages as instant events
+//  Timestamps are microseconds since the first record. Exits 1 on a file it cannot read.
+//
+//  Usage: trace-decode FILE [--log OUT] [--chrome OUT.json] [--no-spans]
+
+#include "Arduino.h"
+#include "trace.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+typedef struct {
+  uint8_t     kind;
+  uint8_t     task;
+  uint8_t     level;
+  uint16_t    format;
+  uint64_t    time;     // us since the first record
+  std::string text;     // message, or span name
+} traceEvent_t;
+
+typedef struct {
+  uint32_t    count;
+  uint64_t    total;
+  uint64_t    max;
+} spanStats_t;
+
+static std::vector<std::string> formats;
+static std::vector<std::string> tasks;
+static std::vector<traceEvent_t> events;
+static traceFileHeader_t header;
+
+static const char* levelName(uint8_t aLevel) {
+  static const char* const names[] = { "silent", "fatal", "error", "warning", "notice", "trace", "verbose" };
+  return aLevel < sizeof(names) / sizeof(names[0]) ? names[aLevel] : "?";
+}
+
+static std::string taskName(uint8_t aTask) {
+  if ( aTask < tasks.size() ) return tasks[aTask];
+  return "other";
+}
+
+// ==== File ==================================================================================
+static bool readFile(const char* aPath) {
+  FILE* f = fopen(aPath, "rb");
+  if ( f == NULL ) {
+    fprintf(stderr, "cannot open %s\n", aPath);
+    return false;
+  }
+  std::vector<uint8_t> data;
+  uint8_t chunk[4096];
+  size_t n;
+  while ( (n = fread(chunk, 1, sizeof(chunk), f)) > 0 ) data.insert(data.end(), chunk, chunk + n);
+  fclose(f);
+
+  size_t pos = 0;
+  if ( data.size() < sizeof(header) ) goto truncated;
+  memcpy(&header, &data[0], sizeof(header));
+  pos = sizeof(header);
+  if ( memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) || header.version != TRACE_VERSION ||
+       header.header != sizeof(traceRecord_t) ) {
+    fprintf(stderr, "%s: not a version %d trace file\n", aPath, TRACE_VERSION);
+    return false;
+  }
+
+  for (uint16_t i = 0; i < header.formats; i++) {
+    uint16_t len;
+    if ( pos + sizeof(len) > data.size() ) goto truncated;
+    memcpy(&len, &data[pos], sizeof(len));
+    pos += sizeof(len);
+    if ( pos + len > data.size() ) goto truncated;
+    formats.push_back(std::string((const char*) &data[pos], len));
+    pos += len;
+  }
+  for (uint16_t i = 0; i < header.tasks; i++) {
+    if ( pos + 1 > data.size() ) goto truncated;
+    uint8_t len = data[pos++];
+    if ( pos + len > data.size() ) goto truncated;
+    tasks.push_back(std::string((const char*) &data[pos], len));
+    pos += len;
+  }
+
+  {
+    //  Times are the low 32 bits of a microsecond clock, unwrapped here
+    uint64_t base = 0, first = 0;
+    uint32_t last = 0;
+    size_t end = pos + header.bytes;
+    if ( end > data.size() ) goto truncated;
+    while ( pos + sizeof(traceRecord_t) <= end ) {
+      traceRecord_t r;
+      memcpy(&r, &data[pos], sizeof(r));
+      pos += sizeof(r);
+      if ( pos + r.size > end ) goto truncated;
+
+      if ( events.empty() ) first = r.time;
+      else if ( r.time < last ) base += 1ULL << 32;
+      last = r.time;
+
+      traceEvent_t e;
+      e.kind = r.kind;
+      e.task = r.task;
+      e.level = r.level;
+      e.format = r.format;
+      e.time = base + r.time - first;
+      const char* format = r.format < formats.size() ? formats[r.format].c_str() : "<format table full>";
+      if ( r.kind == TRACE_KIND_MESSAGE ) {
+        char line[LOG_LINE_MAX];
+        size_t len = SimpleLog::formatMessage(format, &data[pos], r.size, line, sizeof(line));
+        while ( len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r') ) len--;
+        e.text.assign(line, len);
+      }
+      else e.text = format;
+      events.push_back(e);
+      pos += r.size;
+    }
+  }
+  return true;
+
+truncated:
+  fprintf(stderr, "%s: truncated at byte %u\n", aPath, (unsigned) pos);
+  return false;
+}
+
+// ==== Text ==================================================================================
+static void writeLog(FILE* aOut, bool aSpans) {
+  fprintf(aOut, "# %u records, %u overwritten by newer ones, %u dropped\n", (unsigned) events.size(),
+          (unsigned) header.lost, (unsigned) header.dropped);
+  for (size_t i = 0; i < events.size(); i++) {
+    const traceEvent_t& e = events[i];
+    if ( e.kind != TRACE_KIND_MESSAGE ) continue;
+    fprintf(aOut, "%12.3f ms %-12s %-7s %s\n", e.time / 1000.0, taskName(e.task).c_str(), levelName(e.level), e.text.c_str());
+  }
+  if ( !aSpans ) return;
+
+  //  A span ends the innermost open span of the same name on its task
+  std::map<std::pair<std::string, std::string>, spanStats_t> spans;
+  std::map<uint8_t, std::vector<const traceEvent_t*> > open;
+  for (size_t i = 0; i < events.size(); i++) {
+    const traceEvent_t& e = events[i];
+    std::vector<const traceEvent_t*>& stack = open[e.task];
+    if ( e.kind == TRACE_KIND_BEGIN ) stack.push_back(&e);
+    else if ( e.kind == TRACE_KIND_END ) {
+      if ( stack.empty() || stack.back()->text != e.text ) continue;   // begin overwritten
+      uint64_t d = e.time - stack.back()->time;
+      stack.pop_back();
+      spanStats_t& s = spans[std::make_pair(taskName(e.task), e.text)];
+      s.count++;
+      s.total += d;
+      if ( d > s.max ) s.max = d;
+    }
+  }
+  fprintf(aOut, "\n%-12s %-10s %8s %12s %10s %10s\n", "task", "span", "count", "total ms", "mean us", "max us");
+  for (std::map<std::pair<std::string, std::string>, spanStats_t>::iterator it = spans.begin(); it != spans.end(); ++it) {
+    const spanStats_t& s = it->second;
+    fprintf(aOut, "%-12s %-10s %8u %12.3f %10.1f %10u\n", it->first.first.c_str(), it->first.second.c_str(),
+            (unsigned) s.count, s.total / 1000.0, (double) s.total / s.count, (unsigned) s.max);
+  }
+}
+
+// ==== Chrome trace event format ==========================================================
+static void jsonString(FILE* aOut, const std::string& aText) {
+  fputc('"', aOut);
+  for (size_t i = 0; i < aText.size(); i++) {
+    unsigned char c = aText[i];
+    if ( c == '"' || c == '\\' ) fprintf(aOut, "\\%c", c);
+    else if ( c < 0x20 ) fprintf(aOut, "\\u%04x", c);
+    else fputc(c, aOut);
+  }
+  fputc('"', aOut);
+}
+
+static void writeChrome(FILE* aOut) {
+  fprintf(aOut, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  fprintf(aOut, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"esp32cam\"}}");
+  for (size_t i = 0; i <= tasks.size(); i++) {
+    fprintf(aOut, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", (unsigned) i + 1);
+    jsonString(aOut, taskName(i));
+    fprintf(aOut, "}}");
+  }
+
+  std::map<uint8_t, std::vector<std::string> > open;
+  for (size_t i = 0; i < events.size(); i++) {
+    const traceEvent_t& e = events[i];
+    unsigned tid = (e.task < tasks.size() ? e.task : tasks.size()) + 1;
+    std::vector<std::string>& stack = open[e.task];
+    if ( e.kind == TRACE_KIND_END ) {
+      if ( stack.empty() || stack.back() != e.text ) continue;
+      stack.pop_back();
+    }
+    if ( e.kind == TRACE_KIND_BEGIN ) stack.push_back(e.text);
+
+    fprintf(aOut, ",\n{\"name\":");
+    jsonString(aOut, e.text);
+    fprintf(aOut, ",\"ts\":%llu,\"pid\":1,\"tid\":%u,", (unsigned long long) e.time, tid);
+    if ( e.kind == TRACE_KIND_MESSAGE ) fprintf(aOut, "\"ph\":\"i\",\"s\":\"t\",\"cat\":\"log\",\"args\":{\"level\":\"%s\"}}", levelName(e.level));
+    else fprintf(aOut, "\"ph\":\"%c\",\"cat\":\"span\"}", e.kind == TRACE_KIND_BEGIN ? 'B' : 'E');
+  }
+  fprintf(aOut, "\n]}\n");
+}
+
+int main(int argc, char** argv) {
+  const char* input = NULL;
+  const char* logPath = NULL;
+  const char* chromePath = NULL;
+  bool spans = true;
+
+  for (int i = 1; i < argc; i++) {
+    if ( !strcmp(argv[i], "--log") && i + 1 < argc ) logPath = argv[++i];
+    else if ( !strcmp(argv[i], "--chrome") && i + 1 < argc ) chromePath = argv[++i];
+    else if ( !strcmp(argv[i], "--no-spans") ) spans = false;
+    else if ( argv[i][0] != '-' && input == NULL ) input = argv[i];
+    else {
+      input = NULL;
+      break;
+    }
+  }
+  if ( input == NULL ) {
+    fprintf(stderr, "usage: %s FILE [--log OUT] [--chrome OUT.json] [--no-spans]\n", argv[0]);
+    return 1;
+  }
+  if ( !readFile(input) ) return 1;
+
+  FILE* out = logPath ? fopen(logPath, "w") : stdout;
+  if ( out == NULL ) {
+    fprintf(stderr, "cannot write %s\n", logPath);
+    return 1;
+  }
+  writeLog(out, spans);
+  if ( out != stdout ) fclose(out);
+
+  if ( chromePath ) {
+    out = fopen(chromePath, "w");
+    if ( out == NULL ) {
+      fprintf(stderr, "cannot write %s\n", chromePath);
+      return 1;
+    }
+    writeChrome(out);
+    fclose(out);
+  }
+  return 0;
+}
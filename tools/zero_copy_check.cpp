@@ -0,0 +1,340 @@
+//  === Zero-copy frame source check ==================================================================
+//  Plugs a fake camera driver into frameSource: CAMERA_FB_COUNT buffers, each rewritten with a new
+//  capture when the driver hands it out, and counts the buffers out of the driver's hands. A camera
+//  thread runs the camCB capture path against it (frameRingAttach, or a copy through
+//  frameRingReserve when the ring keeps enough driver buffers) while consumer threads hold frames
+//  as sends would, some of them far longer than a frame interval. Checks that
+//    stuck:    clients that never let go of their frames keep at most FRAME_FB_HOLD_MAX driver
+//              buffers; the camera goes on capturing and copying
+//    threads:  the ring never keeps more than FRAME_FB_HOLD_MAX buffers, every buffer goes back to
+//              the driver exactly once, and no frame changes while a consumer holds it
+//  and reports the buffers out and the bytes memcpy'd per second, zero-copy against copying
+//  every frame.
+//  Exits 1 on any failure.
+//
+//  Usage: zero-copy-check [--seconds S] [--consumers N] [--slow N] [--fps F]
+//    --slow N  makes N of the consumers hold each frame 80-150 ms, the others 1 ms
+
+#include "Arduino.h"
+#include "frame_ring.h"
+
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define CHECK_SLOT_SIZE   (64 * 1024)
+
+static int failures = 0;
+static int checks = 0;
+
+static void fail(const char* aFormat, ...) __attribute__ ((format (printf, 1, 2)));
+
+static void fail(const char* aFormat, ...) {
+  va_list args;
+  va_start(args, aFormat);
+  printf("FAIL: ");
+  vprintf(aFormat, args);
+  printf("\n");
+  va_end(args);
+  failures++;
+}
+
+static void expect(bool aOk, const char* aWhat) {
+  checks++;
+  if ( !aOk ) fail("%s", aWhat);
+}
+
+// ==== Fake camera driver ====================================================================
+// A capture is a number and bytes derived from it; a buffer is rewritten when it is handed out
+static inline uint8_t pattern(uint32_t aCapture, size_t aOffset) {
+  return (uint8_t) (aCapture * 131u + aOffset * 7u + (aOffset >> 8));
+}
+
+static uint32_t captureOf(const uint8_t* aBuf) {
+  uint32_t c;
+  memcpy(&c, aBuf, sizeof(c));
+  return c;
+}
+
+static bool intact(const uint8_t* aBuf, size_t aSize) {
+  uint32_t c = captureOf(aBuf);
+  for (size_t i = sizeof(c); i < aSize; i++) {
+    if ( aBuf[i] != pattern(c, i) ) return false;
+  }
+  return true;
+}
+
+typedef struct {
+  std::mutex  mux;
+  camera_fb_t fb[CAMERA_FB_COUNT];
+  uint8_t     data[CAMERA_FB_COUNT][CHECK_SLOT_SIZE];
+  bool        out[CAMERA_FB_COUNT];
+  int         outNow;
+  int         outMax;
+  uint32_t    captures;
+  uint32_t    returns;
+  uint32_t    badReturns;   // returned twice, or never handed out
+  uint32_t    waits;        // gets that found every buffer out and had to wait
+  uint32_t    seed;
+} fakeDriver_t;
+
+static fakeDriver_t driver;
+
+static camera_fb_t* fakeGet() {
+  for (int tries = 0; tries < 200; tries++) {
+    {
+      std::lock_guard<std::mutex> lock(driver.mux);
+      for (int i = 0; i < CAMERA_FB_COUNT; i++) {
+        if ( driver.out[i] ) continue;
+        driver.out[i] = true;
+        if ( ++driver.outNow > driver.outMax ) driver.outMax = driver.outNow;
+        uint32_t c = ++driver.captures;
+        driver.seed = driver.seed * 1103515245u + 12345u;
+        camera_fb_t* fb = &driver.fb[i];
+        fb->buf = driver.data[i];
+        fb->len = 30 * 1024 + (driver.seed >> 8) % (30 * 1024);
+        memcpy(fb->buf, &c, sizeof(c));
+        for (size_t j = sizeof(c); j < fb->len; j++) fb->buf[j] = pattern(c, j);
+        gettimeofday(&fb->timestamp, NULL);
+        return fb;
+      }
+      if ( tries == 0 ) driver.waits++;
+    }
+    //  Like the driver, wait for a buffer to come back - but not forever
+    usleep(500);
+  }
+  return NULL;
+}
+
+static void fakeRet(camera_fb_t* aFb) {
+  std::lock_guard<std::mutex> lock(driver.mux);
+  int i = aFb - driver.fb;
+  if ( i < 0 || i >= CAMERA_FB_COUNT || !driver.out[i] ) {
+    driver.badReturns++;
+    return;
+  }
+  driver.out[i] = false;
+  driver.outNow--;
+  driver.returns++;
+}
+
+static void driverReset() {
+  std::lock_guard<std::mutex> lock(driver.mux);
+  memset(driver.out, 0, sizeof(driver.out));
+  driver.outNow = driver.outMax = 0;
+  driver.captures = driver.returns = driver.badReturns = driver.waits = 0;
+  driver.seed = 1;
+}
+
+// ==== Camera side: the capture path of camCB ================================================
+static std::atomic<uint64_t> bytesCopied(0);
+static std::atomic<int>      heldMax(0);
+
+static bool capture(bool aZeroCopy) {
+  camera_fb_t* fb = frameSource.get();
+  if ( fb == NULL ) return false;
+  frameChunck_t* f = NULL;
+
+  if ( aZeroCopy ) {
+    f = frameRingAttach(fb);
+    if ( f ) fb = NULL;
+  }
+  if ( fb ) {
+    f = frameRingReserve(fb->len);
+    if ( f ) {
+      memcpy(f->dat, fb->buf, fb->len);
+      f->siz = fb->len;
+      f->tsp = fb->timestamp;
+      bytesCopied += fb->len;
+    }
+    frameSource.ret(fb);
+  }
+  if ( f ) frameRingPublish(f);
+
+  int held = frameRingStats.fbHeld;
+  if ( held > heldMax ) heldMax = held;
+  return true;
+}
+
+// Frames still referenced go back through frameRingRelease, the current one through frameRingClear
+static void drain(std::vector<frameChunck_t*>& aHeld) {
+  for (size_t i = 0; i < aHeld.size(); i++) frameRingRelease(aHeld[i]);
+  aHeld.clear();
+  frameRingClear();
+}
+
+// ==== Clients that never let go ==============================================================
+static void checkStuck() {
+  driverReset();
+  heldMax = 0;
+  std::vector<frameChunck_t*> held;
+  uint32_t last = 0;
+
+  //  Every client takes the newest frame and keeps it; the ring has a slot for each of them
+  for (int i = 0; i < FRAME_RING_SLOTS - 2; i++) {
+    capture(true);
+    frameChunck_t* f = frameRingAcquire(last);
+    if ( f ) {
+      held.push_back(f);
+      last = f->fnm;
+    }
+  }
+  uint32_t zeroCopy = frameRingStats.zeroCopy;
+  uint32_t published = frameRingStats.published;
+  for (int i = 0; i < 100; i++) capture(true);
+
+  char what[160];
+  snprintf(what, sizeof(what), "stuck: the ring kept %d driver buffers, at most %d allowed", (int) heldMax, FRAME_FB_HOLD_MAX);
+  expect(heldMax <= FRAME_FB_HOLD_MAX, what);
+  snprintf(what, sizeof(what), "stuck: the driver had %d of %d buffers out", driver.outMax, CAMERA_FB_COUNT);
+  expect(driver.outMax <= FRAME_FB_HOLD_MAX + 1 && driver.waits == 0, what);
+  expect(frameRingStats.published - published == 100 && frameRingStats.zeroCopy - zeroCopy <= 1,
+         "stuck: capture did not go on by copying");
+
+  bool whole = true;
+  for (size_t i = 0; i < held.size(); i++) whole = whole && intact(held[i]->dat, held[i]->siz);
+  expect(whole, "stuck: a held frame changed under its client");
+
+  drain(held);
+  expect(driver.outNow == 0 && driver.badReturns == 0 && frameRingStats.fbHeld == 0,
+         "stuck: driver buffers not returned exactly once");
+  printf("stuck      : %u clients holding frames, %d driver buffers kept at most, 100 more frames copied\n",
+         (unsigned) FRAME_RING_SLOTS - 2, (int) heldMax);
+}
+
+// ==== Camera and consumer threads ============================================================
+typedef struct {
+  bool                  slow;
+  uint32_t              seed;
+  std::atomic<uint32_t> frames;
+} checkConsumer_t;
+
+static std::atomic<bool>     running(false);
+static std::atomic<uint32_t> torn(0);
+
+static void consumerLoop(checkConsumer_t* c) {
+  uint32_t last = 0;
+  while ( running ) {
+    frameChunck_t* f = frameRingAcquire(last);
+    if ( f == NULL ) {
+      usleep(200);
+      continue;
+    }
+    uint32_t capture = captureOf(f->dat);
+    bool ok = intact(f->dat, f->siz);
+    c->seed = c->seed * 1103515245u + 12345u;
+    usleep(c->slow ? 80000 + (c->seed >> 8) % 70000 : 1000);
+    //  Still the same capture, untouched: the buffer was not handed back to the driver meanwhile
+    if ( !ok || captureOf(f->dat) != capture || !intact(f->dat, f->siz) ) torn++;
+    last = f->fnm;
+    c->frames++;
+    frameRingRelease(f);
+  }
+}
+
+typedef struct {
+  uint32_t  frames;
+  uint32_t  zeroCopy;
+  double    bytesPerSecond;
+  int       heldMax;
+  int       outMax;
+  uint32_t  waits;
+} runResult_t;
+
+static runResult_t run(bool aZeroCopy, double aSeconds, int aConsumers, int aSlow, float aFps) {
+  driverReset();
+  heldMax = 0;
+  bytesCopied = 0;
+  uint32_t published = frameRingStats.published;
+  uint32_t zeroCopy = frameRingStats.zeroCopy;
+
+  std::vector<checkConsumer_t> consumers(aConsumers);
+  std::vector<std::thread> threads;
+  running = true;
+  for (int i = 0; i < aConsumers; i++) {
+    consumers[i].slow = i < aSlow;
+    consumers[i].seed = 7 + i;
+    consumers[i].frames = 0;
+    threads.push_back(std::thread(consumerLoop, &consumers[i]));
+  }
+
+  const useconds_t interval = (useconds_t) (1000000 / aFps);
+  const long frames = (long) (aSeconds * aFps);
+  bool starved = false;
+  for (long i = 0; i < frames && !starved; i++) {
+    starved = !capture(aZeroCopy);
+    usleep(interval);
+  }
+  running = false;
+  for (size_t i = 0; i < threads.size(); i++) threads[i].join();
+  std::vector<frameChunck_t*> none;
+  drain(none);
+
+  runResult_t r;
+  r.frames = frameRingStats.published - published;
+  r.zeroCopy = frameRingStats.zeroCopy - zeroCopy;
+  r.bytesPerSecond = bytesCopied / aSeconds;
+  r.heldMax = heldMax;
+  r.outMax = driver.outMax;
+  r.waits = driver.waits;
+
+  const char* mode = aZeroCopy ? "zero-copy" : "copy";
+  char what[160];
+  snprintf(what, sizeof(what), "%s: the driver ran out of buffers for 100 ms", mode);
+  expect(!starved, what);
+  snprintf(what, sizeof(what), "%s: the ring kept %d driver buffers, at most %d allowed", mode, r.heldMax, FRAME_FB_HOLD_MAX);
+  expect(r.heldMax <= FRAME_FB_HOLD_MAX, what);
+  snprintf(what, sizeof(what), "%s: %u driver buffers not returned, %u returned twice", mode,
+           (unsigned) driver.outNow, (unsigned) driver.badReturns);
+  expect(driver.outNow == 0 && driver.badReturns == 0 && driver.returns == driver.captures, what);
+  snprintf(what, sizeof(what), "%s: %u frames changed while a consumer held them", mode, (unsigned) torn.load());
+  expect(torn == 0, what);
+
+  printf("%-10s : %u frames, %u sent zero-copy, %.0f KB/s memcpy'd, %d of %d driver buffers out at most, "
+         "%u waits for a buffer\n", mode, (unsigned) r.frames, (unsigned) r.zeroCopy, r.bytesPerSecond / 1024,
+         r.outMax, CAMERA_FB_COUNT, (unsigned) r.waits);
+  return r;
+}
+
+int main(int argc, char** argv) {
+  double seconds = 2;
+  int consumers = 4;
+  int slow = 2;
+  float fps = 30;
+
+  for (int i = 1; i < argc; i++) {
+    if ( i + 1 >= argc ) consumers = -1;
+    else if ( !strcmp(argv[i], "--seconds") ) seconds = atof(argv[++i]);
+    else if ( !strcmp(argv[i], "--consumers") ) consumers = atoi(argv[++i]);
+    else if ( !strcmp(argv[i], "--slow") ) slow = atoi(argv[++i]);
+    else if ( !strcmp(argv[i], "--fps") ) fps = atof(argv[++i]);
+    else consumers = -1;
+  }
+  if ( seconds <= 0 || fps <= 0 || fps > 1000 || consumers < 1 || consumers > FRAME_RING_SLOTS - 2 || slow < 0 ||
+       slow > consumers ) {
+    fprintf(stderr, "usage: %s [--seconds S] [--consumers 1..%d] [--slow N] [--fps F]\n", argv[0], FRAME_RING_SLOTS - 2);
+    return 1;
+  }
+
+  frameSource.get = fakeGet;
+  frameSource.ret = fakeRet;
+  if ( !frameRingInit(FRAME_RING_SLOTS, CHECK_SLOT_SIZE) ) {
+    fprintf(stderr, "cannot set up the ring\n");
+    return 1;
+  }
+  printf("%d driver buffers, at most %d kept by the ring, %d ring slots\n", CAMERA_FB_COUNT, FRAME_FB_HOLD_MAX,
+         FRAME_RING_SLOTS);
+
+  checkStuck();
+  runResult_t copy = run(false, seconds, consumers, slow, fps);
+  runResult_t zero = run(true, seconds, consumers, slow, fps);
+  expect(zero.zeroCopy > 0 && zero.bytesPerSecond < copy.bytesPerSecond, "zero-copy: copied no less than copying every frame");
+
+  printf("%s: %d checks, %d failures\n", failures ? "FAIL" : "ok", checks, failures);
+  return failures ? 1 : 0;
+}